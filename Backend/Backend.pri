@@ -19,22 +19,60 @@
 INCLUDEPATH += $$PWD\..\Include
 
 HEADERS += \
+    $$PWD/compiledexpression.h \
+    $$PWD/complexinterval.h \
     $$PWD/expression.h \
+    $$PWD/expressionprofiler.h \
+    $$PWD/expressiontemplate.h \
     $$PWD/basez.h \
     $$PWD/constant.h \
+    $$PWD/framepipeline.h \
     $$PWD/functions.h \
+    $$PWD/fusedevaluator.h \
     $$PWD/gridgenerator.h \
+    $$PWD/nativekernel.h \
+    $$PWD/orbitevaluator.h \
+    $$PWD/parallelfor.h \
+    $$PWD/parameter.h \
+    $$PWD/parametersweep.h \
     $$PWD/parser.h \
     $$PWD/power.h \
     $$PWD/product.h \
-    $$PWD/sum.h
+    $$PWD/rationalfunction.h \
+    $$PWD/resultcache.h \
+    $$PWD/rootfinder.h \
+    $$PWD/sample.h \
+    $$PWD/separableevaluator.h \
+    $$PWD/streamlinetracer.h \
+    $$PWD/sum.h \
+    $$PWD/tilescheduler.h \
+    $$PWD/tracer.h \
+    $$PWD/viewportevaluator.h
 
 SOURCES += \
     $$PWD/basez.cpp \
+    $$PWD/compiledexpression.cpp \
+    $$PWD/complexinterval.cpp \
     $$PWD/constant.cpp \
+    $$PWD/expressionprofiler.cpp \
+    $$PWD/framepipeline.cpp \
     $$PWD/functions.cpp \
+    $$PWD/fusedevaluator.cpp \
     $$PWD/gridgenerator.cpp \
+    $$PWD/nativekernel.cpp \
+    $$PWD/orbitevaluator.cpp \
+    $$PWD/parallelfor.cpp \
+    $$PWD/parameter.cpp \
+    $$PWD/parametersweep.cpp \
     $$PWD/parser.cpp \
     $$PWD/power.cpp \
     $$PWD/product.cpp \
-    $$PWD/sum.cpp
+    $$PWD/rationalfunction.cpp \
+    $$PWD/resultcache.cpp \
+    $$PWD/rootfinder.cpp \
+    $$PWD/separableevaluator.cpp \
+    $$PWD/streamlinetracer.cpp \
+    $$PWD/sum.cpp \
+    $$PWD/tilescheduler.cpp \
+    $$PWD/tracer.cpp \
+    $$PWD/viewportevaluator.cpp
@@ -17,6 +17,10 @@
  */
 
 #include "basez.h"
+#include "complexinterval.h"
+
+#include <functional>
+#include <string_view>
 
 namespace Backend {
 
@@ -35,6 +39,16 @@ namespace Backend {
         return input;
     }
 
+    ComplexInterval BaseZ::EvaluateInterval(const ComplexInterval & input) const
+    {
+        return input;
+    }
+
+    std::size_t BaseZ::GetHash() const
+    {
+        return std::hash<std::string_view>{}(u8"BaseZ");
+    }
+
     bool BaseZ::operator==(const Expression &other) const
     {
         if (const auto * b = dynamic_cast<const BaseZ*>(&other))
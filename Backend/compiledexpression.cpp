@@ -0,0 +1,434 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <cfenv>
+#include <cmath>
+#include <stdexcept>
+
+#include "basez.h"
+#include "compiledexpression.h"
+#include "functions.h"
+#include "nativekernel.h"
+#include "power.h"
+#include "product.h"
+#include "sum.h"
+
+namespace Backend {
+
+    namespace {
+
+        template<typename T>
+        std::optional<std::complex<T>> Round(const std::optional<complex> & value)
+        {
+            if (!value.has_value())
+            {
+                return {};
+            }
+
+            std::complex<T> retval(static_cast<T>(value->real()), static_cast<T>(value->imag()));
+
+            // beyond the range of the type, the value is treated like an overflow in Evaluate
+            if ((std::isinf(retval.real()) && !std::isinf(value->real())) || (std::isinf(retval.imag()) && !std::isinf(value->imag())))
+            {
+                return {};
+            }
+
+            return retval;
+        }
+
+        template<typename T>
+        void AddLanes(const T * __restrict leftReal, const T * __restrict leftImag, const T * __restrict rightReal, const T * __restrict rightImag,
+                      T * __restrict destinationReal, T * __restrict destinationImag, T sign, std::size_t count)
+        {
+            for (std::size_t index = 0; index < count; ++index)
+            {
+                destinationReal[index] = leftReal[index] + sign * rightReal[index]; //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                destinationImag[index] = leftImag[index] + sign * rightImag[index]; //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            }
+        }
+
+        template<typename T>
+        void MultiplyLanes(const T * __restrict leftReal, const T * __restrict leftImag, const T * __restrict rightReal, const T * __restrict rightImag,
+                           T * __restrict destinationReal, T * __restrict destinationImag, std::size_t count)
+        {
+            for (std::size_t index = 0; index < count; ++index)
+            {
+                destinationReal[index] = leftReal[index] * rightReal[index] - leftImag[index] * rightImag[index]; //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                destinationImag[index] = leftReal[index] * rightImag[index] + leftImag[index] * rightReal[index]; //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            }
+        }
+    }
+
+    CompiledExpression::CompiledExpression(std::shared_ptr<Expression> expression, bool useNativeCode)
+        : expression(std::move(expression)),
+          initialRegisters(1, complex(0.0)),
+          result(0)
+    {
+        this->result = this->Compile(this->expression);
+        this->compiledNodes.clear();
+
+        if (useNativeCode && CompiledExpression::IsNativeCodeAvailable())
+        {
+            this->nativeKernel = NativeKernel::Create(this->program, this->result);
+        }
+    }
+
+    CompiledExpression::~CompiledExpression() = default;
+
+    bool CompiledExpression::IsNativeCodeAvailable()
+    {
+        return NativeKernel::IsAvailable();
+    }
+
+    bool CompiledExpression::IsNative() const
+    {
+        return this->nativeKernel != nullptr;
+    }
+
+    const std::vector<CompiledExpression::Instruction> & CompiledExpression::GetProgram() const
+    {
+        return this->program;
+    }
+
+    std::optional<complex> CompiledExpression::Evaluate(complex input) const
+    {
+        auto registers = this->initialRegisters;
+        registers[0] = input;
+        unsigned char undefined = 0;
+
+        for (const auto & instruction : this->program)
+        {
+            CompiledExpression::Execute(&instruction, registers.data(), &undefined);
+
+            if (undefined != 0)
+            {
+                return {};
+            }
+        }
+
+        return registers[this->result];
+    }
+
+    void CompiledExpression::EvaluateLine(const complex * inputs, std::optional<complex> * outputs, std::size_t count) const
+    {
+        if (!this->nativeKernel)
+        {
+            this->EvaluateLanes(inputs, outputs, count);
+            return;
+        }
+
+        // the scratch space is kept per thread, such that short lines do not pay for allocations
+        thread_local std::vector<complex> registers;
+        thread_local std::vector<complex> values;
+        thread_local std::vector<unsigned char> undefined;
+
+        registers.assign(this->initialRegisters.begin(), this->initialRegisters.end());
+        values.resize(std::min(count, CompiledExpression::chunkSize));
+        undefined.resize(values.size());
+
+        NativeContext context { nullptr, values.data(), undefined.data(), 0, registers.data(), { -0.0, 0.0 }, 0 };
+
+        for (std::size_t start = 0; start < count; start += CompiledExpression::chunkSize)
+        {
+            context.inputs = inputs + start; //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            context.count = std::min(count - start, CompiledExpression::chunkSize);
+            this->nativeKernel->Run(context);
+
+            for (std::size_t index = 0; index < context.count; ++index)
+            {
+                auto & output = outputs[start + index]; //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                const auto & value = values[index];
+
+                if (undefined[index] != 0)
+                {
+                    output.reset();
+                }
+                else if (std::isnan(value.real()) && std::isnan(value.imag()))
+                {
+                    // std::complex recovers infinities from such products, so they are interpreted
+                    output = this->Evaluate(inputs[start + index]); //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                }
+                else
+                {
+                    output = value;
+                }
+            }
+        }
+    }
+
+    void CompiledExpression::EvaluateLine(const complexf * inputs, std::optional<complexf> * outputs, std::size_t count) const
+    {
+        this->EvaluateLanes(inputs, outputs, count);
+    }
+
+    void CompiledExpression::Execute(const Instruction * instruction, complex * registers, unsigned char * undefined)
+    {
+        const auto & left = registers[instruction->left]; //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        const auto & right = registers[instruction->right]; //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        auto value = CompiledExpression::Apply(*instruction, left, right, registers[0]);
+
+        if (!value.has_value())
+        {
+            *undefined = 1;
+            return;
+        }
+
+        registers[instruction->destination] = value.value(); //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+    std::optional<complex> CompiledExpression::Apply(const Instruction & instruction, complex left, complex right, complex input)
+    {
+        // every case does what the node does in Evaluate
+        switch (instruction.opCode)
+        {
+        case OpCode::Constant:
+            return instruction.constant;
+        case OpCode::Add:
+            return left + right;
+        case OpCode::Subtract:
+            return left - right;
+        case OpCode::Multiply:
+            return left * right;
+        case OpCode::Divide:
+        {
+            if (std::fabs(right.real()) < CompiledExpression::epsilon && std::fabs(right.imag()) < CompiledExpression::epsilon)
+            {
+                return {};
+            }
+
+            std::feclearexcept(FE_ALL_EXCEPT); //NOLINT(hicpp-signed-bitwise)
+            auto quotient = left / right;
+
+            if (std::fetestexcept(FE_DIVBYZERO | FE_OVERFLOW) != 0) //NOLINT(hicpp-signed-bitwise)
+            {
+                return {};
+            }
+
+            return quotient;
+        }
+        case OpCode::Power:
+            return Power::Apply(left, right);
+        case OpCode::Function:
+            return instruction.apply(left);
+        case OpCode::Node:
+            return instruction.node->Evaluate(input);
+        default:
+            throw std::logic_error(u8"programming mistake in CompiledExpression switch");
+        }
+    }
+
+    template<typename T>
+    void CompiledExpression::EvaluateLanes(const std::complex<T> * inputs, std::optional<std::complex<T>> * outputs, std::size_t count) const
+    {
+        // every register is an array of real and an array of imaginary parts, padded to whole lanes
+        auto width = (std::min(count, CompiledExpression::chunkSize) + CompiledExpression::laneCount - 1) / CompiledExpression::laneCount * CompiledExpression::laneCount;
+        thread_local std::vector<T> reals;
+        thread_local std::vector<T> imags;
+        thread_local std::vector<unsigned char> undefined;
+
+        reals.resize(this->initialRegisters.size() * width);
+        imags.resize(this->initialRegisters.size() * width);
+        undefined.resize(width);
+
+        for (std::size_t index = 0; index < this->initialRegisters.size(); ++index)
+        {
+            std::fill_n(reals.begin() + static_cast<std::ptrdiff_t>(index * width), width, static_cast<T>(this->initialRegisters[index].real()));
+            std::fill_n(imags.begin() + static_cast<std::ptrdiff_t>(index * width), width, static_cast<T>(this->initialRegisters[index].imag()));
+        }
+
+        auto real = [&](std::size_t index){ return reals.data() + index * width; }; //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        auto imag = [&](std::size_t index){ return imags.data() + index * width; }; //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+        for (std::size_t start = 0; start < count; start += width)
+        {
+            auto length = std::min(count - start, width);
+            std::fill(undefined.begin(), undefined.end(), 0);
+
+            for (std::size_t index = 0; index < width; ++index)
+            {
+                auto input = index < length ? inputs[start + index] : std::complex<T>(); //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                reals[index] = input.real();
+                imags[index] = input.imag();
+            }
+
+            for (const auto & instruction : this->program)
+            {
+                auto * destinationReal = real(instruction.destination);
+                auto * destinationImag = imag(instruction.destination);
+                const auto * leftReal = real(instruction.left);
+                const auto * leftImag = imag(instruction.left);
+                const auto * rightReal = real(instruction.right);
+                const auto * rightImag = imag(instruction.right);
+
+                switch (instruction.opCode)
+                {
+                case OpCode::Constant:
+                    // already in place
+                    break;
+                case OpCode::Add:
+                case OpCode::Subtract:
+                    // whole lanes of a known length are vectorized
+                    for (std::size_t lane = 0; lane < width; lane += CompiledExpression::laneCount)
+                    {
+                        AddLanes(leftReal + lane, leftImag + lane, rightReal + lane, rightImag + lane, destinationReal + lane, destinationImag + lane, //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                                 static_cast<T>(instruction.opCode == OpCode::Add ? 1.0 : -1.0), CompiledExpression::laneCount);
+                    }
+                    break;
+                case OpCode::Multiply:
+                    for (std::size_t lane = 0; lane < width; lane += CompiledExpression::laneCount)
+                    {
+                        MultiplyLanes(leftReal + lane, leftImag + lane, rightReal + lane, rightImag + lane, destinationReal + lane, destinationImag + lane, //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                                      CompiledExpression::laneCount);
+                    }
+                    break;
+                default:
+                    for (std::size_t index = 0; index < length; ++index)
+                    {
+                        if (undefined[index] != 0)
+                        {
+                            continue;
+                        }
+
+                        auto value = Round<T>(CompiledExpression::Apply(instruction,
+                                                                        complex(leftReal[index], leftImag[index]), //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                                                                        complex(rightReal[index], rightImag[index]), //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                                                                        complex(reals[index], imags[index])));
+
+                        if (!value.has_value())
+                        {
+                            undefined[index] = 1;
+                            continue;
+                        }
+
+                        destinationReal[index] = value->real(); //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                        destinationImag[index] = value->imag(); //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                    }
+                    break;
+                }
+            }
+
+            const auto * resultReal = real(this->result);
+            const auto * resultImag = imag(this->result);
+
+            for (std::size_t index = 0; index < length; ++index)
+            {
+                auto & output = outputs[start + index]; //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                std::complex<T> value(resultReal[index], resultImag[index]); //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+                if (undefined[index] != 0)
+                {
+                    output.reset();
+                }
+                else if (std::isnan(value.real()) && std::isnan(value.imag()))
+                {
+                    // like in native code, std::complex recovers infinities from such products, so they are interpreted
+                    const auto & input = inputs[start + index]; //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                    output = Round<T>(this->Evaluate(complex(input.real(), input.imag())));
+                }
+                else
+                {
+                    output = value;
+                }
+            }
+        }
+    }
+
+    std::size_t CompiledExpression::Compile(const std::shared_ptr<Expression> & node) //NOLINT(misc-no-recursion)
+    {
+        // subtrees shared within the expression are compiled once
+        auto it = this->compiledNodes.find(node.get());
+        if (it != this->compiledNodes.end())
+        {
+            return it->second;
+        }
+
+        std::size_t target = 0;
+
+        if (dynamic_cast<const BaseZ*>(node.get()) != nullptr)
+        {
+            target = 0;
+        }
+        else if (node->IsConstant() && node->Evaluate(0.0).has_value())
+        {
+            target = this->EmitConstant(node->Evaluate(0.0).value());
+        }
+        else if (const auto * function = dynamic_cast<const Function*>(node.get()))
+        {
+            auto argument = this->Compile(function->GetArgument());
+            target = this->Emit(OpCode::Function, argument, argument);
+            this->program.back().apply = GetFunctionTableEntry(function->GetId()).apply;
+        }
+        else if (const auto * sum = dynamic_cast<const Sum*>(node.get()))
+        {
+            // like Sum, start from zero, as adding to zero does not preserve a negative zero
+            target = this->EmitConstant(complex(0.0));
+
+            for (const auto & summand : sum->GetSummands())
+            {
+                auto operand = this->Compile(summand.expression);
+                target = this->Emit(summand.sign == Sum::Sign::Plus ? OpCode::Add : OpCode::Subtract, target, operand);
+            }
+        }
+        else if (const auto * product = dynamic_cast<const Product*>(node.get()))
+        {
+            target = this->EmitConstant(complex(1.0));
+
+            for (const auto & factor : product->GetFactors())
+            {
+                auto operand = this->Compile(factor.expression);
+                target = this->Emit(factor.exponent == Product::Exponent::Positive ? OpCode::Multiply : OpCode::Divide, target, operand);
+            }
+        }
+        else if (const auto * power = dynamic_cast<const Power*>(node.get()))
+        {
+            auto base = this->Compile(power->GetBase());
+            auto exponent = this->Compile(power->GetExponent());
+            target = this->Emit(OpCode::Power, base, exponent);
+        }
+        else
+        {
+            target = this->Emit(OpCode::Node, 0, 0);
+            this->program.back().node = node.get();
+        }
+
+        this->compiledNodes.emplace(node.get(), target);
+
+        return target;
+    }
+
+    std::size_t CompiledExpression::Emit(OpCode opCode, std::size_t left, std::size_t right)
+    {
+        auto destination = this->initialRegisters.size();
+        this->initialRegisters.emplace_back(0.0);
+        this->program.push_back(Instruction { opCode, destination, left, right, complex(0.0), nullptr, nullptr });
+
+        return destination;
+    }
+
+    std::size_t CompiledExpression::EmitConstant(complex value)
+    {
+        // constants are placed into the registers once, so they need no instruction at run time
+        auto destination = this->initialRegisters.size();
+        this->initialRegisters.push_back(value);
+        this->program.push_back(Instruction { OpCode::Constant, destination, 0, 0, value, nullptr, nullptr });
+
+        return destination;
+    }
+
+}
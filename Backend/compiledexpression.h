@@ -0,0 +1,180 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMPILEDEXPRESSION_H
+#define COMPILEDEXPRESSION_H
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "expression.h"
+
+namespace Backend {
+
+    class NativeKernel;
+
+    /*!
+     * \brief The Precision enum selects the floating point type a job is evaluated in.
+     */
+    enum class Precision
+    {
+        Double,
+        Single,
+    };
+
+    /*!
+     * \class CompiledExpression
+     * \brief The CompiledExpression class flattens an expression into a straight-line program
+     *        over numbered registers, optionally translated to native code.
+     *
+     * Register 0 holds the input. Sums, products and powers as well as functions become one
+     * instruction per operation, everything else is evaluated by its node. Each operation
+     * is carried out like the node would, so the results agree with \ref Expression::Evaluate.
+     * On x86-64, additions, subtractions and multiplications are emitted as SSE2 code,
+     * the other instructions call out of the native code. Elsewhere, the program is interpreted.
+     *
+     * Lines are interpreted with the registers held as arrays of real and imaginary parts,
+     * so that additions, subtractions and multiplications run over many points at once.
+     * In single precision, these arrays take half the memory and twice the points per vector.
+     * All other instructions are carried out in double precision and rounded to single precision.
+     */
+    class CompiledExpression final
+    {
+    public:
+        /*!
+         * \brief The OpCode enum names the operations of the program.
+         */
+        enum class OpCode
+        {
+            Constant,
+            Add,
+            Subtract,
+            Multiply,
+            Divide,
+            Power,
+            Function,
+            Node,
+        };
+
+        /*!
+         * \struct Instruction
+         * \brief The Instruction struct describes a single operation writing the destination register.
+         */
+        struct Instruction
+        {
+        public:
+            OpCode opCode;
+            std::size_t destination;
+            std::size_t left;
+            std::size_t right;
+            complex constant;
+            std::optional<complex> (*apply)(complex);
+            const Expression * node;
+        };
+
+    private:
+        constexpr static const double epsilon = 1e-9;
+        constexpr static const std::size_t chunkSize = 1024;
+        constexpr static const std::size_t laneCount = 16;
+
+        std::shared_ptr<Expression> expression;
+        std::vector<Instruction> program;
+        std::vector<complex> initialRegisters;
+        std::size_t result;
+        std::unordered_map<const Expression *, std::size_t> compiledNodes;
+        std::unique_ptr<NativeKernel> nativeKernel;
+
+    public:
+        /*!
+         * \brief Initializes a new instance.
+         * \param expression The expression to compile.
+         * \param useNativeCode Whether to translate the program to native code, if supported.
+         */
+        explicit CompiledExpression(std::shared_ptr<Expression> expression, bool useNativeCode = true);
+        ~CompiledExpression();
+        CompiledExpression(const CompiledExpression&) = delete;
+        CompiledExpression(CompiledExpression&&) = delete;
+        CompiledExpression& operator=(const CompiledExpression&) = delete;
+        CompiledExpression& operator=(CompiledExpression&&) = delete;
+
+        /*!
+         * \brief IsNativeCodeAvailable indicates whether native code can be generated on this platform.
+         * \return true on x86-64, false otherwise.
+         */
+        [[nodiscard]] static bool IsNativeCodeAvailable();
+
+        /*!
+         * \brief IsNative indicates whether the program runs as native code.
+         * \return true if native code is used, false if the program is interpreted.
+         */
+        [[nodiscard]] bool IsNative() const;
+
+        /*!
+         * \brief GetProgram gets the straight-line program.
+         * \return The instructions in order of execution.
+         */
+        [[nodiscard]] const std::vector<Instruction> & GetProgram() const;
+
+        /*!
+         * \brief Evaluate evaluates the program at a single point by interpretation.
+         * \param input The point to evaluate at.
+         * \return The result or nothing if undefined.
+         */
+        [[nodiscard]] std::optional<complex> Evaluate(complex input) const;
+
+        /*!
+         * \brief EvaluateLine evaluates the program at many points, using native code if available.
+         *        Safe to call from several threads at once.
+         * \param inputs The points to evaluate at.
+         * \param outputs The results, nothing where undefined.
+         * \param count The number of points.
+         */
+        void EvaluateLine(const complex * inputs, std::optional<complex> * outputs, std::size_t count) const;
+
+        /*!
+         * \brief EvaluateLine evaluates the program at many points in single precision, never using native code.
+         *        A result beyond the range of float is undefined. Safe to call from several threads at once.
+         * \param inputs The points to evaluate at.
+         * \param outputs The results, nothing where undefined.
+         * \param count The number of points.
+         */
+        void EvaluateLine(const complexf * inputs, std::optional<complexf> * outputs, std::size_t count) const;
+
+        /*!
+         * \brief Execute carries out a single instruction. It is called from native code as well.
+         * \param instruction The instruction.
+         * \param registers The registers.
+         * \param undefined Set to 1 if the result is undefined, left alone otherwise.
+         */
+        static void Execute(const Instruction * instruction, complex * registers, unsigned char * undefined);
+
+    private:
+        [[nodiscard]] static std::optional<complex> Apply(const Instruction & instruction, complex left, complex right, complex input);
+        template<typename T>
+        void EvaluateLanes(const std::complex<T> * inputs, std::optional<std::complex<T>> * outputs, std::size_t count) const;
+        [[nodiscard]] std::size_t Compile(const std::shared_ptr<Expression> & node);
+        [[nodiscard]] std::size_t Emit(OpCode opCode, std::size_t left, std::size_t right);
+        [[nodiscard]] std::size_t EmitConstant(complex value);
+    };
+
+}
+
+#endif // COMPILEDEXPRESSION_H
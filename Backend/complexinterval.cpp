@@ -0,0 +1,494 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "complexinterval.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace Backend {
+
+    namespace {
+
+        const double infinity = std::numeric_limits<double>::infinity();
+        const double twoPi = 2.0 * M_PI;
+
+        // matches the epsilon used for division in Product
+        const double divisionEpsilon = 1e-9;
+
+        // the largest integer exponent evaluated by repeated multiplication
+        const int maximumIntegerExponent = 64;
+
+        // the standard library functions are accurate to a few units in the last place
+        const double roundingAllowance = 8.0 * std::numeric_limits<double>::epsilon();
+
+        double Lower(double value)
+        {
+            return std::isnan(value) ? -infinity : value - std::fabs(value) * roundingAllowance - std::numeric_limits<double>::denorm_min();
+        }
+
+        double Upper(double value)
+        {
+            return std::isnan(value) ? infinity : value + std::fabs(value) * roundingAllowance + std::numeric_limits<double>::denorm_min();
+        }
+
+        struct Range
+        {
+        public:
+            double lower;
+            double upper;
+        };
+
+        Range Multiply(Range a, Range b)
+        {
+            const double products[] = { a.lower * b.lower, a.lower * b.upper, a.upper * b.lower, a.upper * b.upper };
+
+            if (std::any_of(std::begin(products), std::end(products), [](double product){ return std::isnan(product); }))
+            {
+                return Range{-infinity, infinity};
+            }
+
+            return Range{*std::min_element(std::begin(products), std::end(products)), *std::max_element(std::begin(products), std::end(products))};
+        }
+
+        Range CosRange(Range x)
+        {
+            if (!std::isfinite(x.lower) || !std::isfinite(x.upper) || x.upper - x.lower >= twoPi)
+            {
+                return Range{-1.0, 1.0};
+            }
+
+            auto first = std::cos(x.lower);
+            auto second = std::cos(x.upper);
+            Range result{std::min(first, second), std::max(first, second)};
+
+            // the extrema are taken at multiples of pi
+            if (std::ceil(x.lower / twoPi) * twoPi <= x.upper)
+            {
+                result.upper = 1.0;
+            }
+
+            if (std::ceil((x.lower - M_PI) / twoPi) * twoPi + M_PI <= x.upper)
+            {
+                result.lower = -1.0;
+            }
+
+            return result;
+        }
+
+        Range SinRange(Range x)
+        {
+            return CosRange(Range{x.lower - M_PI_2, x.upper - M_PI_2});
+        }
+
+        Range CoshRange(Range x)
+        {
+            auto lowerMagnitude = std::min(std::fabs(x.lower), std::fabs(x.upper));
+            auto upperMagnitude = std::max(std::fabs(x.lower), std::fabs(x.upper));
+
+            if (x.lower <= 0.0 && 0.0 <= x.upper)
+            {
+                lowerMagnitude = 0.0;
+            }
+
+            return Range{std::cosh(lowerMagnitude), std::cosh(upperMagnitude)};
+        }
+
+        Range SinhRange(Range x)
+        {
+            return Range{std::sinh(x.lower), std::sinh(x.upper)};
+        }
+
+        ComplexInterval FromPolar(Range modulus, Range angle, bool singular)
+        {
+            auto real = Multiply(modulus, CosRange(angle));
+            auto imag = Multiply(modulus, SinRange(angle));
+
+            return ComplexInterval(real.lower, real.upper, imag.lower, imag.upper, singular);
+        }
+    }
+
+    ComplexInterval::ComplexInterval(complex value)
+        : minReal(value.real()),
+          maxReal(value.real()),
+          minImag(value.imag()),
+          maxImag(value.imag()),
+          mayBeSingular(!std::isfinite(value.real()) || !std::isfinite(value.imag()))
+    {
+    }
+
+    ComplexInterval::ComplexInterval(double minReal, double maxReal, double minImag, double maxImag, bool mayBeSingular)
+        : minReal(Lower(minReal)),
+          maxReal(Upper(maxReal)),
+          minImag(Lower(minImag)),
+          maxImag(Upper(maxImag)),
+          mayBeSingular(mayBeSingular)
+    {
+        // evaluation treats non-finite results as undefined
+        this->mayBeSingular = this->mayBeSingular || !this->IsBounded();
+    }
+
+    ComplexInterval ComplexInterval::Unbounded()
+    {
+        return ComplexInterval(-infinity, infinity, -infinity, infinity, true);
+    }
+
+    double ComplexInterval::GetMinReal() const
+    {
+        return this->minReal;
+    }
+
+    double ComplexInterval::GetMaxReal() const
+    {
+        return this->maxReal;
+    }
+
+    double ComplexInterval::GetMinImag() const
+    {
+        return this->minImag;
+    }
+
+    double ComplexInterval::GetMaxImag() const
+    {
+        return this->maxImag;
+    }
+
+    bool ComplexInterval::MayBeSingular() const
+    {
+        return this->mayBeSingular;
+    }
+
+    bool ComplexInterval::IsBounded() const
+    {
+        return std::isfinite(this->minReal) && std::isfinite(this->maxReal) && std::isfinite(this->minImag) && std::isfinite(this->maxImag);
+    }
+
+    bool ComplexInterval::Contains(complex value) const
+    {
+        return this->minReal <= value.real() && value.real() <= this->maxReal && this->minImag <= value.imag() && value.imag() <= this->maxImag;
+    }
+
+    bool ComplexInterval::Intersects(double minX, double maxX, double minY, double maxY) const
+    {
+        return this->minReal <= maxX && minX <= this->maxReal && this->minImag <= maxY && minY <= this->maxImag;
+    }
+
+    double ComplexInterval::GetExtent() const
+    {
+        return std::max(this->maxReal - this->minReal, this->maxImag - this->minImag);
+    }
+
+    ComplexInterval ComplexInterval::operator-() const
+    {
+        return ComplexInterval(-this->maxReal, -this->minReal, -this->maxImag, -this->minImag, this->mayBeSingular);
+    }
+
+    ComplexInterval ComplexInterval::operator+(const ComplexInterval &other) const
+    {
+        return ComplexInterval(this->minReal + other.minReal,
+                               this->maxReal + other.maxReal,
+                               this->minImag + other.minImag,
+                               this->maxImag + other.maxImag,
+                               this->mayBeSingular || other.mayBeSingular);
+    }
+
+    ComplexInterval ComplexInterval::operator-(const ComplexInterval &other) const
+    {
+        return *this + (-other);
+    }
+
+    ComplexInterval ComplexInterval::operator*(const ComplexInterval &other) const
+    {
+        Range thisReal{this->minReal, this->maxReal};
+        Range thisImag{this->minImag, this->maxImag};
+        Range otherReal{other.minReal, other.maxReal};
+        Range otherImag{other.minImag, other.maxImag};
+
+        auto realReal = Multiply(thisReal, otherReal);
+        auto imagImag = Multiply(thisImag, otherImag);
+        auto realImag = Multiply(thisReal, otherImag);
+        auto imagReal = Multiply(thisImag, otherReal);
+
+        return ComplexInterval(realReal.lower - imagImag.upper,
+                               realReal.upper - imagImag.lower,
+                               realImag.lower + imagReal.lower,
+                               realImag.upper + imagReal.upper,
+                               this->mayBeSingular || other.mayBeSingular);
+    }
+
+    ComplexInterval ComplexInterval::operator/(const ComplexInterval &other) const
+    {
+        if (other.ContainsZero(divisionEpsilon))
+        {
+            return ComplexInterval::Unbounded();
+        }
+
+        // 1/w = conj(w) / |w|^2
+        auto minimumMagnitude = other.GetMinimumMagnitude();
+        auto maximumMagnitude = other.GetMaximumMagnitude();
+        Range inverseNorm{1.0 / (maximumMagnitude * maximumMagnitude), 1.0 / (minimumMagnitude * minimumMagnitude)};
+
+        auto real = Multiply(Range{other.minReal, other.maxReal}, inverseNorm);
+        auto imag = Multiply(Range{-other.maxImag, -other.minImag}, inverseNorm);
+
+        return *this * ComplexInterval(real.lower, real.upper, imag.lower, imag.upper, other.mayBeSingular);
+    }
+
+    ComplexInterval ComplexInterval::Abs(const ComplexInterval &z)
+    {
+        return ComplexInterval(z.GetMinimumMagnitude(), z.GetMaximumMagnitude(), 0.0, 0.0, z.mayBeSingular);
+    }
+
+    ComplexInterval ComplexInterval::Real(const ComplexInterval &z)
+    {
+        return ComplexInterval(z.minReal, z.maxReal, 0.0, 0.0, z.mayBeSingular);
+    }
+
+    ComplexInterval ComplexInterval::Imag(const ComplexInterval &z)
+    {
+        return ComplexInterval(z.minImag, z.maxImag, 0.0, 0.0, z.mayBeSingular);
+    }
+
+    ComplexInterval ComplexInterval::Norm(const ComplexInterval &z)
+    {
+        auto minimumMagnitude = z.GetMinimumMagnitude();
+        auto maximumMagnitude = z.GetMaximumMagnitude();
+
+        return ComplexInterval(minimumMagnitude * minimumMagnitude, maximumMagnitude * maximumMagnitude, 0.0, 0.0, z.mayBeSingular);
+    }
+
+    ComplexInterval ComplexInterval::Conj(const ComplexInterval &z)
+    {
+        return ComplexInterval(z.minReal, z.maxReal, -z.maxImag, -z.minImag, z.mayBeSingular);
+    }
+
+    ComplexInterval ComplexInterval::Sin(const ComplexInterval &z)
+    {
+        // sin(x + iy) = sin(x) cosh(y) + i cos(x) sinh(y)
+        Range x{z.minReal, z.maxReal};
+        Range y{z.minImag, z.maxImag};
+
+        auto real = Multiply(SinRange(x), CoshRange(y));
+        auto imag = Multiply(CosRange(x), SinhRange(y));
+
+        return ComplexInterval(real.lower, real.upper, imag.lower, imag.upper, z.mayBeSingular);
+    }
+
+    ComplexInterval ComplexInterval::Cos(const ComplexInterval &z)
+    {
+        // cos(x + iy) = cos(x) cosh(y) - i sin(x) sinh(y)
+        Range x{z.minReal, z.maxReal};
+        Range y{z.minImag, z.maxImag};
+
+        auto real = Multiply(CosRange(x), CoshRange(y));
+        auto imag = Multiply(SinRange(x), SinhRange(y));
+
+        return ComplexInterval(real.lower, real.upper, -imag.upper, -imag.lower, z.mayBeSingular);
+    }
+
+    ComplexInterval ComplexInterval::Tan(const ComplexInterval &z)
+    {
+        return ComplexInterval::Sin(z) / ComplexInterval::Cos(z);
+    }
+
+    ComplexInterval ComplexInterval::Sqrt(const ComplexInterval &z)
+    {
+        if (z.ContainsZero(0.0))
+        {
+            return FromPolar(Range{0.0, std::sqrt(z.GetMaximumMagnitude())}, Range{-M_PI_2, M_PI_2}, z.mayBeSingular);
+        }
+
+        auto logarithm = ComplexInterval::Log(z);
+
+        return FromPolar(Range{std::sqrt(z.GetMinimumMagnitude()), std::sqrt(z.GetMaximumMagnitude())},
+                         Range{logarithm.minImag / 2.0, logarithm.maxImag / 2.0},
+                         z.mayBeSingular);
+    }
+
+    ComplexInterval ComplexInterval::Exp(const ComplexInterval &z)
+    {
+        return FromPolar(Range{std::exp(z.minReal), std::exp(z.maxReal)}, Range{z.minImag, z.maxImag}, z.mayBeSingular);
+    }
+
+    ComplexInterval ComplexInterval::Log(const ComplexInterval &z)
+    {
+        if (z.ContainsZero(0.0))
+        {
+            return ComplexInterval::Unbounded();
+        }
+
+        double minAngle = M_PI;
+        double maxAngle = -M_PI;
+
+        // the argument jumps across the negative real axis
+        if (z.minReal < 0.0 && z.minImag <= 0.0 && 0.0 <= z.maxImag)
+        {
+            minAngle = -M_PI;
+            maxAngle = M_PI;
+        }
+        else
+        {
+            // without the origin inside, the extrema of the argument are taken at the corners
+            for (auto real : { z.minReal, z.maxReal })
+            {
+                for (auto imag : { z.minImag, z.maxImag })
+                {
+                    auto angle = std::atan2(imag, real);
+                    minAngle = std::min(minAngle, angle);
+                    maxAngle = std::max(maxAngle, angle);
+                }
+            }
+        }
+
+        return ComplexInterval(std::log(z.GetMinimumMagnitude()), std::log(z.GetMaximumMagnitude()), minAngle, maxAngle, z.mayBeSingular);
+    }
+
+    ComplexInterval ComplexInterval::Log10(const ComplexInterval &z)
+    {
+        return ComplexInterval::Log(z) * ComplexInterval(complex(1.0 / M_LN10));
+    }
+
+    ComplexInterval ComplexInterval::Arg(const ComplexInterval &z)
+    {
+        // unlike the logarithm, the argument is defined at zero
+        if (z.ContainsZero(0.0))
+        {
+            return ComplexInterval(-M_PI, M_PI, 0.0, 0.0, z.mayBeSingular);
+        }
+
+        return ComplexInterval::Imag(ComplexInterval::Log(z));
+    }
+
+    ComplexInterval ComplexInterval::Sinh(const ComplexInterval &z)
+    {
+        // sinh(z) = -i sin(iz)
+        return -ComplexInterval::Sin(z.TimesI()).TimesI();
+    }
+
+    ComplexInterval ComplexInterval::Cosh(const ComplexInterval &z)
+    {
+        // cosh(z) = cos(iz)
+        return ComplexInterval::Cos(z.TimesI());
+    }
+
+    ComplexInterval ComplexInterval::Tanh(const ComplexInterval &z)
+    {
+        // tanh(z) = -i tan(iz)
+        return -ComplexInterval::Tan(z.TimesI()).TimesI();
+    }
+
+    ComplexInterval ComplexInterval::Asin(const ComplexInterval &z)
+    {
+        // asin(z) = -i log(iz + sqrt(1 - z^2))
+        ComplexInterval one(complex(1.0));
+        return -ComplexInterval::Log(z.TimesI() + ComplexInterval::Sqrt(one - z * z)).TimesI();
+    }
+
+    ComplexInterval ComplexInterval::Acos(const ComplexInterval &z)
+    {
+        return ComplexInterval(complex(M_PI_2)) - ComplexInterval::Asin(z);
+    }
+
+    ComplexInterval ComplexInterval::Atan(const ComplexInterval &z)
+    {
+        // atan(z) = i/2 (log(1 - iz) - log(1 + iz))
+        ComplexInterval one(complex(1.0));
+        auto difference = ComplexInterval::Log(one - z.TimesI()) - ComplexInterval::Log(one + z.TimesI());
+        return difference.TimesI() * ComplexInterval(complex(0.5));
+    }
+
+    ComplexInterval ComplexInterval::Expi(const ComplexInterval &z)
+    {
+        return ComplexInterval::Exp(z.TimesI());
+    }
+
+    ComplexInterval ComplexInterval::Pow(const ComplexInterval &base, const ComplexInterval &exponent)
+    {
+        auto n = exponent.minReal;
+
+        bool isSmallInteger = n == exponent.maxReal
+                && exponent.minImag == 0.0
+                && exponent.maxImag == 0.0
+                && std::fabs(n) <= maximumIntegerExponent
+                && std::trunc(n) == n;
+
+        // like Power::Apply, which uses the complex pow, undefined at zero, unless the exponent is a small integer
+        if (!isSmallInteger)
+        {
+            auto result = ComplexInterval::Exp(exponent * ComplexInterval::Log(base));
+            return result.WithSingularity(result.mayBeSingular || base.mayBeSingular || exponent.mayBeSingular || base.ContainsZero(0.0));
+        }
+
+        // repeated squaring like in Power::Apply keeps the overestimation low compared to exp(n log(z))
+        auto remaining = static_cast<unsigned int>(std::fabs(n));
+        ComplexInterval result(complex(1.0));
+        ComplexInterval factor = base;
+
+        while (remaining != 0U)
+        {
+            if ((remaining & 1U) != 0U)
+            {
+                result = result * factor;
+            }
+
+            factor = factor * factor;
+            remaining >>= 1U;
+        }
+
+        if (n < 0.0)
+        {
+            result = ComplexInterval(complex(1.0)) / result;
+        }
+
+        // an overflow makes the power undefined
+        return result.WithSingularity(result.mayBeSingular || base.mayBeSingular || !result.IsBounded());
+    }
+
+    double ComplexInterval::GetMinimumMagnitude() const
+    {
+        auto x = (this->minReal <= 0.0 && 0.0 <= this->maxReal) ? 0.0 : std::min(std::fabs(this->minReal), std::fabs(this->maxReal));
+        auto y = (this->minImag <= 0.0 && 0.0 <= this->maxImag) ? 0.0 : std::min(std::fabs(this->minImag), std::fabs(this->maxImag));
+
+        return std::hypot(x, y);
+    }
+
+    double ComplexInterval::GetMaximumMagnitude() const
+    {
+        auto x = std::max(std::fabs(this->minReal), std::fabs(this->maxReal));
+        auto y = std::max(std::fabs(this->minImag), std::fabs(this->maxImag));
+
+        return std::hypot(x, y);
+    }
+
+    bool ComplexInterval::ContainsZero(double epsilon) const
+    {
+        return this->minReal <= epsilon && -epsilon <= this->maxReal && this->minImag <= epsilon && -epsilon <= this->maxImag;
+    }
+
+    ComplexInterval ComplexInterval::WithSingularity(bool singular) const
+    {
+        return ComplexInterval(this->minReal, this->maxReal, this->minImag, this->maxImag, singular);
+    }
+
+    ComplexInterval ComplexInterval::TimesI() const
+    {
+        return ComplexInterval(-this->maxImag, -this->minImag, this->minReal, this->maxReal, this->mayBeSingular);
+    }
+
+}
@@ -0,0 +1,181 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMPLEXINTERVAL_H
+#define COMPLEXINTERVAL_H
+
+#include "expression.h"
+
+namespace Backend {
+
+    /*!
+     * \class ComplexInterval
+     * \brief The ComplexInterval class represents a rectangle in the complex plane
+     *        that is guaranteed to contain all values of a computation.
+     *
+     * Apart from the bounds, it carries a flag indicating that the computation
+     * may be undefined somewhere in the rectangle it was computed for.
+     * Instead of directed rounding, the bounds are widened slightly on construction
+     * to account for the rounding of the underlying operations.
+     */
+    class ComplexInterval final
+    {
+    private:
+        double minReal;
+        double maxReal;
+        double minImag;
+        double maxImag;
+        bool mayBeSingular;
+
+    public:
+        /*!
+         * \brief Initializes a new instance containing exactly the supplied value.
+         * \param value The value to contain.
+         */
+        explicit ComplexInterval(complex value);
+
+        /*!
+         * \brief Initializes a new instance spanning the supplied rectangle, widened for rounding.
+         * \param minReal The minimum value in real/x-direction.
+         * \param maxReal The maximum value in real/x-direction.
+         * \param minImag The minimum value in imaginary/y-direction.
+         * \param maxImag The maximum value in imaginary/y-direction.
+         * \param mayBeSingular A value indicating whether the computation may be undefined.
+         */
+        ComplexInterval(double minReal, double maxReal, double minImag, double maxImag, bool mayBeSingular = false);
+
+        /*!
+         * \brief Unbounded creates an instance containing the whole complex plane
+         *        for a computation that may be undefined.
+         * \return The unbounded instance.
+         */
+        [[nodiscard]] static ComplexInterval Unbounded();
+
+        /*!
+         * \brief Gets the minimum value in real/x-direction.
+         * \return The minimum value.
+         */
+        [[nodiscard]] double GetMinReal() const;
+
+        /*!
+         * \brief Gets the maximum value in real/x-direction.
+         * \return The maximum value.
+         */
+        [[nodiscard]] double GetMaxReal() const;
+
+        /*!
+         * \brief Gets the minimum value in imaginary/y-direction.
+         * \return The minimum value.
+         */
+        [[nodiscard]] double GetMinImag() const;
+
+        /*!
+         * \brief Gets the maximum value in imaginary/y-direction.
+         * \return The maximum value.
+         */
+        [[nodiscard]] double GetMaxImag() const;
+
+        /*!
+         * \brief Gets a value indicating whether the computation may be undefined
+         *        somewhere in the input.
+         * \return A value indicating possible singularity.
+         */
+        [[nodiscard]] bool MayBeSingular() const;
+
+        /*!
+         * \brief Gets a value indicating whether all bounds are finite.
+         * \return A value indicating boundedness.
+         */
+        [[nodiscard]] bool IsBounded() const;
+
+        /*!
+         * \brief Gets a value indicating whether the supplied value lies within the bounds.
+         * \param value The value to check.
+         * \return A value indicating containment.
+         */
+        [[nodiscard]] bool Contains(complex value) const;
+
+        /*!
+         * \brief Gets a value indicating whether the bounds overlap the supplied rectangle.
+         * \param minX The minimum value in real/x-direction.
+         * \param maxX The maximum value in real/x-direction.
+         * \param minY The minimum value in imaginary/y-direction.
+         * \param maxY The maximum value in imaginary/y-direction.
+         * \return A value indicating overlap.
+         */
+        [[nodiscard]] bool Intersects(double minX, double maxX, double minY, double maxY) const;
+
+        /*!
+         * \brief Gets the larger one of the extents in real and imaginary direction.
+         * \return The extent.
+         */
+        [[nodiscard]] double GetExtent() const;
+
+        /*!
+         * \brief Arithmetic operators, giving bounds of the result for all combinations of values.
+         */
+        ComplexInterval operator-() const;
+        ComplexInterval operator+(const ComplexInterval &other) const;
+        ComplexInterval operator-(const ComplexInterval &other) const;
+        ComplexInterval operator*(const ComplexInterval &other) const;
+
+        /*!
+         * \brief Division operator, flagging a possible singularity if the divisor
+         *        comes close to zero in the same sense as \ref Product::Evaluate does.
+         * \param other The divisor.
+         * \return The bounds of the quotient.
+         */
+        ComplexInterval operator/(const ComplexInterval &other) const;
+
+        /*!
+         * \brief Function counterparts of the functions available to the parser,
+         *        giving bounds of the result for all values of \a z.
+         */
+        [[nodiscard]] static ComplexInterval Abs(const ComplexInterval &z);
+        [[nodiscard]] static ComplexInterval Real(const ComplexInterval &z);
+        [[nodiscard]] static ComplexInterval Imag(const ComplexInterval &z);
+        [[nodiscard]] static ComplexInterval Norm(const ComplexInterval &z);
+        [[nodiscard]] static ComplexInterval Conj(const ComplexInterval &z);
+        [[nodiscard]] static ComplexInterval Sin(const ComplexInterval &z);
+        [[nodiscard]] static ComplexInterval Cos(const ComplexInterval &z);
+        [[nodiscard]] static ComplexInterval Tan(const ComplexInterval &z);
+        [[nodiscard]] static ComplexInterval Sqrt(const ComplexInterval &z);
+        [[nodiscard]] static ComplexInterval Exp(const ComplexInterval &z);
+        [[nodiscard]] static ComplexInterval Log(const ComplexInterval &z);
+        [[nodiscard]] static ComplexInterval Log10(const ComplexInterval &z);
+        [[nodiscard]] static ComplexInterval Arg(const ComplexInterval &z);
+        [[nodiscard]] static ComplexInterval Sinh(const ComplexInterval &z);
+        [[nodiscard]] static ComplexInterval Cosh(const ComplexInterval &z);
+        [[nodiscard]] static ComplexInterval Tanh(const ComplexInterval &z);
+        [[nodiscard]] static ComplexInterval Asin(const ComplexInterval &z);
+        [[nodiscard]] static ComplexInterval Acos(const ComplexInterval &z);
+        [[nodiscard]] static ComplexInterval Atan(const ComplexInterval &z);
+        [[nodiscard]] static ComplexInterval Expi(const ComplexInterval &z);
+        [[nodiscard]] static ComplexInterval Pow(const ComplexInterval &base, const ComplexInterval &exponent);
+
+    private:
+        [[nodiscard]] double GetMinimumMagnitude() const;
+        [[nodiscard]] double GetMaximumMagnitude() const;
+        [[nodiscard]] bool ContainsZero(double epsilon) const;
+        [[nodiscard]] ComplexInterval WithSingularity(bool singular) const;
+        [[nodiscard]] ComplexInterval TimesI() const;
+    };
+
+}
+
+#endif // COMPLEXINTERVAL_H
@@ -17,6 +17,10 @@
  */
 
 #include "constant.h"
+#include "complexinterval.h"
+
+#include <functional>
+#include <string_view>
 
 namespace Backend {
 
@@ -39,13 +43,26 @@ namespace Backend {
         return this->value;
     }
 
+    ComplexInterval Constant::EvaluateInterval(const ComplexInterval &) const //NOLINT(misc-unused-parameter, hicpp-named-parameter, readability-named-parameter)
+    {
+        return ComplexInterval(this->value);
+    }
+
+    std::size_t Constant::GetHash() const
+    {
+        // adding zero maps -0.0 to 0.0, which compare equal
+        auto hash = std::hash<std::string_view>{}(u8"Constant");
+        hash = HashCombine(hash, std::hash<double>{}(this->value.real() + 0.0));
+        return HashCombine(hash, std::hash<double>{}(this->value.imag() + 0.0));
+    }
+
     bool Constant::operator==(const Expression &other) const
     {
         if (const auto * b = dynamic_cast<const Constant*>(&other))
         {
             return b != nullptr
                     && this->value.real() == b->value.real()
-                    && this->value.imag() == this->value.imag();
+                    && this->value.imag() == b->value.imag();
         }
         else
         {
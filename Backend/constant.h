@@ -59,6 +59,16 @@ namespace Backend {
          */
         [[nodiscard]] std::optional<complex> Evaluate(complex) const override;
 
+        /*!
+         * \reimp
+         */
+        [[nodiscard]] ComplexInterval EvaluateInterval(const ComplexInterval & input) const override;
+
+        /*!
+         * \reimp
+         */
+        [[nodiscard]] std::size_t GetHash() const override;
+
         /*!
          * \reimp
          */
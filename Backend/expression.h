@@ -20,12 +20,28 @@
 #define EXPRESSION_H
 
 #include <complex>
+#include <cstddef>
 #include <optional>
 #include <string>
 
 namespace Backend
 {
     using complex = std::complex<double>;
+    using complexf = std::complex<float>;
+
+    class ComplexInterval;
+
+    /*!
+     * \brief HashCombine mixes a value into a running hash.
+     * \param seed The running hash.
+     * \param value The value to mix in.
+     * \return The new running hash.
+     */
+    inline std::size_t HashCombine(std::size_t seed, std::size_t value)
+    {
+        const std::size_t golden = 0x9e3779b9;
+        return seed ^ (value + golden + (seed << 6U) + (seed >> 2U));
+    }
 
     /*!
      * \class Expression
@@ -62,6 +78,20 @@ namespace Backend
          */
         [[nodiscard]] virtual std::optional<complex> Evaluate(complex input) const = 0;
 
+        /*!
+         * \brief Evaluates bounds of the expression for all values within the \a input rectangle.
+         * \param input The rectangle of values to plug in to the expression.
+         * \return The bounds, flagged if the expression may be undefined within the rectangle.
+         */
+        [[nodiscard]] virtual ComplexInterval EvaluateInterval(const ComplexInterval & input) const = 0;
+
+        /*!
+         * \brief Gets a hash of the structure of the expression.
+         *        Equal expressions, as determined by the equality operator, have equal hashes.
+         * \return The structural hash.
+         */
+        [[nodiscard]] virtual std::size_t GetHash() const = 0;
+
         /*!
          * \brief Equality operator for the expression, checking type and content.
          * \param other The instance to compare to.
@@ -0,0 +1,334 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+
+#include "basez.h"
+#include "complexinterval.h"
+#include "constant.h"
+#include "expressionprofiler.h"
+#include "functions.h"
+#include "parameter.h"
+#include "power.h"
+#include "product.h"
+#include "sum.h"
+
+namespace Backend {
+
+    /*!
+     * \class ProfiledNode
+     * \brief The ProfiledNode class stands in for a node, counting its evaluations.
+     *
+     * Everything but the evaluation is forwarded to the original node.
+     */
+    class ProfiledNode final : public Expression
+    {
+    private:
+        std::shared_ptr<Expression> original;
+        const std::size_t samplingInterval;
+        mutable std::size_t evaluationCount;
+        mutable std::size_t undefinedCount;
+        mutable std::size_t sampledCount;
+        mutable std::chrono::steady_clock::duration sampledTime;
+
+    public:
+        ProfiledNode(std::shared_ptr<Expression> original, std::size_t samplingInterval)
+            : original(std::move(original)),
+              samplingInterval(std::max(samplingInterval, static_cast<std::size_t>(1))),
+              evaluationCount(0),
+              undefinedCount(0),
+              sampledCount(0),
+              sampledTime(0)
+        {
+        }
+
+        ~ProfiledNode() override = default;
+        ProfiledNode(const ProfiledNode&) = delete;
+        ProfiledNode(ProfiledNode&&) = delete;
+        ProfiledNode& operator=(const ProfiledNode&) = delete;
+        ProfiledNode& operator=(ProfiledNode&&) = delete;
+
+        [[nodiscard]] int GetLevel() const override
+        {
+            return this->original->GetLevel();
+        }
+
+        [[nodiscard]] bool IsConstant() const override
+        {
+            return this->original->IsConstant();
+        }
+
+        [[nodiscard]] std::optional<complex> Evaluate(complex input) const override
+        {
+            std::optional<complex> retval;
+
+            // reading the clock costs more than many nodes, so only every n-th evaluation is timed
+            if (this->evaluationCount % this->samplingInterval == 0)
+            {
+                auto start = std::chrono::steady_clock::now();
+                retval = this->original->Evaluate(input);
+                this->sampledTime += std::chrono::steady_clock::now() - start;
+                ++this->sampledCount;
+            }
+            else
+            {
+                retval = this->original->Evaluate(input);
+            }
+
+            ++this->evaluationCount;
+
+            if (!retval.has_value())
+            {
+                ++this->undefinedCount;
+            }
+
+            return retval;
+        }
+
+        [[nodiscard]] ComplexInterval EvaluateInterval(const ComplexInterval & input) const override
+        {
+            return this->original->EvaluateInterval(input);
+        }
+
+        [[nodiscard]] std::size_t GetHash() const override
+        {
+            return this->original->GetHash();
+        }
+
+        [[nodiscard]] bool operator==(const Expression &other) const override
+        {
+            return *(this->original) == other;
+        }
+
+        [[nodiscard]] bool operator!=(const Expression &other) const override
+        {
+            return !(*this == other);
+        }
+
+        [[nodiscard]] std::size_t GetEvaluationCount() const
+        {
+            return this->evaluationCount;
+        }
+
+        [[nodiscard]] std::size_t GetUndefinedCount() const
+        {
+            return this->undefinedCount;
+        }
+
+        [[nodiscard]] double GetTime() const
+        {
+            if (this->sampledCount == 0)
+            {
+                return 0.0;
+            }
+
+            auto sampledSeconds = std::chrono::duration<double>(this->sampledTime).count();
+            return sampledSeconds * static_cast<double>(this->evaluationCount) / static_cast<double>(this->sampledCount);
+        }
+
+        void Reset()
+        {
+            this->evaluationCount = 0;
+            this->undefinedCount = 0;
+            this->sampledCount = 0;
+            this->sampledTime = std::chrono::steady_clock::duration(0);
+        }
+    };
+
+    ExpressionProfiler::ExpressionProfiler(const std::shared_ptr<Expression> & expression, std::size_t samplingInterval)
+        : samplingInterval(samplingInterval)
+    {
+        this->expression = this->Instrument(expression, std::string(), 0);
+    }
+
+    const std::shared_ptr<Expression> & ExpressionProfiler::GetExpression() const
+    {
+        return this->expression;
+    }
+
+    void ExpressionProfiler::Reset()
+    {
+        for (const auto & record : this->records)
+        {
+            record.node->Reset();
+        }
+    }
+
+    std::vector<ExpressionProfiler::Entry> ExpressionProfiler::GetReport() const
+    {
+        std::vector<Entry> entries;
+        entries.reserve(this->records.size());
+
+        for (const auto & record : this->records)
+        {
+            auto time = record.node->GetTime();
+            entries.push_back(Entry{record.label, record.depth, record.node->GetEvaluationCount(), record.node->GetUndefinedCount(), time, time});
+        }
+
+        // the children of an entry are the following entries one level deeper, up to the next entry on its level
+        for (std::size_t parent = 0; parent < entries.size(); ++parent)
+        {
+            for (std::size_t child = parent + 1; child < entries.size() && entries[child].depth > entries[parent].depth; ++child)
+            {
+                if (entries[child].depth == entries[parent].depth + 1)
+                {
+                    entries[parent].selfTime -= entries[child].time;
+                }
+            }
+
+            entries[parent].selfTime = std::max(entries[parent].selfTime, 0.0);
+        }
+
+        return entries;
+    }
+
+    std::string ExpressionProfiler::FormatReport() const
+    {
+        const double millisecondsPerSecond = 1000.0;
+
+        auto entries = this->GetReport();
+
+        std::ostringstream stream;
+        stream << std::fixed << std::setprecision(3);
+
+        for (const auto & entry : entries)
+        {
+            stream << std::string(2 * entry.depth, ' ') << entry.label
+                   << u8"  evaluations: " << entry.evaluationCount
+                   << u8", undefined: " << entry.undefinedCount
+                   << u8", time: " << entry.time * millisecondsPerSecond << u8" ms"
+                   << u8", self: " << entry.selfTime * millisecondsPerSecond << u8" ms"
+                   << u8"\n";
+        }
+
+        auto hottest = std::max_element(entries.begin(), entries.end(), [](const Entry & left, const Entry & right){ return left.selfTime < right.selfTime; });
+
+        if (hottest != entries.end() && hottest->selfTime > 0.0)
+        {
+            stream << u8"hot node: " << hottest->label
+                   << u8", self: " << hottest->selfTime * millisecondsPerSecond << u8" ms"
+                   << u8"\n";
+        }
+
+        return stream.str();
+    }
+
+    std::shared_ptr<Expression> ExpressionProfiler::Instrument(const std::shared_ptr<Expression> & expression, const std::string & role, std::size_t depth) //NOLINT(misc-no-recursion)
+    {
+        // the record is taken before the children, such that the records are in pre-order
+        auto recordIndex = this->records.size();
+        this->records.push_back(Record{nullptr, role + ExpressionProfiler::Describe(*expression), depth});
+
+        std::shared_ptr<Expression> original = expression;
+
+        if (const auto * function = dynamic_cast<const Function*>(expression.get()))
+        {
+            auto argument = this->Instrument(function->GetArgument(), std::string(), depth + 1);
+            original = GetFunctionTableEntry(function->GetId()).create(argument);
+        }
+        else if (const auto * sum = dynamic_cast<const Sum*>(expression.get()))
+        {
+            std::vector<Sum::Summand> summands;
+
+            for (const auto & summand : sum->GetSummands())
+            {
+                auto summandRole = summand.sign == Sum::Sign::Plus ? std::string(u8"+ ") : std::string(u8"- ");
+                summands.emplace_back(summand.sign, this->Instrument(summand.expression, summandRole, depth + 1));
+            }
+
+            original = std::make_shared<Sum>(summands);
+        }
+        else if (const auto * product = dynamic_cast<const Product*>(expression.get()))
+        {
+            std::vector<Product::Factor> factors;
+
+            for (const auto & factor : product->GetFactors())
+            {
+                auto factorRole = factor.exponent == Product::Exponent::Positive ? std::string(u8"* ") : std::string(u8"/ ");
+                factors.emplace_back(factor.exponent, this->Instrument(factor.expression, factorRole, depth + 1));
+            }
+
+            original = std::make_shared<Product>(factors);
+        }
+        else if (const auto * power = dynamic_cast<const Power*>(expression.get()))
+        {
+            auto base = this->Instrument(power->GetBase(), std::string(), depth + 1);
+            auto exponent = this->Instrument(power->GetExponent(), std::string(u8"^ "), depth + 1);
+            original = std::make_shared<Power>(base, exponent);
+        }
+
+        auto node = std::make_shared<ProfiledNode>(original, this->samplingInterval);
+        this->records[recordIndex].node = node;
+
+        return node;
+    }
+
+    std::string ExpressionProfiler::Describe(const Expression & expression)
+    {
+        if (dynamic_cast<const BaseZ*>(&expression) != nullptr)
+        {
+            return std::string(u8"z");
+        }
+
+        if (const auto * parameter = dynamic_cast<const Parameter*>(&expression))
+        {
+            return parameter->GetName();
+        }
+
+        if (dynamic_cast<const Constant*>(&expression) != nullptr)
+        {
+            auto value = expression.Evaluate(complex(0.0)).value_or(complex(NAN, NAN));
+
+            std::ostringstream stream;
+            stream << value.real();
+
+            if (value.imag() != 0.0)
+            {
+                stream << (value.imag() < 0.0 ? u8"-" : u8"+") << std::abs(value.imag()) << u8"i";
+            }
+
+            return stream.str();
+        }
+
+        if (const auto * function = dynamic_cast<const Function*>(&expression))
+        {
+            return std::string(GetFunctionTableEntry(function->GetId()).name);
+        }
+
+        if (dynamic_cast<const Sum*>(&expression) != nullptr)
+        {
+            return std::string(u8"sum");
+        }
+
+        if (dynamic_cast<const Product*>(&expression) != nullptr)
+        {
+            return std::string(u8"product");
+        }
+
+        if (dynamic_cast<const Power*>(&expression) != nullptr)
+        {
+            return std::string(u8"power");
+        }
+
+        return std::string(u8"node");
+    }
+
+}
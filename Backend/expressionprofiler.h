@@ -0,0 +1,118 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef EXPRESSIONPROFILER_H
+#define EXPRESSIONPROFILER_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "expression.h"
+
+namespace Backend {
+
+    class ProfiledNode;
+
+    /*!
+     * \class ExpressionProfiler
+     * \brief The ExpressionProfiler class instruments an expression to find out which of its nodes
+     *        cost time and which produce undefined results.
+     *
+     * Every node of the expression is wrapped by a counter of its evaluations and undefined results.
+     * Every n-th evaluation of a node is timed, and the total time is extrapolated from those samples.
+     * Times are inclusive of the children, the self time excludes them.
+     * The results of the instrumented expression agree with \ref Expression::Evaluate.
+     * An instance must not be used from several threads at once.
+     */
+    class ExpressionProfiler final
+    {
+    public:
+        /*!
+         * \struct Entry
+         * \brief The Entry struct describes the counters of a single node, as part of the report.
+         */
+        struct Entry
+        {
+        public:
+            std::string label;
+            std::size_t depth;
+            std::size_t evaluationCount;
+            std::size_t undefinedCount;
+            double time;
+            double selfTime;
+        };
+
+    private:
+        struct Record
+        {
+        public:
+            std::shared_ptr<ProfiledNode> node;
+            std::string label;
+            std::size_t depth;
+        };
+
+        const std::size_t samplingInterval;
+        std::vector<Record> records;
+        std::shared_ptr<Expression> expression;
+
+    public:
+        /*!
+         * \brief Initializes a new instance.
+         * \param expression The expression to instrument.
+         * \param samplingInterval The number of evaluations of a node per timed evaluation.
+         */
+        explicit ExpressionProfiler(const std::shared_ptr<Expression> & expression, std::size_t samplingInterval = 16);
+        ~ExpressionProfiler() = default;
+        ExpressionProfiler(const ExpressionProfiler&) = delete;
+        ExpressionProfiler(ExpressionProfiler&&) = delete;
+        ExpressionProfiler& operator=(const ExpressionProfiler&) = delete;
+        ExpressionProfiler& operator=(ExpressionProfiler&&) = delete;
+
+        /*!
+         * \brief GetExpression gets the instrumented expression, to be evaluated in place of the original.
+         * \return The instrumented expression.
+         */
+        [[nodiscard]] const std::shared_ptr<Expression> & GetExpression() const;
+
+        /*!
+         * \brief Reset sets all counters to zero.
+         */
+        void Reset();
+
+        /*!
+         * \brief GetReport gets the counters of all nodes.
+         * \return The entries in pre-order, the root first, children after their parent.
+         */
+        [[nodiscard]] std::vector<Entry> GetReport() const;
+
+        /*!
+         * \brief FormatReport formats the report as an indented tree, followed by the node with the most self time.
+         * \return The report as text.
+         */
+        [[nodiscard]] std::string FormatReport() const;
+
+    private:
+        [[nodiscard]] std::shared_ptr<Expression> Instrument(const std::shared_ptr<Expression> & expression, const std::string & role, std::size_t depth);
+        [[nodiscard]] static std::string Describe(const Expression & expression);
+    };
+
+}
+
+#endif // EXPRESSIONPROFILER_H
@@ -0,0 +1,364 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef EXPRESSIONTEMPLATE_H
+#define EXPRESSIONTEMPLATE_H
+
+#include <cfenv>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <type_traits>
+
+#include "expression.h"
+#include "functions.h"
+
+/*!
+ * \brief The Templates namespace holds expression templates mirroring the nodes of the backend.
+ *
+ * A formula written in C++, e.g. Z{} * Z{} + Const(1), becomes a type that the compiler
+ * inlines into a tight loop. Each operation is carried out like the corresponding node would,
+ * but without testing the floating point exceptions after every step: undefined intermediate results
+ * become NaN, which propagates, and the result is checked once per point. So the results agree with
+ * \ref Expression::Evaluate up to rounding. This serves as the reference for the speed
+ * the runtime engines could reach without any interpretive overhead.
+ */
+namespace Backend::Templates {
+
+    /*!
+     * \struct Node
+     * \brief The Node struct marks the types that take part in expression templates.
+     */
+    struct Node
+    {
+    };
+
+    /*!
+     * \brief IsNode tells whether the type is an expression template.
+     */
+    template<typename T>
+    constexpr bool IsNode = std::is_base_of_v<Node, T>;
+
+    /*!
+     * \struct Checked
+     * \brief The Checked struct evaluates the expression template \a Derived, detecting undefined results
+     *        once for the whole expression.
+     *
+     * \a Derived provides Compute, which evaluates without any checks and yields NaN where undefined.
+     */
+    template<typename Derived>
+    struct Checked : Node
+    {
+        [[nodiscard]] std::optional<complex> Evaluate(complex input) const
+        {
+            std::feclearexcept(FE_ALL_EXCEPT); //NOLINT(hicpp-signed-bitwise)
+            auto retval = static_cast<const Derived &>(*this).Compute(input);
+
+            if (!std::isfinite(retval.real()) || !std::isfinite(retval.imag()) || std::fetestexcept(FE_DIVBYZERO | FE_OVERFLOW | FE_INVALID) != 0) //NOLINT(hicpp-signed-bitwise)
+            {
+                return {};
+            }
+
+            return retval;
+        }
+    };
+
+    /*!
+     * \brief Undefined is the value of undefined intermediate results.
+     */
+    constexpr complex Undefined()
+    {
+        return complex(std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN());
+    }
+
+    /*!
+     * \struct Z
+     * \brief The Z struct mirrors \ref BaseZ, the variable.
+     */
+    struct Z : Checked<Z>
+    {
+        [[nodiscard]] static complex Compute(complex input)
+        {
+            return input;
+        }
+    };
+
+    /*!
+     * \struct Const
+     * \brief The Const struct mirrors \ref Constant, a fixed value.
+     */
+    struct Const : Checked<Const>
+    {
+        complex value;
+
+        explicit Const(complex value)
+            : value(value)
+        {
+        }
+
+        [[nodiscard]] complex Compute(complex /*input*/) const
+        {
+            return value;
+        }
+    };
+
+    /*!
+     * \struct Add
+     * \brief The Add struct mirrors a \ref Sum of two summands.
+     */
+    template<typename Left, typename Right>
+    struct Add : Checked<Add<Left, Right>>
+    {
+        Left left;
+        Right right;
+
+        Add(Left left, Right right)
+            : left(left), right(right)
+        {
+        }
+
+        [[nodiscard]] complex Compute(complex input) const
+        {
+            return left.Compute(input) + right.Compute(input);
+        }
+    };
+
+    /*!
+     * \struct Subtract
+     * \brief The Subtract struct mirrors a \ref Sum of a summand and a negative summand.
+     */
+    template<typename Left, typename Right>
+    struct Subtract : Checked<Subtract<Left, Right>>
+    {
+        Left left;
+        Right right;
+
+        Subtract(Left left, Right right)
+            : left(left), right(right)
+        {
+        }
+
+        [[nodiscard]] complex Compute(complex input) const
+        {
+            return left.Compute(input) - right.Compute(input);
+        }
+    };
+
+    /*!
+     * \struct Multiply
+     * \brief The Multiply struct mirrors a \ref Product of two factors.
+     */
+    template<typename Left, typename Right>
+    struct Multiply : Checked<Multiply<Left, Right>>
+    {
+        Left left;
+        Right right;
+
+        Multiply(Left left, Right right)
+            : left(left), right(right)
+        {
+        }
+
+        [[nodiscard]] complex Compute(complex input) const
+        {
+            return left.Compute(input) * right.Compute(input);
+        }
+    };
+
+    /*!
+     * \struct Divide
+     * \brief The Divide struct mirrors a \ref Product of a factor and a negative factor,
+     *        including its check for division by zero.
+     */
+    template<typename Left, typename Right>
+    struct Divide : Checked<Divide<Left, Right>>
+    {
+        constexpr static const double epsilon = 1e-9;
+
+        Left left;
+        Right right;
+
+        Divide(Left left, Right right)
+            : left(left), right(right)
+        {
+        }
+
+        [[nodiscard]] complex Compute(complex input) const
+        {
+            auto value = right.Compute(input);
+
+            if (std::fabs(value.real()) < epsilon && std::fabs(value.imag()) < epsilon)
+            {
+                return Undefined();
+            }
+
+            return left.Compute(input) / value;
+        }
+    };
+
+    /*!
+     * \struct Raise
+     * \brief The Raise struct mirrors \ref Power, a base raised to an exponent.
+     *        Small integer exponents are multiplied out like \ref Power::Apply does.
+     */
+    template<typename Base, typename Exponent>
+    struct Raise : Checked<Raise<Base, Exponent>>
+    {
+        constexpr static const double epsilon = 1e-9;
+        constexpr static const double maximumIntegerExponent = 64.0;
+
+        Base base;
+        Exponent exponent;
+
+        Raise(Base base, Exponent exponent)
+            : base(base), exponent(exponent)
+        {
+        }
+
+        [[nodiscard]] complex Compute(complex input) const
+        {
+            auto baseResult = base.Compute(input);
+            auto exponentResult = exponent.Compute(input);
+            auto n = exponentResult.real();
+
+            if (exponentResult.imag() != 0.0 || !(std::fabs(n) <= maximumIntegerExponent) || std::trunc(n) != n)
+            {
+                return std::pow(baseResult, exponentResult);
+            }
+
+            auto remaining = static_cast<unsigned int>(std::fabs(n));
+            complex retval(1.0);
+            complex factor = baseResult;
+
+            while (remaining != 0U)
+            {
+                if ((remaining & 1U) != 0U)
+                {
+                    retval *= factor;
+                }
+
+                remaining >>= 1U;
+
+                if (remaining != 0U)
+                {
+                    factor *= factor;
+                }
+            }
+
+            if (n < 0.0)
+            {
+                if (std::fabs(retval.real()) < epsilon && std::fabs(retval.imag()) < epsilon)
+                {
+                    return Undefined();
+                }
+
+                retval = 1.0 / retval;
+            }
+
+            return retval;
+        }
+    };
+
+    /*!
+     * \struct Applied
+     * \brief The Applied struct mirrors \ref UnaryFunction, the function described by the \a Kernel.
+     */
+    template<typename Kernel, typename Argument>
+    struct Applied : Checked<Applied<Kernel, Argument>>
+    {
+        Argument argument;
+
+        explicit Applied(Argument argument)
+            : argument(argument)
+        {
+        }
+
+        [[nodiscard]] complex Compute(complex input) const
+        {
+            return Kernel::Apply(argument.Compute(input));
+        }
+    };
+
+    template<typename Left, typename Right, typename = std::enable_if_t<IsNode<Left> && IsNode<Right>>>
+    Add<Left, Right> operator+(Left left, Right right)
+    {
+        return Add<Left, Right>(left, right);
+    }
+
+    template<typename Left, typename Right, typename = std::enable_if_t<IsNode<Left> && IsNode<Right>>>
+    Subtract<Left, Right> operator-(Left left, Right right)
+    {
+        return Subtract<Left, Right>(left, right);
+    }
+
+    template<typename Argument, typename = std::enable_if_t<IsNode<Argument>>>
+    Subtract<Const, Argument> operator-(Argument argument)
+    {
+        return Subtract<Const, Argument>(Const(0.0), argument);
+    }
+
+    template<typename Left, typename Right, typename = std::enable_if_t<IsNode<Left> && IsNode<Right>>>
+    Multiply<Left, Right> operator*(Left left, Right right)
+    {
+        return Multiply<Left, Right>(left, right);
+    }
+
+    template<typename Left, typename Right, typename = std::enable_if_t<IsNode<Left> && IsNode<Right>>>
+    Divide<Left, Right> operator/(Left left, Right right)
+    {
+        return Divide<Left, Right>(left, right);
+    }
+
+    /*!
+     * \brief Pow raises the base to the exponent, like the ^ of the parser.
+     */
+    template<typename Base, typename Exponent, typename = std::enable_if_t<IsNode<Base> && IsNode<Exponent>>>
+    Raise<Base, Exponent> Pow(Base base, Exponent exponent)
+    {
+        return Raise<Base, Exponent>(base, exponent);
+    }
+
+    /*!
+     * \brief Apply applies the function described by the \a Kernel, e.g. Apply<SineKernel>(Z{}).
+     */
+    template<typename Kernel, typename Argument, typename = std::enable_if_t<IsNode<Argument>>>
+    Applied<Kernel, Argument> Apply(Argument argument)
+    {
+        return Applied<Kernel, Argument>(argument);
+    }
+
+    /*!
+     * \brief EvaluateLine evaluates the expression template at many points in a tight loop.
+     * \param expression The expression template.
+     * \param inputs The points to evaluate at.
+     * \param outputs The results, nothing where undefined.
+     * \param count The number of points.
+     */
+    template<typename Expression, typename = std::enable_if_t<IsNode<Expression>>>
+    void EvaluateLine(const Expression & expression, const complex * inputs, std::optional<complex> * outputs, std::size_t count)
+    {
+        for (std::size_t index = 0; index < count; ++index)
+        {
+            outputs[index] = expression.Evaluate(inputs[index]); //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+    }
+
+}
+
+#endif // EXPRESSIONTEMPLATE_H
@@ -0,0 +1,153 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include "framepipeline.h"
+#include "parametersweep.h"
+
+namespace Backend {
+
+    FramePipeline::FramePipeline(std::shared_ptr<ParameterizedExpression> parameterized, std::string name, std::vector<complex> grid,
+                                 double startTime, double timeStep, double frameInterval, std::size_t maxDepth)
+        : parameterized(std::move(parameterized)),
+          name(std::move(name)),
+          grid(std::move(grid)),
+          startTime(startTime),
+          timeStep(timeStep),
+          frameInterval(frameInterval),
+          maxDepth(std::max(maxDepth, FramePipeline::minDepth)),
+          ring(this->maxDepth),
+          head(0),
+          count(0),
+          depth(FramePipeline::minDepth),
+          computeTime(0.0),
+          stopping(false)
+    {
+        this->producer = std::thread(&FramePipeline::Produce, this);
+    }
+
+    FramePipeline::~FramePipeline()
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->stopping = true;
+        }
+
+        this->condition.notify_all();
+        this->producer.join();
+    }
+
+    std::optional<Frame> FramePipeline::TakeFrame()
+    {
+        std::unique_lock<std::mutex> lock(this->mutex);
+
+        if (this->count == 0)
+        {
+            return {};
+        }
+
+        auto frame = this->Pop();
+        lock.unlock();
+        this->condition.notify_all();
+
+        return frame;
+    }
+
+    Frame FramePipeline::WaitForFrame()
+    {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->condition.wait(lock, [this]{ return this->count > 0; });
+
+        auto frame = this->Pop();
+        lock.unlock();
+        this->condition.notify_all();
+
+        return frame;
+    }
+
+    std::size_t FramePipeline::GetDepth() const
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        return this->depth;
+    }
+
+    std::size_t FramePipeline::GetBufferedCount() const
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        return this->count;
+    }
+
+    double FramePipeline::GetComputeTime() const
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        return this->computeTime;
+    }
+
+    void FramePipeline::Produce()
+    {
+        // the cached subexpressions are evaluated on the producer as well, keeping the caller responsive
+        ParameterSweep sweep(this->parameterized, this->grid);
+
+        for (std::size_t index = 0;; ++index)
+        {
+            {
+                std::unique_lock<std::mutex> lock(this->mutex);
+                this->condition.wait(lock, [this]{ return this->stopping || this->count < this->depth; });
+
+                if (this->stopping)
+                {
+                    return;
+                }
+            }
+
+            auto time = this->startTime + static_cast<double>(index) * this->timeStep;
+
+            auto start = std::chrono::steady_clock::now();
+            this->parameterized->Bind(this->name, complex(time));
+            auto samples = sweep.EvaluateFrame();
+            auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+            {
+                std::lock_guard<std::mutex> lock(this->mutex);
+
+                this->ring[(this->head + this->count) % this->maxDepth] = Frame{time, std::move(samples)};
+                ++this->count;
+
+                // frames taking longer than the display interval, or varying a lot, need more frames ahead
+                this->computeTime = index == 0 ? elapsed : (1.0 - FramePipeline::smoothing) * this->computeTime + FramePipeline::smoothing * elapsed;
+                auto wanted = static_cast<std::size_t>(std::ceil(FramePipeline::jitterFactor * this->computeTime / this->frameInterval)) + 1U;
+                this->depth = std::clamp(wanted, FramePipeline::minDepth, this->maxDepth);
+            }
+
+            this->condition.notify_all();
+        }
+    }
+
+    Frame FramePipeline::Pop()
+    {
+        auto frame = std::move(this->ring[this->head]);
+        this->head = (this->head + 1) % this->maxDepth;
+        --this->count;
+
+        return frame;
+    }
+
+}
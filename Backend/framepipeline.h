@@ -0,0 +1,139 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef FRAMEPIPELINE_H
+#define FRAMEPIPELINE_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "expression.h"
+#include "parameter.h"
+#include "sample.h"
+
+namespace Backend {
+
+    /*!
+     * \struct Frame
+     * \brief The Frame struct collects the value of the time parameter and the samples evaluated for it.
+     */
+    struct Frame
+    {
+    public:
+        double time;
+        std::vector<Sample> samples;
+    };
+
+    /*!
+     * \class FramePipeline
+     * \brief The FramePipeline class precomputes the frames of an animation on a producer thread.
+     *
+     * The time parameter advances by a fixed step per frame. The producer keeps up to K frames
+     * ahead in a ring buffer, where K follows the measured time to compute a frame relative to
+     * the display interval, such that variations in compute time do not stall the display.
+     * The expression is evaluated by the producer only, so it must not be used elsewhere
+     * while the pipeline exists.
+     */
+    class FramePipeline final
+    {
+    private:
+        constexpr static const std::size_t minDepth = 2;
+        constexpr static const double jitterFactor = 2.0;
+        constexpr static const double smoothing = 0.2;
+
+        std::shared_ptr<ParameterizedExpression> parameterized;
+        const std::string name;
+        const std::vector<complex> grid;
+        const double startTime;
+        const double timeStep;
+        const double frameInterval;
+        const std::size_t maxDepth;
+
+        mutable std::mutex mutex;
+        std::condition_variable condition;
+        std::vector<Frame> ring;
+        std::size_t head;
+        std::size_t count;
+        std::size_t depth;
+        double computeTime;
+        bool stopping;
+        std::thread producer;
+
+    public:
+        /*!
+         * \brief Initializes a new instance and starts the producer.
+         * \param parameterized The handle to the expression to animate, used by the producer exclusively.
+         * \param name The name of the time parameter.
+         * \param grid The points to evaluate at in every frame.
+         * \param startTime The value of the time parameter for the first frame.
+         * \param timeStep The increase of the time parameter from frame to frame.
+         * \param frameInterval The display interval of a frame in seconds.
+         * \param maxDepth The maximum number of frames to compute ahead.
+         */
+        FramePipeline(std::shared_ptr<ParameterizedExpression> parameterized, std::string name, std::vector<complex> grid,
+                      double startTime, double timeStep, double frameInterval, std::size_t maxDepth);
+        ~FramePipeline();
+        FramePipeline(const FramePipeline&) = delete;
+        FramePipeline(FramePipeline&&) = delete;
+        FramePipeline& operator=(const FramePipeline&) = delete;
+        FramePipeline& operator=(FramePipeline&&) = delete;
+
+        /*!
+         * \brief TakeFrame takes the next frame out of the buffer without waiting.
+         * \return The frame or nothing if the producer has not finished it yet.
+         */
+        [[nodiscard]] std::optional<Frame> TakeFrame();
+
+        /*!
+         * \brief WaitForFrame takes the next frame out of the buffer, waiting for the producer if necessary.
+         * \return The frame.
+         */
+        [[nodiscard]] Frame WaitForFrame();
+
+        /*!
+         * \brief GetDepth gets the number of frames the producer currently computes ahead.
+         * \return The number of frames.
+         */
+        [[nodiscard]] std::size_t GetDepth() const;
+
+        /*!
+         * \brief GetBufferedCount gets the number of frames ready to be taken.
+         * \return The number of frames.
+         */
+        [[nodiscard]] std::size_t GetBufferedCount() const;
+
+        /*!
+         * \brief GetComputeTime gets the smoothed time to compute a frame.
+         * \return The time in seconds.
+         */
+        [[nodiscard]] double GetComputeTime() const;
+
+    private:
+        void Produce();
+        [[nodiscard]] Frame Pop();
+    };
+
+}
+
+#endif // FRAMEPIPELINE_H
@@ -16,10 +16,52 @@
  *
  */
 
-/*
- * may only be defined once in the project
- * causes the static init for the registration
- */
-#define ONE_TIME_EXECUTE_FUNCTIONS_H
-
 #include "functions.h"
+
+namespace Backend
+{
+    Function::Function(std::shared_ptr<Expression> argument)
+        : argument(std::move(argument))
+    {
+    }
+
+    Function::~Function()
+    {
+        // paranoid: remove possible source for circular references
+        this->argument.reset();
+    }
+
+    const std::shared_ptr<Expression> & Function::GetArgument() const
+    {
+        return this->argument;
+    }
+
+    int Function::GetLevel() const
+    {
+        return 3;
+    }
+
+    bool Function::IsConstant() const
+    {
+        return false;
+    }
+
+    bool Function::operator==(const Expression &other) const
+    {
+        if (const auto * b = dynamic_cast<const Function*>(&other))
+        {
+            return b != nullptr
+                    && this->GetId() == b->GetId()
+                    && *(this->argument) == *(b->argument);
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    bool Function::operator!=(const Expression &other) const
+    {
+        return !(*this == other);
+    }
+}
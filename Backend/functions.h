@@ -19,170 +19,548 @@
 #ifndef FUNCTIONS_H
 #define FUNCTIONS_H
 
+#include <array>
 #include <cfenv>
 #include <cmath>
+#include <cstddef>
+#include <functional>
 #include <memory>
+#include <string_view>
+#include <utility>
 
+#include "complexinterval.h"
 #include "expression.h"
 #include "parser.h"
 
 /*
- * Documentation for the CREATE_FUNCTION macro below:
- *
- * Create an Expression-inheriting function class from
- *   a class name,
- *   a human-readable function name,
- *   a C++ fragment that
+ * A mathematical function such as sin(z) is described by a kernel, i.e. a policy type providing
+ *   an identifier from FunctionId,
+ *   the human-readable function name used by the parser,
+ *   a function Apply that
  *       takes a z (of type complex) and
- *       gives the correct evaluation (as complex).
- *
- * The idea is to only have to modify this file (by adding a CREATE_FUNCTION call)
- * when adding a new function such as sin(x).
+ *       gives the correct evaluation (as complex),
+ *   a function ApplyInterval that
+ *       takes a z (of type ComplexInterval) and
+ *       gives bounds of the evaluation (as ComplexInterval).
  *
- * The two branches of #ifdef ONE_TIME_EXECUTE_FUNCTIONS_H are identical except for
- * the static initializers executed in the first branch. Therefore, only one
- * translation unit may have ONE_TIME_EXECUTE_FUNCTIONS_H defined.
- * Within the first branch, the registration of the newly created function
- * in the parser is executed using static initialization.
+ * The expression class for the function is UnaryFunction<Kernel>. In order to add a function,
+ * add its identifier and kernel, add the kernel to the FunctionTable and name the expression class.
+ * The parser picks up all functions from the FunctionTable.
  */
 
-#ifdef ONE_TIME_EXECUTE_FUNCTIONS_H
-
-#define CREATE_FUNCTION(classname, functionname, themath)\
-namespace Backend\
-{\
-    class classname : public Expression\
-    {\
-    private:\
-        std::shared_ptr<Expression> expression;\
-        static bool IsRegistered;\
-    public:\
-        classname(std::shared_ptr<Expression> expression) : expression(expression) {}\
-        virtual ~classname() { this->expression.reset(); }\
-        classname(const classname&) = delete;\
-        classname(classname&&) = delete;\
-        classname& operator=(const classname&) = delete;\
-        classname& operator=(classname&&) = delete;\
-        virtual int GetLevel() const { return 3; }\
-        virtual bool IsConstant() const { return false; }\
-        virtual std::optional<complex> Evaluate(complex input) const\
-        {\
-            auto expressionResult = expression->Evaluate(input);\
-            if(!expressionResult.has_value()) { return {}; }\
-            auto z = expressionResult.value();\
-            std::feclearexcept(FE_ALL_EXCEPT);\
-            auto retval = themath;\
-            if(!std::isfinite(retval.real()) || !std::isfinite(retval.imag()) || std::fetestexcept(FE_DIVBYZERO | FE_OVERFLOW | FE_INVALID))\
-            {\
-                std::feclearexcept(FE_ALL_EXCEPT);\
-                return {};\
-            }\
-            return retval;\
-        }\
-        virtual bool operator==(const Expression &other) const\
-        {\
-            if (const classname * b = dynamic_cast<const classname*>(&other))\
-            {\
-                if(b == nullptr) { return false; }\
-                return *(this->expression) == *(b->expression);\
-            }\
-            else { return false; }\
-        }\
-        virtual bool operator!=(const Expression &other) const { return !(*this == other); }\
-        static std::shared_ptr<Expression> Create(std::shared_ptr<Expression> expression) { return std::make_shared<classname>(expression); }\
-        static bool SelfRegister()\
-        {\
-            static bool isRegistered(false);\
-            if(!isRegistered)\
-            {\
-                 Parser::Register(functionname, &classname::Create);\
-            }\
-            return isRegistered;\
-        }\
-    };\
-    bool classname::IsRegistered = classname::SelfRegister();\
-}\
-
-#else // ONE_TIME_EXECUTE_FUNCTIONS_H
-
-#define CREATE_FUNCTION(classname, functionname, themath)\
-namespace Backend\
-{\
-    class classname : public Expression\
-    {\
-    private:\
-        std::shared_ptr<Expression> expression;\
-        static bool IsRegistered;\
-    public:\
-        classname(std::shared_ptr<Expression> expression) : expression(expression) {}\
-        virtual ~classname() { this->expression.reset(); }\
-        classname(const classname&) = delete;\
-        classname(classname&&) = delete;\
-        classname& operator=(const classname&) = delete;\
-        classname& operator=(classname&&) = delete;\
-        virtual int GetLevel() const { return 3; }\
-        virtual bool IsConstant() const { return false; }\
-        virtual std::optional<complex> Evaluate(complex input) const\
-        {\
-            auto expressionResult = expression->Evaluate(input);\
-            if(!expressionResult.has_value()) { return {}; }\
-            auto z = expressionResult.value();\
-            std::feclearexcept(FE_ALL_EXCEPT);\
-            auto retval = themath;\
-            if(!std::isfinite(retval.real()) || !std::isfinite(retval.imag()) || std::fetestexcept(FE_DIVBYZERO | FE_OVERFLOW | FE_INVALID))\
-            {\
-                std::feclearexcept(FE_ALL_EXCEPT);\
-                return {};\
-            }\
-            return retval;\
-        }\
-        virtual bool operator==(const Expression &other) const\
-        {\
-            if (const classname * b = dynamic_cast<const classname*>(&other))\
-            {\
-                if(b == nullptr) { return false; }\
-                return *(this->expression) == *(b->expression);\
-            }\
-            else { return false; }\
-        }\
-        virtual bool operator!=(const Expression &other) const { return !(*this == other); }\
-        static std::shared_ptr<Expression> Create(std::shared_ptr<Expression> expression) { return std::make_shared<classname>(expression); }\
-        static bool SelfRegister()\
-        {\
-            static bool isRegistered(false);\
-            if(!isRegistered)\
-            {\
-                 Parser::Register(functionname, &classname::Create);\
-            }\
-            return isRegistered;\
-        }\
-    };\
-}\
-
-#endif // ONE_TIME_EXECUTE_FUNCTIONS_H
-
-// the actual function creation
-
-CREATE_FUNCTION(Magnitude, "abs", complex(std::abs(z)));
-
-CREATE_FUNCTION(RealPart, "Re", complex(z.real()));
-
-CREATE_FUNCTION(ImaginaryPart, "Im", complex(z.imag()));
-
-CREATE_FUNCTION(Norm, "norm", complex(std::norm(z)));
-
-CREATE_FUNCTION(Conjugate, "conj", std::conj(z));
-
-CREATE_FUNCTION(Sine, "sin", std::sin(z));
-
-CREATE_FUNCTION(Cosine, "cos", std::cos(z));
-
-CREATE_FUNCTION(Tangent, "tan", std::tan(z));
-
-CREATE_FUNCTION(SquareRoot, "sqrt", std::sqrt(z));
-
-CREATE_FUNCTION(NaturalExponential, "exp", std::exp(z));
-
-CREATE_FUNCTION(NaturalLogarithm, "ln", std::log(z));
+namespace Backend
+{
+    /*!
+     * \brief The FunctionId enum identifies the mathematical functions,
+     *        such that they can be dispatched on without knowing the expression classes.
+     *        The values are the indices into the \ref FunctionTable.
+     */
+    enum class FunctionId
+    {
+        Magnitude,
+        RealPart,
+        ImaginaryPart,
+        Norm,
+        Conjugate,
+        Sine,
+        Cosine,
+        Tangent,
+        SquareRoot,
+        NaturalExponential,
+        NaturalLogarithm,
+        CommonLogarithm,
+        Argument,
+        HyperbolicSine,
+        HyperbolicCosine,
+        HyperbolicTangent,
+        ArcSine,
+        ArcCosine,
+        ArcTangent,
+        ImaginaryExponential,
+    };
+
+    /*!
+     * \brief The MagnitudeKernel struct describes abs(z), the magnitude.
+     */
+    struct MagnitudeKernel
+    {
+        static constexpr FunctionId Id = FunctionId::Magnitude;
+        static constexpr std::string_view Name = "abs";
+        static complex Apply(complex z) { return complex(std::abs(z)); }
+        static ComplexInterval ApplyInterval(const ComplexInterval & z) { return ComplexInterval::Abs(z); }
+    };
+
+    /*!
+     * \brief The RealPartKernel struct describes Re(z), the real part.
+     */
+    struct RealPartKernel
+    {
+        static constexpr FunctionId Id = FunctionId::RealPart;
+        static constexpr std::string_view Name = "Re";
+        static complex Apply(complex z) { return complex(z.real()); }
+        static ComplexInterval ApplyInterval(const ComplexInterval & z) { return ComplexInterval::Real(z); }
+    };
+
+    /*!
+     * \brief The ImaginaryPartKernel struct describes Im(z), the imaginary part.
+     */
+    struct ImaginaryPartKernel
+    {
+        static constexpr FunctionId Id = FunctionId::ImaginaryPart;
+        static constexpr std::string_view Name = "Im";
+        static complex Apply(complex z) { return complex(z.imag()); }
+        static ComplexInterval ApplyInterval(const ComplexInterval & z) { return ComplexInterval::Imag(z); }
+    };
+
+    /*!
+     * \brief The NormKernel struct describes norm(z), the squared magnitude.
+     */
+    struct NormKernel
+    {
+        static constexpr FunctionId Id = FunctionId::Norm;
+        static constexpr std::string_view Name = "norm";
+        static complex Apply(complex z) { return complex(std::norm(z)); }
+        static ComplexInterval ApplyInterval(const ComplexInterval & z) { return ComplexInterval::Norm(z); }
+    };
+
+    /*!
+     * \brief The ConjugateKernel struct describes conj(z), the complex conjugate.
+     */
+    struct ConjugateKernel
+    {
+        static constexpr FunctionId Id = FunctionId::Conjugate;
+        static constexpr std::string_view Name = "conj";
+        static complex Apply(complex z) { return std::conj(z); }
+        static ComplexInterval ApplyInterval(const ComplexInterval & z) { return ComplexInterval::Conj(z); }
+    };
+
+    /*!
+     * \brief The SineKernel struct describes sin(z), the sine.
+     */
+    struct SineKernel
+    {
+        static constexpr FunctionId Id = FunctionId::Sine;
+        static constexpr std::string_view Name = "sin";
+        static complex Apply(complex z) { return std::sin(z); }
+        static ComplexInterval ApplyInterval(const ComplexInterval & z) { return ComplexInterval::Sin(z); }
+    };
+
+    /*!
+     * \brief The CosineKernel struct describes cos(z), the cosine.
+     */
+    struct CosineKernel
+    {
+        static constexpr FunctionId Id = FunctionId::Cosine;
+        static constexpr std::string_view Name = "cos";
+        static complex Apply(complex z) { return std::cos(z); }
+        static ComplexInterval ApplyInterval(const ComplexInterval & z) { return ComplexInterval::Cos(z); }
+    };
+
+    /*!
+     * \brief The TangentKernel struct describes tan(z), the tangent.
+     */
+    struct TangentKernel
+    {
+        static constexpr FunctionId Id = FunctionId::Tangent;
+        static constexpr std::string_view Name = "tan";
+        static complex Apply(complex z) { return std::tan(z); }
+        static ComplexInterval ApplyInterval(const ComplexInterval & z) { return ComplexInterval::Tan(z); }
+    };
+
+    /*!
+     * \brief The SquareRootKernel struct describes sqrt(z), the principal square root.
+     */
+    struct SquareRootKernel
+    {
+        static constexpr FunctionId Id = FunctionId::SquareRoot;
+        static constexpr std::string_view Name = "sqrt";
+        static complex Apply(complex z) { return std::sqrt(z); }
+        static ComplexInterval ApplyInterval(const ComplexInterval & z) { return ComplexInterval::Sqrt(z); }
+    };
+
+    /*!
+     * \brief The NaturalExponentialKernel struct describes exp(z), the natural exponential.
+     */
+    struct NaturalExponentialKernel
+    {
+        static constexpr FunctionId Id = FunctionId::NaturalExponential;
+        static constexpr std::string_view Name = "exp";
+        static complex Apply(complex z) { return std::exp(z); }
+        static ComplexInterval ApplyInterval(const ComplexInterval & z) { return ComplexInterval::Exp(z); }
+    };
+
+    /*!
+     * \brief The NaturalLogarithmKernel struct describes ln(z), the principal natural logarithm.
+     */
+    struct NaturalLogarithmKernel
+    {
+        static constexpr FunctionId Id = FunctionId::NaturalLogarithm;
+        static constexpr std::string_view Name = "ln";
+        static complex Apply(complex z) { return std::log(z); }
+        static ComplexInterval ApplyInterval(const ComplexInterval & z) { return ComplexInterval::Log(z); }
+    };
+
+    /*!
+     * \brief The CommonLogarithmKernel struct describes log10(z), the principal common logarithm.
+     */
+    struct CommonLogarithmKernel
+    {
+        static constexpr FunctionId Id = FunctionId::CommonLogarithm;
+        static constexpr std::string_view Name = "log10";
+        static complex Apply(complex z) { return std::log10(z); }
+        static ComplexInterval ApplyInterval(const ComplexInterval & z) { return ComplexInterval::Log10(z); }
+    };
+
+    /*!
+     * \brief The ArgumentKernel struct describes arg(z), the argument in (-pi, pi].
+     */
+    struct ArgumentKernel
+    {
+        static constexpr FunctionId Id = FunctionId::Argument;
+        static constexpr std::string_view Name = "arg";
+        static complex Apply(complex z) { return complex(std::arg(z)); }
+        static ComplexInterval ApplyInterval(const ComplexInterval & z) { return ComplexInterval::Arg(z); }
+    };
+
+    /*!
+     * \brief The HyperbolicSineKernel struct describes sinh(z), the hyperbolic sine.
+     */
+    struct HyperbolicSineKernel
+    {
+        static constexpr FunctionId Id = FunctionId::HyperbolicSine;
+        static constexpr std::string_view Name = "sinh";
+        static complex Apply(complex z) { return std::sinh(z); }
+        static ComplexInterval ApplyInterval(const ComplexInterval & z) { return ComplexInterval::Sinh(z); }
+    };
+
+    /*!
+     * \brief The HyperbolicCosineKernel struct describes cosh(z), the hyperbolic cosine.
+     */
+    struct HyperbolicCosineKernel
+    {
+        static constexpr FunctionId Id = FunctionId::HyperbolicCosine;
+        static constexpr std::string_view Name = "cosh";
+        static complex Apply(complex z) { return std::cosh(z); }
+        static ComplexInterval ApplyInterval(const ComplexInterval & z) { return ComplexInterval::Cosh(z); }
+    };
+
+    /*!
+     * \brief The HyperbolicTangentKernel struct describes tanh(z), the hyperbolic tangent.
+     */
+    struct HyperbolicTangentKernel
+    {
+        static constexpr FunctionId Id = FunctionId::HyperbolicTangent;
+        static constexpr std::string_view Name = "tanh";
+        static complex Apply(complex z) { return std::tanh(z); }
+        static ComplexInterval ApplyInterval(const ComplexInterval & z) { return ComplexInterval::Tanh(z); }
+    };
+
+    /*!
+     * \brief The ArcSineKernel struct describes asin(z), the principal inverse sine.
+     */
+    struct ArcSineKernel
+    {
+        static constexpr FunctionId Id = FunctionId::ArcSine;
+        static constexpr std::string_view Name = "asin";
+        static complex Apply(complex z) { return std::asin(z); }
+        static ComplexInterval ApplyInterval(const ComplexInterval & z) { return ComplexInterval::Asin(z); }
+    };
+
+    /*!
+     * \brief The ArcCosineKernel struct describes acos(z), the principal inverse cosine.
+     */
+    struct ArcCosineKernel
+    {
+        static constexpr FunctionId Id = FunctionId::ArcCosine;
+        static constexpr std::string_view Name = "acos";
+        static complex Apply(complex z) { return std::acos(z); }
+        static ComplexInterval ApplyInterval(const ComplexInterval & z) { return ComplexInterval::Acos(z); }
+    };
+
+    /*!
+     * \brief The ArcTangentKernel struct describes atan(z), the principal inverse tangent.
+     */
+    struct ArcTangentKernel
+    {
+        static constexpr FunctionId Id = FunctionId::ArcTangent;
+        static constexpr std::string_view Name = "atan";
+        static complex Apply(complex z) { return std::atan(z); }
+        static ComplexInterval ApplyInterval(const ComplexInterval & z) { return ComplexInterval::Atan(z); }
+    };
+
+    /*!
+     * \brief The ImaginaryExponentialKernel struct describes expi(z) = exp(iz) = cos(z) + i sin(z).
+     *        It shares the work of sine and cosine, and is cheaper than exp(i*z).
+     */
+    struct ImaginaryExponentialKernel
+    {
+        static constexpr FunctionId Id = FunctionId::ImaginaryExponential;
+        static constexpr std::string_view Name = "expi";
+        static complex Apply(complex z) { return std::polar(std::exp(-z.imag()), z.real()); }
+        static ComplexInterval ApplyInterval(const ComplexInterval & z) { return ComplexInterval::Expi(z); }
+    };
+
+    /*!
+     * \class Function
+     * \brief The Function class forms the base for all mathematical functions of a single argument.
+     */
+    class Function : public Expression
+    {
+    protected:
+        std::shared_ptr<Expression> argument;
+
+    public:
+        /*!
+         * \brief Initializes a new instance holding the supplied argument.
+         * \param argument The argument of the function.
+         */
+        explicit Function(std::shared_ptr<Expression> argument);
+        ~Function() override;
+        Function(const Function&) = delete;
+        Function(Function&&) = delete;
+        Function& operator=(const Function&) = delete;
+        Function& operator=(Function&&) = delete;
+
+        /*!
+         * \brief Gets the identifier of the mathematical function.
+         * \return The identifier.
+         */
+        [[nodiscard]] virtual FunctionId GetId() const = 0;
+
+        /*!
+         * \brief Gets the argument of the function.
+         * \return The argument.
+         */
+        [[nodiscard]] const std::shared_ptr<Expression> & GetArgument() const;
+
+        /*!
+         * \reimp
+         */
+        [[nodiscard]] int GetLevel() const override;
+
+        /*!
+         * \reimp
+         */
+        [[nodiscard]] bool IsConstant() const override;
+
+        /*!
+         * \reimp
+         */
+        [[nodiscard]] bool operator==(const Expression &other) const override;
+
+        /*!
+         * \reimp
+         */
+        [[nodiscard]] bool operator!=(const Expression &other) const override;
+    };
+
+    /*!
+     * \class UnaryFunction
+     * \brief The UnaryFunction class represents the mathematical function described by the \a Kernel,
+     *        applied to an argument.
+     */
+    template<typename Kernel>
+    class UnaryFunction final : public Function
+    {
+    public:
+        /*!
+         * \brief Initializes a new instance holding the supplied argument.
+         * \param argument The argument of the function.
+         */
+        explicit UnaryFunction(std::shared_ptr<Expression> argument)
+            : Function(std::move(argument))
+        {
+        }
+
+        ~UnaryFunction() override = default;
+        UnaryFunction(const UnaryFunction&) = delete;
+        UnaryFunction(UnaryFunction&&) = delete;
+        UnaryFunction& operator=(const UnaryFunction&) = delete;
+        UnaryFunction& operator=(UnaryFunction&&) = delete;
+
+        /*!
+         * \brief Create creates an instance holding the supplied argument, for registration with the \ref Parser.
+         * \param argument The argument of the function.
+         * \return The new instance.
+         */
+        static std::shared_ptr<Expression> Create(std::shared_ptr<Expression> argument)
+        {
+            return std::make_shared<UnaryFunction>(std::move(argument));
+        }
+
+        /*!
+         * \brief ApplyChecked applies the kernel, detecting undefined results.
+         * \param z The value to apply the kernel to.
+         * \return The result or nothing if undefined.
+         */
+        static std::optional<complex> ApplyChecked(complex z)
+        {
+            std::feclearexcept(FE_ALL_EXCEPT); //NOLINT(hicpp-signed-bitwise)
+            auto retval = Kernel::Apply(z);
+
+            if (!std::isfinite(retval.real()) || !std::isfinite(retval.imag()) || std::fetestexcept(FE_DIVBYZERO | FE_OVERFLOW | FE_INVALID) != 0) //NOLINT(hicpp-signed-bitwise)
+            {
+                std::feclearexcept(FE_ALL_EXCEPT); //NOLINT(hicpp-signed-bitwise)
+                return {};
+            }
+
+            return retval;
+        }
+
+        /*!
+         * \brief ApplyBatch applies the kernel to many values in a tight loop.
+         *        Undefined results are not detected, but are usually non-finite.
+         * \param inputs The values to apply the kernel to.
+         * \param outputs The results, may be the same as the inputs.
+         * \param count The number of values.
+         */
+        static void ApplyBatch(const complex * inputs, complex * outputs, std::size_t count)
+        {
+            for (std::size_t index = 0; index < count; ++index)
+            {
+                outputs[index] = Kernel::Apply(inputs[index]); //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            }
+        }
+
+        /*!
+         * \reimp
+         */
+        [[nodiscard]] FunctionId GetId() const override
+        {
+            return Kernel::Id;
+        }
+
+        /*!
+         * \reimp
+         */
+        [[nodiscard]] std::optional<complex> Evaluate(complex input) const override
+        {
+            auto argumentResult = this->argument->Evaluate(input);
+
+            if (!argumentResult.has_value())
+            {
+                return {};
+            }
+
+            return ApplyChecked(argumentResult.value());
+        }
+
+        /*!
+         * \reimp
+         */
+        [[nodiscard]] ComplexInterval EvaluateInterval(const ComplexInterval & input) const override
+        {
+            return Kernel::ApplyInterval(this->argument->EvaluateInterval(input));
+        }
+
+        /*!
+         * \reimp
+         */
+        [[nodiscard]] std::size_t GetHash() const override
+        {
+            return HashCombine(std::hash<std::string_view>{}(Kernel::Name), this->argument->GetHash());
+        }
+    };
+
+    using Magnitude = UnaryFunction<MagnitudeKernel>;
+    using RealPart = UnaryFunction<RealPartKernel>;
+    using ImaginaryPart = UnaryFunction<ImaginaryPartKernel>;
+    using Norm = UnaryFunction<NormKernel>;
+    using Conjugate = UnaryFunction<ConjugateKernel>;
+    using Sine = UnaryFunction<SineKernel>;
+    using Cosine = UnaryFunction<CosineKernel>;
+    using Tangent = UnaryFunction<TangentKernel>;
+    using SquareRoot = UnaryFunction<SquareRootKernel>;
+    using NaturalExponential = UnaryFunction<NaturalExponentialKernel>;
+    using NaturalLogarithm = UnaryFunction<NaturalLogarithmKernel>;
+    using CommonLogarithm = UnaryFunction<CommonLogarithmKernel>;
+    using Argument = UnaryFunction<ArgumentKernel>;
+    using HyperbolicSine = UnaryFunction<HyperbolicSineKernel>;
+    using HyperbolicCosine = UnaryFunction<HyperbolicCosineKernel>;
+    using HyperbolicTangent = UnaryFunction<HyperbolicTangentKernel>;
+    using ArcSine = UnaryFunction<ArcSineKernel>;
+    using ArcCosine = UnaryFunction<ArcCosineKernel>;
+    using ArcTangent = UnaryFunction<ArcTangentKernel>;
+    using ImaginaryExponential = UnaryFunction<ImaginaryExponentialKernel>;
+
+    /*!
+     * \struct FunctionTableEntry
+     * \brief The FunctionTableEntry struct collects everything known about a mathematical function
+     *        for dispatching on its \ref FunctionId.
+     */
+    struct FunctionTableEntry
+    {
+    public:
+        FunctionId id;
+        std::string_view name;
+        CreateFunction create;
+        std::optional<complex> (*apply)(complex);
+        void (*applyBatch)(const complex *, complex *, std::size_t);
+    };
+
+    template<typename... Kernels>
+    constexpr std::array<FunctionTableEntry, sizeof...(Kernels)> MakeFunctionTable()
+    {
+        return {{
+            {
+                Kernels::Id,
+                Kernels::Name,
+                &UnaryFunction<Kernels>::Create,
+                &UnaryFunction<Kernels>::ApplyChecked,
+                &UnaryFunction<Kernels>::ApplyBatch,
+            }...
+        }};
+    }
+
+    /*!
+     * \brief FunctionTable lists all mathematical functions, indexed by their \ref FunctionId.
+     */
+    inline constexpr auto FunctionTable = MakeFunctionTable<
+            MagnitudeKernel,
+            RealPartKernel,
+            ImaginaryPartKernel,
+            NormKernel,
+            ConjugateKernel,
+            SineKernel,
+            CosineKernel,
+            TangentKernel,
+            SquareRootKernel,
+            NaturalExponentialKernel,
+            NaturalLogarithmKernel,
+            CommonLogarithmKernel,
+            ArgumentKernel,
+            HyperbolicSineKernel,
+            HyperbolicCosineKernel,
+            HyperbolicTangentKernel,
+            ArcSineKernel,
+            ArcCosineKernel,
+            ArcTangentKernel,
+            ImaginaryExponentialKernel>();
+
+    constexpr bool IsFunctionTableIndexedById()
+    {
+        for (std::size_t index = 0; index < FunctionTable.size(); ++index)
+        {
+            if (static_cast<std::size_t>(FunctionTable[index].id) != index) //NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    static_assert(IsFunctionTableIndexedById(), "the FunctionTable must list the kernels in the order of FunctionId");
+
+    /*!
+     * \brief GetFunctionTableEntry gets the entry of the \ref FunctionTable for a function.
+     * \param id The identifier of the function.
+     * \return The entry.
+     */
+    constexpr const FunctionTableEntry & GetFunctionTableEntry(FunctionId id)
+    {
+        return FunctionTable[static_cast<std::size_t>(id)]; //NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+    }
+}
 
 #endif // FUNCTIONS_H
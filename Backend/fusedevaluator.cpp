@@ -0,0 +1,367 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <cmath>
+
+#include "basez.h"
+#include "complexinterval.h"
+#include "constant.h"
+#include "functions.h"
+#include "fusedevaluator.h"
+#include "parameter.h"
+#include "power.h"
+#include "product.h"
+#include "sum.h"
+#include "tracer.h"
+
+namespace Backend {
+
+    namespace {
+
+        struct Memo
+        {
+        public:
+            complex lastInput;
+            std::optional<complex> lastOutput;
+        };
+
+        // the values remembered by the evaluation running on this thread, one per shared subexpression
+        thread_local std::vector<Memo> * currentMemos = nullptr;
+
+        /*!
+         * \class MemoScope
+         * \brief The MemoScope class provides fresh memos for the shared subexpressions
+         *        while an evaluation runs on the current thread.
+         */
+        class MemoScope final
+        {
+        private:
+            std::vector<Memo> memos;
+            std::vector<Memo> * previousMemos;
+
+        public:
+            explicit MemoScope(std::size_t count)
+                : memos(count, Memo{complex(NAN, NAN), std::nullopt}),
+                  previousMemos(currentMemos)
+            {
+                currentMemos = &this->memos;
+            }
+
+            ~MemoScope()
+            {
+                currentMemos = this->previousMemos;
+            }
+
+            MemoScope(const MemoScope&) = delete;
+            MemoScope(MemoScope&&) = delete;
+            MemoScope& operator=(const MemoScope&) = delete;
+            MemoScope& operator=(MemoScope&&) = delete;
+        };
+
+    }
+
+    /*!
+     * \class SharedSubexpression
+     * \brief The SharedSubexpression class stands in for all occurrences of a subexpression,
+     *        remembering its value at the last point evaluated by the running evaluation.
+     *
+     * Everything but the evaluation is forwarded to the original subexpression.
+     * Outside of an evaluation by the \ref FusedEvaluator, nothing is remembered.
+     */
+    class SharedSubexpression final : public Expression
+    {
+    private:
+        std::shared_ptr<Expression> original;
+        const std::size_t slot;
+
+    public:
+        SharedSubexpression(std::shared_ptr<Expression> original, std::size_t slot)
+            : original(std::move(original)),
+              slot(slot)
+        {
+        }
+
+        ~SharedSubexpression() override = default;
+        SharedSubexpression(const SharedSubexpression&) = delete;
+        SharedSubexpression(SharedSubexpression&&) = delete;
+        SharedSubexpression& operator=(const SharedSubexpression&) = delete;
+        SharedSubexpression& operator=(SharedSubexpression&&) = delete;
+
+        [[nodiscard]] int GetLevel() const override
+        {
+            return this->original->GetLevel();
+        }
+
+        [[nodiscard]] bool IsConstant() const override
+        {
+            return this->original->IsConstant();
+        }
+
+        [[nodiscard]] std::optional<complex> Evaluate(complex input) const override
+        {
+            if (currentMemos == nullptr)
+            {
+                return this->original->Evaluate(input);
+            }
+
+            // the initial NaN never compares equal, so the first point is always evaluated
+            auto & memo = (*currentMemos)[this->slot];
+
+            if (input != memo.lastInput)
+            {
+                memo.lastOutput = this->original->Evaluate(input);
+                memo.lastInput = input;
+            }
+
+            return memo.lastOutput;
+        }
+
+        [[nodiscard]] ComplexInterval EvaluateInterval(const ComplexInterval & input) const override
+        {
+            return this->original->EvaluateInterval(input);
+        }
+
+        [[nodiscard]] std::size_t GetHash() const override
+        {
+            return this->original->GetHash();
+        }
+
+        [[nodiscard]] bool operator==(const Expression &other) const override
+        {
+            return *(this->original) == other;
+        }
+
+        [[nodiscard]] bool operator!=(const Expression &other) const override
+        {
+            return !(*this == other);
+        }
+    };
+
+    FusedEvaluator::FusedEvaluator(const std::vector<std::shared_ptr<Expression>> & expressions)
+        : sharedCount(0)
+    {
+        for (const auto & expression : expressions)
+        {
+            static_cast<void>(this->Count(expression));
+        }
+
+        for (const auto & expression : expressions)
+        {
+            this->expressions.push_back(this->Substitute(expression));
+        }
+
+        // the representatives are only needed while building
+        this->occurrences.clear();
+        this->index.clear();
+    }
+
+    std::vector<std::optional<complex>> FusedEvaluator::Evaluate(complex input) const
+    {
+        MemoScope memoScope(this->sharedCount);
+
+        std::vector<std::optional<complex>> results;
+        results.reserve(this->expressions.size());
+
+        for (const auto & expression : this->expressions)
+        {
+            results.push_back(expression->Evaluate(input));
+        }
+
+        return results;
+    }
+
+    std::vector<std::vector<Sample>> FusedEvaluator::EvaluateAll(const std::vector<complex> & grid) const
+    {
+        TraceSpan span(u8"evaluate", u8"FusedEvaluator::EvaluateAll");
+        MemoScope memoScope(this->sharedCount);
+
+        std::vector<std::vector<Sample>> results(this->expressions.size());
+
+        for (auto & samples : results)
+        {
+            samples.reserve(grid.size());
+        }
+
+        for (const auto & input : grid)
+        {
+            for (std::size_t expressionIndex = 0; expressionIndex < this->expressions.size(); ++expressionIndex)
+            {
+                results[expressionIndex].push_back(Sample{input, this->expressions[expressionIndex]->Evaluate(input)});
+            }
+        }
+
+        return results;
+    }
+
+    std::size_t FusedEvaluator::GetSharedCount() const
+    {
+        return this->sharedCount;
+    }
+
+    bool FusedEvaluator::Count(const std::shared_ptr<Expression> & expression) //NOLINT(misc-no-recursion)
+    {
+        // returns whether the expression depends on a parameter.
+        // The children of a repeated occurrence have been counted with the first one already
+        if (dynamic_cast<const Parameter*>(expression.get()) != nullptr)
+        {
+            return true;
+        }
+
+        auto * occurrence = FusedEvaluator::IsShareable(*expression) ? this->Find(*expression) : nullptr;
+        if (occurrence != nullptr)
+        {
+            ++occurrence->count;
+            return false;
+        }
+
+        bool dependsOnParameter = false;
+
+        if (const auto * function = dynamic_cast<const Function*>(expression.get()))
+        {
+            dependsOnParameter = this->Count(function->GetArgument());
+        }
+        else if (const auto * sum = dynamic_cast<const Sum*>(expression.get()))
+        {
+            for (const auto & summand : sum->GetSummands())
+            {
+                dependsOnParameter = this->Count(summand.expression) || dependsOnParameter;
+            }
+        }
+        else if (const auto * product = dynamic_cast<const Product*>(expression.get()))
+        {
+            for (const auto & factor : product->GetFactors())
+            {
+                dependsOnParameter = this->Count(factor.expression) || dependsOnParameter;
+            }
+        }
+        else if (const auto * power = dynamic_cast<const Power*>(expression.get()))
+        {
+            dependsOnParameter = this->Count(power->GetBase());
+            dependsOnParameter = this->Count(power->GetExponent()) || dependsOnParameter;
+        }
+
+        if (!dependsOnParameter && FusedEvaluator::IsShareable(*expression))
+        {
+            this->index.emplace(expression->GetHash(), this->occurrences.size());
+            this->occurrences.push_back(Occurrence{expression, 1, nullptr});
+        }
+
+        return dependsOnParameter;
+    }
+
+    std::shared_ptr<Expression> FusedEvaluator::Substitute(const std::shared_ptr<Expression> & expression) //NOLINT(misc-no-recursion)
+    {
+        auto * occurrence = FusedEvaluator::IsShareable(*expression) ? this->Find(*expression) : nullptr;
+        bool isShared = occurrence != nullptr && occurrence->count > 1;
+
+        if (isShared && occurrence->shared)
+        {
+            return occurrence->shared;
+        }
+
+        auto substituted = expression;
+
+        if (const auto * function = dynamic_cast<const Function*>(expression.get()))
+        {
+            auto argument = this->Substitute(function->GetArgument());
+
+            if (argument != function->GetArgument())
+            {
+                substituted = GetFunctionTableEntry(function->GetId()).create(argument);
+            }
+        }
+        else if (const auto * sum = dynamic_cast<const Sum*>(expression.get()))
+        {
+            std::vector<Sum::Summand> summands;
+            bool changed = false;
+
+            for (const auto & summand : sum->GetSummands())
+            {
+                summands.emplace_back(summand.sign, this->Substitute(summand.expression));
+                changed = changed || summands.back().expression != summand.expression;
+            }
+
+            if (changed)
+            {
+                substituted = std::make_shared<Sum>(summands);
+            }
+        }
+        else if (const auto * product = dynamic_cast<const Product*>(expression.get()))
+        {
+            std::vector<Product::Factor> factors;
+            bool changed = false;
+
+            for (const auto & factor : product->GetFactors())
+            {
+                factors.emplace_back(factor.exponent, this->Substitute(factor.expression));
+                changed = changed || factors.back().expression != factor.expression;
+            }
+
+            if (changed)
+            {
+                substituted = std::make_shared<Product>(factors);
+            }
+        }
+        else if (const auto * power = dynamic_cast<const Power*>(expression.get()))
+        {
+            auto base = this->Substitute(power->GetBase());
+            auto exponent = this->Substitute(power->GetExponent());
+
+            if (base != power->GetBase() || exponent != power->GetExponent())
+            {
+                substituted = std::make_shared<Power>(base, exponent);
+            }
+        }
+
+        if (!isShared)
+        {
+            return substituted;
+        }
+
+        occurrence->shared = std::make_shared<SharedSubexpression>(substituted, this->sharedCount);
+        ++this->sharedCount;
+
+        return occurrence->shared;
+    }
+
+    FusedEvaluator::Occurrence * FusedEvaluator::Find(const Expression & expression)
+    {
+        auto range = this->index.equal_range(expression.GetHash());
+
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            auto & occurrence = this->occurrences[it->second];
+
+            if (*(occurrence.representative) == expression)
+            {
+                return &occurrence;
+            }
+        }
+
+        return nullptr;
+    }
+
+    bool FusedEvaluator::IsShareable(const Expression & expression)
+    {
+        // leaves and constants are cheaper to evaluate than to look up
+        return dynamic_cast<const BaseZ*>(&expression) == nullptr
+                && dynamic_cast<const Constant*>(&expression) == nullptr
+                && !expression.IsConstant();
+    }
+
+}
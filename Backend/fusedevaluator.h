@@ -0,0 +1,103 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef FUSEDEVALUATOR_H
+#define FUSEDEVALUATOR_H
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "expression.h"
+#include "sample.h"
+
+namespace Backend {
+
+    class SharedSubexpression;
+
+    /*!
+     * \class FusedEvaluator
+     * \brief The FusedEvaluator class evaluates several expressions on the same points in a single pass.
+     *
+     * Subexpressions that are structurally equal, within an expression or across expressions,
+     * are evaluated once per point and shared. Subexpressions depending on a \ref Parameter are not shared.
+     * The results agree with \ref Expression::Evaluate up to rounding, as equality of sums and products
+     * does not depend on the order of their operands.
+     * The shared values are remembered per call and thread, such that an instance may be used
+     * from several threads at once.
+     */
+    class FusedEvaluator final
+    {
+    private:
+        struct Occurrence
+        {
+        public:
+            std::shared_ptr<Expression> representative;
+            std::size_t count;
+            std::shared_ptr<SharedSubexpression> shared;
+        };
+
+        std::vector<std::shared_ptr<Expression>> expressions;
+        std::vector<Occurrence> occurrences;
+        std::unordered_multimap<std::size_t, std::size_t> index;
+        std::size_t sharedCount;
+
+    public:
+        /*!
+         * \brief Initializes a new instance.
+         * \param expressions The expressions to evaluate.
+         */
+        explicit FusedEvaluator(const std::vector<std::shared_ptr<Expression>> & expressions);
+        ~FusedEvaluator() = default;
+        FusedEvaluator(const FusedEvaluator&) = delete;
+        FusedEvaluator(FusedEvaluator&&) = delete;
+        FusedEvaluator& operator=(const FusedEvaluator&) = delete;
+        FusedEvaluator& operator=(FusedEvaluator&&) = delete;
+
+        /*!
+         * \brief Evaluate evaluates all expressions at a point.
+         * \param input The point to evaluate at.
+         * \return The results in the order of the expressions, nothing where undefined.
+         */
+        [[nodiscard]] std::vector<std::optional<complex>> Evaluate(complex input) const;
+
+        /*!
+         * \brief EvaluateAll evaluates all expressions on the points, reading each point once.
+         * \param grid The points to evaluate at.
+         * \return Per expression, the samples in the order of the points.
+         */
+        [[nodiscard]] std::vector<std::vector<Sample>> EvaluateAll(const std::vector<complex> & grid) const;
+
+        /*!
+         * \brief GetSharedCount gets the number of distinct subexpressions evaluated once for several occurrences.
+         * \return The number of subexpressions.
+         */
+        [[nodiscard]] std::size_t GetSharedCount() const;
+
+    private:
+        bool Count(const std::shared_ptr<Expression> & expression);
+        [[nodiscard]] std::shared_ptr<Expression> Substitute(const std::shared_ptr<Expression> & expression);
+        [[nodiscard]] Occurrence * Find(const Expression & expression);
+        [[nodiscard]] static bool IsShareable(const Expression & expression);
+    };
+
+}
+
+#endif // FUSEDEVALUATOR_H
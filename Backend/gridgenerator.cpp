@@ -20,27 +20,89 @@
 #include <math.h>
 #undef _USE_MATH_DEFINES
 
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+
 #include "gridgenerator.h"
+#include "complexinterval.h"
+#include "tracer.h"
 
 namespace Backend {
 
+    bool GridSpecification::operator==(const GridSpecification &other) const
+    {
+        return this->type == other.type
+                && this->distLike == other.distLike
+                && this->angle == other.angle
+                && this->variation == other.variation
+                && this->depth == other.depth;
+    }
+
+    bool GridSpecification::operator!=(const GridSpecification &other) const
+    {
+        return !(*this == other);
+    }
+
+    std::size_t GridSpecification::GetHash() const
+    {
+        auto hash = std::hash<int>{}(static_cast<int>(this->type));
+        hash = HashCombine(hash, std::hash<double>{}(this->distLike));
+        hash = HashCombine(hash, std::hash<double>{}(this->angle));
+        hash = HashCombine(hash, std::hash<double>{}(this->variation));
+        return HashCombine(hash, std::hash<int>{}(this->depth));
+    }
+
     GridGenerator::GridGenerator(double maxX, double maxY)
-        : maxX(maxX), maxY(maxY)
+        : GridGenerator(-maxX, maxX, -maxY, maxY)
     {
     }
 
+    GridGenerator::GridGenerator(double minX, double maxX, double minY, double maxY)
+        : minX(minX), maxX(maxX), minY(minY), maxY(maxY)
+    {
+    }
+
+    std::vector<complex> GridGenerator::Create(const GridSpecification & specification, const std::shared_ptr<Expression> & expression)
+    {
+        TraceSpan span(u8"grid", u8"GridGenerator::Create");
+
+        switch (specification.type)
+        {
+        case GridSpecification::Type::Square:
+            return this->CreateSquare(specification.distLike);
+
+        case GridSpecification::Type::AngularFromConstantAngle:
+            return this->CreateAngularFromConstantAngle(specification.distLike, specification.angle);
+
+        case GridSpecification::Type::AngularFromApproximateDistance:
+            return this->CreateAngularFromApproximateDistance(specification.distLike);
+
+        case GridSpecification::Type::Adaptive:
+            return this->CreateAdaptive(specification.distLike, expression, specification.variation, specification.depth);
+
+        default:
+            throw std::logic_error(u8"programming mistake in GridGenerator switch");
+        }
+    }
+
     std::vector<complex> GridGenerator::CreateSquare(double dist)
     {
+        TraceSpan span(u8"grid", u8"GridGenerator::CreateSquare");
+
         using namespace std::complex_literals;
 
         std::vector<complex> list;
 
-        int xCount = static_cast<int>(this->maxX / dist);
-        int yCount = static_cast<int>(this->maxY / dist);
+        auto xFirst = static_cast<long long>(std::ceil(this->minX / dist));
+        auto xLast = static_cast<long long>(std::floor(this->maxX / dist));
+        auto yFirst = static_cast<long long>(std::ceil(this->minY / dist));
+        auto yLast = static_cast<long long>(std::floor(this->maxY / dist));
 
-        for(int x = -xCount; x <= xCount; ++x)
+        for(long long x = xFirst; x <= xLast; ++x)
         {
-            for(int y = -yCount; y <= yCount; ++y)
+            for(long long y = yFirst; y <= yLast; ++y)
             {
                 list.emplace_back(static_cast<double>(x) * complex(dist) + static_cast<double>(y) * dist * complex(1.0i));
             }
@@ -51,13 +113,18 @@ namespace Backend {
 
     std::vector<complex> GridGenerator::CreateAngularFromConstantAngle(double radial, double angle)
     {
+        TraceSpan span(u8"grid", u8"GridGenerator::CreateAngularFromConstantAngle");
+
         using namespace std::complex_literals;
 
         std::vector<complex> list;
 
-        list.emplace_back(complex(0.0));
+        if (this->Contains(complex(0.0)))
+        {
+            list.emplace_back(complex(0.0));
+        }
 
-        auto rCount = static_cast<int>(std::sqrt(this->maxX * this->maxX + this->maxY * this->maxY) / radial);
+        auto rCount = static_cast<int>(this->GetMaximumRadius() / radial);
 
         for (int r = 1; r <= rCount; ++r)
         {
@@ -70,13 +137,18 @@ namespace Backend {
 
     std::vector<complex> GridGenerator::CreateAngularFromApproximateDistance(double dist)
     {
+        TraceSpan span(u8"grid", u8"GridGenerator::CreateAngularFromApproximateDistance");
+
         using namespace std::complex_literals;
 
         std::vector<complex> list;
 
-        list.emplace_back(complex(0.0));
+        if (this->Contains(complex(0.0)))
+        {
+            list.emplace_back(complex(0.0));
+        }
 
-        auto rCount = static_cast<int>(std::sqrt(this->maxX * this->maxX + this->maxY * this->maxY) / dist);
+        auto rCount = static_cast<int>(this->GetMaximumRadius() / dist);
 
         for (int r = 1; r <= rCount; ++r)
         {
@@ -91,6 +163,141 @@ namespace Backend {
         return list;
     }
 
+    std::vector<complex> GridGenerator::CreateAdaptive(double dist, const std::shared_ptr<Expression> & expression, double variation, int depth)
+    {
+        auto samples = this->CreateAdaptiveSamples(dist, expression, variation, depth);
+
+        std::vector<complex> list;
+        list.reserve(samples.size());
+
+        for (const auto & sample : samples)
+        {
+            list.push_back(sample.input);
+        }
+
+        return list;
+    }
+
+    std::vector<Sample> GridGenerator::CreateAdaptiveSamples(double dist, const std::shared_ptr<Expression> & expression, double variation, int depth)
+    {
+        TraceSpan span(u8"grid", u8"GridGenerator::CreateAdaptive");
+
+        // all points live on a lattice with the finest spacing, such that shared corners are evaluated once
+        const long long cellSize = 1LL << depth;
+        const double unit = dist / static_cast<double>(cellSize);
+
+        auto xFirst = static_cast<long long>(std::ceil(this->minX / dist));
+        auto xLast = static_cast<long long>(std::floor(this->maxX / dist));
+        auto yFirst = static_cast<long long>(std::ceil(this->minY / dist));
+        auto yLast = static_cast<long long>(std::floor(this->maxY / dist));
+
+        LatticeValues values;
+
+        if (xFirst == xLast || yFirst == yLast)
+        {
+            for(long long x = xFirst; x <= xLast; ++x)
+            {
+                for(long long y = yFirst; y <= yLast; ++y)
+                {
+                    auto input = complex(static_cast<double>(x * cellSize) * unit, static_cast<double>(y * cellSize) * unit);
+                    values.emplace(LatticePoint(x * cellSize, y * cellSize), expression->Evaluate(input));
+                }
+            }
+        }
+
+        for(long long x = xFirst; x < xLast; ++x)
+        {
+            for(long long y = yFirst; y < yLast; ++y)
+            {
+                this->RefineCell(*expression, values, unit, LatticePoint(x * cellSize, y * cellSize), cellSize, variation);
+            }
+        }
+
+        std::vector<Sample> samples;
+        samples.reserve(values.size());
+
+        for (const auto & value : values)
+        {
+            samples.push_back(Sample{complex(static_cast<double>(value.first.first) * unit, static_cast<double>(value.first.second) * unit), value.second});
+        }
+
+        return samples;
+    }
+
+    void GridGenerator::RefineCell(const Expression & expression, LatticeValues & values, double unit, LatticePoint corner, long long size, double variation) //NOLINT(misc-no-recursion)
+    {
+        const LatticePoint corners[] = {
+            corner,
+            LatticePoint(corner.first + size, corner.second),
+            LatticePoint(corner.first + size, corner.second + size),
+            LatticePoint(corner.first, corner.second + size)
+        };
+
+        std::optional<complex> results[4];
+
+        for (int index = 0; index < 4; ++index)
+        {
+            auto it = values.find(corners[index]);
+            if (it == values.end())
+            {
+                auto input = complex(static_cast<double>(corners[index].first) * unit, static_cast<double>(corners[index].second) * unit);
+                it = values.emplace(corners[index], expression.Evaluate(input)).first;
+            }
+
+            results[index] = it->second;
+        }
+
+        if (size == 1)
+        {
+            return;
+        }
+
+        auto definedCount = std::count_if(std::begin(results), std::end(results), [](const auto & result){ return result.has_value(); });
+
+        bool refine = definedCount != 0 && definedCount != 4;
+
+        // bounds over the whole cell reveal singularities between well-behaved corners
+        // and cells whose image is out of sight, which gain nothing from variation-driven refinement
+        auto image = expression.EvaluateInterval(ComplexInterval(static_cast<double>(corner.first) * unit,
+                                                                 static_cast<double>(corner.first + size) * unit,
+                                                                 static_cast<double>(corner.second) * unit,
+                                                                 static_cast<double>(corner.second + size) * unit));
+
+        refine = refine || (definedCount != 0 && image.MayBeSingular());
+
+        bool visible = image.Intersects(this->minX, this->maxX, this->minY, this->maxY);
+
+        for (int index = 0; index < 4 && !refine && visible && definedCount == 4; ++index)
+        {
+            refine = std::abs(results[index].value() - results[(index + 1) % 4].value()) > variation;
+        }
+
+        if (!refine)
+        {
+            return;
+        }
+
+        auto half = size / 2;
+
+        this->RefineCell(expression, values, unit, corner, half, variation);
+        this->RefineCell(expression, values, unit, LatticePoint(corner.first + half, corner.second), half, variation);
+        this->RefineCell(expression, values, unit, LatticePoint(corner.first, corner.second + half), half, variation);
+        this->RefineCell(expression, values, unit, LatticePoint(corner.first + half, corner.second + half), half, variation);
+    }
+
+    GridSpecification GridGenerator::Limit(const GridSpecification & specification, double maxCount) const
+    {
+        // doubling keeps the coarser square grid a subset of the finer one
+        auto limited = specification;
+
+        while (limited.distLike > 0.0 && this->GetCount(limited) > std::max(maxCount, 1.0))
+        {
+            limited.distLike *= 2.0;
+        }
+
+        return limited;
+    }
+
     std::vector<complex> GridGenerator::CreatePointsOnCircle(double radius, double angle)
     {
         using namespace std::complex_literals;
@@ -103,7 +310,7 @@ namespace Backend {
         {
             auto z = std::polar(radius, t * angle / 180.0 * M_PI);
 
-            if(std::abs(z.real()) <= this->maxX && std::abs(z.imag()) <= this->maxY)
+            if(this->Contains(z))
             {
                 list.push_back(z);
             }
@@ -112,4 +319,49 @@ namespace Backend {
         return list;
     }
 
+    double GridGenerator::GetMaximumRadius() const
+    {
+        auto x = std::max(std::abs(this->minX), std::abs(this->maxX));
+        auto y = std::max(std::abs(this->minY), std::abs(this->maxY));
+
+        return std::sqrt(x * x + y * y);
+    }
+
+    double GridGenerator::GetCount(const GridSpecification & specification) const
+    {
+        auto rCount = std::floor(this->GetMaximumRadius() / specification.distLike);
+
+        switch (specification.type)
+        {
+        case GridSpecification::Type::Square:
+            return this->GetSquareCount(specification.distLike);
+
+        case GridSpecification::Type::AngularFromConstantAngle:
+            return 1.0 + rCount * std::floor(360.0 / specification.angle);
+
+        case GridSpecification::Type::AngularFromApproximateDistance:
+            // the r-th circle has at most 2 pi r points, since asin(x) >= x
+            return 1.0 + M_PI * rCount * (rCount + 1.0);
+
+        case GridSpecification::Type::Adaptive:
+            return this->GetSquareCount(std::ldexp(specification.distLike, -specification.depth));
+
+        default:
+            throw std::logic_error(u8"programming mistake in GridGenerator switch");
+        }
+    }
+
+    double GridGenerator::GetSquareCount(double dist) const
+    {
+        auto xCount = std::floor(this->maxX / dist) - std::ceil(this->minX / dist) + 1.0;
+        auto yCount = std::floor(this->maxY / dist) - std::ceil(this->minY / dist) + 1.0;
+
+        return std::max(xCount, 0.0) * std::max(yCount, 0.0);
+    }
+
+    bool GridGenerator::Contains(complex z) const
+    {
+        return this->minX <= z.real() && z.real() <= this->maxX && this->minY <= z.imag() && z.imag() <= this->maxY;
+    }
+
 }
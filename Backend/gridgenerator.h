@@ -16,15 +16,67 @@
  *
  */
 
+#include <map>
+#include <memory>
+#include <optional>
+#include <utility>
 #include <vector>
 
 #include "expression.h"
+#include "sample.h"
 
 #ifndef GRIDGENERATOR_H
 #define GRIDGENERATOR_H
 
 namespace Backend {
 
+    /*!
+     * \struct GridSpecification
+     * \brief The GridSpecification struct collects the parameters describing a grid,
+     *        independent of the area it is created for.
+     */
+    struct GridSpecification
+    {
+    public:
+        /*!
+         * \enum Type
+         * \brief The Type enum represents the kinds of grids provided by the \ref GridGenerator.
+         */
+        enum class Type
+        {
+            Square,
+            AngularFromConstantAngle,
+            AngularFromApproximateDistance,
+            Adaptive,
+        };
+
+        Type type;
+        double distLike;
+        double angle;
+        double variation;
+        int depth;
+
+        /*!
+         * \brief Equality operator for the specification, checking all parameters.
+         * \param other The instance to compare to.
+         * \return A value indicating equality.
+         */
+        bool operator==(const GridSpecification &other) const;
+
+        /*!
+         * \brief Inequality operator for the specification, checking all parameters.
+         * \param other The instance to compare to.
+         * \return A value indicating inequality.
+         */
+        bool operator!=(const GridSpecification &other) const;
+
+        /*!
+         * \brief Gets a hash of the parameters.
+         * \return The hash.
+         */
+        [[nodiscard]] std::size_t GetHash() const;
+    };
+
     /*!
      * \brief The GridGenerator class provides the generation of grids of
      *        regularly spaced input values
@@ -32,7 +84,9 @@ namespace Backend {
     class GridGenerator
     {
     private:
+        const double minX;
         const double maxX;
+        const double minY;
         const double maxY;
 
     public:
@@ -43,10 +97,29 @@ namespace Backend {
          */
         GridGenerator(double maxX, double maxY);
 
+        /*!
+         * \brief GridGenerator
+         * \param minX The minimum value in real/x-direction.
+         * \param maxX The maximum value in real/x-direction.
+         * \param minY The minimum value in imaginary/y-direction.
+         * \param maxY The maximum value in imaginary/y-direction.
+         */
+        GridGenerator(double minX, double maxX, double minY, double maxY);
+
+        /*!
+         * \brief Create creates the grid described by the specification.
+         * \param specification The description of the grid.
+         * \param expression The expression used by grids depending on the function, may be null otherwise.
+         * \return A list of values constituting the grid.
+         */
+        [[nodiscard]] std::vector<complex> Create(const GridSpecification & specification, const std::shared_ptr<Expression> & expression);
+
         /*!
          * \brief CreateRectangular creates a square grid
          *        defined by the point-to-point distance
          *        and aligned with the axis.
+         *        The points are multiples of the distance, such that grids for
+         *        overlapping areas share their points.
          * \param dist The point-to-point distance.
          * \return A list of values constituting the square grid.
          */
@@ -75,8 +148,55 @@ namespace Backend {
          */
         [[nodiscard]] std::vector<complex> CreateAngularFromApproximateDistance(double dist);
 
+        /*!
+         * \brief CreateAdaptive creates a square grid that is refined where the
+         *        supplied expression varies strongly.
+         *        It starts from the grid created by \ref CreateSquare and recursively
+         *        subdivides cells whose corners differ by more than the variation
+         *        threshold in output, or which have both defined and undefined corners.
+         *        Cells which may contain a singularity according to interval evaluation
+         *        are refined as well, cells whose image lies outside of the area are not
+         *        refined for variation.
+         * \param dist The point-to-point distance of the coarse grid.
+         * \param expression The expression determining the refinement.
+         * \param variation The maximum tolerated absolute output difference between corners of a cell.
+         * \param depth The maximum number of subdivisions of a coarse cell.
+         * \return A list of values constituting the adaptive grid.
+         */
+        [[nodiscard]] std::vector<complex> CreateAdaptive(double dist, const std::shared_ptr<Expression> & expression, double variation, int depth);
+
+        /*!
+         * \brief CreateAdaptiveSamples creates the grid like \ref CreateAdaptive,
+         *        keeping the outputs evaluated for the refinement, such that they need not be evaluated again.
+         * \param dist The point-to-point distance of the coarse grid.
+         * \param expression The expression determining the refinement.
+         * \param variation The maximum tolerated absolute output difference between corners of a cell.
+         * \param depth The maximum number of subdivisions of a coarse cell.
+         * \return A list of samples constituting the adaptive grid.
+         */
+        [[nodiscard]] std::vector<Sample> CreateAdaptiveSamples(double dist, const std::shared_ptr<Expression> & expression, double variation, int depth);
+
+        /*!
+         * \brief Limit doubles the distance of the specification until creating its grid
+         *        considers at most the given number of points.
+         *        Angular grids consider every point on their circles, also outside of the area,
+         *        adaptive grids are bounded by their finest lattice.
+         * \param specification The description of the grid.
+         * \param maxCount The maximum number of points.
+         * \return The specification with a possibly larger distance.
+         */
+        [[nodiscard]] GridSpecification Limit(const GridSpecification & specification, double maxCount) const;
+
     private:
+        using LatticePoint = std::pair<long long, long long>;
+        using LatticeValues = std::map<LatticePoint, std::optional<complex>>;
+
         [[nodiscard]] std::vector<complex> CreatePointsOnCircle(double radius, double angle);
+        [[nodiscard]] double GetMaximumRadius() const;
+        [[nodiscard]] double GetCount(const GridSpecification & specification) const;
+        [[nodiscard]] double GetSquareCount(double dist) const;
+        [[nodiscard]] bool Contains(complex z) const;
+        void RefineCell(const Expression & expression, LatticeValues & values, double unit, LatticePoint corner, long long size, double variation);
     };
 
 }
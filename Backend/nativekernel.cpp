@@ -0,0 +1,507 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "nativekernel.h"
+
+#if (defined(__x86_64__) || defined(_M_X64)) && (defined(__linux__) || defined(__APPLE__) || defined(_WIN32))
+#define NATIVE_KERNEL_X86_64
+#endif
+
+#if defined(NATIVE_KERNEL_X86_64) && defined(_WIN32)
+#include <windows.h>
+#elif defined(NATIVE_KERNEL_X86_64)
+#include <sys/mman.h>
+#endif
+
+namespace Backend {
+
+#ifdef NATIVE_KERNEL_X86_64
+
+    namespace {
+
+        /*!
+         * \brief The Gpr enum numbers the general purpose registers as encoded in instructions.
+         */
+        enum Gpr : std::uint8_t
+        {
+            Rax = 0, Rcx = 1, Rdx = 2, Rbx = 3, Rsp = 4, Rbp = 5, Rsi = 6, Rdi = 7,
+            R8 = 8, R12 = 12, R13 = 13, R14 = 14, R15 = 15,
+        };
+
+#ifdef _WIN32
+        const Gpr FirstArgument = Rcx;
+        const Gpr SecondArgument = Rdx;
+        const Gpr ThirdArgument = R8;
+        // shadow space for the callee, plus keeping the stack aligned to 16 bytes
+        const std::uint8_t StackReserve = 40;
+#else
+        const Gpr FirstArgument = Rdi;
+        const Gpr SecondArgument = Rsi;
+        const Gpr ThirdArgument = Rdx;
+        const std::uint8_t StackReserve = 8;
+#endif
+
+        /*!
+         * \class Emitter
+         * \brief The Emitter class appends encoded x86-64 instructions to a buffer.
+         *
+         * Only the few forms needed by \ref NativeKernel are supported. Memory operands
+         * are always [base + disp32]. Only xmm0 to xmm4 are used, which need no REX prefix
+         * and are volatile in both calling conventions. On Win64 only xmm0 to xmm5 are volatile,
+         * xmm6 and above are callee-saved and must not be touched without saving them.
+         */
+        class Emitter final
+        {
+        public:
+            std::vector<std::uint8_t> code;
+
+            void Byte(std::uint8_t value)
+            {
+                this->code.push_back(value);
+            }
+
+            void Int32(std::int32_t value)
+            {
+                auto bits = static_cast<std::uint32_t>(value);
+
+                for (int shift = 0; shift < 32; shift += 8)
+                {
+                    this->Byte(static_cast<std::uint8_t>(bits >> static_cast<unsigned>(shift)));
+                }
+            }
+
+            void Int64(std::uint64_t value)
+            {
+                for (int shift = 0; shift < 64; shift += 8)
+                {
+                    this->Byte(static_cast<std::uint8_t>(value >> static_cast<unsigned>(shift)));
+                }
+            }
+
+            void Rex(bool wide, unsigned reg, unsigned base)
+            {
+                auto rex = static_cast<std::uint8_t>(0x40U | (wide ? 0x08U : 0U) | ((reg >> 3U) << 2U) | (base >> 3U));
+
+                if (rex != 0x40U)
+                {
+                    this->Byte(rex);
+                }
+            }
+
+            void Memory(unsigned reg, unsigned base, std::int32_t displacement)
+            {
+                this->Byte(static_cast<std::uint8_t>(0x80U | ((reg & 7U) << 3U) | (base & 7U)));
+
+                // rsp and r12 as base need a SIB byte
+                if ((base & 7U) == Rsp)
+                {
+                    this->Byte(0x24);
+                }
+
+                this->Int32(displacement);
+            }
+
+            void Direct(unsigned reg, unsigned rm)
+            {
+                this->Byte(static_cast<std::uint8_t>(0xC0U | ((reg & 7U) << 3U) | (rm & 7U)));
+            }
+
+            void Push(Gpr reg)
+            {
+                this->Rex(false, 0, reg);
+                this->Byte(static_cast<std::uint8_t>(0x50U + (reg & 7U)));
+            }
+
+            void Pop(Gpr reg)
+            {
+                this->Rex(false, 0, reg);
+                this->Byte(static_cast<std::uint8_t>(0x58U + (reg & 7U)));
+            }
+
+            void Load(Gpr destination, Gpr base, std::int32_t displacement)
+            {
+                this->Rex(true, destination, base);
+                this->Byte(0x8B);
+                this->Memory(destination, base, displacement);
+            }
+
+            void Move(Gpr destination, Gpr source)
+            {
+                this->Rex(true, source, destination);
+                this->Byte(0x89);
+                this->Direct(source, destination);
+            }
+
+            void MoveImmediate(Gpr destination, std::uint64_t value)
+            {
+                this->Rex(true, 0, destination);
+                this->Byte(static_cast<std::uint8_t>(0xB8U + (destination & 7U)));
+                this->Int64(value);
+            }
+
+            void LoadAddress(Gpr destination, Gpr base, std::int32_t displacement)
+            {
+                this->Rex(true, destination, base);
+                this->Byte(0x8D);
+                this->Memory(destination, base, displacement);
+            }
+
+            void Test(Gpr reg)
+            {
+                this->Rex(true, reg, reg);
+                this->Byte(0x85);
+                this->Direct(reg, reg);
+            }
+
+            void AddImmediate(Gpr reg, std::uint8_t value)
+            {
+                this->Rex(true, 0, reg);
+                this->Byte(0x83);
+                this->Direct(0, reg);
+                this->Byte(value);
+            }
+
+            void SubtractImmediate(Gpr reg, std::uint8_t value)
+            {
+                this->Rex(true, 0, reg);
+                this->Byte(0x83);
+                this->Direct(5, reg);
+                this->Byte(value);
+            }
+
+            void Increment(Gpr reg)
+            {
+                this->Rex(true, 0, reg);
+                this->Byte(0xFF);
+                this->Direct(0, reg);
+            }
+
+            void Decrement(Gpr reg)
+            {
+                this->Rex(true, 0, reg);
+                this->Byte(0xFF);
+                this->Direct(1, reg);
+            }
+
+            void StoreByteImmediate(Gpr base, std::int32_t displacement, std::uint8_t value)
+            {
+                this->Rex(false, 0, base);
+                this->Byte(0xC6);
+                this->Memory(0, base, displacement);
+                this->Byte(value);
+            }
+
+            void LoadByte(Gpr base, std::int32_t displacement)
+            {
+                // into al
+                this->Rex(false, 0, base);
+                this->Byte(0x8A);
+                this->Memory(Rax, base, displacement);
+            }
+
+            void StoreByte(Gpr base, std::int32_t displacement)
+            {
+                // from al
+                this->Rex(false, 0, base);
+                this->Byte(0x88);
+                this->Memory(Rax, base, displacement);
+            }
+
+            void CallRax()
+            {
+                this->Byte(0xFF);
+                this->Byte(0xD0);
+            }
+
+            void Return()
+            {
+                this->Byte(0xC3);
+            }
+
+            std::size_t JumpIfZero()
+            {
+                this->Byte(0x0F);
+                this->Byte(0x84);
+                this->Int32(0);
+                return this->code.size();
+            }
+
+            void Jump(std::size_t target)
+            {
+                this->Byte(0xE9);
+                this->Int32(static_cast<std::int32_t>(static_cast<std::ptrdiff_t>(target) - static_cast<std::ptrdiff_t>(this->code.size() + 4)));
+            }
+
+            void Patch(std::size_t jumpEnd, std::size_t target)
+            {
+                auto offset = static_cast<std::uint32_t>(static_cast<std::int32_t>(static_cast<std::ptrdiff_t>(target) - static_cast<std::ptrdiff_t>(jumpEnd)));
+
+                for (std::size_t index = 0; index < 4; ++index)
+                {
+                    this->code[jumpEnd - 4 + index] = static_cast<std::uint8_t>(offset >> (8U * index));
+                }
+            }
+
+            void PackedLoad(unsigned xmm, Gpr base, std::int32_t displacement)
+            {
+                // movupd xmm, [base + displacement]
+                this->Byte(0x66);
+                this->Rex(false, xmm, base);
+                this->Byte(0x0F);
+                this->Byte(0x10);
+                this->Memory(xmm, base, displacement);
+            }
+
+            void PackedStore(Gpr base, std::int32_t displacement, unsigned xmm)
+            {
+                // movupd [base + displacement], xmm
+                this->Byte(0x66);
+                this->Rex(false, xmm, base);
+                this->Byte(0x0F);
+                this->Byte(0x11);
+                this->Memory(xmm, base, displacement);
+            }
+
+            void Packed(std::uint8_t opCode, unsigned destination, unsigned source)
+            {
+                // addpd 0x58, mulpd 0x59, subpd 0x5C, xorpd 0x57, movapd 0x28, unpcklpd 0x14, unpckhpd 0x15
+                this->Byte(0x66);
+                this->Byte(0x0F);
+                this->Byte(opCode);
+                this->Direct(destination, source);
+            }
+
+            void Shuffle(unsigned destination, unsigned source, std::uint8_t selector)
+            {
+                // shufpd
+                this->Packed(0xC6, destination, source);
+                this->Byte(selector);
+            }
+        };
+
+        const std::uint8_t MovApd = 0x28;
+        const std::uint8_t UnpckLpd = 0x14;
+        const std::uint8_t UnpckHpd = 0x15;
+        const std::uint8_t XorPd = 0x57;
+        const std::uint8_t AddPd = 0x58;
+        const std::uint8_t MulPd = 0x59;
+        const std::uint8_t SubPd = 0x5C;
+
+        std::int32_t RegisterOffset(std::size_t index)
+        {
+            return static_cast<std::int32_t>(index * sizeof(complex));
+        }
+
+        std::int32_t ContextOffset(std::size_t offset)
+        {
+            return static_cast<std::int32_t>(offset);
+        }
+
+    }
+
+    NativeKernel::NativeKernel(void * memory, std::size_t size)
+        : memory(memory),
+          size(size),
+          entry(reinterpret_cast<void (*)(NativeContext *)>(memory)) //NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    {
+    }
+
+    NativeKernel::~NativeKernel()
+    {
+#ifdef _WIN32
+        VirtualFree(this->memory, 0, MEM_RELEASE);
+#else
+        munmap(this->memory, this->size);
+#endif
+    }
+
+    bool NativeKernel::IsAvailable()
+    {
+        return true;
+    }
+
+    std::unique_ptr<NativeKernel> NativeKernel::Create(const std::vector<CompiledExpression::Instruction> & program, std::size_t result)
+    {
+        using OpCode = CompiledExpression::OpCode;
+
+        Emitter emitter;
+
+        // rbx: context, r12: input, r13: output, r14: remaining count, r15: registers, rbp: undefined flags
+        emitter.Push(Rbx);
+        emitter.Push(Rbp);
+        emitter.Push(R12);
+        emitter.Push(R13);
+        emitter.Push(R14);
+        emitter.Push(R15);
+        emitter.SubtractImmediate(Rsp, StackReserve);
+
+        emitter.Move(Rbx, FirstArgument);
+        emitter.Load(R12, Rbx, ContextOffset(offsetof(NativeContext, inputs)));
+        emitter.Load(R13, Rbx, ContextOffset(offsetof(NativeContext, outputs)));
+        emitter.Load(Rbp, Rbx, ContextOffset(offsetof(NativeContext, undefined)));
+        emitter.Load(R14, Rbx, ContextOffset(offsetof(NativeContext, count)));
+        emitter.Load(R15, Rbx, ContextOffset(offsetof(NativeContext, registers)));
+
+        auto loop = emitter.code.size();
+        emitter.Test(R14);
+        auto exit = emitter.JumpIfZero();
+
+        emitter.StoreByteImmediate(Rbx, ContextOffset(offsetof(NativeContext, flag)), 0);
+        emitter.PackedLoad(0, R12, 0);
+        emitter.PackedStore(R15, RegisterOffset(0), 0);
+
+        for (const auto & instruction : program)
+        {
+            switch (instruction.opCode)
+            {
+            case OpCode::Constant:
+                // filled before the run
+                break;
+            case OpCode::Add:
+            case OpCode::Subtract:
+                emitter.PackedLoad(0, R15, RegisterOffset(instruction.left));
+                emitter.PackedLoad(1, R15, RegisterOffset(instruction.right));
+                emitter.Packed(instruction.opCode == OpCode::Add ? AddPd : SubPd, 0, 1);
+                emitter.PackedStore(R15, RegisterOffset(instruction.destination), 0);
+                break;
+            case OpCode::Multiply:
+                // (a + bi)(c + di) = (ac - bd) + (ad + bc)i, in the order of operations of std::complex
+                emitter.PackedLoad(0, R15, RegisterOffset(instruction.left));
+                emitter.PackedLoad(1, R15, RegisterOffset(instruction.right));
+                emitter.Packed(MovApd, 2, 0);
+                emitter.Packed(UnpckLpd, 2, 2);
+                emitter.Packed(UnpckHpd, 0, 0);
+                emitter.Packed(MulPd, 2, 1);
+                emitter.Packed(MovApd, 3, 1);
+                emitter.Shuffle(3, 3, 1);
+                emitter.Packed(MulPd, 0, 3);
+                emitter.PackedLoad(4, Rbx, ContextOffset(offsetof(NativeContext, lowNegation)));
+                emitter.Packed(XorPd, 0, 4);
+                emitter.Packed(AddPd, 2, 0);
+                emitter.PackedStore(R15, RegisterOffset(instruction.destination), 2);
+                break;
+            case OpCode::Divide:
+            case OpCode::Power:
+            case OpCode::Function:
+            case OpCode::Node:
+                emitter.MoveImmediate(FirstArgument, reinterpret_cast<std::uint64_t>(&instruction)); //NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+                emitter.Move(SecondArgument, R15);
+                emitter.LoadAddress(ThirdArgument, Rbx, ContextOffset(offsetof(NativeContext, flag)));
+                emitter.MoveImmediate(Rax, reinterpret_cast<std::uint64_t>(&CompiledExpression::Execute)); //NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+                emitter.CallRax();
+                break;
+            }
+        }
+
+        emitter.PackedLoad(0, R15, RegisterOffset(result));
+        emitter.PackedStore(R13, 0, 0);
+        emitter.LoadByte(Rbx, ContextOffset(offsetof(NativeContext, flag)));
+        emitter.StoreByte(Rbp, 0);
+
+        emitter.AddImmediate(R12, sizeof(complex));
+        emitter.AddImmediate(R13, sizeof(complex));
+        emitter.Increment(Rbp);
+        emitter.Decrement(R14);
+        emitter.Jump(loop);
+
+        emitter.Patch(exit, emitter.code.size());
+        emitter.AddImmediate(Rsp, StackReserve);
+        emitter.Pop(R15);
+        emitter.Pop(R14);
+        emitter.Pop(R13);
+        emitter.Pop(R12);
+        emitter.Pop(Rbp);
+        emitter.Pop(Rbx);
+        emitter.Return();
+
+        // the code is written first and made executable afterwards, never both at once
+        auto size = emitter.code.size();
+
+#ifdef _WIN32
+        void * memory = VirtualAlloc(nullptr, size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+        if (memory == nullptr)
+        {
+            return nullptr;
+        }
+
+        std::memcpy(memory, emitter.code.data(), size);
+
+        DWORD oldProtection = 0;
+        if (VirtualProtect(memory, size, PAGE_EXECUTE_READ, &oldProtection) == 0)
+        {
+            VirtualFree(memory, 0, MEM_RELEASE);
+            return nullptr;
+        }
+
+        FlushInstructionCache(GetCurrentProcess(), memory, size);
+#else
+        void * memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0); //NOLINT(hicpp-signed-bitwise)
+        if (memory == MAP_FAILED) //NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+        {
+            return nullptr;
+        }
+
+        std::memcpy(memory, emitter.code.data(), size);
+
+        if (mprotect(memory, size, PROT_READ | PROT_EXEC) != 0) //NOLINT(hicpp-signed-bitwise)
+        {
+            munmap(memory, size);
+            return nullptr;
+        }
+#endif
+
+        return std::unique_ptr<NativeKernel>(new NativeKernel(memory, size));
+    }
+
+    void NativeKernel::Run(NativeContext & context) const
+    {
+        this->entry(&context);
+    }
+
+#else
+
+    NativeKernel::NativeKernel(void * memory, std::size_t size)
+        : memory(memory),
+          size(size),
+          entry(nullptr)
+    {
+    }
+
+    NativeKernel::~NativeKernel() = default;
+
+    bool NativeKernel::IsAvailable()
+    {
+        return false;
+    }
+
+    std::unique_ptr<NativeKernel> NativeKernel::Create(const std::vector<CompiledExpression::Instruction> &, std::size_t) //NOLINT(misc-unused-parameter, hicpp-named-parameter, readability-named-parameter)
+    {
+        return nullptr;
+    }
+
+    void NativeKernel::Run(NativeContext &) const //NOLINT(misc-unused-parameter, hicpp-named-parameter, readability-named-parameter)
+    {
+    }
+
+#endif
+
+}
@@ -0,0 +1,95 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef NATIVEKERNEL_H
+#define NATIVEKERNEL_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "compiledexpression.h"
+#include "expression.h"
+
+namespace Backend {
+
+    /*!
+     * \struct NativeContext
+     * \brief The NativeContext struct passes the data of a run to the native code.
+     */
+    struct NativeContext
+    {
+    public:
+        const complex * inputs;
+        complex * outputs;
+        unsigned char * undefined;
+        std::size_t count;
+        complex * registers;
+        double lowNegation[2];
+        unsigned char flag;
+    };
+
+    /*!
+     * \class NativeKernel
+     * \brief The NativeKernel class holds x86-64 machine code executing a straight-line program
+     *        of a \ref CompiledExpression point by point.
+     *
+     * Additions, subtractions and multiplications use SSE2 on the registers in memory,
+     * every other instruction calls \ref CompiledExpression::Execute.
+     * Constant registers are expected to be filled before the run.
+     */
+    class NativeKernel final
+    {
+    private:
+        void * memory;
+        std::size_t size;
+        void (*entry)(NativeContext *);
+
+        NativeKernel(void * memory, std::size_t size);
+
+    public:
+        ~NativeKernel();
+        NativeKernel(const NativeKernel&) = delete;
+        NativeKernel(NativeKernel&&) = delete;
+        NativeKernel& operator=(const NativeKernel&) = delete;
+        NativeKernel& operator=(NativeKernel&&) = delete;
+
+        /*!
+         * \brief IsAvailable indicates whether native code can be generated on this platform.
+         * \return true on x86-64 with Linux, Windows or macOS, false otherwise.
+         */
+        [[nodiscard]] static bool IsAvailable();
+
+        /*!
+         * \brief Create translates the program into machine code.
+         * \param program The instructions of the program.
+         * \param result The register holding the result.
+         * \return The kernel or a nullptr if not available.
+         */
+        [[nodiscard]] static std::unique_ptr<NativeKernel> Create(const std::vector<CompiledExpression::Instruction> & program, std::size_t result);
+
+        /*!
+         * \brief Run executes the machine code for all points of the context.
+         * \param context The data of the run.
+         */
+        void Run(NativeContext & context) const;
+    };
+
+}
+
+#endif // NATIVEKERNEL_H
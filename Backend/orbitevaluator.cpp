@@ -0,0 +1,146 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "orbitevaluator.h"
+#include "parallelfor.h"
+#include "tracer.h"
+
+#include <cmath>
+#include <optional>
+#include <utility>
+
+namespace Backend {
+
+    OrbitEvaluator::OrbitEvaluator(std::shared_ptr<Expression> expression, int maxIterations, double escapeRadius, double tolerance)
+        : expression(std::move(expression)),
+          compiledExpression(this->expression),
+          maxIterations(maxIterations),
+          escapeRadius(escapeRadius),
+          tolerance(tolerance)
+    {
+    }
+
+    std::vector<complex> OrbitEvaluator::Trace(complex start) const
+    {
+        std::vector<complex> orbit { start };
+
+        auto z = start;
+
+        for (int iteration = 0; iteration < this->maxIterations; ++iteration)
+        {
+            auto next = this->compiledExpression.Evaluate(z);
+
+            if (!next.has_value())
+            {
+                break;
+            }
+
+            orbit.push_back(next.value());
+
+            if (std::abs(next.value()) > this->escapeRadius || std::abs(next.value() - z) < this->tolerance)
+            {
+                break;
+            }
+
+            z = next.value();
+        }
+
+        return orbit;
+    }
+
+    std::vector<OrbitResult> OrbitEvaluator::EvaluateAll(const std::vector<complex> & starts, unsigned int threadCount) const
+    {
+        std::vector<OrbitResult> results(starts.size());
+
+        // blocks are handed out one by one, as orbits end after very different numbers of iterations
+        ParallelFor(starts.size(), threadCount, this->blockSize, [&](std::size_t begin, std::size_t end, unsigned int)
+        {
+            this->EvaluateBlock(starts, begin, end, results);
+        });
+
+        return results;
+    }
+
+    void OrbitEvaluator::EvaluateBlock(const std::vector<complex> & starts, std::size_t begin, std::size_t end, std::vector<OrbitResult> & results) const
+    {
+        TraceSpan span(u8"evaluate", u8"OrbitEvaluator::EvaluateBlock");
+
+        // the orbits still running are kept densely packed, such that finished ones cost nothing in later iterations
+        // and the others are evaluated as one line
+        std::vector<std::size_t> active;
+        active.reserve(end - begin);
+
+        for (auto index = begin; index < end; ++index)
+        {
+            results[index] = OrbitResult { OrbitResult::Outcome::Bounded, 0, starts[index] };
+            active.push_back(index);
+        }
+
+        std::vector<complex> points;
+        std::vector<std::optional<complex>> values;
+
+        for (int iteration = 1; iteration <= this->maxIterations && !active.empty(); ++iteration)
+        {
+            points.resize(active.size());
+            values.resize(active.size());
+
+            for (std::size_t position = 0; position < active.size(); ++position)
+            {
+                points[position] = results[active[position]].last;
+            }
+
+            this->compiledExpression.EvaluateLine(points.data(), values.data(), points.size());
+
+            std::size_t kept = 0;
+
+            for (std::size_t position = 0; position < active.size(); ++position)
+            {
+                auto index = active[position];
+                auto & result = results[index];
+                const auto & next = values[position];
+
+                if (!next.has_value())
+                {
+                    result.outcome = OrbitResult::Outcome::Undefined;
+                    continue;
+                }
+
+                auto previous = result.last;
+                result.last = next.value();
+                result.iterations = iteration;
+
+                if (std::abs(next.value()) > this->escapeRadius)
+                {
+                    result.outcome = OrbitResult::Outcome::Escaped;
+                    continue;
+                }
+
+                if (std::abs(next.value() - previous) < this->tolerance)
+                {
+                    result.outcome = OrbitResult::Outcome::Converged;
+                    continue;
+                }
+
+                active[kept++] = index;
+            }
+
+            active.resize(kept);
+        }
+    }
+
+}
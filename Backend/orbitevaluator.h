@@ -0,0 +1,109 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef ORBITEVALUATOR_H
+#define ORBITEVALUATOR_H
+
+#include <memory>
+#include <vector>
+
+#include "compiledexpression.h"
+#include "expression.h"
+
+namespace Backend {
+
+    /*!
+     * \struct OrbitResult
+     * \brief The OrbitResult struct collects the fate of an orbit z_{n+1} = f(z_n).
+     */
+    struct OrbitResult
+    {
+    public:
+        /*!
+         * \brief The Outcome enum lists the ways an orbit can end.
+         */
+        enum class Outcome
+        {
+            Bounded,
+            Escaped,
+            Converged,
+            Undefined,
+        };
+
+        Outcome outcome;
+        int iterations;
+        complex last;
+    };
+
+    /*!
+     * \class OrbitEvaluator
+     * \brief The OrbitEvaluator class iterates an expression, starting from given points.
+     *
+     * An orbit ends early when it escapes beyond the escape radius,
+     * when consecutive points are closer than the tolerance, or when it hits an undefined point.
+     * The orbits of a block advance together, each iteration evaluating the compiled expression
+     * along the line of those still running.
+     */
+    class OrbitEvaluator final
+    {
+    private:
+        const std::size_t blockSize = 1024;
+
+        std::shared_ptr<Expression> expression;
+        const CompiledExpression compiledExpression;
+        const int maxIterations;
+        const double escapeRadius;
+        const double tolerance;
+
+    public:
+        /*!
+         * \brief Initializes a new instance.
+         * \param expression The expression to iterate.
+         * \param maxIterations The maximum number of iterations for each orbit.
+         * \param escapeRadius The magnitude beyond which an orbit is considered escaped.
+         * \param tolerance The distance of consecutive points below which an orbit is considered converged.
+         */
+        OrbitEvaluator(std::shared_ptr<Expression> expression, int maxIterations, double escapeRadius, double tolerance);
+        ~OrbitEvaluator() = default;
+        OrbitEvaluator(const OrbitEvaluator&) = delete;
+        OrbitEvaluator(OrbitEvaluator&&) = delete;
+        OrbitEvaluator& operator=(const OrbitEvaluator&) = delete;
+        OrbitEvaluator& operator=(OrbitEvaluator&&) = delete;
+
+        /*!
+         * \brief Trace iterates the expression from a single point, keeping the orbit.
+         * \param start The point to start from.
+         * \return The points of the orbit, starting with the given one.
+         */
+        [[nodiscard]] std::vector<complex> Trace(complex start) const;
+
+        /*!
+         * \brief EvaluateAll iterates the expression from all points, in parallel.
+         * \param starts The points to start from, e.g. a grid.
+         * \param threadCount The number of threads to use, 0 for the hardware concurrency.
+         * \return The results in the order of the points.
+         */
+        [[nodiscard]] std::vector<OrbitResult> EvaluateAll(const std::vector<complex> & starts, unsigned int threadCount = 0) const;
+
+    private:
+        void EvaluateBlock(const std::vector<complex> & starts, std::size_t begin, std::size_t end, std::vector<OrbitResult> & results) const;
+    };
+
+}
+
+#endif // ORBITEVALUATOR_H
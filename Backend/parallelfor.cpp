@@ -0,0 +1,65 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "parallelfor.h"
+
+namespace Backend {
+
+    unsigned int GetThreadCount(unsigned int threadCount)
+    {
+        return threadCount != 0 ? threadCount : std::max(1U, std::thread::hardware_concurrency());
+    }
+
+    void ParallelFor(std::size_t count, unsigned int threadCount, std::size_t blockSize, const std::function<void(std::size_t, std::size_t, unsigned int)> & body)
+    {
+        threadCount = GetThreadCount(threadCount);
+        blockSize = std::max<std::size_t>(1, blockSize);
+
+        std::atomic<std::size_t> next(0);
+
+        auto worker = [&](unsigned int thread)
+        {
+            for (auto begin = next.fetch_add(blockSize); begin < count; begin = next.fetch_add(blockSize))
+            {
+                body(begin, std::min(begin + blockSize, count), thread);
+            }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(threadCount - 1);
+
+        for (unsigned int thread = 1; thread < threadCount; ++thread)
+        {
+            threads.emplace_back(worker, thread);
+        }
+
+        worker(0);
+
+        for (auto & thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+}
@@ -0,0 +1,48 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef PARALLELFOR_H
+#define PARALLELFOR_H
+
+#include <cstddef>
+#include <functional>
+
+namespace Backend {
+
+    /*!
+     * \brief GetThreadCount resolves the number of threads to use.
+     * \param threadCount The requested number of threads, 0 for the hardware concurrency.
+     * \return The number of threads, at least 1.
+     */
+    [[nodiscard]] unsigned int GetThreadCount(unsigned int threadCount);
+
+    /*!
+     * \brief ParallelFor calls the body for all indices from 0 to count, exclusive, on several threads.
+     *        The indices are handed out in blocks, one block at a time, such that threads finishing early
+     *        take over the rest of the work. The calling thread takes part and the call returns when all blocks are done.
+     * \param count The number of indices.
+     * \param threadCount The number of threads to use, 0 for the hardware concurrency.
+     * \param blockSize The number of consecutive indices handed out at once.
+     * \param body The function called with the begin and end of a block and the number of the thread, counting from 0.
+     */
+    void ParallelFor(std::size_t count, unsigned int threadCount, std::size_t blockSize, const std::function<void(std::size_t, std::size_t, unsigned int)> & body);
+
+}
+
+#endif // PARALLELFOR_H
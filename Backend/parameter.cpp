@@ -0,0 +1,179 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <functional>
+#include <string_view>
+
+#include "complexinterval.h"
+#include "functions.h"
+#include "parameter.h"
+#include "power.h"
+#include "product.h"
+#include "sum.h"
+
+namespace Backend {
+
+    Parameter::Parameter(std::string name, complex value)
+        : name(std::move(name)),
+          value(value)
+    {
+    }
+
+    const std::string & Parameter::GetName() const
+    {
+        return this->name;
+    }
+
+    complex Parameter::GetValue() const
+    {
+        return this->value;
+    }
+
+    void Parameter::SetValue(complex newValue)
+    {
+        this->value = newValue;
+    }
+
+    int Parameter::GetLevel() const
+    {
+        return 0;
+    }
+
+    bool Parameter::IsConstant() const
+    {
+        // never folded by the parser, as the value may change
+        return false;
+    }
+
+    std::optional<complex> Parameter::Evaluate(complex) const //NOLINT(misc-unused-parameter, hicpp-named-parameter, readability-named-parameter)
+    {
+        return this->value;
+    }
+
+    ComplexInterval Parameter::EvaluateInterval(const ComplexInterval &) const //NOLINT(misc-unused-parameter, hicpp-named-parameter, readability-named-parameter)
+    {
+        return ComplexInterval(this->value);
+    }
+
+    std::size_t Parameter::GetHash() const
+    {
+        auto hash = std::hash<std::string_view>{}(u8"Parameter");
+        hash = HashCombine(hash, std::hash<std::string>{}(this->name));
+        hash = HashCombine(hash, std::hash<double>{}(this->value.real()));
+        return HashCombine(hash, std::hash<double>{}(this->value.imag()));
+    }
+
+    bool Parameter::operator==(const Expression &other) const
+    {
+        if (const auto * b = dynamic_cast<const Parameter*>(&other))
+        {
+            return this->name == b->name && this->value == b->value;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    bool Parameter::operator!=(const Expression &other) const
+    {
+        return !this->operator==(other);
+    }
+
+    ParameterizedExpression::ParameterizedExpression(std::shared_ptr<Expression> expression)
+        : expression(std::move(expression))
+    {
+        this->Collect(this->expression);
+    }
+
+    const std::shared_ptr<Expression> & ParameterizedExpression::GetExpression() const
+    {
+        return this->expression;
+    }
+
+    std::vector<std::string> ParameterizedExpression::GetParameterNames() const
+    {
+        std::vector<std::string> names;
+
+        for (const auto & parameter : this->parameters)
+        {
+            names.push_back(parameter.first);
+        }
+
+        return names;
+    }
+
+    bool ParameterizedExpression::Bind(const std::string & name, complex value)
+    {
+        auto it = this->parameters.find(name);
+        if (it == this->parameters.end())
+        {
+            return false;
+        }
+
+        for (const auto & parameter : it->second)
+        {
+            parameter->SetValue(value);
+        }
+
+        return true;
+    }
+
+    std::optional<complex> ParameterizedExpression::GetValue(const std::string & name) const
+    {
+        auto it = this->parameters.find(name);
+        if (it == this->parameters.end())
+        {
+            return {};
+        }
+
+        return it->second.front()->GetValue();
+    }
+
+    void ParameterizedExpression::Collect(const std::shared_ptr<Expression> & node) //NOLINT(misc-no-recursion)
+    {
+        if (auto parameter = std::dynamic_pointer_cast<Parameter>(node))
+        {
+            this->parameters[parameter->GetName()].push_back(parameter);
+        }
+        else if (const auto * function = dynamic_cast<const Function*>(node.get()))
+        {
+            this->Collect(function->GetArgument());
+        }
+        else if (const auto * sum = dynamic_cast<const Sum*>(node.get()))
+        {
+            for (const auto & summand : sum->GetSummands())
+            {
+                this->Collect(summand.expression);
+            }
+        }
+        else if (const auto * product = dynamic_cast<const Product*>(node.get()))
+        {
+            for (const auto & factor : product->GetFactors())
+            {
+                this->Collect(factor.expression);
+            }
+        }
+        else if (const auto * power = dynamic_cast<const Power*>(node.get()))
+        {
+            this->Collect(power->GetBase());
+            this->Collect(power->GetExponent());
+        }
+    }
+
+}
@@ -0,0 +1,169 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef PARAMETER_H
+#define PARAMETER_H
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "expression.h"
+
+namespace Backend {
+
+    /*!
+     * \class Parameter
+     * \brief The Parameter class represents a named value that can be rebound
+     *        without rebuilding the expression it is part of.
+     *
+     * Rebinding must not happen concurrently to evaluating the expression.
+     */
+    class Parameter final : public Expression
+    {
+    private:
+        const std::string name;
+        complex value;
+
+    public:
+        /*!
+         * \brief Initializes a new instance.
+         * \param name The name of the parameter.
+         * \param value The initial value of the parameter.
+         */
+        explicit Parameter(std::string name, complex value = complex(0.0));
+        ~Parameter() override = default;
+        Parameter(const Parameter&) = delete;
+        Parameter(Parameter&&) = delete;
+        Parameter& operator=(const Parameter&) = delete;
+        Parameter& operator=(Parameter&&) = delete;
+
+        /*!
+         * \brief Gets the name of the parameter.
+         * \return The name.
+         */
+        [[nodiscard]] const std::string & GetName() const;
+
+        /*!
+         * \brief Gets the value currently bound to the parameter.
+         * \return The value.
+         */
+        [[nodiscard]] complex GetValue() const;
+
+        /*!
+         * \brief SetValue binds a new value to the parameter.
+         * \param newValue The value.
+         */
+        void SetValue(complex newValue);
+
+        /*!
+         * \reimp
+         */
+        [[nodiscard]] int GetLevel() const override;
+
+        /*!
+         * \reimp
+         */
+        [[nodiscard]] bool IsConstant() const override;
+
+        /*!
+         * \reimp
+         */
+        [[nodiscard]] std::optional<complex> Evaluate(complex input) const override;
+
+        /*!
+         * \reimp
+         */
+        [[nodiscard]] ComplexInterval EvaluateInterval(const ComplexInterval & input) const override;
+
+        /*!
+         * \reimp
+         * The hash includes the value, such that results for different values are kept apart.
+         */
+        [[nodiscard]] std::size_t GetHash() const override;
+
+        /*!
+         * \reimp
+         */
+        [[nodiscard]] bool operator==(const Expression &other) const override;
+
+        /*!
+         * \reimp
+         */
+        [[nodiscard]] bool operator!=(const Expression &other) const override;
+    };
+
+    /*!
+     * \class ParameterizedExpression
+     * \brief The ParameterizedExpression class is a handle to an expression containing parameters,
+     *        allowing to rebind their values by name.
+     */
+    class ParameterizedExpression final
+    {
+    private:
+        std::shared_ptr<Expression> expression;
+        std::map<std::string, std::vector<std::shared_ptr<Parameter>>> parameters;
+
+    public:
+        /*!
+         * \brief Initializes a new instance, collecting the parameters of the expression.
+         * \param expression The expression.
+         */
+        explicit ParameterizedExpression(std::shared_ptr<Expression> expression);
+        ~ParameterizedExpression() = default;
+        ParameterizedExpression(const ParameterizedExpression&) = delete;
+        ParameterizedExpression(ParameterizedExpression&&) = delete;
+        ParameterizedExpression& operator=(const ParameterizedExpression&) = delete;
+        ParameterizedExpression& operator=(ParameterizedExpression&&) = delete;
+
+        /*!
+         * \brief Gets the expression, which reflects the values bound.
+         * \return The expression.
+         */
+        [[nodiscard]] const std::shared_ptr<Expression> & GetExpression() const;
+
+        /*!
+         * \brief Gets the names of the parameters occurring in the expression, in alphabetical order.
+         * \return The names.
+         */
+        [[nodiscard]] std::vector<std::string> GetParameterNames() const;
+
+        /*!
+         * \brief Bind binds a value to all occurrences of the named parameter.
+         * \param name The name of the parameter.
+         * \param value The value.
+         * \return true if the parameter occurs in the expression, false otherwise.
+         */
+        bool Bind(const std::string & name, complex value);
+
+        /*!
+         * \brief Gets the value bound to the named parameter.
+         * \param name The name of the parameter.
+         * \return The value or nothing if the parameter does not occur in the expression.
+         */
+        [[nodiscard]] std::optional<complex> GetValue(const std::string & name) const;
+
+    private:
+        void Collect(const std::shared_ptr<Expression> & node);
+    };
+
+}
+
+#endif // PARAMETER_H
@@ -0,0 +1,270 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "basez.h"
+#include "complexinterval.h"
+#include "constant.h"
+#include "functions.h"
+#include "parametersweep.h"
+#include "power.h"
+#include "product.h"
+#include "sum.h"
+#include "tracer.h"
+
+namespace Backend {
+
+    /*!
+     * \class CachedSubexpression
+     * \brief The CachedSubexpression class stands in for a subexpression not depending on any parameter,
+     *        looking up its values on the grid of the sweep.
+     *
+     * The sweep advances the shared cursor point by point. Any other input is evaluated directly.
+     */
+    class CachedSubexpression final : public Expression
+    {
+    private:
+        std::shared_ptr<Expression> original;
+        const std::vector<complex> & grid;
+        const std::size_t & cursor;
+        std::vector<std::optional<complex>> values;
+
+    public:
+        CachedSubexpression(std::shared_ptr<Expression> original, const std::vector<complex> & grid, const std::size_t & cursor)
+            : original(std::move(original)),
+              grid(grid),
+              cursor(cursor)
+        {
+            this->values.reserve(grid.size());
+
+            for (const auto & input : grid)
+            {
+                this->values.push_back(this->original->Evaluate(input));
+            }
+        }
+
+        ~CachedSubexpression() override = default;
+        CachedSubexpression(const CachedSubexpression&) = delete;
+        CachedSubexpression(CachedSubexpression&&) = delete;
+        CachedSubexpression& operator=(const CachedSubexpression&) = delete;
+        CachedSubexpression& operator=(CachedSubexpression&&) = delete;
+
+        [[nodiscard]] int GetLevel() const override
+        {
+            return this->original->GetLevel();
+        }
+
+        [[nodiscard]] bool IsConstant() const override
+        {
+            return this->original->IsConstant();
+        }
+
+        [[nodiscard]] std::optional<complex> Evaluate(complex input) const override
+        {
+            if (this->cursor < this->grid.size() && this->grid[this->cursor] == input)
+            {
+                return this->values[this->cursor];
+            }
+
+            return this->original->Evaluate(input);
+        }
+
+        [[nodiscard]] ComplexInterval EvaluateInterval(const ComplexInterval & input) const override
+        {
+            return this->original->EvaluateInterval(input);
+        }
+
+        [[nodiscard]] std::size_t GetHash() const override
+        {
+            return this->original->GetHash();
+        }
+
+        [[nodiscard]] bool operator==(const Expression &other) const override
+        {
+            return *(this->original) == other;
+        }
+
+        [[nodiscard]] bool operator!=(const Expression &other) const override
+        {
+            return !(*this == other);
+        }
+    };
+
+    ParameterSweep::ParameterSweep(std::shared_ptr<ParameterizedExpression> parameterized, std::vector<complex> grid)
+        : parameterized(std::move(parameterized)),
+          grid(std::move(grid)),
+          cursor(0)
+    {
+        bool dependsOnParameter = false;
+        this->expression = this->Substitute(this->parameterized->GetExpression(), dependsOnParameter);
+    }
+
+    std::vector<Sample> ParameterSweep::EvaluateFrame()
+    {
+        TraceSpan span(u8"evaluate", u8"ParameterSweep::EvaluateFrame");
+
+        std::vector<Sample> samples;
+        samples.reserve(this->grid.size());
+
+        for (this->cursor = 0; this->cursor < this->grid.size(); ++this->cursor)
+        {
+            auto input = this->grid[this->cursor];
+            samples.push_back(Sample{input, this->expression->Evaluate(input)});
+        }
+
+        return samples;
+    }
+
+    std::vector<std::vector<Sample>> ParameterSweep::Sweep(const std::string & name, const std::vector<complex> & values)
+    {
+        std::vector<std::vector<Sample>> frames;
+
+        auto previous = this->parameterized->GetValue(name);
+        if (!previous.has_value())
+        {
+            return frames;
+        }
+
+        frames.reserve(values.size());
+
+        for (const auto & value : values)
+        {
+            this->parameterized->Bind(name, value);
+            frames.push_back(this->EvaluateFrame());
+        }
+
+        this->parameterized->Bind(name, previous.value());
+
+        return frames;
+    }
+
+    std::size_t ParameterSweep::GetCachedCount() const
+    {
+        return this->cachedSubexpressions.size();
+    }
+
+    std::shared_ptr<Expression> ParameterSweep::Substitute(const std::shared_ptr<Expression> & expression, bool & dependsOnParameter) //NOLINT(misc-no-recursion)
+    {
+        // children independent of parameters are cached as a whole if their parent depends on a parameter,
+        // an expression without any parameter is cached entirely
+        auto cache = [this](const std::shared_ptr<Expression> & child, bool childDependsOnParameter) -> std::shared_ptr<Expression>
+        {
+            bool isLeaf = dynamic_cast<const BaseZ*>(child.get()) != nullptr
+                    || dynamic_cast<const Constant*>(child.get()) != nullptr;
+
+            if (childDependsOnParameter || isLeaf || child->IsConstant())
+            {
+                return child;
+            }
+
+            auto cached = std::make_shared<CachedSubexpression>(child, this->grid, this->cursor);
+            this->cachedSubexpressions.push_back(cached);
+            return cached;
+        };
+
+        dependsOnParameter = false;
+
+        if (dynamic_cast<const Parameter*>(expression.get()) != nullptr)
+        {
+            dependsOnParameter = true;
+            return expression;
+        }
+
+        if (const auto * function = dynamic_cast<const Function*>(expression.get()))
+        {
+            auto argument = this->Substitute(function->GetArgument(), dependsOnParameter);
+
+            if (!dependsOnParameter)
+            {
+                return this->parameterized->GetExpression() == expression ? cache(expression, false) : expression;
+            }
+
+            return argument == function->GetArgument() ? expression : GetFunctionTableEntry(function->GetId()).create(argument);
+        }
+
+        if (const auto * sum = dynamic_cast<const Sum*>(expression.get()))
+        {
+            std::vector<Sum::Summand> summands;
+            std::vector<bool> dependencies;
+
+            for (const auto & summand : sum->GetSummands())
+            {
+                bool childDependsOnParameter = false;
+                summands.emplace_back(summand.sign, this->Substitute(summand.expression, childDependsOnParameter));
+                dependencies.push_back(childDependsOnParameter);
+                dependsOnParameter = dependsOnParameter || childDependsOnParameter;
+            }
+
+            if (!dependsOnParameter)
+            {
+                return this->parameterized->GetExpression() == expression ? cache(expression, false) : expression;
+            }
+
+            for (std::size_t index = 0; index < summands.size(); ++index)
+            {
+                summands[index].expression = cache(summands[index].expression, dependencies[index]);
+            }
+
+            return std::make_shared<Sum>(summands);
+        }
+
+        if (const auto * product = dynamic_cast<const Product*>(expression.get()))
+        {
+            std::vector<Product::Factor> factors;
+            std::vector<bool> dependencies;
+
+            for (const auto & factor : product->GetFactors())
+            {
+                bool childDependsOnParameter = false;
+                factors.emplace_back(factor.exponent, this->Substitute(factor.expression, childDependsOnParameter));
+                dependencies.push_back(childDependsOnParameter);
+                dependsOnParameter = dependsOnParameter || childDependsOnParameter;
+            }
+
+            if (!dependsOnParameter)
+            {
+                return this->parameterized->GetExpression() == expression ? cache(expression, false) : expression;
+            }
+
+            for (std::size_t index = 0; index < factors.size(); ++index)
+            {
+                factors[index].expression = cache(factors[index].expression, dependencies[index]);
+            }
+
+            return std::make_shared<Product>(factors);
+        }
+
+        if (const auto * power = dynamic_cast<const Power*>(expression.get()))
+        {
+            bool baseDependsOnParameter = false;
+            bool exponentDependsOnParameter = false;
+            auto base = this->Substitute(power->GetBase(), baseDependsOnParameter);
+            auto exponent = this->Substitute(power->GetExponent(), exponentDependsOnParameter);
+            dependsOnParameter = baseDependsOnParameter || exponentDependsOnParameter;
+
+            if (!dependsOnParameter)
+            {
+                return this->parameterized->GetExpression() == expression ? cache(expression, false) : expression;
+            }
+
+            return std::make_shared<Power>(cache(base, baseDependsOnParameter), cache(exponent, exponentDependsOnParameter));
+        }
+
+        return this->parameterized->GetExpression() == expression ? cache(expression, false) : expression;
+    }
+
+}
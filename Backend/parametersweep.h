@@ -0,0 +1,93 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef PARAMETERSWEEP_H
+#define PARAMETERSWEEP_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "expression.h"
+#include "parameter.h"
+#include "sample.h"
+
+namespace Backend {
+
+    class CachedSubexpression;
+
+    /*!
+     * \class ParameterSweep
+     * \brief The ParameterSweep class evaluates a \ref ParameterizedExpression on a fixed grid
+     *        for changing parameter values.
+     *
+     * The largest subexpressions not depending on any parameter are evaluated once for the
+     * whole grid, such that a frame only evaluates the parts depending on the parameters.
+     * The results agree with \ref Expression::Evaluate.
+     * Rebinding must not happen concurrently to evaluating a frame.
+     */
+    class ParameterSweep final
+    {
+    private:
+        std::shared_ptr<ParameterizedExpression> parameterized;
+        std::vector<complex> grid;
+        std::size_t cursor;
+        std::shared_ptr<Expression> expression;
+        std::vector<std::shared_ptr<CachedSubexpression>> cachedSubexpressions;
+
+    public:
+        /*!
+         * \brief Initializes a new instance.
+         * \param parameterized The handle to the expression to evaluate.
+         * \param grid The points to evaluate at in every frame.
+         */
+        ParameterSweep(std::shared_ptr<ParameterizedExpression> parameterized, std::vector<complex> grid);
+        ~ParameterSweep() = default;
+        ParameterSweep(const ParameterSweep&) = delete;
+        ParameterSweep(ParameterSweep&&) = delete;
+        ParameterSweep& operator=(const ParameterSweep&) = delete;
+        ParameterSweep& operator=(ParameterSweep&&) = delete;
+
+        /*!
+         * \brief EvaluateFrame evaluates the grid for the parameter values currently bound.
+         * \return The samples in the order of the grid.
+         */
+        [[nodiscard]] std::vector<Sample> EvaluateFrame();
+
+        /*!
+         * \brief Sweep evaluates the grid for each of the values of the named parameter.
+         *        The value bound before is restored afterwards.
+         * \param name The name of the parameter.
+         * \param values The values to bind, one per frame.
+         * \return The frames in the order of the values, or no frames if the parameter does not occur.
+         */
+        [[nodiscard]] std::vector<std::vector<Sample>> Sweep(const std::string & name, const std::vector<complex> & values);
+
+        /*!
+         * \brief GetCachedCount gets the number of subexpressions evaluated once for all frames.
+         * \return The number of subexpressions.
+         */
+        [[nodiscard]] std::size_t GetCachedCount() const;
+
+    private:
+        [[nodiscard]] std::shared_ptr<Expression> Substitute(const std::shared_ptr<Expression> & expression, bool & dependsOnParameter);
+    };
+
+}
+
+#endif // PARAMETERSWEEP_H
@@ -17,18 +17,26 @@
  */
 
 #include <algorithm>
+#include <array>
+#include <cfenv>
+#include <charconv>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
 #include <functional>
 #include <regex>
-#include <set>
+#include <stdexcept>
 #include <string>
 
 #include "basez.h"
 #include "constant.h"
 #include "functions.h"
+#include "parameter.h"
 #include "parser.h"
 #include "power.h"
 #include "product.h"
 #include "sum.h"
+#include "tracer.h"
 
 namespace Backend {
 
@@ -37,6 +45,29 @@ namespace Backend {
     {
     }
 
+    Parser::Parser(bool optimize, std::vector<std::string> parameterNames)
+        : optimize(optimize),
+          parameterNames(std::move(parameterNames))
+    {
+        const auto & functions = Parser::GetRegisteredFunctions();
+
+        for (const auto & name : this->parameterNames)
+        {
+            if (name.empty()
+                    || std::any_of(name.begin(), name.end(), [](char c){ return std::isalpha(static_cast<unsigned char>(c)) == 0; })
+                    || name == "z" || name == "Z" || name == "i" || name == "I"
+                    || functions.find(name) != functions.end())
+            {
+                throw std::logic_error(u8"invalid parameter name " + name);
+            }
+
+            for (char c : name)
+            {
+                this->parameterCharacters.set(static_cast<unsigned char>(c));
+            }
+        }
+    }
+
     bool Parser::Register(const std::string & name, CreateFunction createFunction)
     {
         auto & functions = Parser::GetRegisteredFunctions();
@@ -45,60 +76,81 @@ namespace Backend {
         if (it == functions.end())
         {
             functions.emplace(name, createFunction);
+            ++Parser::GetRegistrationGeneration();
             return true;
         }
 
         return false;
     }
 
-    std::map<std::string, CreateFunction> & Parser::GetRegisteredFunctions()
+    bool Parser::Unregister(const std::string & name)
     {
-        static std::map<std::string, CreateFunction> theFunctions;
-        return theFunctions;
+        if (Parser::GetRegisteredFunctions().erase(name) == 0)
+        {
+            return false;
+        }
+
+        ++Parser::GetRegistrationGeneration();
+        return true;
     }
 
-    std::regex Parser::GetValidationRegex() const
+    std::size_t & Parser::GetRegistrationGeneration()
     {
-        // This must be adjusted if another math operator is added to the game.
-        std::string regexString("^[-+/*^()0-9.,");
-
-        // allow independent variable and imaginary unit
-        std::set<char> allowedLetters {'z', 'Z', 'i', 'I'};
-
-        // grab from all function names all letters
-        auto & registrationMap = Parser::GetRegisteredFunctions();
-        auto registrationMapIt = registrationMap.begin();
-        auto registrationMapEnd = registrationMap.end();
+        static std::size_t theGeneration = 1;
+        return theGeneration;
+    }
 
-        for(; registrationMapIt != registrationMapEnd; ++registrationMapIt)
+    std::map<std::string, CreateFunction, std::less<>> & Parser::GetRegisteredFunctions()
+    {
+        static std::map<std::string, CreateFunction, std::less<>> theFunctions = []()
         {
-            auto functionName = registrationMapIt->first;
-            auto functionNameIt = functionName.begin();
-            auto functionNameEnd = functionName.end();
+            std::map<std::string, CreateFunction, std::less<>> functions;
 
-            for(; functionNameIt != functionNameEnd; ++functionNameIt)
+            for (const auto & entry : FunctionTable)
             {
-                allowedLetters.insert(*functionNameIt);
+                functions.emplace(std::string(entry.name), entry.create);
             }
+
+            return functions;
+        }();
+
+        return theFunctions;
+    }
+
+    std::bitset<256> Parser::GetValidCharacters() const
+    {
+        // This must be adjusted if another math operator is added to the game.
+        std::bitset<256> validCharacters;
+        std::string_view operatorsAndDigits("-+/*^()0123456789.,");
+
+        for (char c : operatorsAndDigits)
+        {
+            validCharacters.set(static_cast<unsigned char>(c));
         }
 
-        // extend regex by the collection of letters
-        auto allowedLettersIt = allowedLetters.begin();
-        auto allowedLettersEnd = allowedLetters.end();
+        // allow independent variable and imaginary unit
+        std::string_view variableAndUnit("zZiI");
 
-        for(; allowedLettersIt != allowedLettersEnd; ++allowedLettersIt)
+        for (char c : variableAndUnit)
         {
-            regexString += *allowedLettersIt;
+            validCharacters.set(static_cast<unsigned char>(c));
         }
 
-        regexString.append("]+$");
+        // grab from all function names all letters
+        for (const auto & registration : Parser::GetRegisteredFunctions())
+        {
+            for (char c : registration.first)
+            {
+                validCharacters.set(static_cast<unsigned char>(c));
+            }
+        }
 
-        return std::regex(regexString.c_str(), std::regex_constants::ECMAScript);
+        return validCharacters;
     }
 
     std::shared_ptr<Expression> Parser::Parse(const std::string & input) const
     {
-        std::string locale(std::setlocale(LC_ALL, nullptr));
+        TraceSpan span(u8"parse", u8"Parser::Parse");
 
         try
         {
@@ -108,22 +160,55 @@ namespace Backend {
                 return nullptr;
             }
 
-            std::setlocale(LC_ALL, "en_US.UTF-8");
-            auto result = this->InternalParse(prepared);
-            std::setlocale(LC_ALL, locale.c_str());
-
-            return result;
+            return this->InternalParse(prepared);
         }
         catch(std::exception &)
         {
-            std::setlocale(LC_ALL, locale.c_str());
             return nullptr;
         }
     }
 
     bool Parser::IsParseable(const std::string& input) const
     {
-        return this->Parse(input) != nullptr;
+        try
+        {
+            // only strip blanks if there are any, so that the common case works on the input itself
+            std::string prepared;
+            std::string_view view(input);
+
+            if (input.find_first_of(" \t") != std::string::npos)
+            {
+                prepared = this->PrepareInput(input);
+                view = prepared;
+            }
+
+            if (!this->ValidateInput(view))
+            {
+                return false;
+            }
+
+            return this->Recognize(view).parseable;
+        }
+        catch(std::exception &)
+        {
+            return false;
+        }
+    }
+
+    std::shared_ptr<ParameterizedExpression> Parser::ParseParameterized(const std::string & input) const
+    {
+        auto expression = this->Parse(input);
+        if (expression == nullptr)
+        {
+            return nullptr;
+        }
+
+        return std::make_shared<ParameterizedExpression>(expression);
+    }
+
+    bool Parser::IsParameterName(std::string_view input) const
+    {
+        return std::any_of(this->parameterNames.begin(), this->parameterNames.end(), [input](const std::string & name){ return name == input; });
     }
 
     std::string Parser::PrepareInput(const std::string & input) const
@@ -133,17 +218,35 @@ namespace Backend {
         return std::regex_replace(input, re, "");
     }
 
-    bool Parser::ValidateInput(const std::string & input) const
+    bool Parser::ValidateInput(std::string_view input) const
     {
-        // check unsupported characters. The regex should not change after startup
-        static auto inputValidationRegex = this->GetValidationRegex();
-        if(!std::regex_match(input, inputValidationRegex))
+        if (input.empty())
+        {
+            return false;
+        }
+
+        // check unsupported characters. The table is rebuilt whenever functions were registered or unregistered in between
+        thread_local std::size_t validatedGeneration = 0;
+        thread_local std::bitset<256> validCharacters;
+
+        auto registrationGeneration = Parser::GetRegistrationGeneration();
+        if (registrationGeneration != validatedGeneration)
+        {
+            validCharacters = this->GetValidCharacters();
+            validatedGeneration = registrationGeneration;
+        }
+
+        if (std::any_of(input.begin(), input.end(), [this](char c)
+            {
+                auto index = static_cast<unsigned char>(c);
+                return !validCharacters.test(index) && !this->parameterCharacters.test(index);
+            }))
         {
             return false;
         }
 
         // check for "^-", "^+", which is hard to parse
-        if(input.find("^-") != std::string::npos || input.find("^+") != std::string::npos)
+        if(input.find("^-") != std::string_view::npos || input.find("^+") != std::string_view::npos)
         {
             return false;
         }
@@ -181,7 +284,7 @@ namespace Backend {
         return count == 0;
     }
 
-    unsigned long long Parser::FindMatchingBrace(const std::string & input, unsigned long long pos) const
+    unsigned long long Parser::FindMatchingBrace(std::string_view input, unsigned long long pos) const
     {
         if (pos > input.length() - 1)
         {
@@ -268,6 +371,11 @@ namespace Backend {
             return std::make_shared<BaseZ>();
         }
 
+        if (this->IsParameterName(input))
+        {
+            return std::make_shared<Parameter>(input);
+        }
+
         if (input == "I" || input == "i" || input == "+I" || input == "+i")
         {
             return std::make_shared<Constant>(1.0i);
@@ -278,18 +386,14 @@ namespace Backend {
             return std::make_shared<Constant>(-1.0i);
         }
 
-        static std::regex realConstantRegex("^[-+]?[0-9]+[.,]?[0-9]*$", std::regex_constants::ECMAScript);
-
         // deal with a simple case: a real constant
-        if (std::regex_search(input, realConstantRegex))
+        if (Parser::IsRealConstant(input))
         {
             return this->ParseToRealConstant(input);
         }
 
-        static std::regex imaginaryConstantRegex("^[-+]?[0-9]+[.,]?[0-9]*[iI]$", std::regex_constants::ECMAScript);
-
         // deal with a simple case: an imaginary constant
-        if (std::regex_search(input, imaginaryConstantRegex))
+        if (Parser::IsImaginaryConstant(input))
         {
             return this->ParseToImaginaryConstant(input);
         }
@@ -301,9 +405,7 @@ namespace Backend {
         this->Tokenize(input, tokens, ops);
 
         // deal with a signed single token
-        static std::regex singleSignedTokenRegex("^[-+]", std::regex_constants::ECMAScript);
-
-        if (tokens.size() == 1 && std::regex_search(input, singleSignedTokenRegex))
+        if (tokens.size() == 1 && (input[0] == '-' || input[0] == '+'))
         {
             std::string subToken = input.substr(1);
             std::shared_ptr<Expression> bracketedExpression = this->InternalParse(subToken);
@@ -398,42 +500,104 @@ namespace Backend {
         }
     }
 
-    std::shared_ptr<Expression> Parser::ParseToRealConstant(const std::string & input) const
+    bool Parser::IsRealConstant(std::string_view input)
     {
-        try
+        // equivalent to the regex "^[-+]?[0-9]+[.,]?[0-9]*$"
+        auto isDigit = [](char c){ return c >= '0' && c <= '9'; };
+
+        std::size_t index = 0;
+        if (index < input.length() && (input[index] == '-' || input[index] == '+'))
         {
-            static std::regex re(",", std::regex_constants::ECMAScript);
+            ++index;
+        }
 
-            auto anglified = std::regex_replace(input, re, ".");
+        auto digitsBegin = index;
+        while (index < input.length() && isDigit(input[index]))
+        {
+            ++index;
+        }
 
-            double parsed = std::stod(anglified);
-            return std::make_shared<Constant>(parsed);
+        if (index == digitsBegin)
+        {
+            return false;
         }
-        catch (std::exception &)
+
+        if (index < input.length() && (input[index] == '.' || input[index] == ','))
         {
-            return nullptr;
+            ++index;
         }
+
+        while (index < input.length() && isDigit(input[index]))
+        {
+            ++index;
+        }
+
+        return index == input.length();
     }
 
-    std::shared_ptr<Expression> Parser::ParseToImaginaryConstant(const std::string & input) const
+    bool Parser::IsImaginaryConstant(std::string_view input)
     {
-        using namespace std::complex_literals;
+        // equivalent to the regex "^[-+]?[0-9]+[.,]?[0-9]*[iI]$"
+        return !input.empty()
+                && (input.back() == 'i' || input.back() == 'I')
+                && Parser::IsRealConstant(input.substr(0, input.length() - 1));
+    }
 
-        try
+    bool Parser::ConvertNumber(std::string_view input, double & value)
+    {
+        // sensible literals fit into the buffer, so that only absurdly long ones cause an allocation
+        std::array<char, 64> buffer {};
+        std::string longInput;
+        char * begin = buffer.data();
+
+        if (input.length() < buffer.size())
+        {
+            std::copy(input.begin(), input.end(), buffer.begin());
+        }
+        else
+        {
+            longInput.assign(input);
+            begin = longInput.data();
+        }
+
+        char * end = begin + input.length();
+        std::replace(begin, end, ',', '.');
+
+        // from_chars ignores the locale, so parsing on several threads needs no setlocale,
+        // it does not take a plus sign though
+        if (begin != end && *begin == '+')
         {
-            auto numericalOnly = input.substr(0, input.size() - 1);
+            ++begin;
+        }
 
-            static std::regex re(",", std::regex_constants::ECMAScript);
+        // mirrors the checks of std::stod
+        auto result = std::from_chars(begin, end, value);
 
-            auto anglified = std::regex_replace(numericalOnly, re, ".");
+        return result.ptr != begin && result.ec != std::errc::result_out_of_range;
+    }
 
-            double parsed = std::stod(anglified);
-            return std::make_shared<Constant>(parsed * 1.0i);
+    std::shared_ptr<Expression> Parser::ParseToRealConstant(const std::string & input) const
+    {
+        double parsed = 0.0;
+        if (!Parser::ConvertNumber(input, parsed))
+        {
+            return nullptr;
         }
-        catch (std::exception &)
+
+        return std::make_shared<Constant>(parsed);
+    }
+
+    std::shared_ptr<Expression> Parser::ParseToImaginaryConstant(const std::string & input) const
+    {
+        using namespace std::complex_literals;
+
+        double parsed = 0.0;
+        if (!Parser::ConvertNumber(std::string_view(input).substr(0, input.size() - 1), parsed))
         {
             return nullptr;
         }
+
+        return std::make_shared<Constant>(parsed * 1.0i);
     }
 
     std::shared_ptr<Expression> Parser::ParseToSum(std::vector<std::string> & tokens, std::vector<std::string> & ops) const
@@ -696,4 +860,285 @@ namespace Backend {
 
         return (*createFunction).second(argument);
     }
+    template<typename Callback>
+    void Parser::ScanOperators(std::string_view input, Callback callback, unsigned long long & tokenCount) const
+    {
+        // mirrors Tokenize: an operator only separates tokens if it is preceded by a token
+        tokenCount = 0;
+        unsigned long long tokenLength = 0;
+
+        for (unsigned long long index = 0; index < input.length(); ++index)
+        {
+            char c = input[index];
+
+            if (c == '(')
+            {
+                auto endIndex = FindMatchingBrace(input, index);
+                tokenLength += std::min<unsigned long long>(endIndex, input.length() - 1) - index + 1;
+                index = endIndex;
+                continue;
+            }
+
+            if ((c == '-' || c == '+' || c == '*' || c == '/' || c == '^') && tokenLength > 0)
+            {
+                ++tokenCount;
+                tokenLength = 0;
+                callback(index, c);
+                continue;
+            }
+
+            ++tokenLength;
+        }
+
+        if (tokenLength > 0)
+        {
+            ++tokenCount;
+        }
+    }
+
+    Parser::Recognition Parser::Recognize(std::string_view input) const //NOLINT(misc-no-recursion)
+    {
+        using namespace std::complex_literals;
+
+        // mirrors InternalParse step by step, but works on views into the input
+        if (!ValidateInput(input))
+        {
+            return {false, false, {}};
+        }
+
+        if (input[0] == '(' && input.length() - 1 == this->FindMatchingBrace(input, 0))
+        {
+            return this->Recognize(input.substr(1, input.length() - 2));
+        }
+
+        if (input == "Z" || input == "z" || this->IsParameterName(input))
+        {
+            return {true, false, {}};
+        }
+
+        if (input == "I" || input == "i" || input == "+I" || input == "+i")
+        {
+            return {true, true, 1.0i};
+        }
+
+        if (input == "-I" || input == "-i")
+        {
+            return {true, true, -1.0i};
+        }
+
+        if (Parser::IsRealConstant(input))
+        {
+            double parsed = 0.0;
+            bool converted = Parser::ConvertNumber(input, parsed);
+            return {converted, true, parsed};
+        }
+
+        if (Parser::IsImaginaryConstant(input))
+        {
+            double parsed = 0.0;
+            bool converted = Parser::ConvertNumber(input.substr(0, input.length() - 1), parsed);
+            return {converted, true, parsed * 1.0i};
+        }
+
+        // count what Tokenize would produce
+        unsigned long long tokenCount = 0;
+        unsigned long long opCount = 0;
+        bool hasSumOp = false;
+        bool hasProductOp = false;
+        bool hasPowerOp = false;
+
+        this->ScanOperators(input, [&](unsigned long long, char op)
+        {
+            ++opCount;
+            hasSumOp = hasSumOp || op == '+' || op == '-';
+            hasProductOp = hasProductOp || op == '*' || op == '/';
+            hasPowerOp = hasPowerOp || op == '^';
+        }, tokenCount);
+
+        if (tokenCount == 1 && (input[0] == '-' || input[0] == '+'))
+        {
+            auto bracketed = this->Recognize(input.substr(1));
+
+            if (bracketed.parseable && input[0] == '-')
+            {
+                // the expression is wrapped into a negating sum, which evaluates like this
+                complex negated(0.0);
+                negated -= bracketed.value;
+                bracketed.value = negated;
+            }
+
+            return bracketed;
+        }
+
+        if (tokenCount != opCount + 1 && (hasSumOp || hasProductOp || hasPowerOp))
+        {
+            return {false, false, {}};
+        }
+
+        if (hasSumOp)
+        {
+            return this->RecognizeSum(input);
+        }
+
+        if (hasProductOp)
+        {
+            return this->RecognizeProduct(input);
+        }
+
+        if (hasPowerOp)
+        {
+            return this->RecognizePower(input);
+        }
+
+        if (tokenCount == 1)
+        {
+            return this->RecognizeFunction(input);
+        }
+
+        return {false, false, {}};
+    }
+
+    Parser::Recognition Parser::RecognizeSum(std::string_view input) const //NOLINT(misc-no-recursion)
+    {
+        // constant summands are folded like in ParseToSum, which cannot fail
+        bool parseable = true;
+        bool hasVariable = false;
+        complex constantValue(0.0);
+        unsigned long long termBegin = 0;
+        char sign = '+';
+
+        auto recognizeTerm = [&](std::string_view term)
+        {
+            auto recognition = this->Recognize(term);
+            parseable = parseable && recognition.parseable;
+            hasVariable = hasVariable || !recognition.constant;
+
+            if (recognition.constant && sign == '+')
+            {
+                constantValue += recognition.value;
+            }
+            else if (recognition.constant)
+            {
+                constantValue -= recognition.value;
+            }
+        };
+
+        unsigned long long tokenCount = 0;
+        this->ScanOperators(input, [&](unsigned long long index, char op)
+        {
+            if (parseable && (op == '+' || op == '-'))
+            {
+                recognizeTerm(input.substr(termBegin, index - termBegin));
+                termBegin = index + 1;
+                sign = op;
+            }
+        }, tokenCount);
+
+        if (parseable)
+        {
+            recognizeTerm(input.substr(termBegin));
+        }
+
+        return {parseable, this->optimize && !hasVariable, constantValue};
+    }
+
+    Parser::Recognition Parser::RecognizeProduct(std::string_view input) const //NOLINT(misc-no-recursion)
+    {
+        // constant factors are folded like in ParseToProduct, which fails if the evaluation does
+        bool parseable = true;
+        bool hasVariable = false;
+        complex constantValue(1.0);
+        unsigned long long termBegin = 0;
+        char exponent = '*';
+
+        auto recognizeTerm = [&](std::string_view term)
+        {
+            auto recognition = this->Recognize(term);
+            parseable = parseable && recognition.parseable;
+            hasVariable = hasVariable || !recognition.constant;
+
+            if (!parseable || !recognition.constant || !this->optimize)
+            {
+                return;
+            }
+
+            if (exponent == '*')
+            {
+                constantValue *= recognition.value;
+                return;
+            }
+
+            // matches the epsilon and the checks used for division in Product
+            const double epsilon = 1e-9;
+            if(std::fabs(recognition.value.real()) < epsilon && std::fabs(recognition.value.imag()) < epsilon)
+            {
+                parseable = false;
+                return;
+            }
+
+            std::feclearexcept(FE_ALL_EXCEPT); //NOLINT(hicpp-signed-bitwise)
+            constantValue /= recognition.value;
+
+            if(std::fetestexcept(FE_DIVBYZERO | FE_OVERFLOW) != 0) //NOLINT(hicpp-signed-bitwise)
+            {
+                parseable = false;
+            }
+        };
+
+        unsigned long long tokenCount = 0;
+        this->ScanOperators(input, [&](unsigned long long index, char op)
+        {
+            if (parseable && (op == '*' || op == '/'))
+            {
+                recognizeTerm(input.substr(termBegin, index - termBegin));
+                termBegin = index + 1;
+                exponent = op;
+            }
+        }, tokenCount);
+
+        if (parseable)
+        {
+            recognizeTerm(input.substr(termBegin));
+        }
+
+        return {parseable, this->optimize && !hasVariable, constantValue};
+    }
+
+    Parser::Recognition Parser::RecognizePower(std::string_view input) const //NOLINT(misc-no-recursion)
+    {
+        // the base is the first token, the exponent is all the rest
+        unsigned long long basePosition = input.length();
+        unsigned long long tokenCount = 0;
+
+        this->ScanOperators(input, [&](unsigned long long index, char)
+        {
+            basePosition = std::min<unsigned long long>(basePosition, index);
+        }, tokenCount);
+
+        auto base = this->Recognize(input.substr(0, basePosition));
+        if (!base.parseable)
+        {
+            return {false, false, {}};
+        }
+
+        auto exponent = this->Recognize(input.substr(basePosition + 1));
+        return {exponent.parseable, false, {}};
+    }
+
+    Parser::Recognition Parser::RecognizeFunction(std::string_view input) const //NOLINT(misc-no-recursion)
+    {
+        auto index = input.find('(');
+        auto name = input.substr(0, index);
+
+        auto & functions = Parser::GetRegisteredFunctions();
+
+        // a name without argument makes ParseToFunction throw, which Parse turns into a nullptr
+        if (functions.find(name) == functions.end() || index == std::string_view::npos)
+        {
+            return {false, false, {}};
+        }
+
+        auto argument = this->Recognize(input.substr(index));
+        return {argument.parseable, false, {}};
+    }
 }
@@ -19,11 +19,15 @@
 #ifndef PARSER_H
 #define PARSER_H
 
+#include <bitset>
 #include <map>
 #include <memory>
-#include <regex>
+#include <string>
+#include <string_view>
+#include <vector>
 
 #include "expression.h"
+#include "parameter.h"
 
 namespace Backend {
 
@@ -37,12 +41,8 @@ namespace Backend {
     {
     private:
         bool optimize;
-
-        /*!
-         * \brief InputValidationRegex provides cheap validation for the input string.
-         * It must be adjusted any time another math function is added to the game.
-         */
-        static const std::regex InputValidationRegex;
+        std::vector<std::string> parameterNames;
+        std::bitset<256> parameterCharacters;
 
         constexpr static const std::string_view PlusString = "+";
         constexpr static const std::string_view MinusString = "-";
@@ -57,6 +57,17 @@ namespace Backend {
          */
         explicit Parser(bool optimize);
 
+        /*!
+         * \brief Initializes a new instance that accepts the given parameter names,
+         *        creating a \ref Parameter for every occurrence.
+         * \param optimize Flag indicating whether to optimize away some constant terms
+         * \param parameterNames The names of the parameters, consisting of letters only.
+         *
+         * Throws std::logic_error if a name is empty, contains other characters than letters
+         * or collides with the independent variable, the imaginary unit or a registered function.
+         */
+        Parser(bool optimize, std::vector<std::string> parameterNames);
+
         /*!
          * \brief Parse creates an \ref expression from a string, if possible.
          * \param input The string to parse.
@@ -66,36 +77,83 @@ namespace Backend {
 
         /*!
          * \brief IsParseable indicates whether the supplied string is parseable.
+         *
+         * Agrees with \ref Parse, but only recognizes the grammar
+         * without creating any expression.
+         *
          * \param input The string to check for parseability.
          * \return true if the argument is parseable, false otherwise.
          */
         [[nodiscard]] bool IsParseable(const std::string & input) const;
 
+        /*!
+         * \brief ParseParameterized creates an \ref expression from a string, if possible,
+         *        and wraps it into a handle allowing to rebind the values of its parameters.
+         * \param input The string to parse.
+         * \return A pointer to the handle or a nullptr.
+         */
+        [[nodiscard]] std::shared_ptr<ParameterizedExpression> ParseParameterized(const std::string & input) const;
+
          /*!
          * \brief Register registers a function to create an expression representing
          *        a mathematical function under the given human-readable name.
          * \param name The human-readable name of the function, e.g. "sin".
          * \param createFunction Pointer to a function to create an expression
          *        representing the mathematical function.
-         * \return A dummy bool such that the function can be used in static initialization.
+         * \return true if the name was not registered before, false otherwise.
+         *
+         * Registration must not happen concurrently to parsing. The input validation
+         * picks up the letters of newly registered names on its own.
          */
         static bool Register(const std::string & name, CreateFunction createFunction);
 
+        /*!
+         * \brief Unregister removes the function registered under the given human-readable name.
+         * \param name The human-readable name of the function, e.g. "sin".
+         * \return true if the name was registered before, false otherwise.
+         *
+         * Like registration, this must not happen concurrently to parsing.
+         */
+        static bool Unregister(const std::string & name);
+
     private:
         /*!
          * \brief GetRegisteredFunctions Gets the class-static map of registered functions for the parser.
          *
          * By doing it this way, we avoid the static initialization fiasco,
-         * because the map returned is actually method-static, initialized on first access.
+         * because the map returned is actually method-static, initialized on first access
+         * with the functions of the \ref FunctionTable.
          *
          * \return The registration map.
          */
-        static std::map<std::string, CreateFunction> & GetRegisteredFunctions();
+        static std::map<std::string, CreateFunction, std::less<>> & GetRegisteredFunctions();
 
-        [[nodiscard]] std::regex GetValidationRegex() const;
+        /*!
+         * \brief GetRegistrationGeneration Gets the counter of changes to the registered functions,
+         *        such that cached results depending on them can be invalidated.
+         * \return The counter.
+         */
+        static std::size_t & GetRegistrationGeneration();
+
+        /*!
+         * \brief The Recognition struct holds the outcome of recognizing a part of the input.
+         * The value of a constant part is tracked because constant folding fails where its evaluation does.
+         */
+        struct Recognition
+        {
+            bool parseable;
+            bool constant;
+            complex value;
+        };
+
+        [[nodiscard]] std::bitset<256> GetValidCharacters() const;
         [[nodiscard]] std::string PrepareInput(const std::string & input) const;
-        [[nodiscard]] bool ValidateInput(const std::string & input) const;
-        [[nodiscard]] unsigned long long FindMatchingBrace(const std::string & input, unsigned long long pos) const;
+        [[nodiscard]] bool ValidateInput(std::string_view input) const;
+        [[nodiscard]] unsigned long long FindMatchingBrace(std::string_view input, unsigned long long pos) const;
+        [[nodiscard]] static bool IsRealConstant(std::string_view input);
+        [[nodiscard]] static bool IsImaginaryConstant(std::string_view input);
+        [[nodiscard]] static bool ConvertNumber(std::string_view input, double & value);
+        [[nodiscard]] bool IsParameterName(std::string_view input) const;
 
         [[nodiscard]] std::shared_ptr<Expression> InternalParse(std::string input) const;
         void Tokenize(const std::string & input, std::vector<std::string> & tokens, std::vector<std::string> & ops) const;
@@ -105,6 +163,14 @@ namespace Backend {
         [[nodiscard]] std::shared_ptr<Expression> ParseToProduct(std::vector<std::string>& tokens, std::vector<std::string>& ops) const;
         [[nodiscard]] std::shared_ptr<Expression> ParseToPower(std::vector<std::string>& tokens, std::vector<std::string>& ops) const;
         [[nodiscard]] std::shared_ptr<Expression> ParseToFunction(std::vector<std::string>& tokens) const;
+
+        template<typename Callback>
+        void ScanOperators(std::string_view input, Callback callback, unsigned long long & tokenCount) const;
+        [[nodiscard]] Recognition Recognize(std::string_view input) const;
+        [[nodiscard]] Recognition RecognizeSum(std::string_view input) const;
+        [[nodiscard]] Recognition RecognizeProduct(std::string_view input) const;
+        [[nodiscard]] Recognition RecognizePower(std::string_view input) const;
+        [[nodiscard]] Recognition RecognizeFunction(std::string_view input) const;
     };
 }
 
@@ -17,8 +17,11 @@
  */
 
 #include "power.h"
+#include "complexinterval.h"
 #include <cfenv>
 #include <cmath>
+#include <functional>
+#include <string_view>
 #include <utility>
 
 namespace Backend
@@ -36,6 +39,16 @@ namespace Backend
         exponent.reset();
     }
 
+    const std::shared_ptr<Expression> & Power::GetBase() const
+    {
+        return this->base;
+    }
+
+    const std::shared_ptr<Expression> & Power::GetExponent() const
+    {
+        return this->exponent;
+    }
+
     int Power::GetLevel() const
     {
         return 3;
@@ -56,18 +69,77 @@ namespace Backend
             return {};
         }
 
-        std::feclearexcept(FE_ALL_EXCEPT);
-        auto retval = std::pow(baseResult.value(), exponentResult.value());
+        return Power::Apply(baseResult.value(), exponentResult.value());
+    }
 
-        if (!(std::isfinite(retval.real()) || std::isfinite(retval.imag())) || (std::fetestexcept(FE_DIVBYZERO | FE_OVERFLOW | FE_INVALID) != 0))
+    std::optional<complex> Power::Apply(complex base, complex exponent)
+    {
+        auto n = exponent.real();
+
+        if (exponent.imag() != 0.0 || std::fabs(n) > Power::maximumIntegerExponent || std::trunc(n) != n)
         {
-            return {};
             std::feclearexcept(FE_ALL_EXCEPT);
+            auto retval = std::pow(base, exponent);
+
+            if (!(std::isfinite(retval.real()) || std::isfinite(retval.imag())) || (std::fetestexcept(FE_DIVBYZERO | FE_OVERFLOW | FE_INVALID) != 0))
+            {
+                return {};
+            }
+
+            return retval;
+        }
+
+        // integer powers are multiplied out, so that they are defined at zero like polynomials
+        auto remaining = static_cast<unsigned int>(std::fabs(n));
+        complex retval(1.0);
+        complex factor = base;
+
+        while (remaining != 0U)
+        {
+            if ((remaining & 1U) != 0U)
+            {
+                retval *= factor;
+            }
+
+            remaining >>= 1U;
+
+            if (remaining != 0U)
+            {
+                factor *= factor;
+            }
+        }
+
+        if (n < 0.0)
+        {
+            // matches the epsilon used for division in Product
+            if (std::fabs(retval.real()) < Power::epsilon && std::fabs(retval.imag()) < Power::epsilon)
+            {
+                return {};
+            }
+
+            retval = 1.0 / retval;
+        }
+
+        if (!std::isfinite(retval.real()) || !std::isfinite(retval.imag()))
+        {
+            return {};
         }
 
         return retval;
     }
 
+    ComplexInterval Power::EvaluateInterval(const ComplexInterval & input) const
+    {
+        return ComplexInterval::Pow(base->EvaluateInterval(input), exponent->EvaluateInterval(input));
+    }
+
+    std::size_t Power::GetHash() const
+    {
+        auto hash = std::hash<std::string_view>{}(u8"Power");
+        hash = HashCombine(hash, this->base->GetHash());
+        return HashCombine(hash, this->exponent->GetHash());
+    }
+
     bool Power::operator==(const Expression& other) const
     {
         if (const auto * b = dynamic_cast<const Power*>(&other))
@@ -31,6 +31,9 @@ namespace Backend
     class Power final : public Expression
     {
     private:
+        constexpr static const double epsilon = 1e-9;
+        constexpr static const double maximumIntegerExponent = 64.0;
+
         std::shared_ptr<Expression> base;
         std::shared_ptr<Expression> exponent;
 
@@ -47,6 +50,27 @@ namespace Backend
         Power& operator=(const Power&) = delete;
         Power& operator=(Power&&) = delete;
 
+        /*!
+         * \brief Gets the base of the power.
+         * \return The base.
+         */
+        [[nodiscard]] const std::shared_ptr<Expression> & GetBase() const;
+
+        /*!
+         * \brief Gets the exponent of the power.
+         * \return The exponent.
+         */
+        [[nodiscard]] const std::shared_ptr<Expression> & GetExponent() const;
+
+        /*!
+         * \brief Apply raises \a base to the power of \a exponent like \ref Evaluate does.
+         *        Small integer exponents are multiplied out, everything else uses the complex pow.
+         * \param base The base.
+         * \param exponent The exponent.
+         * \return The power or nothing if undefined.
+         */
+        [[nodiscard]] static std::optional<complex> Apply(complex base, complex exponent);
+
         /*!
          * \reimp
          */
@@ -62,6 +86,16 @@ namespace Backend
          */
         [[nodiscard]] std::optional<complex> Evaluate(complex input) const override;
 
+        /*!
+         * \reimp
+         */
+        [[nodiscard]] ComplexInterval EvaluateInterval(const ComplexInterval & input) const override;
+
+        /*!
+         * \reimp
+         */
+        [[nodiscard]] std::size_t GetHash() const override;
+
         /*!
          * \reimp
          */
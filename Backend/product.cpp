@@ -17,9 +17,12 @@
  */
 
 #include "product.h"
+#include "complexinterval.h"
 #include <algorithm>
 #include <cfenv>
 #include <cmath>
+#include <functional>
+#include <string_view>
 #include <utility>
 
 namespace Backend
@@ -35,6 +38,11 @@ namespace Backend
         factors.clear();
     }
 
+    const std::vector<Product::Factor> & Product::GetFactors() const
+    {
+        return this->factors;
+    }
+
     int Product::GetLevel() const
     {
         return 2;
@@ -93,6 +101,44 @@ namespace Backend
         return retval;
     }
 
+    ComplexInterval Product::EvaluateInterval(const ComplexInterval & input) const
+    {
+        ComplexInterval retval(complex(1.0));
+
+        for (const auto & factor : factors)
+        {
+            auto subResult = factor.expression->EvaluateInterval(input);
+
+            switch (factor.exponent)
+            {
+            case Product::Exponent::Positive:
+                retval = retval * subResult;
+                break;
+            case Product::Exponent::Negative:
+                // flags a possible singularity where the epsilon check in Evaluate may fire
+                retval = retval / subResult;
+                break;
+            default:
+                throw std::logic_error(u8"programming mistake in Product switch");
+            }
+        }
+
+        return retval;
+    }
+
+    std::size_t Product::GetHash() const
+    {
+        // the order of the factors does not matter for equality, hence a commutative accumulation
+        std::size_t accumulated = 0;
+
+        for (const auto & factor : factors)
+        {
+            accumulated += HashCombine(static_cast<std::size_t>(factor.exponent), factor.expression->GetHash());
+        }
+
+        return HashCombine(std::hash<std::string_view>{}(u8"Product"), accumulated);
+    }
+
     bool Product::operator==(const Expression &other) const
     {
         if (const auto * b = dynamic_cast<const Product*>(&other))
@@ -99,6 +99,12 @@ namespace Backend
         Product& operator=(const Product&) = delete;
         Product& operator=(Product&&) = delete;
 
+        /*!
+         * \brief Gets the factors of the product.
+         * \return The factors.
+         */
+        [[nodiscard]] const std::vector<Factor> & GetFactors() const;
+
         /*!
          * \reimp
          */
@@ -114,6 +120,16 @@ namespace Backend
          */
         [[nodiscard]] std::optional<complex> Evaluate(complex input) const override;
 
+        /*!
+         * \reimp
+         */
+        [[nodiscard]] ComplexInterval EvaluateInterval(const ComplexInterval & input) const override;
+
+        /*!
+         * \reimp
+         */
+        [[nodiscard]] std::size_t GetHash() const override;
+
         /*!
          * \reimp
          */
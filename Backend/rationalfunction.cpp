@@ -0,0 +1,430 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include "basez.h"
+#include "complexinterval.h"
+#include "power.h"
+#include "product.h"
+#include "rationalfunction.h"
+#include "sum.h"
+
+namespace Backend {
+
+    namespace {
+
+        using Coefficients = RationalFunction::Coefficients;
+
+        void Trim(Coefficients & coefficients)
+        {
+            while (coefficients.size() > 1 && coefficients.back() == complex(0.0))
+            {
+                coefficients.pop_back();
+            }
+        }
+
+        Coefficients Add(const Coefficients & left, const Coefficients & right, double sign)
+        {
+            Coefficients retval(std::max(left.size(), right.size()), complex(0.0));
+
+            for (std::size_t index = 0; index < left.size(); ++index)
+            {
+                retval[index] += left[index];
+            }
+
+            for (std::size_t index = 0; index < right.size(); ++index)
+            {
+                retval[index] += sign * right[index];
+            }
+
+            Trim(retval);
+            return retval;
+        }
+
+        Coefficients Multiply(const Coefficients & left, const Coefficients & right)
+        {
+            Coefficients retval(left.size() + right.size() - 1, complex(0.0));
+
+            for (std::size_t leftIndex = 0; leftIndex < left.size(); ++leftIndex)
+            {
+                for (std::size_t rightIndex = 0; rightIndex < right.size(); ++rightIndex)
+                {
+                    retval[leftIndex + rightIndex] += left[leftIndex] * right[rightIndex];
+                }
+            }
+
+            Trim(retval);
+            return retval;
+        }
+    }
+
+    RationalFunction::RationalFunction(std::shared_ptr<Expression> original, Coefficients numerator, Coefficients denominator)
+        : original(std::move(original)),
+          numerator(std::move(numerator)),
+          denominator(std::move(denominator))
+    {
+    }
+
+    std::shared_ptr<RationalFunction> RationalFunction::Compile(const std::shared_ptr<Expression> & expression)
+    {
+        auto compiled = RationalFunction::CompileRecursive(*expression);
+
+        if (!compiled.has_value())
+        {
+            return nullptr;
+        }
+
+        return std::make_shared<RationalFunction>(expression, std::move(compiled->first), std::move(compiled->second));
+    }
+
+    const RationalFunction::Coefficients & RationalFunction::GetNumerator() const
+    {
+        return this->numerator;
+    }
+
+    const RationalFunction::Coefficients & RationalFunction::GetDenominator() const
+    {
+        return this->denominator;
+    }
+
+    bool RationalFunction::IsPolynomial() const
+    {
+        return this->denominator.size() == 1;
+    }
+
+    void RationalFunction::EvaluateLine(const complex * inputs, std::optional<complex> * outputs, std::size_t count) const
+    {
+        std::array<complex, anchorDistance> numeratorValues {};
+        std::array<complex, anchorDistance> denominatorValues {};
+
+        for (std::size_t begin = 0; begin < count; begin += anchorDistance)
+        {
+            auto length = std::min(anchorDistance, count - begin);
+
+            RationalFunction::ForwardDifference(this->numerator, inputs + begin, numeratorValues.data(), length); //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+            // a constant denominator is not differenced
+            if (this->IsPolynomial())
+            {
+                denominatorValues.fill(this->denominator[0]);
+            }
+            else
+            {
+                RationalFunction::ForwardDifference(this->denominator, inputs + begin, denominatorValues.data(), length); //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            }
+
+            for (std::size_t index = 0; index < length; ++index)
+            {
+                outputs[begin + index] = this->Divide(numeratorValues[index], denominatorValues[index]); //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic, cppcoreguidelines-pro-bounds-constant-array-index)
+            }
+        }
+    }
+
+    int RationalFunction::GetLevel() const
+    {
+        return this->original->GetLevel();
+    }
+
+    bool RationalFunction::IsConstant() const
+    {
+        return this->original->IsConstant();
+    }
+
+    std::optional<complex> RationalFunction::Evaluate(complex input) const
+    {
+        return this->Divide(RationalFunction::Horner(this->numerator, input), RationalFunction::Horner(this->denominator, input));
+    }
+
+    ComplexInterval RationalFunction::EvaluateInterval(const ComplexInterval & input) const
+    {
+        return this->original->EvaluateInterval(input);
+    }
+
+    std::size_t RationalFunction::GetHash() const
+    {
+        return this->original->GetHash();
+    }
+
+    bool RationalFunction::operator==(const Expression &other) const
+    {
+        return *(this->original) == other;
+    }
+
+    bool RationalFunction::operator!=(const Expression &other) const
+    {
+        return !(*this == other);
+    }
+
+    std::optional<std::pair<RationalFunction::Coefficients, RationalFunction::Coefficients>> RationalFunction::CompileRecursive(const Expression & expression) //NOLINT(misc-no-recursion)
+    {
+        auto isTooHigh = [](const std::pair<Coefficients, Coefficients> & fraction)
+        {
+            return fraction.first.size() > maxDegree + 1 || fraction.second.size() > maxDegree + 1;
+        };
+
+        if (expression.IsConstant())
+        {
+            auto value = expression.Evaluate(0.0);
+
+            if (!value.has_value())
+            {
+                return {};
+            }
+
+            return std::make_pair(Coefficients{value.value()}, Coefficients{complex(1.0)});
+        }
+
+        if (dynamic_cast<const BaseZ*>(&expression) != nullptr)
+        {
+            return std::make_pair(Coefficients{complex(0.0), complex(1.0)}, Coefficients{complex(1.0)});
+        }
+
+        if (const auto * sum = dynamic_cast<const Sum*>(&expression))
+        {
+            std::pair<Coefficients, Coefficients> retval(Coefficients{complex(0.0)}, Coefficients{complex(1.0)});
+
+            for (const auto & summand : sum->GetSummands())
+            {
+                auto term = RationalFunction::CompileRecursive(*summand.expression);
+
+                if (!term.has_value())
+                {
+                    return {};
+                }
+
+                auto sign = summand.sign == Sum::Sign::Plus ? 1.0 : -1.0;
+
+                // a common denominator is kept as it is
+                if (retval.second == term->second)
+                {
+                    retval.first = Add(retval.first, term->first, sign);
+                }
+                else
+                {
+                    retval.first = Add(Multiply(retval.first, term->second), Multiply(term->first, retval.second), sign);
+                    retval.second = Multiply(retval.second, term->second);
+                }
+
+                if (isTooHigh(retval))
+                {
+                    return {};
+                }
+            }
+
+            return retval;
+        }
+
+        if (const auto * product = dynamic_cast<const Product*>(&expression))
+        {
+            std::pair<Coefficients, Coefficients> retval(Coefficients{complex(1.0)}, Coefficients{complex(1.0)});
+
+            for (const auto & factor : product->GetFactors())
+            {
+                auto term = RationalFunction::CompileRecursive(*factor.expression);
+
+                if (!term.has_value())
+                {
+                    return {};
+                }
+
+                if (factor.exponent == Product::Exponent::Positive)
+                {
+                    retval.first = Multiply(retval.first, term->first);
+                    retval.second = Multiply(retval.second, term->second);
+                }
+                else
+                {
+                    retval.first = Multiply(retval.first, term->second);
+                    retval.second = Multiply(retval.second, term->first);
+                }
+
+                if (isTooHigh(retval))
+                {
+                    return {};
+                }
+            }
+
+            return retval;
+        }
+
+        if (const auto * power = dynamic_cast<const Power*>(&expression))
+        {
+            // only constant integer exponents keep the function rational
+            if (!power->GetExponent()->IsConstant())
+            {
+                return {};
+            }
+
+            auto exponent = power->GetExponent()->Evaluate(0.0);
+
+            if (!exponent.has_value()
+                    || exponent->imag() != 0.0
+                    || exponent->real() != std::round(exponent->real())
+                    || std::fabs(exponent->real()) > static_cast<double>(maxDegree))
+            {
+                return {};
+            }
+
+            // a constant base keeps the exact value of the power
+            if (power->GetBase()->IsConstant())
+            {
+                auto value = power->Evaluate(0.0);
+
+                if (!value.has_value())
+                {
+                    return {};
+                }
+
+                return std::make_pair(Coefficients{value.value()}, Coefficients{complex(1.0)});
+            }
+
+            auto base = RationalFunction::CompileRecursive(*power->GetBase());
+
+            if (!base.has_value())
+            {
+                return {};
+            }
+
+            auto count = static_cast<long long>(std::fabs(exponent->real()));
+            std::pair<Coefficients, Coefficients> retval(Coefficients{complex(1.0)}, Coefficients{complex(1.0)});
+
+            for (long long index = 0; index < count; ++index)
+            {
+                retval.first = Multiply(retval.first, base->first);
+                retval.second = Multiply(retval.second, base->second);
+
+                if (isTooHigh(retval))
+                {
+                    return {};
+                }
+            }
+
+            if (exponent->real() < 0.0)
+            {
+                std::swap(retval.first, retval.second);
+            }
+
+            return retval;
+        }
+
+        return {};
+    }
+
+    complex RationalFunction::Horner(const Coefficients & coefficients, complex input)
+    {
+        auto coefficientsIt = coefficients.rbegin();
+        auto coefficientsEnd = coefficients.rend();
+
+        complex retval = *coefficientsIt;
+
+        for (++coefficientsIt; coefficientsIt != coefficientsEnd; ++coefficientsIt)
+        {
+            retval = retval * input + *coefficientsIt;
+        }
+
+        return retval;
+    }
+
+    void RationalFunction::ForwardDifference(const Coefficients & coefficients, const complex * inputs, complex * outputs, std::size_t count) //NOLINT(misc-no-recursion)
+    {
+        auto degree = coefficients.size() - 1;
+
+        // the rounding error of the k-th difference is amplified by binomial(span, k),
+        // so the span shrinks with the degree and high degrees are not differenced at all
+        auto span = degree <= maxDifferencedDegree ? anchorDistance >> (degree > 0 ? degree - 1 : 0) : 0;
+
+        if (count > span && span > degree + 1)
+        {
+            for (std::size_t begin = 0; begin < count; begin += span)
+            {
+                RationalFunction::ForwardDifference(coefficients, inputs + begin, outputs + begin, std::min(span, count - begin)); //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            }
+
+            return;
+        }
+
+        // too short for the differences to pay off
+        if (count <= degree + 1 || span <= degree + 1)
+        {
+            for (std::size_t index = 0; index < count; ++index)
+            {
+                outputs[index] = RationalFunction::Horner(coefficients, inputs[index]); //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            }
+
+            return;
+        }
+
+        // the differences of all orders at the first point, from the values at the first degree + 1 points
+        std::array<complex, maxDegree + 1> differences {};
+
+        for (std::size_t index = 0; index <= degree; ++index)
+        {
+            differences[index] = RationalFunction::Horner(coefficients, inputs[index]); //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic, cppcoreguidelines-pro-bounds-constant-array-index)
+        }
+
+        for (std::size_t order = 1; order <= degree; ++order)
+        {
+            for (std::size_t index = degree; index >= order; --index)
+            {
+                differences[index] -= differences[index - 1]; //NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+            }
+        }
+
+        for (std::size_t index = 0; index < count; ++index)
+        {
+            outputs[index] = differences[0]; //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+            for (std::size_t order = 0; order < degree; ++order)
+            {
+                differences[order] += differences[order + 1]; //NOLINT(cppcoreguidelines-pro-bounds-constant-array-index)
+            }
+        }
+    }
+
+    std::optional<complex> RationalFunction::Divide(complex numeratorValue, complex denominatorValue) const
+    {
+        if (this->denominator.size() == 1 && this->denominator[0] == complex(1.0))
+        {
+            if (!std::isfinite(numeratorValue.real()) || !std::isfinite(numeratorValue.imag()))
+            {
+                return {};
+            }
+
+            return numeratorValue;
+        }
+
+        // matches the epsilon used for division in Product, beyond which only an overflow can happen
+        if (std::fabs(denominatorValue.real()) < this->epsilon && std::fabs(denominatorValue.imag()) < this->epsilon)
+        {
+            return {};
+        }
+
+        auto retval = numeratorValue / denominatorValue;
+
+        if (!std::isfinite(retval.real()) || !std::isfinite(retval.imag()))
+        {
+            return {};
+        }
+
+        return retval;
+    }
+
+}
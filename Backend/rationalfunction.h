@@ -0,0 +1,151 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef RATIONALFUNCTION_H
+#define RATIONALFUNCTION_H
+
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "expression.h"
+
+namespace Backend {
+
+    /*!
+     * \class RationalFunction
+     * \brief The RationalFunction class stands in for an expression that is a polynomial
+     *        or a rational function in z with constant coefficients.
+     *
+     * The numerator and the denominator are kept as coefficient arrays, lowest order first,
+     * and evaluated by Horner's scheme. Integer powers are multiplied out like \ref Power does,
+     * so that z^n is defined at zero in either. Like \ref Product, the result is undefined
+     * where the denominator vanishes.
+     * Everything but the evaluation is forwarded to the original expression.
+     */
+    class RationalFunction final : public Expression
+    {
+    public:
+        using Coefficients = std::vector<complex>;
+
+    private:
+        static constexpr std::size_t maxDegree = 32;
+        static constexpr std::size_t anchorDistance = 64;
+        static constexpr std::size_t maxDifferencedDegree = 3;
+        const double epsilon = 1e-9;
+
+        std::shared_ptr<Expression> original;
+        Coefficients numerator;
+        Coefficients denominator;
+
+    public:
+        /*!
+         * \brief Initializes a new instance.
+         * \param original The expression the instance stands in for.
+         * \param numerator The coefficients of the numerator, lowest order first.
+         * \param denominator The coefficients of the denominator, lowest order first.
+         */
+        RationalFunction(std::shared_ptr<Expression> original, Coefficients numerator, Coefficients denominator);
+        ~RationalFunction() override = default;
+        RationalFunction(const RationalFunction&) = delete;
+        RationalFunction(RationalFunction&&) = delete;
+        RationalFunction& operator=(const RationalFunction&) = delete;
+        RationalFunction& operator=(RationalFunction&&) = delete;
+
+        /*!
+         * \brief Compile converts the expression into numerator and denominator coefficients, if possible.
+         *        It recognizes sums, products, quotients and constant integer powers of z and constants.
+         * \param expression The expression to convert.
+         * \return The rational function or a nullptr if the expression is not rational or of too high a degree.
+         */
+        [[nodiscard]] static std::shared_ptr<RationalFunction> Compile(const std::shared_ptr<Expression> & expression);
+
+        /*!
+         * \brief Gets the coefficients of the numerator, lowest order first.
+         * \return The coefficients.
+         */
+        [[nodiscard]] const Coefficients & GetNumerator() const;
+
+        /*!
+         * \brief Gets the coefficients of the denominator, lowest order first.
+         * \return The coefficients.
+         */
+        [[nodiscard]] const Coefficients & GetDenominator() const;
+
+        /*!
+         * \brief IsPolynomial indicates whether the denominator is constant.
+         * \return true if the instance is a polynomial, false otherwise.
+         */
+        [[nodiscard]] bool IsPolynomial() const;
+
+        /*!
+         * \brief EvaluateLine evaluates at equally spaced points by forward differencing,
+         *        going back to Horner's scheme every few points to limit the accumulated rounding.
+         *        Only numerators and denominators of low degree are differenced.
+         * \param inputs The points to evaluate at, equally spaced along a row or column.
+         * \param outputs The results, nothing where undefined.
+         * \param count The number of points.
+         */
+        void EvaluateLine(const complex * inputs, std::optional<complex> * outputs, std::size_t count) const;
+
+        /*!
+         * \reimp
+         */
+        [[nodiscard]] int GetLevel() const override;
+
+        /*!
+         * \reimp
+         */
+        [[nodiscard]] bool IsConstant() const override;
+
+        /*!
+         * \reimp
+         */
+        [[nodiscard]] std::optional<complex> Evaluate(complex input) const override;
+
+        /*!
+         * \reimp
+         */
+        [[nodiscard]] ComplexInterval EvaluateInterval(const ComplexInterval & input) const override;
+
+        /*!
+         * \reimp
+         */
+        [[nodiscard]] std::size_t GetHash() const override;
+
+        /*!
+         * \reimp
+         */
+        [[nodiscard]] bool operator==(const Expression &other) const override;
+
+        /*!
+         * \reimp
+         */
+        [[nodiscard]] bool operator!=(const Expression &other) const override;
+
+    private:
+        [[nodiscard]] static std::optional<std::pair<Coefficients, Coefficients>> CompileRecursive(const Expression & expression);
+        [[nodiscard]] static complex Horner(const Coefficients & coefficients, complex input);
+        static void ForwardDifference(const Coefficients & coefficients, const complex * inputs, complex * outputs, std::size_t count);
+        [[nodiscard]] std::optional<complex> Divide(complex numeratorValue, complex denominatorValue) const;
+    };
+
+}
+
+#endif // RATIONALFUNCTION_H
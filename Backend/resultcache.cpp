@@ -0,0 +1,222 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <utility>
+
+#include "resultcache.h"
+#include "separableevaluator.h"
+
+namespace Backend {
+
+    ResultCache::ResultCache(std::size_t capacity)
+        : capacity(capacity),
+          usedSize(0)
+    {
+    }
+
+    bool ResultCache::Extent::operator==(const Extent &other) const
+    {
+        return this->xFirst == other.xFirst
+                && this->xLast == other.xLast
+                && this->yFirst == other.yFirst
+                && this->yLast == other.yLast;
+    }
+
+    ResultCache::Samples ResultCache::Find(const std::shared_ptr<Expression> & expression, const GridSpecification & specification, double minX, double maxX, double minY, double maxY)
+    {
+        auto extent = ResultCache::GetExtent(specification, minX, maxX, minY, maxY);
+        auto hash = ResultCache::GetKeyHash(expression, specification, extent);
+        auto entry = this->Lookup(hash, expression, specification, extent);
+
+        if (entry == this->entries.end())
+        {
+            return nullptr;
+        }
+
+        // mark as most recently used
+        this->entries.splice(this->entries.begin(), this->entries, entry);
+
+        return entry->samples;
+    }
+
+    ResultCache::Samples ResultCache::Insert(const std::shared_ptr<Expression> & expression, const GridSpecification & specification, double minX, double maxX, double minY, double maxY, std::vector<Sample> samples)
+    {
+        auto extent = ResultCache::GetExtent(specification, minX, maxX, minY, maxY);
+        auto hash = ResultCache::GetKeyHash(expression, specification, extent);
+
+        auto existing = this->Lookup(hash, expression, specification, extent);
+        if (existing != this->entries.end())
+        {
+            this->Remove(existing);
+        }
+
+        auto size = samples.size() * sizeof(Sample) + sizeof(Entry);
+        auto stored = std::make_shared<const std::vector<Sample>>(std::move(samples));
+
+        if (size > this->capacity)
+        {
+            return stored;
+        }
+
+        while (this->usedSize + size > this->capacity)
+        {
+            this->Remove(std::prev(this->entries.end()));
+        }
+
+        this->entries.push_front(Entry{hash, expression, specification, extent, stored, size});
+        this->index.emplace(hash, this->entries.begin());
+        this->usedSize += size;
+
+        return stored;
+    }
+
+    ResultCache::Samples ResultCache::GetOrEvaluate(const std::shared_ptr<Expression> & expression, const GridSpecification & specification, double minX, double maxX, double minY, double maxY)
+    {
+        auto found = this->Find(expression, specification, minX, maxX, minY, maxY);
+        if (found)
+        {
+            return found;
+        }
+
+        GridGenerator gridGenerator(minX, maxX, minY, maxY);
+
+        // adaptive grids are evaluated while refining already
+        if (specification.type == GridSpecification::Type::Adaptive)
+        {
+            return this->Insert(expression, specification, minX, maxX, minY, maxY,
+                                gridGenerator.CreateAdaptiveSamples(specification.distLike, expression, specification.variation, specification.depth));
+        }
+
+        auto grid = gridGenerator.Create(specification, expression);
+
+        std::vector<Sample> samples;
+        samples.reserve(grid.size());
+
+        // square grids take functions of affine arguments from row and column tables
+        if (specification.type == GridSpecification::Type::Square)
+        {
+            SeparableEvaluator separableEvaluator(expression, specification.distLike);
+            separableEvaluator.Tabulate(minX, maxX, minY, maxY);
+
+            // the grid runs along the columns, which are evaluated as lines
+            auto yFirst = static_cast<long long>(std::ceil(minY / specification.distLike));
+            auto yLast = static_cast<long long>(std::floor(maxY / specification.distLike));
+            auto columnLength = yLast >= yFirst ? static_cast<std::size_t>(yLast - yFirst + 1) : grid.size();
+
+            std::vector<std::optional<complex>> outputs(grid.size());
+
+            for (std::size_t begin = 0; begin < grid.size(); begin += columnLength)
+            {
+                separableEvaluator.EvaluateLine(grid.data() + begin, outputs.data() + begin, std::min(columnLength, grid.size() - begin)); //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            }
+
+            for (std::size_t index = 0; index < grid.size(); ++index)
+            {
+                samples.push_back(Sample{grid[index], outputs[index]});
+            }
+
+            return this->Insert(expression, specification, minX, maxX, minY, maxY, std::move(samples));
+        }
+
+        for (const auto & input : grid)
+        {
+            samples.push_back(Sample{input, expression->Evaluate(input)});
+        }
+
+        return this->Insert(expression, specification, minX, maxX, minY, maxY, std::move(samples));
+    }
+
+    std::size_t ResultCache::GetUsedSize() const
+    {
+        return this->usedSize;
+    }
+
+    void ResultCache::Clear()
+    {
+        this->index.clear();
+        this->entries.clear();
+        this->usedSize = 0;
+    }
+
+    ResultCache::Extent ResultCache::GetExtent(const GridSpecification & specification, double minX, double maxX, double minY, double maxY)
+    {
+        // the circles of angular grids are cut by the area itself
+        if (specification.type != GridSpecification::Type::Square && specification.type != GridSpecification::Type::Adaptive)
+        {
+            return Extent{minX, maxX, minY, maxY};
+        }
+
+        // the same index range yields the same points, like in GridGenerator::CreateSquare
+        return Extent{
+            std::ceil(minX / specification.distLike),
+            std::floor(maxX / specification.distLike),
+            std::ceil(minY / specification.distLike),
+            std::floor(maxY / specification.distLike)
+        };
+    }
+
+    std::size_t ResultCache::GetKeyHash(const std::shared_ptr<Expression> & expression, const GridSpecification & specification, const Extent & extent)
+    {
+        // adding zero maps -0.0 to 0.0, which compare equal
+        auto hash = HashCombine(expression->GetHash(), specification.GetHash());
+        hash = HashCombine(hash, std::hash<double>{}(extent.xFirst + 0.0));
+        hash = HashCombine(hash, std::hash<double>{}(extent.xLast + 0.0));
+        hash = HashCombine(hash, std::hash<double>{}(extent.yFirst + 0.0));
+        return HashCombine(hash, std::hash<double>{}(extent.yLast + 0.0));
+    }
+
+    std::list<ResultCache::Entry>::iterator ResultCache::Lookup(std::size_t hash, const std::shared_ptr<Expression> & expression, const GridSpecification & specification, const Extent & extent)
+    {
+        auto range = this->index.equal_range(hash);
+
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            const auto & entry = *(it->second);
+
+            if (entry.specification == specification
+                    && entry.extent == extent
+                    && *(entry.expression) == *expression)
+            {
+                return it->second;
+            }
+        }
+
+        return this->entries.end();
+    }
+
+    void ResultCache::Remove(std::list<Entry>::iterator entry)
+    {
+        auto range = this->index.equal_range(entry->hash);
+
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            if (it->second == entry)
+            {
+                this->index.erase(it);
+                break;
+            }
+        }
+
+        this->usedSize -= entry->size;
+        this->entries.erase(entry);
+    }
+
+}
@@ -0,0 +1,148 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef RESULTCACHE_H
+#define RESULTCACHE_H
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "expression.h"
+#include "gridgenerator.h"
+#include "sample.h"
+
+namespace Backend {
+
+    /*!
+     * \class ResultCache
+     * \brief The ResultCache class keeps the evaluated samples of recently used grids.
+     *
+     * Results are keyed by the structure of the expression, the grid specification
+     * and the points the grid covers inside the area. Square and adaptive grids lie on a lattice
+     * of multiples of their distance, so areas covering the same lattice indices share their results.
+     * Angular grids are keyed by the exact area. The memory used by the samples is bounded,
+     * the least recently used results are dropped first.
+     */
+    class ResultCache final
+    {
+    public:
+        using Samples = std::shared_ptr<const std::vector<Sample>>;
+
+    private:
+        struct Extent
+        {
+        public:
+            double xFirst;
+            double xLast;
+            double yFirst;
+            double yLast;
+
+            bool operator==(const Extent &other) const;
+        };
+
+        struct Entry
+        {
+        public:
+            std::size_t hash;
+            std::shared_ptr<Expression> expression;
+            GridSpecification specification;
+            Extent extent;
+            Samples samples;
+            std::size_t size;
+        };
+
+        const std::size_t capacity;
+        std::size_t usedSize;
+        std::list<Entry> entries;
+        std::unordered_multimap<std::size_t, std::list<Entry>::iterator> index;
+
+    public:
+        /*!
+         * \brief Initializes a new instance.
+         * \param capacity The maximum number of bytes to use for samples.
+         */
+        explicit ResultCache(std::size_t capacity);
+        ~ResultCache() = default;
+        ResultCache(const ResultCache&) = delete;
+        ResultCache(ResultCache&&) = delete;
+        ResultCache& operator=(const ResultCache&) = delete;
+        ResultCache& operator=(ResultCache&&) = delete;
+
+        /*!
+         * \brief Find looks up the samples for the supplied expression and grid.
+         * \param expression The expression evaluated.
+         * \param specification The specification of the grid.
+         * \param minX The minimum value in real/x-direction.
+         * \param maxX The maximum value in real/x-direction.
+         * \param minY The minimum value in imaginary/y-direction.
+         * \param maxY The maximum value in imaginary/y-direction.
+         * \return The samples or a nullptr if not present.
+         */
+        [[nodiscard]] Samples Find(const std::shared_ptr<Expression> & expression, const GridSpecification & specification, double minX, double maxX, double minY, double maxY);
+
+        /*!
+         * \brief Insert stores the samples for the supplied expression and grid,
+         *        replacing any previous samples for the same key.
+         * \param expression The expression evaluated.
+         * \param specification The specification of the grid.
+         * \param minX The minimum value in real/x-direction.
+         * \param maxX The maximum value in real/x-direction.
+         * \param minY The minimum value in imaginary/y-direction.
+         * \param maxY The maximum value in imaginary/y-direction.
+         * \param samples The samples to store.
+         * \return The stored samples.
+         */
+        Samples Insert(const std::shared_ptr<Expression> & expression, const GridSpecification & specification, double minX, double maxX, double minY, double maxY, std::vector<Sample> samples);
+
+        /*!
+         * \brief GetOrEvaluate looks up the samples for the supplied expression and grid,
+         *        creating and evaluating the grid if not present.
+         * \param expression The expression to evaluate.
+         * \param specification The specification of the grid.
+         * \param minX The minimum value in real/x-direction.
+         * \param maxX The maximum value in real/x-direction.
+         * \param minY The minimum value in imaginary/y-direction.
+         * \param maxY The maximum value in imaginary/y-direction.
+         * \return The samples.
+         */
+        Samples GetOrEvaluate(const std::shared_ptr<Expression> & expression, const GridSpecification & specification, double minX, double maxX, double minY, double maxY);
+
+        /*!
+         * \brief GetUsedSize gets the number of bytes used for samples.
+         * \return The number of bytes.
+         */
+        [[nodiscard]] std::size_t GetUsedSize() const;
+
+        /*!
+         * \brief Clear drops all samples.
+         */
+        void Clear();
+
+    private:
+        [[nodiscard]] static Extent GetExtent(const GridSpecification & specification, double minX, double maxX, double minY, double maxY);
+        [[nodiscard]] static std::size_t GetKeyHash(const std::shared_ptr<Expression> & expression, const GridSpecification & specification, const Extent & extent);
+        [[nodiscard]] std::list<Entry>::iterator Lookup(std::size_t hash, const std::shared_ptr<Expression> & expression, const GridSpecification & specification, const Extent & extent);
+        void Remove(std::list<Entry>::iterator entry);
+    };
+
+}
+
+#endif // RESULTCACHE_H
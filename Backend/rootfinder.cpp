@@ -0,0 +1,280 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#define _USE_MATH_DEFINES
+#include <math.h>
+#undef _USE_MATH_DEFINES
+
+#include "rootfinder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "gridgenerator.h"
+#include "parallelfor.h"
+
+namespace Backend {
+
+    RootFinder::RootFinder(std::shared_ptr<Expression> expression, double minX, double maxX, double minY, double maxY)
+        : expression(std::move(expression)),
+          compiledExpression(this->expression),
+          minX(minX),
+          maxX(maxX),
+          minY(minY),
+          maxY(maxY)
+    {
+    }
+
+    std::vector<Root> RootFinder::Find(double cellSize, unsigned int threadCount) const
+    {
+        GridGenerator gridGenerator(this->minX, this->maxX, this->minY, this->maxY);
+        auto centers = gridGenerator.CreateSquare(cellSize);
+
+        threadCount = GetThreadCount(threadCount);
+
+        std::vector<std::vector<Root>> threadRoots(threadCount);
+
+        ParallelFor(centers.size(), threadCount, 1, [&](std::size_t begin, std::size_t, unsigned int thread)
+        {
+            this->FindInCell(centers[begin], cellSize / 2.0, 0, threadRoots[thread]);
+        });
+
+        std::vector<Root> roots;
+        for (const auto & found : threadRoots)
+        {
+            roots.insert(roots.end(), found.begin(), found.end());
+        }
+
+        std::sort(roots.begin(), roots.end(), [](const Root & lhs, const Root & rhs)
+        {
+            return lhs.location.real() < rhs.location.real()
+                    || (lhs.location.real() == rhs.location.real() && lhs.location.imag() < rhs.location.imag());
+        });
+
+        // roots on the boundary between cells are found from both sides
+        auto tolerance = cellSize * std::ldexp(1.0, -this->maxDepth);
+        std::vector<Root> unique;
+
+        for (const auto & root : roots)
+        {
+            auto isDuplicate = std::any_of(unique.rbegin(), unique.rend(), [&](const Root & known)
+            {
+                return known.kind == root.kind && std::abs(known.location - root.location) < tolerance;
+            });
+
+            if (!isDuplicate)
+            {
+                unique.push_back(root);
+            }
+        }
+
+        return unique;
+    }
+
+    void RootFinder::FindInCell(complex center, double halfSize, int depth, std::vector<Root> & roots) const
+    {
+        auto winding = this->GetWinding(center, halfSize);
+
+        // a root on the boundary makes the count meaningless, but gives a very good start
+        if (winding.hit.has_value())
+        {
+            auto hit = winding.hit.value();
+            static_cast<void>(this->Confirm(hit, Root::Kind::Zero, halfSize, roots) || this->Confirm(hit, Root::Kind::Pole, halfSize, roots));
+        }
+        else if (!winding.count.has_value() || winding.count.value() == 0)
+        {
+            return;
+        }
+
+        if (depth < this->maxDepth)
+        {
+            auto quarter = halfSize / 2.0;
+
+            for (auto offset : { complex(-quarter, -quarter), complex(quarter, -quarter), complex(-quarter, quarter), complex(quarter, quarter) })
+            {
+                this->FindInCell(center + offset, quarter, depth + 1, roots);
+            }
+
+            return;
+        }
+
+        if (winding.count.has_value())
+        {
+            auto kind = winding.count.value() > 0 ? Root::Kind::Zero : Root::Kind::Pole;
+            static_cast<void>(this->Confirm(center, kind, halfSize, roots));
+        }
+    }
+
+    bool RootFinder::Confirm(complex start, Root::Kind kind, double halfSize, std::vector<Root> & roots) const
+    {
+        auto location = this->Refine(start, kind, 1, halfSize * 1e-6);
+
+        // Newton's method wandering off means the count was caused by something else, e.g. a branch cut
+        if (!location.has_value()
+                || std::abs(location.value().real() - start.real()) > 2.0 * halfSize
+                || std::abs(location.value().imag() - start.imag()) > 2.0 * halfSize
+                || !this->Contains(location.value()))
+        {
+            return false;
+        }
+
+        // the winding around the location itself gives the order, which also confirms the kind
+        auto count = this->GetWinding(location.value(), halfSize * 1e-2).count.value_or(0);
+
+        if ((kind == Root::Kind::Zero && count <= 0) || (kind == Root::Kind::Pole && count >= 0))
+        {
+            return false;
+        }
+
+        auto order = std::abs(count);
+        auto refined = order > 1 ? this->Refine(location.value(), kind, order, halfSize * 1e-6) : location;
+        roots.push_back(Root { kind, refined.value_or(location.value()), order });
+
+        return true;
+    }
+
+    RootFinder::Winding RootFinder::GetWinding(complex center, double halfSize) const
+    {
+        const complex corners[] = {
+            center + complex(-halfSize, -halfSize),
+            center + complex(halfSize, -halfSize),
+            center + complex(halfSize, halfSize),
+            center + complex(-halfSize, halfSize),
+        };
+
+        std::vector<complex> points;
+        std::vector<std::optional<complex>> values;
+
+        for (int edgePoints = this->initialEdgePoints; edgePoints <= this->maxEdgePoints; edgePoints *= 2)
+        {
+            // the whole boundary is evaluated as one line, the closing point of each edge is the opening point of the next
+            points.clear();
+
+            for (int edge = 0; edge < 4; ++edge)
+            {
+                auto from = corners[edge];
+                auto to = corners[(edge + 1) % 4];
+
+                for (int point = 0; point < edgePoints || (edge == 3 && point == edgePoints); ++point)
+                {
+                    points.push_back(from + (to - from) * (static_cast<double>(point) / edgePoints));
+                }
+            }
+
+            values.resize(points.size());
+            this->compiledExpression.EvaluateLine(points.data(), values.data(), points.size());
+
+            double argument = 0.0;
+            bool isResolved = true;
+
+            for (std::size_t index = 0; index < points.size() && isResolved; ++index)
+            {
+                const auto & z = points[index];
+                const auto & value = values[index];
+
+                if (!value.has_value() || std::abs(value.value()) < this->zeroEpsilon || !std::isfinite(std::abs(value.value())))
+                {
+                    return Winding { {}, z };
+                }
+
+                if (index > 0)
+                {
+                    const auto & previous = values[index - 1];
+                    auto step = std::arg(value.value() / previous.value());
+
+                    if (std::abs(step) > this->maxArgumentStep)
+                    {
+                        // a jump remaining at the finest resolution is caused by a root on the boundary
+                        if (edgePoints * 2 > this->maxEdgePoints)
+                        {
+                            return Winding { {}, std::abs(value.value()) < std::abs(previous.value()) ? z : points[index - 1] };
+                        }
+
+                        isResolved = false;
+                        break;
+                    }
+
+                    argument += step;
+                }
+            }
+
+            if (isResolved)
+            {
+                return Winding { static_cast<int>(std::lround(argument / (2.0 * M_PI))), {} };
+            }
+        }
+
+        return Winding { {}, {} };
+    }
+
+    std::optional<complex> RootFinder::Refine(complex start, Root::Kind kind, int order, double step) const
+    {
+        // poles of f are zeros of 1/f, whose Newton step is the negated one of f
+        auto sign = kind == Root::Kind::Zero ? -1.0 : 1.0;
+        auto z = start;
+
+        for (int iteration = 0; iteration < this->maxNewtonIterations; ++iteration)
+        {
+            // the value and the central difference around it are evaluated as one line
+            const complex points[] = { z, z + step, z - step };
+            std::optional<complex> values[3];
+            this->compiledExpression.EvaluateLine(points, values, 3);
+
+            const auto & value = values[0];
+
+            if (!value.has_value() || !std::isfinite(std::abs(value.value())))
+            {
+                return kind == Root::Kind::Pole ? std::optional<complex>(z) : std::nullopt;
+            }
+
+            if (value.value() == complex(0.0))
+            {
+                return kind == Root::Kind::Zero ? std::optional<complex>(z) : std::nullopt;
+            }
+
+            if (!values[1].has_value() || !values[2].has_value())
+            {
+                return {};
+            }
+
+            auto derivative = (values[1].value() - values[2].value()) / (2.0 * step);
+
+            if (std::abs(derivative) < this->zeroEpsilon)
+            {
+                return {};
+            }
+
+            auto delta = sign * static_cast<double>(order) * value.value() / derivative;
+            z += delta;
+
+            if (std::abs(delta) < this->newtonEpsilon * (1.0 + std::abs(z)))
+            {
+                return z;
+            }
+        }
+
+        return {};
+    }
+
+    bool RootFinder::Contains(complex z) const
+    {
+        return this->minX <= z.real() && z.real() <= this->maxX && this->minY <= z.imag() && z.imag() <= this->maxY;
+    }
+
+}
@@ -0,0 +1,120 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef ROOTFINDER_H
+#define ROOTFINDER_H
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "compiledexpression.h"
+#include "expression.h"
+
+namespace Backend {
+
+    /*!
+     * \struct Root
+     * \brief The Root struct describes a zero or a pole of an expression.
+     */
+    struct Root
+    {
+    public:
+        /*!
+         * \brief The Kind enum distinguishes zeros from poles.
+         */
+        enum class Kind
+        {
+            Zero,
+            Pole,
+        };
+
+        Kind kind;
+        complex location;
+        int order;
+    };
+
+    /*!
+     * \class RootFinder
+     * \brief The RootFinder class locates the zeros and poles of an expression inside an area.
+     *
+     * The area is covered by the cells of a square grid. The winding number of the image
+     * of each cell boundary counts the zeros minus the poles inside, following the argument principle.
+     * Cells with a non-zero count are subdivided, and the location inside the smallest cells
+     * is refined using Newton's method. The expression is assumed to be meromorphic.
+     * Cell boundaries and Newton steps are evaluated by the compiled expression, one line at a time.
+     */
+    class RootFinder final
+    {
+    private:
+        struct Winding
+        {
+            std::optional<int> count;
+            std::optional<complex> hit;
+        };
+
+        const int maxDepth = 6;
+        const int initialEdgePoints = 16;
+        const int maxEdgePoints = 1024;
+        const int maxNewtonIterations = 50;
+        const double maxArgumentStep = 0.5;
+        const double zeroEpsilon = 1e-12;
+        const double newtonEpsilon = 1e-12;
+
+        std::shared_ptr<Expression> expression;
+        const CompiledExpression compiledExpression;
+        const double minX;
+        const double maxX;
+        const double minY;
+        const double maxY;
+
+    public:
+        /*!
+         * \brief Initializes a new instance.
+         * \param expression The expression to investigate.
+         * \param minX The minimum value in real/x-direction.
+         * \param maxX The maximum value in real/x-direction.
+         * \param minY The minimum value in imaginary/y-direction.
+         * \param maxY The maximum value in imaginary/y-direction.
+         */
+        RootFinder(std::shared_ptr<Expression> expression, double minX, double maxX, double minY, double maxY);
+        ~RootFinder() = default;
+        RootFinder(const RootFinder&) = delete;
+        RootFinder(RootFinder&&) = delete;
+        RootFinder& operator=(const RootFinder&) = delete;
+        RootFinder& operator=(RootFinder&&) = delete;
+
+        /*!
+         * \brief Find finds the zeros and poles inside the area, in parallel over the cells.
+         * \param cellSize The size of the cells initially covering the area.
+         * \param threadCount The number of threads to use, 0 for the hardware concurrency.
+         * \return The zeros and poles, ordered by real and then imaginary part.
+         */
+        [[nodiscard]] std::vector<Root> Find(double cellSize, unsigned int threadCount = 0) const;
+
+    private:
+        void FindInCell(complex center, double halfSize, int depth, std::vector<Root> & roots) const;
+        [[nodiscard]] bool Confirm(complex start, Root::Kind kind, double halfSize, std::vector<Root> & roots) const;
+        [[nodiscard]] Winding GetWinding(complex center, double halfSize) const;
+        [[nodiscard]] std::optional<complex> Refine(complex start, Root::Kind kind, int order, double step) const;
+        [[nodiscard]] bool Contains(complex z) const;
+    };
+
+}
+
+#endif // ROOTFINDER_H
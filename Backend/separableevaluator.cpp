@@ -0,0 +1,443 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "basez.h"
+#include "complexinterval.h"
+#include "functions.h"
+#include "power.h"
+#include "product.h"
+#include "rationalfunction.h"
+#include "separableevaluator.h"
+#include "sum.h"
+
+namespace Backend {
+
+    /*!
+     * \class TabulatedFunction
+     * \brief The TabulatedFunction class stands in for a function of an affine argument,
+     *        looking up its values on the square grid.
+     *
+     * With p depending on x and q depending on y, the value is first(p) * first(q) + sign * second(p) * second(q).
+     * Where the two terms are much larger than their sum, cancellation would lose the result,
+     * so such points are evaluated directly.
+     * Everything but the evaluation is forwarded to the original function.
+     */
+    class TabulatedFunction final : public Expression
+    {
+    private:
+        constexpr static const double cancellationLimit = 16.0;
+
+        std::shared_ptr<Expression> original;
+        FunctionId id;
+        complex slope;
+        complex intercept;
+
+        double dist;
+        long long xFirst;
+        long long yFirst;
+        std::vector<complex> columnFirst;
+        std::vector<complex> columnSecond;
+        std::vector<complex> rowFirst;
+        std::vector<complex> rowSecond;
+        double sign;
+
+    public:
+        TabulatedFunction(std::shared_ptr<Expression> original, FunctionId id, complex slope, complex intercept)
+            : original(std::move(original)),
+              id(id),
+              slope(slope),
+              intercept(intercept),
+              dist(1.0),
+              xFirst(0),
+              yFirst(0),
+              sign(1.0)
+        {
+        }
+
+        ~TabulatedFunction() override = default;
+        TabulatedFunction(const TabulatedFunction&) = delete;
+        TabulatedFunction(TabulatedFunction&&) = delete;
+        TabulatedFunction& operator=(const TabulatedFunction&) = delete;
+        TabulatedFunction& operator=(TabulatedFunction&&) = delete;
+
+        void Tabulate(double dist, long long xFirst, long long xLast, long long yFirst, long long yLast)
+        {
+            using namespace std::complex_literals;
+
+            this->dist = dist;
+            this->xFirst = xFirst;
+            this->yFirst = yFirst;
+
+            // expi(w) is exp(iw)
+            auto kernelId = this->id == FunctionId::ImaginaryExponential ? FunctionId::NaturalExponential : this->id;
+            auto kernelSlope = this->id == FunctionId::ImaginaryExponential ? 1.0i * this->slope : this->slope;
+            auto kernelIntercept = this->id == FunctionId::ImaginaryExponential ? 1.0i * this->intercept : this->intercept;
+
+            FunctionId firstId = kernelId;
+            FunctionId secondId = kernelId;
+            FunctionId rowFirstId = kernelId;
+            FunctionId rowSecondId = kernelId;
+
+            switch (kernelId)
+            {
+            case FunctionId::NaturalExponential:
+                this->sign = 0.0;
+                break;
+            case FunctionId::Sine:
+                // sin(p + q) = sin p cos q + cos p sin q
+                secondId = FunctionId::Cosine;
+                rowFirstId = FunctionId::Cosine;
+                this->sign = 1.0;
+                break;
+            case FunctionId::Cosine:
+                // cos(p + q) = cos p cos q - sin p sin q
+                secondId = FunctionId::Sine;
+                rowSecondId = FunctionId::Sine;
+                this->sign = -1.0;
+                break;
+            case FunctionId::HyperbolicSine:
+                // sinh(p + q) = sinh p cosh q + cosh p sinh q
+                secondId = FunctionId::HyperbolicCosine;
+                rowFirstId = FunctionId::HyperbolicCosine;
+                this->sign = 1.0;
+                break;
+            case FunctionId::HyperbolicCosine:
+                // cosh(p + q) = cosh p cosh q + sinh p sinh q
+                secondId = FunctionId::HyperbolicSine;
+                rowSecondId = FunctionId::HyperbolicSine;
+                this->sign = 1.0;
+                break;
+            default:
+                throw std::logic_error(u8"programming mistake in TabulatedFunction switch");
+            }
+
+            auto columns = xLast >= xFirst ? static_cast<std::size_t>(xLast - xFirst + 1) : 0U;
+            auto rows = yLast >= yFirst ? static_cast<std::size_t>(yLast - yFirst + 1) : 0U;
+
+            TabulatedFunction::Fill(this->columnFirst, firstId, columns, [&](std::size_t index){ return kernelSlope * (static_cast<double>(xFirst + static_cast<long long>(index)) * dist) + kernelIntercept; });
+            TabulatedFunction::Fill(this->columnSecond, secondId, this->sign == 0.0 ? 0U : columns, [&](std::size_t index){ return kernelSlope * (static_cast<double>(xFirst + static_cast<long long>(index)) * dist) + kernelIntercept; });
+            TabulatedFunction::Fill(this->rowFirst, rowFirstId, rows, [&](std::size_t index){ return kernelSlope * complex(0.0, static_cast<double>(yFirst + static_cast<long long>(index)) * dist); });
+            TabulatedFunction::Fill(this->rowSecond, rowSecondId, this->sign == 0.0 ? 0U : rows, [&](std::size_t index){ return kernelSlope * complex(0.0, static_cast<double>(yFirst + static_cast<long long>(index)) * dist); });
+        }
+
+        [[nodiscard]] int GetLevel() const override
+        {
+            return this->original->GetLevel();
+        }
+
+        [[nodiscard]] bool IsConstant() const override
+        {
+            return this->original->IsConstant();
+        }
+
+        [[nodiscard]] std::optional<complex> Evaluate(complex input) const override
+        {
+            auto x = std::llround(input.real() / this->dist);
+            auto y = std::llround(input.imag() / this->dist);
+            auto column = static_cast<std::size_t>(x - this->xFirst);
+            auto row = static_cast<std::size_t>(y - this->yFirst);
+
+            // only points exactly on the tabulated grid are looked up
+            if (column >= this->columnFirst.size() || row >= this->rowFirst.size()
+                    || static_cast<double>(x) * this->dist != input.real() || static_cast<double>(y) * this->dist != input.imag())
+            {
+                return this->original->Evaluate(input);
+            }
+
+            auto first = this->columnFirst[column] * this->rowFirst[row];
+
+            if (this->sign == 0.0)
+            {
+                if (!std::isfinite(first.real()) || !std::isfinite(first.imag()))
+                {
+                    return this->original->Evaluate(input);
+                }
+
+                return first;
+            }
+
+            auto second = this->sign * (this->columnSecond[column] * this->rowSecond[row]);
+            auto retval = first + second;
+
+            // with a slope off the axes, both terms may grow exponentially and cancel, losing all digits,
+            // as may terms too large to represent
+            auto scale = std::max({std::fabs(first.real()), std::fabs(first.imag()), std::fabs(second.real()), std::fabs(second.imag())});
+            auto magnitude = std::max(std::fabs(retval.real()), std::fabs(retval.imag()));
+
+            if (!std::isfinite(scale) || !(scale <= TabulatedFunction::cancellationLimit * magnitude))
+            {
+                return this->original->Evaluate(input);
+            }
+
+            return retval;
+        }
+
+        [[nodiscard]] ComplexInterval EvaluateInterval(const ComplexInterval & input) const override
+        {
+            return this->original->EvaluateInterval(input);
+        }
+
+        [[nodiscard]] std::size_t GetHash() const override
+        {
+            return this->original->GetHash();
+        }
+
+        [[nodiscard]] bool operator==(const Expression &other) const override
+        {
+            return *(this->original) == other;
+        }
+
+        [[nodiscard]] bool operator!=(const Expression &other) const override
+        {
+            return !(*this == other);
+        }
+
+    private:
+        template<typename Argument>
+        static void Fill(std::vector<complex> & table, FunctionId id, std::size_t count, Argument argument)
+        {
+            const auto & entry = GetFunctionTableEntry(id);
+
+            table.resize(count);
+
+            // undefined entries propagate into the products as non-finite values
+            for (std::size_t index = 0; index < count; ++index)
+            {
+                table[index] = entry.apply(argument(index)).value_or(complex(NAN, NAN));
+            }
+        }
+    };
+
+    SeparableEvaluator::SeparableEvaluator(const std::shared_ptr<Expression> & expression, double dist)
+        : dist(dist)
+    {
+        this->expression = this->Substitute(expression);
+    }
+
+    void SeparableEvaluator::Tabulate(double minX, double maxX, double minY, double maxY)
+    {
+        auto xFirst = static_cast<long long>(std::ceil(minX / this->dist));
+        auto xLast = static_cast<long long>(std::floor(maxX / this->dist));
+        auto yFirst = static_cast<long long>(std::ceil(minY / this->dist));
+        auto yLast = static_cast<long long>(std::floor(maxY / this->dist));
+
+        for (const auto & tabulatedFunction : this->tabulatedFunctions)
+        {
+            tabulatedFunction->Tabulate(this->dist, xFirst, xLast, yFirst, yLast);
+        }
+    }
+
+    std::optional<complex> SeparableEvaluator::Evaluate(complex input) const
+    {
+        return this->expression->Evaluate(input);
+    }
+
+    void SeparableEvaluator::EvaluateLine(const complex * inputs, std::optional<complex> * outputs, std::size_t count) const
+    {
+        if (const auto * rational = dynamic_cast<const RationalFunction*>(this->expression.get()))
+        {
+            rational->EvaluateLine(inputs, outputs, count);
+            return;
+        }
+
+        for (std::size_t index = 0; index < count; ++index)
+        {
+            outputs[index] = this->expression->Evaluate(inputs[index]); //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+    }
+
+    const std::shared_ptr<Expression> & SeparableEvaluator::GetExpression() const
+    {
+        return this->expression;
+    }
+
+    std::size_t SeparableEvaluator::GetTabulatedCount() const
+    {
+        return this->tabulatedFunctions.size();
+    }
+
+    std::shared_ptr<Expression> SeparableEvaluator::Substitute(const std::shared_ptr<Expression> & expression) //NOLINT(misc-no-recursion)
+    {
+        // rational parts are compiled as a whole, other subtrees without tabulated functions are shared with the original expression
+        bool isComposite = dynamic_cast<const Sum*>(expression.get()) != nullptr
+                || dynamic_cast<const Product*>(expression.get()) != nullptr
+                || dynamic_cast<const Power*>(expression.get()) != nullptr;
+
+        if (isComposite && !expression->IsConstant())
+        {
+            auto rational = RationalFunction::Compile(expression);
+
+            if (rational)
+            {
+                return rational;
+            }
+        }
+
+        if (const auto * function = dynamic_cast<const Function*>(expression.get()))
+        {
+            auto id = function->GetId();
+
+            if (id == FunctionId::NaturalExponential || id == FunctionId::ImaginaryExponential
+                    || id == FunctionId::Sine || id == FunctionId::Cosine
+                    || id == FunctionId::HyperbolicSine || id == FunctionId::HyperbolicCosine)
+            {
+                auto coefficients = SeparableEvaluator::GetAffineCoefficients(*function->GetArgument());
+
+                if (coefficients.has_value())
+                {
+                    auto tabulated = std::make_shared<TabulatedFunction>(expression, id, coefficients->first, coefficients->second);
+                    this->tabulatedFunctions.push_back(tabulated);
+                    return tabulated;
+                }
+            }
+
+            auto argument = this->Substitute(function->GetArgument());
+            return argument == function->GetArgument() ? expression : GetFunctionTableEntry(id).create(argument);
+        }
+
+        if (const auto * sum = dynamic_cast<const Sum*>(expression.get()))
+        {
+            std::vector<Sum::Summand> summands;
+            bool changed = false;
+
+            for (const auto & summand : sum->GetSummands())
+            {
+                summands.emplace_back(summand.sign, this->Substitute(summand.expression));
+                changed = changed || summands.back().expression != summand.expression;
+            }
+
+            return changed ? std::make_shared<Sum>(summands) : expression;
+        }
+
+        if (const auto * product = dynamic_cast<const Product*>(expression.get()))
+        {
+            std::vector<Product::Factor> factors;
+            bool changed = false;
+
+            for (const auto & factor : product->GetFactors())
+            {
+                factors.emplace_back(factor.exponent, this->Substitute(factor.expression));
+                changed = changed || factors.back().expression != factor.expression;
+            }
+
+            return changed ? std::make_shared<Product>(factors) : expression;
+        }
+
+        if (const auto * power = dynamic_cast<const Power*>(expression.get()))
+        {
+            auto base = this->Substitute(power->GetBase());
+            auto exponent = this->Substitute(power->GetExponent());
+
+            return base == power->GetBase() && exponent == power->GetExponent() ? expression : std::make_shared<Power>(base, exponent);
+        }
+
+        return expression;
+    }
+
+    std::optional<std::pair<complex, complex>> SeparableEvaluator::GetAffineCoefficients(const Expression & expression) //NOLINT(misc-no-recursion)
+    {
+        // the coefficients (a, b) describe a*z + b
+        if (expression.IsConstant())
+        {
+            auto value = expression.Evaluate(0.0);
+
+            if (!value.has_value())
+            {
+                return {};
+            }
+
+            return std::make_pair(complex(0.0), value.value());
+        }
+
+        if (dynamic_cast<const BaseZ*>(&expression) != nullptr)
+        {
+            return std::make_pair(complex(1.0), complex(0.0));
+        }
+
+        if (const auto * sum = dynamic_cast<const Sum*>(&expression))
+        {
+            std::pair<complex, complex> retval(0.0, 0.0);
+
+            for (const auto & summand : sum->GetSummands())
+            {
+                auto coefficients = SeparableEvaluator::GetAffineCoefficients(*summand.expression);
+
+                if (!coefficients.has_value())
+                {
+                    return {};
+                }
+
+                auto factor = summand.sign == Sum::Sign::Plus ? 1.0 : -1.0;
+                retval.first += factor * coefficients->first;
+                retval.second += factor * coefficients->second;
+            }
+
+            return retval;
+        }
+
+        if (const auto * product = dynamic_cast<const Product*>(&expression))
+        {
+            // at most one factor may depend on z, and only as a multiplier
+            complex scale(1.0);
+            std::optional<std::pair<complex, complex>> affine;
+
+            for (const auto & factor : product->GetFactors())
+            {
+                if (!factor.expression->IsConstant())
+                {
+                    if (affine.has_value() || factor.exponent != Product::Exponent::Positive)
+                    {
+                        return {};
+                    }
+
+                    affine = SeparableEvaluator::GetAffineCoefficients(*factor.expression);
+
+                    if (!affine.has_value())
+                    {
+                        return {};
+                    }
+
+                    continue;
+                }
+
+                auto value = factor.expression->Evaluate(0.0);
+
+                if (!value.has_value() || (factor.exponent == Product::Exponent::Negative && value.value() == complex(0.0)))
+                {
+                    return {};
+                }
+
+                scale = factor.exponent == Product::Exponent::Positive ? scale * value.value() : scale / value.value();
+            }
+
+            if (!affine.has_value())
+            {
+                return std::make_pair(complex(0.0), scale);
+            }
+
+            return std::make_pair(scale * affine->first, scale * affine->second);
+        }
+
+        return {};
+    }
+
+}
@@ -0,0 +1,112 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef SEPARABLEEVALUATOR_H
+#define SEPARABLEEVALUATOR_H
+
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "expression.h"
+
+namespace Backend {
+
+    class TabulatedFunction;
+
+    /*!
+     * \class SeparableEvaluator
+     * \brief The SeparableEvaluator class evaluates an expression on the square grid,
+     *        taking functions of an affine argument from tables.
+     *
+     * On the square grid, z = x + iy only takes few distinct values of x and y.
+     * For an argument a*z + b, the functions exp, expi, sin, cos, sinh and cosh split by
+     * their addition theorems into terms depending on x and terms depending on y,
+     * such that tables per column and per row replace the transcendental call per point.
+     * Parts that are polynomials or rational functions in z are evaluated as \ref RationalFunction.
+     * The results agree with \ref Expression::Evaluate up to rounding.
+     * Points off the tabulated grid are evaluated directly.
+     */
+    class SeparableEvaluator final
+    {
+    private:
+        const double dist;
+        std::shared_ptr<Expression> expression;
+        std::vector<std::shared_ptr<TabulatedFunction>> tabulatedFunctions;
+
+    public:
+        /*!
+         * \brief Initializes a new instance.
+         * \param expression The expression to evaluate.
+         * \param dist The point-to-point distance of the square grid.
+         */
+        SeparableEvaluator(const std::shared_ptr<Expression> & expression, double dist);
+        ~SeparableEvaluator() = default;
+        SeparableEvaluator(const SeparableEvaluator&) = delete;
+        SeparableEvaluator(SeparableEvaluator&&) = delete;
+        SeparableEvaluator& operator=(const SeparableEvaluator&) = delete;
+        SeparableEvaluator& operator=(SeparableEvaluator&&) = delete;
+
+        /*!
+         * \brief Tabulate fills the tables for the points of the square grid inside the area,
+         *        as created by \ref GridGenerator::CreateSquare.
+         * \param minX The minimum value in real/x-direction.
+         * \param maxX The maximum value in real/x-direction.
+         * \param minY The minimum value in imaginary/y-direction.
+         * \param maxY The maximum value in imaginary/y-direction.
+         */
+        void Tabulate(double minX, double maxX, double minY, double maxY);
+
+        /*!
+         * \brief Evaluate evaluates the expression, using the tables for points of the tabulated grid.
+         * \param input The point to evaluate at.
+         * \return The result or nothing if undefined.
+         */
+        [[nodiscard]] std::optional<complex> Evaluate(complex input) const;
+
+        /*!
+         * \brief EvaluateLine evaluates at equally spaced points along a row or column of the grid.
+         *        An expression that is rational as a whole is evaluated by forward differencing.
+         * \param inputs The points to evaluate at.
+         * \param outputs The results, nothing where undefined.
+         * \param count The number of points.
+         */
+        void EvaluateLine(const complex * inputs, std::optional<complex> * outputs, std::size_t count) const;
+
+        /*!
+         * \brief GetExpression gets the expression taking the functions from the tables,
+         *        which agrees with the original expression up to rounding.
+         * \return The expression.
+         */
+        [[nodiscard]] const std::shared_ptr<Expression> & GetExpression() const;
+
+        /*!
+         * \brief GetTabulatedCount gets the number of function nodes taken from tables.
+         * \return The number of function nodes.
+         */
+        [[nodiscard]] std::size_t GetTabulatedCount() const;
+
+    private:
+        [[nodiscard]] std::shared_ptr<Expression> Substitute(const std::shared_ptr<Expression> & expression);
+        [[nodiscard]] static std::optional<std::pair<complex, complex>> GetAffineCoefficients(const Expression & expression);
+    };
+
+}
+
+#endif // SEPARABLEEVALUATOR_H
@@ -0,0 +1,363 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "streamlinetracer.h"
+#include "parallelfor.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+namespace Backend {
+
+    StreamlineTracer::StreamlineTracer(std::shared_ptr<Expression> expression, Method method, double step, double tolerance, int maxSteps, double minX, double maxX, double minY, double maxY)
+        : expression(std::move(expression)),
+          compiledExpression(this->expression),
+          method(method),
+          step(step),
+          tolerance(tolerance),
+          maxSteps(maxSteps),
+          minX(minX),
+          maxX(maxX),
+          minY(minY),
+          maxY(maxY)
+    {
+    }
+
+    std::vector<complex> StreamlineTracer::Trace(complex seed) const
+    {
+        std::vector<complex> line;
+        this->TraceSeeds(&seed, &line, 1);
+
+        return line;
+    }
+
+    std::vector<std::vector<complex>> StreamlineTracer::TraceAll(const std::vector<complex> & seeds, unsigned int threadCount) const
+    {
+        std::vector<std::vector<complex>> lines(seeds.size());
+
+        // small blocks, as the lengths of the lines vary strongly
+        ParallelFor(seeds.size(), threadCount, this->seedBlockSize, [&](std::size_t begin, std::size_t end, unsigned int)
+        {
+            this->TraceSeeds(seeds.data() + begin, lines.data() + begin, end - begin); //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        });
+
+        return lines;
+    }
+
+    void StreamlineTracer::TraceSeeds(const complex * seeds, std::vector<complex> * lines, std::size_t count) const
+    {
+        std::vector<std::vector<complex>> backwardLines(count);
+        std::vector<Walker> walkers;
+
+        for (std::size_t index = 0; index < count; ++index)
+        {
+            lines[index].clear(); //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+            if (this->Contains(seeds[index])) //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            {
+                walkers.push_back(Walker { seeds[index], seeds[index], this->step, complex(0.0), &backwardLines[index] }); //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            }
+        }
+
+        this->TraceDirection(walkers, -1.0);
+
+        for (auto & walker : walkers)
+        {
+            auto & line = lines[walker.line - backwardLines.data()]; //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            const auto & backward = *walker.line;
+
+            line.assign(backward.rbegin(), backward.rend());
+            line.push_back(walker.seed);
+            walker.line = &line;
+        }
+
+        // a closed line has been traced completely in one direction
+        walkers.erase(std::remove_if(walkers.begin(), walkers.end(), [&](const Walker & walker)
+        {
+            return walker.line->size() > 1 && std::abs(walker.line->front() - walker.seed) <= this->step;
+        }), walkers.end());
+
+        this->TraceDirection(walkers, 1.0);
+    }
+
+    void StreamlineTracer::TraceDirection(std::vector<Walker> walkers, double sign) const
+    {
+        for (int count = 0; count < this->maxSteps && !walkers.empty(); ++count)
+        {
+            std::vector<std::optional<complex>> next;
+
+            switch (this->method)
+            {
+            case Method::RungeKutta4:
+                next = this->StepRungeKutta4(walkers, sign);
+                break;
+            case Method::DormandPrince45:
+                next = this->StepDormandPrince45(walkers, sign);
+                break;
+            default:
+                throw std::logic_error(u8"programming mistake in StreamlineTracer switch");
+            }
+
+            // the lines still running are kept densely packed
+            std::size_t kept = 0;
+
+            for (std::size_t index = 0; index < walkers.size(); ++index)
+            {
+                if (this->Advance(walkers[index], next[index], count))
+                {
+                    walkers[kept++] = walkers[index];
+                }
+            }
+
+            walkers.resize(kept);
+        }
+    }
+
+    bool StreamlineTracer::Advance(Walker & walker, const std::optional<complex> & next, int count) const
+    {
+        if (!next.has_value() || !this->Contains(next.value()))
+        {
+            return false;
+        }
+
+        // a reversing or vanishing step means the line has run into a sink or a pole and would oscillate around it
+        auto delta = next.value() - walker.z;
+        if ((std::conj(walker.previousDelta) * delta).real() < 0.0 || std::abs(delta) < this->step * this->minimumStepFactor)
+        {
+            return false;
+        }
+
+        walker.previousDelta = delta;
+        walker.z = next.value();
+        walker.line->push_back(walker.z);
+
+        return count < this->closingStepCount || std::abs(walker.z - walker.seed) >= this->step / 2.0;
+    }
+
+    void StreamlineTracer::Directions(const std::vector<complex> & points, double sign, std::vector<std::optional<complex>> & directions) const
+    {
+        directions.resize(points.size());
+        this->compiledExpression.EvaluateLine(points.data(), directions.data(), points.size());
+
+        for (auto & direction : directions)
+        {
+            if (!direction.has_value())
+            {
+                continue;
+            }
+
+            auto magnitude = std::abs(direction.value());
+
+            if (!std::isfinite(magnitude) || magnitude < this->zeroEpsilon)
+            {
+                direction.reset();
+                continue;
+            }
+
+            direction = sign * direction.value() / magnitude;
+        }
+    }
+
+    std::vector<std::optional<complex>> StreamlineTracer::StepRungeKutta4(const std::vector<Walker> & walkers, double sign) const
+    {
+        auto count = walkers.size();
+        std::vector<complex> points(count);
+        std::vector<std::optional<complex>> k1;
+        std::vector<std::optional<complex>> k2;
+        std::vector<std::optional<complex>> k3;
+        std::vector<std::optional<complex>> k4;
+
+        // a stage of a line already undefined is evaluated at the start again, its result is not used
+        auto stagePoint = [&](std::size_t index, const std::optional<complex> & k, double factor)
+        {
+            const auto & walker = walkers[index];
+            return k.has_value() ? walker.z + walker.h * factor * k.value() : walker.z;
+        };
+
+        for (std::size_t index = 0; index < count; ++index)
+        {
+            points[index] = walkers[index].z;
+        }
+
+        this->Directions(points, sign, k1);
+
+        for (std::size_t index = 0; index < count; ++index)
+        {
+            points[index] = stagePoint(index, k1[index], 0.5);
+        }
+
+        this->Directions(points, sign, k2);
+
+        for (std::size_t index = 0; index < count; ++index)
+        {
+            points[index] = stagePoint(index, k2[index], 0.5);
+        }
+
+        this->Directions(points, sign, k3);
+
+        for (std::size_t index = 0; index < count; ++index)
+        {
+            points[index] = stagePoint(index, k3[index], 1.0);
+        }
+
+        this->Directions(points, sign, k4);
+
+        std::vector<std::optional<complex>> next(count);
+
+        for (std::size_t index = 0; index < count; ++index)
+        {
+            if (k1[index].has_value() && k2[index].has_value() && k3[index].has_value() && k4[index].has_value())
+            {
+                auto h = walkers[index].h;
+                next[index] = walkers[index].z + h / 6.0 * (k1[index].value() + 2.0 * k2[index].value() + 2.0 * k3[index].value() + k4[index].value());
+            }
+        }
+
+        return next;
+    }
+
+    std::vector<std::optional<complex>> StreamlineTracer::StepDormandPrince45(std::vector<Walker> & walkers, double sign) const
+    {
+        // Butcher tableau of the Dormand-Prince method
+        static const double a[7][6] = {
+            { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 },
+            { 1.0 / 5.0, 0.0, 0.0, 0.0, 0.0, 0.0 },
+            { 3.0 / 40.0, 9.0 / 40.0, 0.0, 0.0, 0.0, 0.0 },
+            { 44.0 / 45.0, -56.0 / 15.0, 32.0 / 9.0, 0.0, 0.0, 0.0 },
+            { 19372.0 / 6561.0, -25360.0 / 2187.0, 64448.0 / 6561.0, -212.0 / 729.0, 0.0, 0.0 },
+            { 9017.0 / 3168.0, -355.0 / 33.0, 46732.0 / 5247.0, 49.0 / 176.0, -5103.0 / 18656.0, 0.0 },
+            { 35.0 / 384.0, 0.0, 500.0 / 1113.0, 125.0 / 192.0, -2187.0 / 6784.0, 11.0 / 84.0 },
+        };
+        static const double errorWeights[7] = {
+            35.0 / 384.0 - 5179.0 / 57600.0,
+            0.0,
+            500.0 / 1113.0 - 7571.0 / 16695.0,
+            125.0 / 192.0 - 393.0 / 640.0,
+            -2187.0 / 6784.0 + 92097.0 / 339200.0,
+            11.0 / 84.0 - 187.0 / 2100.0,
+            -1.0 / 40.0,
+        };
+
+        const double minimumStep = this->step * this->minimumStepFactor;
+
+        std::vector<std::optional<complex>> next(walkers.size());
+        std::vector<std::array<complex, 7>> k(walkers.size());
+        std::vector<unsigned char> defined(walkers.size());
+        std::vector<complex> points;
+        std::vector<std::optional<complex>> directions;
+
+        // the lines whose step has been neither accepted nor given up, retrying with a shorter step
+        std::vector<std::size_t> pending(walkers.size());
+        std::iota(pending.begin(), pending.end(), 0);
+
+        while (!pending.empty())
+        {
+            points.resize(pending.size());
+
+            for (auto index : pending)
+            {
+                defined[index] = 1;
+            }
+
+            for (int stage = 0; stage < 7; ++stage)
+            {
+                for (std::size_t position = 0; position < pending.size(); ++position)
+                {
+                    auto index = pending[position];
+                    const auto & walker = walkers[index];
+                    complex point = walker.z;
+
+                    for (int previous = 0; previous < stage; ++previous)
+                    {
+                        point += walker.h * a[stage][previous] * k[index][previous];
+                    }
+
+                    points[position] = point;
+                }
+
+                this->Directions(points, sign, directions);
+
+                for (std::size_t position = 0; position < pending.size(); ++position)
+                {
+                    auto index = pending[position];
+                    const auto & direction = directions[position];
+
+                    // an undefined stage zeroes the remaining ones of its line
+                    defined[index] = defined[index] != 0 && direction.has_value() ? 1 : 0;
+                    k[index][stage] = defined[index] != 0 ? direction.value() : complex(0.0);
+                }
+            }
+
+            std::size_t kept = 0;
+
+            for (auto index : pending)
+            {
+                auto & walker = walkers[index];
+                auto & h = walker.h;
+
+                complex error(0.0);
+                for (int stage = 0; stage < 7 && defined[index] != 0; ++stage)
+                {
+                    error += h * errorWeights[stage] * k[index][stage];
+                }
+
+                // undefined stages are treated like a failed error check, approaching the undefined point carefully
+                auto errorNorm = defined[index] != 0 ? std::abs(error) : std::numeric_limits<double>::infinity();
+
+                if (errorNorm <= this->tolerance)
+                {
+                    // the fifth order solution equals the last stage point (first same as last)
+                    complex point = walker.z;
+                    for (int previous = 0; previous < 6; ++previous)
+                    {
+                        point += h * a[6][previous] * k[index][previous];
+                    }
+
+                    auto factor = errorNorm > 0.0 ? 0.9 * std::pow(this->tolerance / errorNorm, 0.2) : 5.0;
+                    h = std::min(this->step, h * std::clamp(factor, 0.2, 5.0));
+
+                    next[index] = point;
+                    continue;
+                }
+
+                auto factor = std::isfinite(errorNorm) ? 0.9 * std::pow(this->tolerance / errorNorm, 0.2) : 0.2;
+                h *= std::clamp(factor, 0.2, 0.9);
+
+                if (h >= minimumStep)
+                {
+                    pending[kept++] = index;
+                }
+            }
+
+            pending.resize(kept);
+        }
+
+        return next;
+    }
+
+    bool StreamlineTracer::Contains(complex z) const
+    {
+        return this->minX <= z.real() && z.real() <= this->maxX && this->minY <= z.imag() && z.imag() <= this->maxY;
+    }
+
+}
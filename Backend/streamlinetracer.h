@@ -0,0 +1,129 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef STREAMLINETRACER_H
+#define STREAMLINETRACER_H
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "compiledexpression.h"
+#include "expression.h"
+
+namespace Backend {
+
+    /*!
+     * \class StreamlineTracer
+     * \brief The StreamlineTracer class traces streamlines of the vector field z -> f(z).
+     *
+     * The integration follows the direction of the field with unit speed,
+     * such that the integration variable is the arc length. Tracing stops at
+     * undefined points, zeros and sinks of the field, when leaving the area,
+     * when returning to the seed on a closed line, or after the maximum number of steps.
+     *
+     * Seeds are traced in lockstep in small blocks, such that every stage of the integration
+     * evaluates the compiled expression along a line of points, one per streamline still running.
+     */
+    class StreamlineTracer final
+    {
+    public:
+        /*!
+         * \brief The Method enum lists the available integration schemes.
+         */
+        enum class Method
+        {
+            RungeKutta4,
+            DormandPrince45,
+        };
+
+    private:
+        struct Walker
+        {
+        public:
+            complex seed;
+            complex z;
+            double h;
+            complex previousDelta;
+            std::vector<complex> * line;
+        };
+
+        const std::size_t seedBlockSize = 32;
+        const double zeroEpsilon = 1e-12;
+        const double minimumStepFactor = 1e-3;
+        const int closingStepCount = 10;
+
+        std::shared_ptr<Expression> expression;
+        const CompiledExpression compiledExpression;
+        const Method method;
+        const double step;
+        const double tolerance;
+        const int maxSteps;
+        const double minX;
+        const double maxX;
+        const double minY;
+        const double maxY;
+
+    public:
+        /*!
+         * \brief Initializes a new instance.
+         * \param expression The expression defining the vector field.
+         * \param method The integration scheme.
+         * \param step The step length, which is the maximum step length for adaptive schemes.
+         * \param tolerance The tolerated local error per step for adaptive schemes.
+         * \param maxSteps The maximum number of steps in each direction.
+         * \param minX The minimum value in real/x-direction.
+         * \param maxX The maximum value in real/x-direction.
+         * \param minY The minimum value in imaginary/y-direction.
+         * \param maxY The maximum value in imaginary/y-direction.
+         */
+        StreamlineTracer(std::shared_ptr<Expression> expression, Method method, double step, double tolerance, int maxSteps, double minX, double maxX, double minY, double maxY);
+        ~StreamlineTracer() = default;
+        StreamlineTracer(const StreamlineTracer&) = delete;
+        StreamlineTracer(StreamlineTracer&&) = delete;
+        StreamlineTracer& operator=(const StreamlineTracer&) = delete;
+        StreamlineTracer& operator=(StreamlineTracer&&) = delete;
+
+        /*!
+         * \brief Trace traces the streamline through the seed, backwards and forwards.
+         * \param seed The point to start from.
+         * \return The points of the streamline in the direction of the field, empty if the seed is not inside the area.
+         */
+        [[nodiscard]] std::vector<complex> Trace(complex seed) const;
+
+        /*!
+         * \brief TraceAll traces the streamlines through all seeds in parallel.
+         * \param seeds The points to start from, e.g. a grid.
+         * \param threadCount The number of threads to use, 0 for the hardware concurrency.
+         * \return The streamlines in the order of the seeds.
+         */
+        [[nodiscard]] std::vector<std::vector<complex>> TraceAll(const std::vector<complex> & seeds, unsigned int threadCount = 0) const;
+
+    private:
+        void TraceSeeds(const complex * seeds, std::vector<complex> * lines, std::size_t count) const;
+        void TraceDirection(std::vector<Walker> walkers, double sign) const;
+        [[nodiscard]] bool Advance(Walker & walker, const std::optional<complex> & next, int count) const;
+        void Directions(const std::vector<complex> & points, double sign, std::vector<std::optional<complex>> & directions) const;
+        [[nodiscard]] std::vector<std::optional<complex>> StepRungeKutta4(const std::vector<Walker> & walkers, double sign) const;
+        [[nodiscard]] std::vector<std::optional<complex>> StepDormandPrince45(std::vector<Walker> & walkers, double sign) const;
+        [[nodiscard]] bool Contains(complex z) const;
+    };
+
+}
+
+#endif // STREAMLINETRACER_H
@@ -17,8 +17,11 @@
  */
 
 #include "sum.h"
+#include "complexinterval.h"
 
 #include <algorithm>
+#include <functional>
+#include <string_view>
 #include <utility>
 
 namespace Backend
@@ -34,6 +37,11 @@ namespace Backend
         summands.clear();
     }
 
+    const std::vector<Sum::Summand> & Sum::GetSummands() const
+    {
+        return this->summands;
+    }
+
     int Sum::GetLevel() const
     {
         return 1;
@@ -76,6 +84,43 @@ namespace Backend
         return retval;
     }
 
+    ComplexInterval Sum::EvaluateInterval(const ComplexInterval & input) const
+    {
+        ComplexInterval retval(complex(0.0));
+
+        for (const auto & summand : summands)
+        {
+            auto subResult = summand.expression->EvaluateInterval(input);
+
+            switch (summand.sign)
+            {
+            case Sum::Sign::Plus:
+                retval = retval + subResult;
+                break;
+            case Sum::Sign::Minus:
+                retval = retval - subResult;
+                break;
+            default:
+                throw std::logic_error(u8"programming mistake in Sum switch");
+            }
+        }
+
+        return retval;
+    }
+
+    std::size_t Sum::GetHash() const
+    {
+        // the order of the summands does not matter for equality, hence a commutative accumulation
+        std::size_t accumulated = 0;
+
+        for (const auto & summand : summands)
+        {
+            accumulated += HashCombine(static_cast<std::size_t>(summand.sign), summand.expression->GetHash());
+        }
+
+        return HashCombine(std::hash<std::string_view>{}(u8"Sum"), accumulated);
+    }
+
     bool Sum::operator==(const Expression &other) const
     {
         if (const auto * b = dynamic_cast<const Sum*>(&other))
@@ -97,6 +97,12 @@ namespace Backend
         Sum& operator=(const Sum&) = delete;
         Sum& operator=(Sum&&) = delete;
 
+        /*!
+         * \brief Gets the summands of the sum.
+         * \return The summands.
+         */
+        [[nodiscard]] const std::vector<Summand> & GetSummands() const;
+
         /*!
          * \reimp
          */
@@ -112,6 +118,16 @@ namespace Backend
          */
         [[nodiscard]] std::optional<complex> Evaluate(complex input) const override;
 
+        /*!
+         * \reimp
+         */
+        [[nodiscard]] ComplexInterval EvaluateInterval(const ComplexInterval & input) const override;
+
+        /*!
+         * \reimp
+         */
+        [[nodiscard]] std::size_t GetHash() const override;
+
         /*!
          * \reimp
          */
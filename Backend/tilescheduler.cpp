@@ -0,0 +1,229 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "tilescheduler.h"
+#include "complexinterval.h"
+#include "tracer.h"
+
+namespace Backend {
+
+    TileScheduler::TileScheduler(std::shared_ptr<Expression> expression, const std::vector<complex> & points, complex center, double tileSize)
+        : expression(std::move(expression)),
+          compiledExpression(this->expression),
+          center(center),
+          tileSize(tileSize),
+          orderIndex(0),
+          coarseDone(false),
+          cancelled(false)
+    {
+        for (const auto & point : points)
+        {
+            auto key = std::make_pair(
+                        static_cast<int>(std::floor((point.real() - center.real()) / tileSize)),
+                        static_cast<int>(std::floor((point.imag() - center.imag()) / tileSize)));
+
+            auto it = this->tiles.find(key);
+            if (it == this->tiles.end())
+            {
+                complex tileCenter(
+                            center.real() + (key.first + 0.5) * tileSize,
+                            center.imag() + (key.second + 0.5) * tileSize);
+
+                it = this->tiles.emplace(key, Tile{tileCenter, std::vector<complex>(), 0, std::nullopt, 0.0}).first;
+            }
+
+            auto & tile = it->second;
+            tile.points.push_back(point);
+
+            if (std::abs(point - tile.center) < std::abs(tile.points[tile.representativeIndex] - tile.center))
+            {
+                tile.representativeIndex = tile.points.size() - 1;
+            }
+        }
+    }
+
+    bool TileScheduler::HasNext() const
+    {
+        if (this->cancelled || this->tiles.empty())
+        {
+            return false;
+        }
+
+        return !this->coarseDone || this->orderIndex < this->order.size();
+    }
+
+    std::vector<Sample> TileScheduler::GetNext()
+    {
+        if (!this->HasNext())
+        {
+            return {};
+        }
+
+        if (!this->coarseDone)
+        {
+            auto coarse = this->EvaluateCoarse();
+            this->Prioritize();
+            this->coarseDone = true;
+            return coarse;
+        }
+
+        return this->EvaluateTile(this->order[this->orderIndex++]);
+    }
+
+    void TileScheduler::Cancel()
+    {
+        this->cancelled = true;
+        this->tiles.clear();
+        this->order.clear();
+    }
+
+    std::vector<Sample> TileScheduler::EvaluateCoarse()
+    {
+        TraceSpan span(u8"evaluate", u8"TileScheduler::EvaluateCoarse");
+
+        std::vector<complex> inputs;
+        inputs.reserve(this->tiles.size());
+
+        for (const auto & [key, tile] : this->tiles)
+        {
+            inputs.push_back(tile.points[tile.representativeIndex]);
+        }
+
+        std::vector<std::optional<complex>> outputs(inputs.size());
+        this->compiledExpression.EvaluateLine(inputs.data(), outputs.data(), inputs.size());
+
+        std::vector<Sample> samples;
+        samples.reserve(inputs.size());
+
+        std::size_t index = 0;
+        for (auto & [key, tile] : this->tiles)
+        {
+            tile.representativeOutput = outputs[index];
+            samples.push_back(Sample{inputs[index], outputs[index]});
+            ++index;
+        }
+
+        return samples;
+    }
+
+    std::vector<Sample> TileScheduler::EvaluateTile(const std::pair<int, int> & key)
+    {
+        TraceSpan span(u8"evaluate", u8"TileScheduler::EvaluateTile");
+
+        const auto & tile = this->tiles.at(key);
+
+        std::vector<complex> inputs;
+        inputs.reserve(tile.points.size());
+
+        for (unsigned long long index = 0; index < tile.points.size(); ++index)
+        {
+            if (index != tile.representativeIndex)
+            {
+                inputs.push_back(tile.points[index]);
+            }
+        }
+
+        std::vector<std::optional<complex>> outputs(inputs.size());
+        this->compiledExpression.EvaluateLine(inputs.data(), outputs.data(), inputs.size());
+
+        std::vector<Sample> samples;
+        samples.reserve(inputs.size());
+
+        for (std::size_t index = 0; index < inputs.size(); ++index)
+        {
+            samples.push_back(Sample{inputs[index], outputs[index]});
+        }
+
+        return samples;
+    }
+
+    double TileScheduler::GetVariation(const std::pair<int, int> & key) const
+    {
+        const auto & tile = this->tiles.at(key);
+
+        if (!tile.representativeOutput.has_value())
+        {
+            return std::numeric_limits<double>::infinity();
+        }
+
+        // a singularity may hide between the representatives
+        auto halfSize = this->tileSize / 2.0;
+        auto image = this->expression->EvaluateInterval(ComplexInterval(tile.center.real() - halfSize,
+                                                                        tile.center.real() + halfSize,
+                                                                        tile.center.imag() - halfSize,
+                                                                        tile.center.imag() + halfSize));
+
+        if (image.MayBeSingular())
+        {
+            return std::numeric_limits<double>::infinity();
+        }
+
+        const std::pair<int, int> neighbourOffsets[] = { {-1, 0}, {1, 0}, {0, -1}, {0, 1} };
+
+        double variation = 0.0;
+
+        for (const auto & offset : neighbourOffsets)
+        {
+            auto neighbour = this->tiles.find(std::make_pair(key.first + offset.first, key.second + offset.second));
+            if (neighbour == this->tiles.end())
+            {
+                continue;
+            }
+
+            if (!neighbour->second.representativeOutput.has_value())
+            {
+                return std::numeric_limits<double>::infinity();
+            }
+
+            variation = std::max(variation, std::abs(tile.representativeOutput.value() - neighbour->second.representativeOutput.value()));
+        }
+
+        return variation / this->tileSize;
+    }
+
+    void TileScheduler::Prioritize()
+    {
+        this->order.clear();
+        this->order.reserve(this->tiles.size());
+
+        for (auto & [key, tile] : this->tiles)
+        {
+            auto variation = this->GetVariation(key);
+            auto distance = std::abs(tile.center - this->center) / this->tileSize;
+
+            // tiles near the center and tiles with strongly varying output come first,
+            // tiles close to undefined points are handled before all others
+            tile.priority = std::isfinite(variation) ? distance / (1.0 + variation) : -1.0 / (1.0 + distance);
+
+            if (tile.points.size() > 1)
+            {
+                this->order.push_back(key);
+            }
+        }
+
+        std::stable_sort(this->order.begin(), this->order.end(), [&](const auto & a, const auto & b)
+        {
+            return this->tiles.at(a).priority < this->tiles.at(b).priority;
+        });
+    }
+
+}
@@ -0,0 +1,111 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TILESCHEDULER_H
+#define TILESCHEDULER_H
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "compiledexpression.h"
+#include "expression.h"
+#include "sample.h"
+
+namespace Backend {
+
+    /*!
+     * \class TileScheduler
+     * \brief The TileScheduler class provides progressive evaluation of a grid.
+     *
+     * The points are bucketed into square tiles. The first batch consists of one
+     * representative point per tile, forming a coarse grid. The remaining points
+     * are then handed out tile by tile, tiles close to the center and tiles
+     * showing a high variation between neighbouring representatives first.
+     * Tiles which may contain a singularity according to interval evaluation
+     * are treated like tiles next to undefined points.
+     * The batches are evaluated line by line by a \ref CompiledExpression.
+     */
+    class TileScheduler final
+    {
+    private:
+        struct Tile
+        {
+        public:
+            complex center;
+            std::vector<complex> points;
+            unsigned long long representativeIndex;
+            std::optional<complex> representativeOutput;
+            double priority;
+        };
+
+        std::shared_ptr<Expression> expression;
+        const CompiledExpression compiledExpression;
+        const complex center;
+        const double tileSize;
+        std::map<std::pair<int, int>, Tile> tiles;
+        std::vector<std::pair<int, int>> order;
+        unsigned long long orderIndex;
+        bool coarseDone;
+        bool cancelled;
+
+    public:
+        /*!
+         * \brief Initializes a new instance.
+         * \param expression The expression to evaluate.
+         * \param points The points to evaluate the expression at.
+         * \param center The point around which refinement shall start.
+         * \param tileSize The edge length of a tile.
+         */
+        TileScheduler(std::shared_ptr<Expression> expression, const std::vector<complex> & points, complex center, double tileSize);
+        ~TileScheduler() = default;
+        TileScheduler(const TileScheduler&) = delete;
+        TileScheduler(TileScheduler&&) = delete;
+        TileScheduler& operator=(const TileScheduler&) = delete;
+        TileScheduler& operator=(TileScheduler&&) = delete;
+
+        /*!
+         * \brief HasNext returns a value indicating whether a next batch exists.
+         * \return A value indicating whether a next batch exists.
+         */
+        [[nodiscard]] bool HasNext() const;
+
+        /*!
+         * \brief GetNext evaluates and returns the next batch.
+         *        The first batch is the coarse grid, every further batch is a single tile.
+         * \return The evaluated samples of the batch.
+         */
+        [[nodiscard]] std::vector<Sample> GetNext();
+
+        /*!
+         * \brief Cancel discards all pending work.
+         */
+        void Cancel();
+
+    private:
+        [[nodiscard]] std::vector<Sample> EvaluateCoarse();
+        [[nodiscard]] std::vector<Sample> EvaluateTile(const std::pair<int, int> & key);
+        [[nodiscard]] double GetVariation(const std::pair<int, int> & key) const;
+        void Prioritize();
+    };
+
+}
+
+#endif // TILESCHEDULER_H
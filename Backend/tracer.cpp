@@ -0,0 +1,156 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <mutex>
+#include <sstream>
+
+#include "tracer.h"
+
+namespace Backend {
+
+    namespace {
+
+        /*!
+         * \brief The TraceLog struct holds the events of the \ref Tracer.
+         */
+        struct TraceLog
+        {
+        public:
+            std::mutex mutex;
+            std::vector<Tracer::Event> events;
+            Tracer::Clock::time_point origin;
+        };
+
+        TraceLog & GetTraceLog()
+        {
+            static TraceLog log;
+            return log;
+        }
+
+        std::string EscapeJson(const char * text)
+        {
+            std::string escaped;
+
+            for (const char * character = text; *character != '\0'; ++character) //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            {
+                if (*character == '"' || *character == '\\')
+                {
+                    escaped.push_back('\\');
+                }
+
+                escaped.push_back(*character);
+            }
+
+            return escaped;
+        }
+
+    }
+
+    void Tracer::Enable()
+    {
+        auto & log = GetTraceLog();
+
+        {
+            std::lock_guard<std::mutex> lock(log.mutex);
+            log.events.clear();
+            log.origin = Clock::now();
+        }
+
+        enabled.store(true, std::memory_order_relaxed);
+    }
+
+    void Tracer::Disable()
+    {
+        enabled.store(false, std::memory_order_relaxed);
+    }
+
+    void Tracer::Record(const char * category, const char * name, Clock::time_point start, Clock::time_point end)
+    {
+        auto threadId = Tracer::GetThreadId();
+        auto & log = GetTraceLog();
+
+        std::lock_guard<std::mutex> lock(log.mutex);
+
+        // a span opened before the last Enable would get a negative time stamp
+        if (start < log.origin)
+        {
+            return;
+        }
+
+        log.events.push_back(Event{category, name, start, end, threadId});
+    }
+
+    std::vector<Tracer::Event> Tracer::GetEvents()
+    {
+        auto & log = GetTraceLog();
+
+        std::lock_guard<std::mutex> lock(log.mutex);
+        return log.events;
+    }
+
+    std::string Tracer::ToJson()
+    {
+        auto & log = GetTraceLog();
+
+        std::vector<Event> events;
+        Clock::time_point origin;
+
+        {
+            std::lock_guard<std::mutex> lock(log.mutex);
+            events = log.events;
+            origin = log.origin;
+        }
+
+        auto toMicroseconds = [](Clock::duration duration)
+        {
+            return std::chrono::duration<double, std::micro>(duration).count();
+        };
+
+        std::ostringstream stream;
+        stream.precision(3);
+        stream << std::fixed << u8"{\"traceEvents\":[";
+
+        for (std::size_t index = 0; index < events.size(); ++index)
+        {
+            const auto & event = events[index];
+
+            // complete events, with time stamp and duration in microseconds
+            stream << (index == 0 ? u8"\n" : u8",\n")
+                   << u8"{\"name\":\"" << EscapeJson(event.name)
+                   << u8"\",\"cat\":\"" << EscapeJson(event.category)
+                   << u8"\",\"ph\":\"X\",\"ts\":" << toMicroseconds(event.start - origin)
+                   << u8",\"dur\":" << toMicroseconds(event.end - event.start)
+                   << u8",\"pid\":1,\"tid\":" << event.threadId
+                   << u8"}";
+        }
+
+        stream << u8"\n],\"displayTimeUnit\":\"ms\"}\n";
+
+        return stream.str();
+    }
+
+    std::uint32_t Tracer::GetThreadId()
+    {
+        // small consecutive numbers read better in the viewer than hashed native ids
+        static std::atomic<std::uint32_t> nextThreadId{1};
+        thread_local std::uint32_t threadId = nextThreadId.fetch_add(1, std::memory_order_relaxed);
+
+        return threadId;
+    }
+
+}
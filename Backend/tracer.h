@@ -0,0 +1,154 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Backend {
+
+    /*!
+     * \class Tracer
+     * \brief The Tracer class collects timed spans of the whole program, for viewing
+     *        in the trace event format of Chrome and Perfetto.
+     *
+     * Spans are recorded by \ref TraceSpan from any thread while tracing is enabled.
+     * While disabled, a span costs a single branch and records nothing.
+     */
+    class Tracer final
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        /*!
+         * \struct Event
+         * \brief The Event struct describes a single completed span.
+         */
+        struct Event
+        {
+        public:
+            const char * category;
+            const char * name;
+            Clock::time_point start;
+            Clock::time_point end;
+            std::uint32_t threadId;
+        };
+
+    private:
+        inline static std::atomic<bool> enabled{false};
+
+    public:
+        Tracer() = delete;
+
+        /*!
+         * \brief IsEnabled tells whether spans are recorded.
+         * \return True if enabled.
+         */
+        [[nodiscard]] static bool IsEnabled()
+        {
+            return enabled.load(std::memory_order_relaxed);
+        }
+
+        /*!
+         * \brief Enable discards all events recorded so far and starts recording.
+         *        Spans still open at that time are not recorded, as they started before the new origin.
+         */
+        static void Enable();
+
+        /*!
+         * \brief Disable stops recording, keeping the events recorded so far.
+         */
+        static void Disable();
+
+        /*!
+         * \brief Record adds a completed span. Category and name must outlive the tracer, e.g. string literals.
+         * \param category The category of the span.
+         * \param name The name of the span.
+         * \param start The time the span started.
+         * \param end The time the span ended.
+         */
+        static void Record(const char * category, const char * name, Clock::time_point start, Clock::time_point end);
+
+        /*!
+         * \brief GetEvents gets a copy of the events recorded so far.
+         * \return The events in the order they completed.
+         */
+        [[nodiscard]] static std::vector<Event> GetEvents();
+
+        /*!
+         * \brief ToJson formats the events recorded so far in the trace event format.
+         * \return The JSON text.
+         */
+        [[nodiscard]] static std::string ToJson();
+
+    private:
+        [[nodiscard]] static std::uint32_t GetThreadId();
+    };
+
+    /*!
+     * \class TraceSpan
+     * \brief The TraceSpan class records the time from its construction to its destruction
+     *        as a span of the \ref Tracer, if tracing is enabled at construction.
+     */
+    class TraceSpan final
+    {
+    private:
+        const char * category;
+        const char * name;
+        bool active;
+        Tracer::Clock::time_point start;
+
+    public:
+        /*!
+         * \brief Initializes a new instance, starting the span.
+         * \param category The category of the span, a string literal.
+         * \param name The name of the span, a string literal.
+         */
+        TraceSpan(const char * category, const char * name)
+            : category(category),
+              name(name),
+              active(Tracer::IsEnabled())
+        {
+            if (this->active)
+            {
+                this->start = Tracer::Clock::now();
+            }
+        }
+
+        ~TraceSpan()
+        {
+            if (this->active)
+            {
+                Tracer::Record(this->category, this->name, this->start, Tracer::Clock::now());
+            }
+        }
+
+        TraceSpan(const TraceSpan&) = delete;
+        TraceSpan(TraceSpan&&) = delete;
+        TraceSpan& operator=(const TraceSpan&) = delete;
+        TraceSpan& operator=(TraceSpan&&) = delete;
+    };
+
+}
+
+#endif // TRACER_H
@@ -0,0 +1,207 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "tracer.h"
+#include "viewportevaluator.h"
+
+namespace Backend {
+
+    ViewportEvaluator::ViewportEvaluator(std::shared_ptr<Expression> expression, double dist)
+        : expression(std::move(expression)),
+          dist(dist),
+          separableEvaluator(this->expression, dist),
+          lastEvaluationCount(0)
+    {
+    }
+
+    ViewportEvaluator::ViewportEvaluator(const ViewportEvaluator & previous, double dist)
+        : ViewportEvaluator(previous.expression, dist)
+    {
+        auto coarsening = std::llround(dist / previous.dist);
+        auto refinement = std::llround(previous.dist / dist);
+
+        if (coarsening >= 1 && std::abs(static_cast<double>(coarsening) * previous.dist - dist) <= this->latticeTolerance * dist)
+        {
+            // only every coarsening-th point of the finer grid is on the coarser one
+            for (const auto & value : previous.values)
+            {
+                if (value.first.first % coarsening == 0 && value.first.second % coarsening == 0)
+                {
+                    this->values.emplace_hint(this->values.end(), LatticePoint(value.first.first / coarsening, value.first.second / coarsening), value.second);
+                }
+            }
+        }
+        else if (refinement >= 1 && std::abs(static_cast<double>(refinement) * dist - previous.dist) <= this->latticeTolerance * previous.dist)
+        {
+            for (const auto & value : previous.values)
+            {
+                this->values.emplace_hint(this->values.end(), LatticePoint(value.first.first * refinement, value.first.second * refinement), value.second);
+            }
+        }
+    }
+
+    double ViewportEvaluator::GetDistance() const
+    {
+        return this->dist;
+    }
+
+    std::vector<Sample> ViewportEvaluator::Evaluate(double minX, double maxX, double minY, double maxY)
+    {
+        TraceSpan span(u8"evaluate", u8"ViewportEvaluator::Evaluate");
+
+        this->Prune(minX, maxX, minY, maxY);
+        this->lastEvaluationCount = 0;
+
+        auto xFirst = static_cast<long long>(std::ceil(minX / this->dist));
+        auto xLast = static_cast<long long>(std::floor(maxX / this->dist));
+        auto yFirst = static_cast<long long>(std::ceil(minY / this->dist));
+        auto yLast = static_cast<long long>(std::floor(maxY / this->dist));
+
+        std::vector<Sample> samples;
+
+        if (xLast >= xFirst && yLast >= yFirst)
+        {
+            samples.reserve(static_cast<unsigned long long>((xLast - xFirst + 1) * (yLast - yFirst + 1)));
+            this->separableEvaluator.Tabulate(minX, maxX, minY, maxY);
+        }
+
+        for (auto x = xFirst; x <= xLast; ++x)
+        {
+            for (auto y = yFirst; y <= yLast; ++y)
+            {
+                auto input = complex(static_cast<double>(x) * this->dist, static_cast<double>(y) * this->dist);
+
+                auto it = this->values.find(LatticePoint(x, y));
+                if (it == this->values.end())
+                {
+                    it = this->values.emplace(LatticePoint(x, y), this->separableEvaluator.Evaluate(input)).first;
+                    ++this->lastEvaluationCount;
+                }
+
+                samples.push_back(Sample{input, it->second});
+            }
+        }
+
+        return samples;
+    }
+
+    std::vector<Sample> ViewportEvaluator::Collect(double minX, double maxX, double minY, double maxY, std::vector<complex> & exposed)
+    {
+        this->Prune(minX, maxX, minY, maxY);
+
+        auto xFirst = static_cast<long long>(std::ceil(minX / this->dist));
+        auto xLast = static_cast<long long>(std::floor(maxX / this->dist));
+        auto yFirst = static_cast<long long>(std::ceil(minY / this->dist));
+        auto yLast = static_cast<long long>(std::floor(maxY / this->dist));
+
+        std::vector<Sample> samples;
+        exposed.clear();
+
+        if (xLast >= xFirst && yLast >= yFirst)
+        {
+            this->separableEvaluator.Tabulate(minX, maxX, minY, maxY);
+        }
+
+        for (auto x = xFirst; x <= xLast; ++x)
+        {
+            for (auto y = yFirst; y <= yLast; ++y)
+            {
+                auto input = complex(static_cast<double>(x) * this->dist, static_cast<double>(y) * this->dist);
+
+                auto it = this->values.find(LatticePoint(x, y));
+                if (it == this->values.end())
+                {
+                    exposed.push_back(input);
+                }
+                else
+                {
+                    samples.push_back(Sample{input, it->second});
+                }
+            }
+        }
+
+        return samples;
+    }
+
+    void ViewportEvaluator::Store(const std::vector<Sample> & samples)
+    {
+        for (const auto & sample : samples)
+        {
+            auto x = std::llround(sample.input.real() / this->dist);
+            auto y = std::llround(sample.input.imag() / this->dist);
+
+            this->values[LatticePoint(x, y)] = sample.output;
+        }
+    }
+
+    const std::shared_ptr<Expression> & ViewportEvaluator::GetEvaluationExpression() const
+    {
+        return this->separableEvaluator.GetExpression();
+    }
+
+    double ViewportEvaluator::LimitDistance(double dist, double minX, double maxX, double minY, double maxY, double maxCount)
+    {
+        // doubling keeps the coarser grid a subset of the finer one
+        auto count = [&](double candidate)
+        {
+            return (std::floor((maxX - minX) / candidate) + 1.0) * (std::floor((maxY - minY) / candidate) + 1.0);
+        };
+
+        while (count(dist) > std::max(maxCount, 1.0))
+        {
+            dist *= 2.0;
+        }
+
+        return dist;
+    }
+
+    unsigned long long ViewportEvaluator::GetLastEvaluationCount() const
+    {
+        return this->lastEvaluationCount;
+    }
+
+    void ViewportEvaluator::Prune(double minX, double maxX, double minY, double maxY)
+    {
+        auto marginX = (maxX - minX) * this->retainedMargin;
+        auto marginY = (maxY - minY) * this->retainedMargin;
+
+        auto xFirst = (minX - marginX) / this->dist;
+        auto xLast = (maxX + marginX) / this->dist;
+        auto yFirst = (minY - marginY) / this->dist;
+        auto yLast = (maxY + marginY) / this->dist;
+
+        for (auto it = this->values.begin(); it != this->values.end();)
+        {
+            auto x = static_cast<double>(it->first.first);
+            auto y = static_cast<double>(it->first.second);
+
+            if (x < xFirst || x > xLast || y < yFirst || y > yLast)
+            {
+                it = this->values.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+}
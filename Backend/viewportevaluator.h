@@ -0,0 +1,149 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef VIEWPORTEVALUATOR_H
+#define VIEWPORTEVALUATOR_H
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "expression.h"
+#include "sample.h"
+#include "separableevaluator.h"
+
+namespace Backend {
+
+    /*!
+     * \class ViewportEvaluator
+     * \brief The ViewportEvaluator class evaluates an expression on the square grid
+     *        inside a changing viewport.
+     *
+     * The grid points are multiples of the grid distance. Results are kept for the
+     * points of the previous viewport, such that panning and zooming only evaluates
+     * the newly exposed points. Results far outside the current viewport are dropped.
+     * The newly exposed points may also be handed out for evaluation elsewhere,
+     * e.g. progressively by a \ref TileScheduler, and their results stored afterwards.
+     * An instance for a coarser or finer grid may take over the results on the shared points.
+     */
+    class ViewportEvaluator final
+    {
+    private:
+        using LatticePoint = std::pair<long long, long long>;
+
+        const double retainedMargin = 0.5;
+        const double latticeTolerance = 1e-9;
+
+        std::shared_ptr<Expression> expression;
+        const double dist;
+        SeparableEvaluator separableEvaluator;
+        std::map<LatticePoint, std::optional<complex>> values;
+        unsigned long long lastEvaluationCount;
+
+    public:
+        /*!
+         * \brief Initializes a new instance.
+         * \param expression The expression to evaluate.
+         * \param dist The point-to-point distance of the square grid.
+         */
+        ViewportEvaluator(std::shared_ptr<Expression> expression, double dist);
+
+        /*!
+         * \brief Initializes a new instance for the expression of a previous instance and another distance.
+         *        When one distance is a multiple of the other, e.g. after \ref LimitDistance doubled it,
+         *        the results for points on both grids are kept.
+         * \param previous The instance whose results are kept.
+         * \param dist The point-to-point distance of the square grid.
+         */
+        ViewportEvaluator(const ViewportEvaluator & previous, double dist);
+        ~ViewportEvaluator() = default;
+        ViewportEvaluator(const ViewportEvaluator&) = delete;
+        ViewportEvaluator(ViewportEvaluator&&) = delete;
+        ViewportEvaluator& operator=(const ViewportEvaluator&) = delete;
+        ViewportEvaluator& operator=(ViewportEvaluator&&) = delete;
+
+        /*!
+         * \brief GetDistance gets the point-to-point distance of the square grid.
+         * \return The point-to-point distance.
+         */
+        [[nodiscard]] double GetDistance() const;
+
+        /*!
+         * \brief Evaluate evaluates the expression on all grid points inside the viewport,
+         *        reusing the results known from previous calls.
+         * \param minX The minimum value in real/x-direction.
+         * \param maxX The maximum value in real/x-direction.
+         * \param minY The minimum value in imaginary/y-direction.
+         * \param maxY The maximum value in imaginary/y-direction.
+         * \return The samples inside the viewport.
+         */
+        [[nodiscard]] std::vector<Sample> Evaluate(double minX, double maxX, double minY, double maxY);
+
+        /*!
+         * \brief Collect gets the samples known for the grid points inside the viewport,
+         *        and the newly exposed points still to be evaluated.
+         * \param minX The minimum value in real/x-direction.
+         * \param maxX The maximum value in real/x-direction.
+         * \param minY The minimum value in imaginary/y-direction.
+         * \param maxY The maximum value in imaginary/y-direction.
+         * \param exposed Receives the points not evaluated yet.
+         * \return The samples known inside the viewport.
+         */
+        [[nodiscard]] std::vector<Sample> Collect(double minX, double maxX, double minY, double maxY, std::vector<complex> & exposed);
+
+        /*!
+         * \brief Store keeps the results of points evaluated elsewhere, e.g. those handed out by \ref Collect.
+         * \param samples The evaluated samples.
+         */
+        void Store(const std::vector<Sample> & samples);
+
+        /*!
+         * \brief GetEvaluationExpression gets the expression evaluating the grid points inside the viewport
+         *        last passed to \ref Collect fastest. Other points are evaluated correctly, but slower.
+         * \return The expression.
+         */
+        [[nodiscard]] const std::shared_ptr<Expression> & GetEvaluationExpression() const;
+
+        /*!
+         * \brief LimitDistance doubles the grid distance until the square grid inside the viewport
+         *        consists of no more than the supplied number of points.
+         * \param dist The point-to-point distance wanted.
+         * \param minX The minimum value in real/x-direction.
+         * \param maxX The maximum value in real/x-direction.
+         * \param minY The minimum value in imaginary/y-direction.
+         * \param maxY The maximum value in imaginary/y-direction.
+         * \param maxCount The maximum number of points.
+         * \return The point-to-point distance to use.
+         */
+        [[nodiscard]] static double LimitDistance(double dist, double minX, double maxX, double minY, double maxY, double maxCount);
+
+        /*!
+         * \brief GetLastEvaluationCount gets the number of points actually evaluated by the last call to \ref Evaluate.
+         * \return The number of points evaluated.
+         */
+        [[nodiscard]] unsigned long long GetLastEvaluationCount() const;
+
+    private:
+        void Prune(double minX, double maxX, double minY, double maxY);
+    };
+
+}
+
+#endif // VIEWPORTEVALUATOR_H
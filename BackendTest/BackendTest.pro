@@ -33,17 +33,34 @@ HEADERS += \
         SubsetGenerator.h \
         doublehelper.h \
         tst_basez.h \
+        tst_compiledexpression.h \
+        tst_complexinterval.h \
         tst_complexmatcher.h \
         tst_constant.h \
         tst_functions.h \
+        tst_fusedevaluator.h \
         tst_fundamental.h \
         tst_equality.h \
+        tst_expressionprofiler.h \
+        tst_expressiontemplate.h \
+        tst_framepipeline.h \
         tst_gridgenerator.h \
+        tst_orbitevaluator.h \
+        tst_parallelfor.h \
+        tst_parameter.h \
         tst_parser.h \
         tst_power.h \
         tst_product.h \
+        tst_rationalfunction.h \
+        tst_resultcache.h \
+        tst_rootfinder.h \
+        tst_separableevaluator.h \
+        tst_streamlinetracer.h \
         tst_subsetgenerator.h \
-        tst_sum.h
+        tst_sum.h \
+        tst_tilescheduler.h \
+        tst_tracer.h \
+        tst_viewportevaluator.h
 
 SOURCES += \
         SubsetGenerator.cpp \
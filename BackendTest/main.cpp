@@ -19,17 +19,34 @@
 #include <gtest/gtest.h>
 
 #include "tst_basez.h"
+#include "tst_compiledexpression.h"
+#include "tst_complexinterval.h"
 #include "tst_complexmatcher.h"
 #include "tst_constant.h"
 #include "tst_equality.h"
+#include "tst_expressionprofiler.h"
+#include "tst_expressiontemplate.h"
+#include "tst_framepipeline.h"
 #include "tst_functions.h"
+#include "tst_fusedevaluator.h"
 #include "tst_fundamental.h"
 #include "tst_parser.h"
 #include "tst_gridgenerator.h"
+#include "tst_orbitevaluator.h"
+#include "tst_parallelfor.h"
+#include "tst_parameter.h"
 #include "tst_power.h"
 #include "tst_product.h"
+#include "tst_rationalfunction.h"
+#include "tst_resultcache.h"
+#include "tst_rootfinder.h"
+#include "tst_separableevaluator.h"
+#include "tst_streamlinetracer.h"
 #include "tst_subsetgenerator.h"
 #include "tst_sum.h"
+#include "tst_tilescheduler.h"
+#include "tst_tracer.h"
+#include "tst_viewportevaluator.h"
 
 int main(int argc, char *argv[])
 {
@@ -0,0 +1,278 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TST_COMPILEDEXPRESSION_H
+#define TST_COMPILEDEXPRESSION_H
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../Backend/basez.h"
+#include "../Backend/compiledexpression.h"
+#include "../Backend/constant.h"
+#include "../Backend/functions.h"
+#include "../Backend/gridgenerator.h"
+#include "../Backend/parser.h"
+#include "../Backend/power.h"
+
+namespace {
+
+    bool AreSame(double left, double right)
+    {
+        return (std::isnan(left) && std::isnan(right)) || left == right;
+    }
+
+    bool AreSame(const std::optional<Backend::complex> & left, const std::optional<Backend::complex> & right)
+    {
+        if (!left.has_value() || !right.has_value())
+        {
+            return left.has_value() == right.has_value();
+        }
+
+        return AreSame(left.value().real(), right.value().real()) && AreSame(left.value().imag(), right.value().imag());
+    }
+
+    void ExpectAgreementWithTree(const std::shared_ptr<Backend::Expression> & expression, const std::vector<Backend::complex> & inputs)
+    {
+        Backend::CompiledExpression native(expression);
+        Backend::CompiledExpression interpreted(expression, false);
+
+        std::vector<std::optional<Backend::complex>> nativeOutputs(inputs.size());
+        std::vector<std::optional<Backend::complex>> interpretedOutputs(inputs.size());
+        native.EvaluateLine(inputs.data(), nativeOutputs.data(), inputs.size());
+        interpreted.EvaluateLine(inputs.data(), interpretedOutputs.data(), inputs.size());
+
+        EXPECT_EQ(Backend::CompiledExpression::IsNativeCodeAvailable(), native.IsNative());
+        EXPECT_FALSE(interpreted.IsNative());
+
+        for (std::size_t index = 0; index < inputs.size(); ++index)
+        {
+            auto expected = expression->Evaluate(inputs[index]);
+
+            EXPECT_TRUE(AreSame(expected, nativeOutputs[index])) << "at " << inputs[index];
+            EXPECT_TRUE(AreSame(expected, interpretedOutputs[index])) << "at " << inputs[index];
+            EXPECT_TRUE(AreSame(expected, interpreted.Evaluate(inputs[index]))) << "at " << inputs[index];
+        }
+    }
+
+    double GetSinglePrecisionDeviation(const std::string & formula, const std::vector<Backend::complex> & inputs)
+    {
+        Backend::Parser parser(true);
+        auto expression = parser.Parse(formula);
+        Backend::CompiledExpression compiled(expression);
+
+        std::vector<Backend::complexf> singleInputs(inputs.begin(), inputs.end());
+        std::vector<std::optional<Backend::complex>> doubleOutputs(inputs.size());
+        std::vector<std::optional<Backend::complexf>> singleOutputs(inputs.size());
+
+        auto start = std::chrono::steady_clock::now();
+        compiled.EvaluateLine(inputs.data(), doubleOutputs.data(), inputs.size());
+        auto middle = std::chrono::steady_clock::now();
+        compiled.EvaluateLine(singleInputs.data(), singleOutputs.data(), singleInputs.size());
+        auto end = std::chrono::steady_clock::now();
+
+        std::ostringstream timings;
+        timings << "ms double " << std::chrono::duration<double, std::milli>(middle - start).count()
+                << ", single " << std::chrono::duration<double, std::milli>(end - middle).count();
+        ::testing::Test::RecordProperty(formula, timings.str());
+
+        // relative to the magnitude, absolute below one
+        double deviation = 0.0;
+
+        for (std::size_t index = 0; index < inputs.size(); ++index)
+        {
+            EXPECT_EQ(doubleOutputs[index].has_value(), singleOutputs[index].has_value()) << formula << " at " << inputs[index];
+
+            if (doubleOutputs[index].has_value() && singleOutputs[index].has_value())
+            {
+                auto expected = doubleOutputs[index].value();
+                auto actual = Backend::complex(singleOutputs[index]->real(), singleOutputs[index]->imag());
+                deviation = std::max(deviation, std::abs(expected - actual) / (1.0 + std::abs(expected)));
+            }
+        }
+
+        return deviation;
+    }
+
+}
+
+TEST(BackendTest, CompiledExpressionShallAgreeWithTreeOnFunctionCases)
+{
+    using namespace std::complex_literals;
+
+    // Arrange
+    auto z = std::make_shared<Backend::BaseZ>();
+    std::vector<Backend::complex> inputs({ 0.8+0.1i, -3.0+2.0i, 1.0-2.0i, 0.0, -1.0, 4.0, 0.5i, 1e300, -800.0+1.0i });
+
+    // Act, Assert
+    for (const auto & entry : Backend::FunctionTable)
+    {
+        ExpectAgreementWithTree(entry.create(z), inputs);
+    }
+}
+
+TEST(BackendTest, CompiledExpressionShallAgreeWithTreeOnPowerCases)
+{
+    using namespace std::complex_literals;
+
+    // Arrange
+    auto z = std::make_shared<Backend::BaseZ>();
+    std::vector<std::shared_ptr<Backend::Constant>> constants(
+        {
+            std::make_shared<Backend::Constant>(3.0),
+            std::make_shared<Backend::Constant>(2.0),
+            std::make_shared<Backend::Constant>(-2.0),
+            std::make_shared<Backend::Constant>(0.5),
+            std::make_shared<Backend::Constant>(0.333333333),
+            std::make_shared<Backend::Constant>(0.0+1.0i),
+            std::make_shared<Backend::Constant>(0.5+0.3i),
+            std::make_shared<Backend::Constant>(0.0+0.333333333i),
+        });
+    std::vector<Backend::complex> inputs({ 0.0, -4.5, 2.0, 1.5, 1.0, 9.0, -9.0, 8.0, -8.0, 3.0, 1.0i, 1.0-2.0i, 8.0+0.1i });
+
+    // Act, Assert
+    for (const auto & constant : constants)
+    {
+        ExpectAgreementWithTree(std::make_shared<Backend::Power>(constant, z), inputs);
+        ExpectAgreementWithTree(std::make_shared<Backend::Power>(z, constant), inputs);
+    }
+}
+
+TEST(BackendTest, CompiledExpressionShallAgreeWithTreeOnFormulas)
+{
+    // Arrange
+    Backend::Parser parser(false, {u8"a"});
+    Backend::GridGenerator gridGenerator(-2.0, 2.0, -2.0, 2.0);
+    auto grid = gridGenerator.CreateSquare(0.125);
+    grid.emplace_back(0.0, -0.0);
+    grid.emplace_back(-0.0, -0.0);
+    grid.emplace_back(1e200, 1e200);
+    grid.emplace_back(-1e300, 1.0);
+
+    std::vector<std::string> formulas(
+        {
+            u8"z*z*z-3*z+2",
+            u8"(z^2+1)/(z-i)-sin(z)*cos(z)",
+            u8"-z",
+            u8"ln(-z)-ln(z)",
+            u8"sqrt(-1-z*z)",
+            u8"exp(z)*z^z/(conj(z)+0.5)",
+            u8"1/(1/z)+a*z",
+            u8"(2+3)*z-(4/2)",
+            u8"tan(z)*z*z*z*z*z*z*z*z*z*z*z*z*z*z*z*z*z*z*z*z*z*z*z*z*z*z*z*z*z*z*z*z*z*z*z*z*z*z*z*z*z",
+        });
+
+    // Act, Assert
+    for (const auto & formula : formulas)
+    {
+        auto expression = parser.Parse(formula);
+        ASSERT_NE(nullptr, expression) << formula;
+
+        ExpectAgreementWithTree(expression, grid);
+    }
+}
+
+TEST(BackendTest, CompiledExpressionShallCompileSharedSubtreesOnce)
+{
+    // Arrange
+    auto z = std::make_shared<Backend::BaseZ>();
+    auto sine = std::make_shared<Backend::Sine>(z);
+    auto power = std::make_shared<Backend::Power>(sine, sine);
+
+    // Act
+    Backend::CompiledExpression compiled(power);
+
+    // Assert
+    ASSERT_EQ(2, compiled.GetProgram().size());
+    EXPECT_EQ(Backend::CompiledExpression::OpCode::Function, compiled.GetProgram()[0].opCode);
+    EXPECT_EQ(Backend::CompiledExpression::OpCode::Power, compiled.GetProgram()[1].opCode);
+}
+
+TEST(BackendTest, CompiledExpressionShallEvaluateSinglePrecisionCloseToDoublePrecision)
+{
+    // Arrange
+    Backend::GridGenerator gridGenerator(-2.0, 2.0, -2.0, 2.0);
+    auto grid = gridGenerator.CreateSquare(0.01);
+
+    std::vector<std::string> formulas(
+        {
+            u8"z*z*z-3*z+2",
+            u8"(z^2+1)/(z^2-1)",
+            u8"sin(z)*exp(z)/(z*z+1)",
+            u8"sqrt(z)+ln(z)",
+            u8"cos(z)^2+sin(z)^2",
+        });
+
+    for (const auto & formula : formulas)
+    {
+        // Act
+        auto deviation = GetSinglePrecisionDeviation(formula, grid);
+
+        // Assert
+        // the inputs are rounded to single precision as well,
+        // measured are up to 2.3e-6, i.e. about 20 units of the single precision epsilon 1.2e-7
+        EXPECT_LT(deviation, 1e-5) << formula;
+    }
+}
+
+TEST(BackendTest, CompiledExpressionShallLoseSinglePrecisionUnderCancellation)
+{
+    // Arrange
+    Backend::GridGenerator gridGenerator(-2.0, 2.0, -2.0, 2.0);
+    auto grid = gridGenerator.CreateSquare(0.01);
+
+    // Act
+    auto deviation = GetSinglePrecisionDeviation(u8"(z+1)^6-(z^6+6*z^5+15*z^4+20*z^3+15*z^2+6*z+1)", grid);
+
+    // Assert
+    // the difference of two terms of magnitude up to 729 keeps no more than a few significant digits,
+    // measured is 6.1e-4
+    EXPECT_GT(deviation, 1e-4);
+    EXPECT_LT(deviation, 1e-2);
+}
+
+TEST(BackendTest, CompiledExpressionShallOverflowEarlierInSinglePrecision)
+{
+    // Arrange
+    Backend::Parser parser(true);
+    Backend::CompiledExpression compiled(parser.Parse(u8"exp(z)"));
+    std::vector<Backend::complex> doubleInputs({ 80.0, 100.0 });
+    std::vector<Backend::complexf> singleInputs({ 80.0F, 100.0F });
+    std::vector<std::optional<Backend::complex>> doubleOutputs(doubleInputs.size());
+    std::vector<std::optional<Backend::complexf>> singleOutputs(singleInputs.size());
+
+    // Act
+    compiled.EvaluateLine(doubleInputs.data(), doubleOutputs.data(), doubleInputs.size());
+    compiled.EvaluateLine(singleInputs.data(), singleOutputs.data(), singleInputs.size());
+
+    // Assert
+    // single precision ends at exp(88.7)
+    EXPECT_TRUE(doubleOutputs[0].has_value());
+    EXPECT_TRUE(doubleOutputs[1].has_value());
+    EXPECT_TRUE(singleOutputs[0].has_value());
+    EXPECT_FALSE(singleOutputs[1].has_value());
+}
+
+#endif // TST_COMPILEDEXPRESSION_H
@@ -0,0 +1,175 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TST_COMPLEXINTERVAL_H
+#define TST_COMPLEXINTERVAL_H
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../Backend/complexinterval.h"
+#include "../Backend/parser.h"
+
+namespace {
+    const int boundsSteps = 20;
+
+    struct BoundsCase
+    {
+        std::string input;
+        double minX;
+        double maxX;
+        double minY;
+        double maxY;
+    };
+
+    struct BoundsCheck
+    {
+        std::string input;
+        Backend::complex z;
+        bool defined;
+        bool contained;
+        bool flaggedSingular;
+    };
+
+    std::vector<BoundsCheck> CheckBoundsAgainstSamples(const BoundsCase & boundsCase)
+    {
+        Backend::Parser parser(true);
+        auto expression = parser.Parse(boundsCase.input);
+
+        if (!expression)
+        {
+            return {};
+        }
+
+        auto bounds = expression->EvaluateInterval(Backend::ComplexInterval(boundsCase.minX, boundsCase.maxX, boundsCase.minY, boundsCase.maxY));
+
+        std::vector<BoundsCheck> checks;
+
+        for (int x = 0; x <= boundsSteps; ++x)
+        {
+            for (int y = 0; y <= boundsSteps; ++y)
+            {
+                auto z = Backend::complex(boundsCase.minX + (boundsCase.maxX - boundsCase.minX) * x / boundsSteps,
+                                          boundsCase.minY + (boundsCase.maxY - boundsCase.minY) * y / boundsSteps);
+                auto result = expression->Evaluate(z);
+
+                checks.push_back(BoundsCheck{boundsCase.input, z, result.has_value(), result.has_value() && bounds.Contains(result.value()), bounds.MayBeSingular()});
+            }
+        }
+
+        return checks;
+    }
+}
+
+TEST(BackendTest, ComplexIntervalShallContainAllEvaluations)
+{
+    // Arrange
+    const std::vector<BoundsCase> cases = {
+        {"z", -1.0, 2.0, 0.5, 1.5},
+        {"z*z-2*z+i", -1.0, 2.0, 0.5, 1.5},
+        {"1/(z+3)", -1.0, 2.0, 0.5, 1.5},
+        {"z^3", -1.0, 2.0, -0.5, 1.5},
+        // the sample lattices of these contain zero
+        {"z^2", -1.0, 1.0, -1.0, 1.0},
+        {"z^3", -2.0, 2.0, -1.0, 1.0},
+        {"z^2+1", -1.0, 1.0, -2.0, 2.0},
+        {"z^(0-2)", -1.0, 1.0, -1.0, 1.0},
+        {"z^0.5", -1.0, 1.0, -1.0, 1.0},
+        {"z^z", -1.0, 1.0, -1.0, 1.0},
+        {"z^(0-2)", 1.0, 2.0, -0.5, 1.5},
+        {"z^(0.5*i)", 1.0, 2.0, -0.5, 1.5},
+        {"abs(z)+Re(z)*Im(z)+norm(z)+conj(z)", -1.0, 2.0, -0.5, 1.5},
+        {"sin(z)+cos(z)", -4.0, 4.0, -1.0, 1.5},
+        {"tan(z)", 0.2, 1.2, -1.0, 1.0},
+        {"sqrt(z)", -2.0, 2.0, -1.0, 1.0},
+        {"exp(z)", -1.0, 2.0, -4.0, 4.0},
+        {"ln(z)", -2.0, -1.0, -1.0, 1.0},
+        {"ln(z)", 0.5, 2.0, 0.5, 1.0},
+        {"log10(z)+arg(z)", -2.0, 1.0, -1.0, 1.0},
+        {"sinh(z)+cosh(z)", -1.5, 2.0, -4.0, 4.0},
+        {"tanh(z)", -1.0, 1.0, -1.0, 1.0},
+        {"asin(z)+acos(z)", -0.5, 0.5, -1.0, 1.0},
+        {"asin(z)", 0.5, 2.0, -0.5, 0.5},
+        {"atan(z)", -2.0, 2.0, -0.5, 0.5},
+        {"expi(z)", -4.0, 4.0, -1.0, 2.0},
+    };
+
+    // Act
+    std::vector<BoundsCheck> checks;
+
+    for (const auto & boundsCase : cases)
+    {
+        auto caseChecks = CheckBoundsAgainstSamples(boundsCase);
+        checks.insert(checks.end(), caseChecks.begin(), caseChecks.end());
+    }
+
+    // Assert
+    ASSERT_EQ(cases.size() * (boundsSteps + 1) * (boundsSteps + 1), checks.size());
+
+    for (const auto & check : checks)
+    {
+        if (check.defined)
+        {
+            EXPECT_TRUE(check.contained) << check.input << " at " << check.z;
+        }
+        else
+        {
+            EXPECT_TRUE(check.flaggedSingular) << check.input << " at " << check.z;
+        }
+    }
+}
+
+TEST(BackendTest, ComplexIntervalShallFlagPossibleSingularities)
+{
+    // Arrange
+    Backend::Parser parser(true);
+    auto reciprocal = parser.Parse("1/z");
+    auto logarithm = parser.Parse("ln(z)");
+    auto root = parser.Parse("sqrt(z)");
+
+    Backend::ComplexInterval aroundZero(-0.5, 0.5, -0.5, 0.5);
+    Backend::ComplexInterval awayFromZero(1.0, 2.0, -0.5, 0.5);
+
+    // Act, Assert
+    EXPECT_TRUE(reciprocal->EvaluateInterval(aroundZero).MayBeSingular());
+    EXPECT_FALSE(reciprocal->EvaluateInterval(awayFromZero).MayBeSingular());
+    EXPECT_TRUE(reciprocal->EvaluateInterval(awayFromZero).IsBounded());
+    EXPECT_TRUE(logarithm->EvaluateInterval(aroundZero).MayBeSingular());
+    EXPECT_FALSE(logarithm->EvaluateInterval(awayFromZero).MayBeSingular());
+    EXPECT_FALSE(root->EvaluateInterval(aroundZero).MayBeSingular());
+}
+
+TEST(BackendTest, ComplexIntervalShallDetectIntersection)
+{
+    // Arrange
+    Backend::Parser parser(true);
+    auto expression = parser.Parse("z+10");
+
+    // Act
+    auto bounds = expression->EvaluateInterval(Backend::ComplexInterval(-1.0, 1.0, -1.0, 1.0));
+
+    // Assert
+    EXPECT_FALSE(bounds.Intersects(-5.0, 5.0, -5.0, 5.0));
+    EXPECT_TRUE(bounds.Intersects(-10.0, 10.0, -10.0, 10.0));
+    EXPECT_NEAR(2.0, bounds.GetExtent(), 1e-9);
+}
+
+#endif // TST_COMPLEXINTERVAL_H
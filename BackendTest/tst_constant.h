@@ -44,4 +44,26 @@ TEST(BackendTest, ConstantShallEvaluateCorrectly)
     EXPECT_THAT(result2.value(), COMPLEX_NEAR(1.0+2.0i));
 }
 
+TEST(BackendTest, ConstantsShallOnlyBeEqualWithEqualImaginaryParts)
+{
+    using namespace std::complex_literals;
+
+    // Arrange
+    Backend::Constant c(-3.0+2.0i);
+    Backend::Constant same(-3.0+2.0i);
+    Backend::Constant conjugate(-3.0-2.0i);
+    Backend::Constant real(-3.0);
+
+    // Act
+    bool sameIsEqual = c == same;
+    bool conjugateIsEqual = c == conjugate;
+    bool realIsEqual = c == real;
+
+    // Assert
+    EXPECT_TRUE(sameIsEqual);
+    EXPECT_FALSE(conjugateIsEqual);
+    EXPECT_FALSE(realIsEqual);
+    EXPECT_TRUE(c != conjugate);
+}
+
 #endif // TST_CONSTANT_H
@@ -0,0 +1,142 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TST_EXPRESSIONPROFILER_H
+#define TST_EXPRESSIONPROFILER_H
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+#include "../Backend/basez.h"
+#include "../Backend/expressionprofiler.h"
+#include "../Backend/functions.h"
+#include "../Backend/gridgenerator.h"
+#include "../Backend/parser.h"
+#include "../Backend/sum.h"
+
+TEST(BackendTest, ExpressionProfilerShallAgreeWithDirectEvaluation)
+{
+    // Arrange
+    Backend::Parser parser(true);
+    auto expression = parser.Parse(u8"sin(z^2)*exp(z)+1/(z-1)-ln(z)");
+    Backend::GridGenerator gridGenerator(-2.0, 2.0, -2.0, 2.0);
+    auto grid = gridGenerator.CreateSquare(0.25);
+
+    // Act
+    Backend::ExpressionProfiler profiler(expression);
+
+    // Assert
+    for (const auto & input : grid)
+    {
+        EXPECT_EQ(expression->Evaluate(input), profiler.GetExpression()->Evaluate(input));
+    }
+
+    EXPECT_EQ(expression->GetHash(), profiler.GetExpression()->GetHash());
+}
+
+TEST(BackendTest, ExpressionProfilerShallCountEvaluationsAndUndefinedResults)
+{
+    // Arrange
+    auto logarithm = std::make_shared<Backend::NaturalLogarithm>(std::make_shared<Backend::BaseZ>());
+    auto expression = std::make_shared<Backend::Sum>(std::vector<Backend::Sum::Summand>(
+        {
+            Backend::Sum::Summand(Backend::Sum::Sign::Plus, logarithm),
+            Backend::Sum::Summand(Backend::Sum::Sign::Minus, std::make_shared<Backend::BaseZ>()),
+        }));
+    std::vector<Backend::complex> inputs({ 0.0, 1.0, 2.0 });
+    Backend::ExpressionProfiler profiler(expression);
+
+    // Act
+    for (const auto & input : inputs)
+    {
+        (void)profiler.GetExpression()->Evaluate(input);
+    }
+
+    auto report = profiler.GetReport();
+
+    // Assert
+    ASSERT_EQ(4, report.size());
+
+    EXPECT_EQ(u8"sum", report[0].label);
+    EXPECT_EQ(0, report[0].depth);
+    EXPECT_EQ(3, report[0].evaluationCount);
+    EXPECT_EQ(1, report[0].undefinedCount);
+
+    EXPECT_EQ(u8"+ ln", report[1].label);
+    EXPECT_EQ(1, report[1].depth);
+    EXPECT_EQ(3, report[1].evaluationCount);
+    EXPECT_EQ(1, report[1].undefinedCount);
+
+    EXPECT_EQ(u8"z", report[2].label);
+    EXPECT_EQ(2, report[2].depth);
+    EXPECT_EQ(3, report[2].evaluationCount);
+    EXPECT_EQ(0, report[2].undefinedCount);
+
+    // the sum stops at the first undefined summand
+    EXPECT_EQ(u8"- z", report[3].label);
+    EXPECT_EQ(1, report[3].depth);
+    EXPECT_EQ(2, report[3].evaluationCount);
+    EXPECT_EQ(0, report[3].undefinedCount);
+}
+
+TEST(BackendTest, ExpressionProfilerShallReportTimesAndReset)
+{
+    // Arrange
+    Backend::Parser parser(true);
+    auto expression = parser.Parse(u8"tan(sin(z)*cosh(z))+z");
+    Backend::GridGenerator gridGenerator(-2.0, 2.0, -2.0, 2.0);
+    auto grid = gridGenerator.CreateSquare(0.05);
+    Backend::ExpressionProfiler profiler(expression, 4);
+
+    // Act
+    for (const auto & input : grid)
+    {
+        (void)profiler.GetExpression()->Evaluate(input);
+    }
+
+    auto report = profiler.GetReport();
+    auto text = profiler.FormatReport();
+    profiler.Reset();
+    auto resetReport = profiler.GetReport();
+
+    // Assert
+    ASSERT_FALSE(report.empty());
+    EXPECT_EQ(grid.size(), report[0].evaluationCount);
+    EXPECT_GT(report[0].time, 0.0);
+
+    for (const auto & entry : report)
+    {
+        EXPECT_GE(entry.time, 0.0);
+        EXPECT_GE(entry.selfTime, 0.0);
+        EXPECT_LE(entry.selfTime, entry.time);
+    }
+
+    EXPECT_THAT(text, ::testing::HasSubstr(u8"tan"));
+    EXPECT_THAT(text, ::testing::HasSubstr(u8"hot node: "));
+
+    for (const auto & entry : resetReport)
+    {
+        EXPECT_EQ(0, entry.evaluationCount);
+        EXPECT_EQ(0, entry.undefinedCount);
+        EXPECT_EQ(0.0, entry.time);
+    }
+}
+
+#endif // TST_EXPRESSIONPROFILER_H
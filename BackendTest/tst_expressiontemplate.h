@@ -0,0 +1,257 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TST_EXPRESSIONTEMPLATE_H
+#define TST_EXPRESSIONTEMPLATE_H
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../Backend/compiledexpression.h"
+#include "../Backend/expressiontemplate.h"
+#include "../Backend/functions.h"
+#include "../Backend/fusedevaluator.h"
+#include "../Backend/gridgenerator.h"
+#include "../Backend/parser.h"
+#include "../Backend/separableevaluator.h"
+
+namespace {
+
+    void ExpectNear(const std::optional<Backend::complex> & expected, const std::optional<Backend::complex> & actual, Backend::complex input)
+    {
+        ASSERT_EQ(expected.has_value(), actual.has_value()) << "at " << input;
+
+        if (expected.has_value())
+        {
+            EXPECT_LE(std::abs(expected.value() - actual.value()), 1e-12 * (1.0 + std::abs(expected.value()))) << "at " << input;
+        }
+    }
+
+    template<typename Template>
+    void ExpectAgreementWithTree(const std::string & formula, const Template & expressionTemplate, const std::vector<Backend::complex> & inputs)
+    {
+        Backend::Parser parser(true);
+        auto expression = parser.Parse(formula);
+        ASSERT_NE(nullptr, expression) << formula;
+
+        std::vector<std::optional<Backend::complex>> outputs(inputs.size());
+        Backend::Templates::EvaluateLine(expressionTemplate, inputs.data(), outputs.data(), inputs.size());
+
+        for (std::size_t index = 0; index < inputs.size(); ++index)
+        {
+            ExpectNear(expression->Evaluate(inputs[index]), outputs[index], inputs[index]);
+        }
+    }
+
+    double MeasureMilliseconds(const std::function<void()> & action)
+    {
+        auto start = std::chrono::steady_clock::now();
+        action();
+        auto end = std::chrono::steady_clock::now();
+
+        return std::chrono::duration<double, std::milli>(end - start).count();
+    }
+
+    template<typename Template>
+    void CompareEngines(const std::string & formula, const Template & expressionTemplate, double dist)
+    {
+        Backend::Parser parser(true);
+        auto expression = parser.Parse(formula);
+        ASSERT_NE(nullptr, expression) << formula;
+
+        Backend::GridGenerator gridGenerator(-2.0, 2.0, -2.0, 2.0);
+        auto grid = gridGenerator.CreateSquare(dist);
+
+        std::size_t columnLength = 1;
+        while (columnLength < grid.size() && grid[columnLength].real() == grid[0].real())
+        {
+            ++columnLength;
+        }
+
+        std::vector<std::optional<Backend::complex>> reference(grid.size());
+        std::vector<std::optional<Backend::complex>> outputs(grid.size());
+
+        auto templateTime = MeasureMilliseconds([&]
+        {
+            Backend::Templates::EvaluateLine(expressionTemplate, grid.data(), reference.data(), grid.size());
+        });
+
+        auto treeTime = MeasureMilliseconds([&]
+        {
+            for (std::size_t index = 0; index < grid.size(); ++index)
+            {
+                outputs[index] = expression->Evaluate(grid[index]);
+            }
+        });
+
+        for (std::size_t index = 0; index < grid.size(); ++index)
+        {
+            ExpectNear(reference[index], outputs[index], grid[index]);
+        }
+
+        Backend::CompiledExpression interpreted(expression, false);
+        auto interpretedTime = MeasureMilliseconds([&]
+        {
+            interpreted.EvaluateLine(grid.data(), outputs.data(), grid.size());
+        });
+
+        for (std::size_t index = 0; index < grid.size(); ++index)
+        {
+            ExpectNear(reference[index], outputs[index], grid[index]);
+        }
+
+        Backend::CompiledExpression native(expression);
+        auto nativeTime = MeasureMilliseconds([&]
+        {
+            native.EvaluateLine(grid.data(), outputs.data(), grid.size());
+        });
+
+        for (std::size_t index = 0; index < grid.size(); ++index)
+        {
+            ExpectNear(reference[index], outputs[index], grid[index]);
+        }
+
+        // the tables are setup like compiling, so they are timed on their own
+        Backend::SeparableEvaluator separable(expression, dist);
+        auto tabulateTime = MeasureMilliseconds([&]
+        {
+            separable.Tabulate(-2.0, 2.0, -2.0, 2.0);
+        });
+
+        auto separableTime = MeasureMilliseconds([&]
+        {
+            for (std::size_t start = 0; start < grid.size(); start += columnLength)
+            {
+                separable.EvaluateLine(grid.data() + start, outputs.data() + start, std::min(columnLength, grid.size() - start)); //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            }
+        });
+
+        for (std::size_t index = 0; index < grid.size(); ++index)
+        {
+            ExpectNear(reference[index], outputs[index], grid[index]);
+        }
+
+        Backend::FusedEvaluator fused({ expression });
+        std::vector<std::vector<Backend::Sample>> fusedSamples;
+        auto fusedTime = MeasureMilliseconds([&]
+        {
+            fusedSamples = fused.EvaluateAll(grid);
+        });
+
+        ASSERT_EQ(1, fusedSamples.size());
+        ASSERT_EQ(grid.size(), fusedSamples[0].size());
+
+        for (std::size_t index = 0; index < grid.size(); ++index)
+        {
+            ExpectNear(reference[index], fusedSamples[0][index].output, grid[index]);
+        }
+
+        // the timings go to the test report instead of the console
+        std::ostringstream timings;
+        timings << grid.size() << " points, in ms:"
+                << " template " << templateTime
+                << ", tree " << treeTime
+                << ", interpreted " << interpretedTime
+                << ", native " << nativeTime
+                << ", separable " << separableTime << " (tabulate " << tabulateTime << ")"
+                << ", fused " << fusedTime;
+
+        ::testing::Test::RecordProperty(formula, timings.str());
+    }
+
+}
+
+TEST(BackendTest, ExpressionTemplateShallAgreeWithTree)
+{
+    using namespace Backend::Templates;
+    using namespace std::complex_literals;
+
+    // Arrange
+    Backend::GridGenerator gridGenerator(-2.0, 2.0, -2.0, 2.0);
+    auto grid = gridGenerator.CreateSquare(0.125);
+
+    // Act, Assert
+    ExpectAgreementWithTree(u8"z*z+1", Z{} * Z{} + Const(1), grid);
+    ExpectAgreementWithTree(u8"z*z*z-3*z+2", Z{} * Z{} * Z{} - Const(3) * Z{} + Const(2), grid);
+    ExpectAgreementWithTree(u8"-z/(z-1)", -Z{} / (Z{} - Const(1)), grid);
+    ExpectAgreementWithTree(u8"z^(0.5+0.3i)", Pow(Z{}, Const(0.5+0.3i)), grid);
+    ExpectAgreementWithTree(u8"sin(z)*exp(z)/(z*z+1)",
+                            Apply<Backend::SineKernel>(Z{}) * Apply<Backend::NaturalExponentialKernel>(Z{}) / (Z{} * Z{} + Const(1)),
+                            grid);
+    ExpectAgreementWithTree(u8"ln(z)", Apply<Backend::NaturalLogarithmKernel>(Z{}), grid);
+}
+
+TEST(BackendTest, ExpressionTemplateShallBeUndefinedLikeTheNodes)
+{
+    using namespace Backend::Templates;
+
+    // Arrange
+    auto quotient = Const(1) / (Z{} - Const(1));
+    auto power = Pow(Z{}, Const(-1));
+    auto logarithm = Apply<Backend::NaturalLogarithmKernel>(Z{}) + Z{};
+    auto reciprocal = Const(1) / Apply<Backend::NaturalExponentialKernel>(Z{});
+
+    // Act
+    auto quotientResult = quotient.Evaluate(Backend::complex(1.0));
+    auto powerResult = power.Evaluate(Backend::complex(0.0));
+    auto logarithmResult = logarithm.Evaluate(Backend::complex(0.0));
+    auto reciprocalResult = reciprocal.Evaluate(Backend::complex(1000.0));
+    auto definedResult = reciprocal.Evaluate(Backend::complex(0.0));
+
+    // Assert
+    EXPECT_FALSE(quotientResult.has_value());
+    EXPECT_FALSE(powerResult.has_value());
+    EXPECT_FALSE(logarithmResult.has_value());
+    // the overflow of the exponential is caught once for the point, although 1/inf is finite
+    EXPECT_FALSE(reciprocalResult.has_value());
+    ASSERT_TRUE(definedResult.has_value());
+    EXPECT_DOUBLE_EQ(1.0, definedResult.value().real());
+}
+
+TEST(BackendTest, ExpressionTemplateShallBeTheReferenceForAllEngines)
+{
+    using namespace Backend::Templates;
+    using namespace std::complex_literals;
+
+    // Arrange
+#ifdef _SKIP_LONG_TEST
+    const double dist = 0.02;
+#else // _USE_LONG_TEST
+    const double dist = 0.004;
+#endif // _SKIP_LONG_TEST
+
+    // Act, Assert
+    CompareEngines(u8"z*z*z-3*z+2", Z{} * Z{} * Z{} - Const(3) * Z{} + Const(2), dist);
+    CompareEngines(u8"(z*z+1)/(z*z-4)", (Z{} * Z{} + Const(1)) / (Z{} * Z{} - Const(4)), dist);
+    CompareEngines(u8"sin(z)*exp(z)/(z*z+1)",
+                   Apply<Backend::SineKernel>(Z{}) * Apply<Backend::NaturalExponentialKernel>(Z{}) / (Z{} * Z{} + Const(1)),
+                   dist);
+    CompareEngines(u8"sin((1+i)*z)+cosh((2-i)*z+i)*expi((1+2i)*z)",
+                   Apply<Backend::SineKernel>(Const(1.0+1.0i) * Z{})
+                   + Apply<Backend::HyperbolicCosineKernel>(Const(2.0-1.0i) * Z{} + Const(1.0i)) * Apply<Backend::ImaginaryExponentialKernel>(Const(1.0+2.0i) * Z{}),
+                   dist);
+}
+
+#endif // TST_EXPRESSIONTEMPLATE_H
@@ -0,0 +1,103 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TST_FRAMEPIPELINE_H
+#define TST_FRAMEPIPELINE_H
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "../Backend/framepipeline.h"
+#include "../Backend/gridgenerator.h"
+#include "../Backend/parser.h"
+
+TEST(BackendTest, FramePipelineShallDeliverFramesInOrder)
+{
+    // Arrange
+    Backend::Parser parser(true, {u8"t"});
+    auto animated = parser.ParseParameterized(u8"exp(i*t)*z^2+sin(z)");
+    auto reference = parser.ParseParameterized(u8"exp(i*t)*z^2+sin(z)");
+    Backend::GridGenerator gridGenerator(-2.0, 2.0, -2.0, 2.0);
+    auto grid = gridGenerator.CreateSquare(0.5);
+
+    // Act
+    std::vector<Backend::Frame> frames;
+
+    {
+        Backend::FramePipeline pipeline(animated, u8"t", grid, 1.0, 0.25, 1.0 / 60.0, 4);
+
+        for (int index = 0; index < 10; ++index)
+        {
+            frames.push_back(pipeline.WaitForFrame());
+        }
+    }
+
+    // Assert
+    for (std::size_t index = 0; index < frames.size(); ++index)
+    {
+        const auto & frame = frames[index];
+        EXPECT_EQ(1.0 + 0.25 * static_cast<double>(index), frame.time);
+        ASSERT_EQ(grid.size(), frame.samples.size());
+
+        reference->Bind(u8"t", Backend::complex(frame.time));
+
+        for (std::size_t point = 0; point < grid.size(); ++point)
+        {
+            EXPECT_EQ(grid[point], frame.samples[point].input);
+            EXPECT_EQ(reference->GetExpression()->Evaluate(grid[point]), frame.samples[point].output);
+        }
+    }
+}
+
+TEST(BackendTest, FramePipelineShallAdaptDepthToComputeTime)
+{
+    // Arrange
+    Backend::Parser parser(true, {u8"t"});
+    Backend::GridGenerator gridGenerator(-2.0, 2.0, -2.0, 2.0);
+    auto grid = gridGenerator.CreateSquare(0.05);
+
+    // Act
+    Backend::FramePipeline slowDisplay(parser.ParseParameterized(u8"sin(t*z)"), u8"t", grid, 0.0, 0.1, 1e6, 8);
+    Backend::FramePipeline fastDisplay(parser.ParseParameterized(u8"sin(t*z)"), u8"t", grid, 0.0, 0.1, 1e-9, 8);
+
+    for (int index = 0; index < 3; ++index)
+    {
+        static_cast<void>(slowDisplay.WaitForFrame());
+        static_cast<void>(fastDisplay.WaitForFrame());
+    }
+
+    // the producers fill their buffers up to the depth
+    while (fastDisplay.GetBufferedCount() < fastDisplay.GetDepth() || slowDisplay.GetBufferedCount() < slowDisplay.GetDepth())
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    // Assert
+    EXPECT_EQ(2, slowDisplay.GetDepth());
+    EXPECT_EQ(8, fastDisplay.GetDepth());
+    EXPECT_GT(fastDisplay.GetComputeTime(), 0.0);
+    EXPECT_EQ(2, slowDisplay.GetBufferedCount());
+    EXPECT_EQ(8, fastDisplay.GetBufferedCount());
+    EXPECT_TRUE(fastDisplay.TakeFrame().has_value());
+}
+
+#endif // TST_FRAMEPIPELINE_H
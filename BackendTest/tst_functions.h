@@ -22,6 +22,7 @@
 #include <gmock/gmock-matchers.h>
 #include <gtest/gtest.h>
 #include <memory>
+#include <string>
 
 #include "ComplexMatcher.h"
 
@@ -29,6 +30,7 @@
 #include "../Backend/constant.h"
 #include "../Backend/expression.h"
 #include "../Backend/functions.h"
+#include "../Backend/parser.h"
 
 TEST(BackendTest, MagnitudeShallEvaluateCorrectly)
 {
@@ -229,4 +231,121 @@ TEST(BackendTest, NaturalLogarithmShallEvaluateCorrectly)
     EXPECT_THAT(value, COMPLEX_NEAR(-0.2153914580462271+0.1243549945467614i));
 }
 
+TEST(BackendTest, FunctionTableShallDispatchLikeTheExpressions)
+{
+    using namespace std::complex_literals;
+
+    // Arrange
+    Backend::Parser parser(false);
+    const Backend::complex inputs[] = { 0.5+0.25i, -1.0+2.0i, 3.0-0.5i };
+
+    for (const auto & entry : Backend::FunctionTable)
+    {
+        auto expression = parser.Parse(std::string(entry.name) + "(z)");
+        Backend::complex outputs[3];
+
+        // Act
+        entry.applyBatch(inputs, outputs, 3);
+
+        // Assert
+        ASSERT_TRUE(expression) << entry.name;
+        const auto * function = dynamic_cast<const Backend::Function *>(expression.get());
+        ASSERT_NE(nullptr, function) << entry.name;
+        EXPECT_EQ(entry.id, function->GetId()) << entry.name;
+        EXPECT_EQ(&entry, &Backend::GetFunctionTableEntry(entry.id)) << entry.name;
+
+        for (int index = 0; index < 3; ++index)
+        {
+            auto expected = expression->Evaluate(inputs[index]);
+            ASSERT_TRUE(expected.has_value()) << entry.name;
+            EXPECT_EQ(expected, entry.apply(inputs[index])) << entry.name;
+            EXPECT_THAT(outputs[index], COMPLEX_NEAR(expected.value())) << entry.name;
+        }
+    }
+}
+
+TEST(BackendTest, FunctionsShallCompareByKernel)
+{
+    // Arrange
+    auto baseZ = std::make_shared<Backend::BaseZ>();
+    auto sine = std::make_shared<Backend::Sine>(baseZ);
+    auto otherSine = std::make_shared<Backend::Sine>(std::make_shared<Backend::BaseZ>());
+    auto cosine = std::make_shared<Backend::Cosine>(baseZ);
+
+    // Act, Assert
+    EXPECT_TRUE(*sine == *otherSine);
+    EXPECT_TRUE(*sine != *cosine);
+    EXPECT_EQ(sine->GetHash(), otherSine->GetHash());
+    EXPECT_NE(sine->GetHash(), cosine->GetHash());
+}
+
+TEST(BackendTest, AdditionalFunctionsShallEvaluateLikeTheStandardLibrary)
+{
+    using namespace std::complex_literals;
+
+    // Arrange
+    Backend::Parser parser(false);
+    const Backend::complex input = 0.3-0.7i;
+
+    // Act, Assert
+    EXPECT_THAT(parser.Parse("log10(z)")->Evaluate(input).value(), COMPLEX_NEAR(std::log10(input)));
+    EXPECT_THAT(parser.Parse("arg(z)")->Evaluate(input).value(), COMPLEX_NEAR(Backend::complex(std::arg(input))));
+    EXPECT_THAT(parser.Parse("sinh(z)")->Evaluate(input).value(), COMPLEX_NEAR(std::sinh(input)));
+    EXPECT_THAT(parser.Parse("cosh(z)")->Evaluate(input).value(), COMPLEX_NEAR(std::cosh(input)));
+    EXPECT_THAT(parser.Parse("tanh(z)")->Evaluate(input).value(), COMPLEX_NEAR(std::tanh(input)));
+    EXPECT_THAT(parser.Parse("asin(z)")->Evaluate(input).value(), COMPLEX_NEAR(std::asin(input)));
+    EXPECT_THAT(parser.Parse("acos(z)")->Evaluate(input).value(), COMPLEX_NEAR(std::acos(input)));
+    EXPECT_THAT(parser.Parse("atan(z)")->Evaluate(input).value(), COMPLEX_NEAR(std::atan(input)));
+    EXPECT_THAT(parser.Parse("expi(z)")->Evaluate(input).value(), COMPLEX_NEAR(std::exp(1.0i * input)));
+}
+
+TEST(BackendTest, NativeFunctionsShallMatchTheirDefinitions)
+{
+    using namespace std::complex_literals;
+
+    // Arrange
+    Backend::Parser parser(false);
+    auto sinh = parser.Parse("sinh(z)");
+    auto sinhDefinition = parser.Parse("(exp(z)-exp(-z))/2");
+    auto expi = parser.Parse("expi(z)");
+    auto expiDefinition = parser.Parse("cos(z)+i*sin(z)");
+
+    for (auto input : { 0.0+0.0i, 1.5-0.25i, -2.0+3.0i })
+    {
+        // Act, Assert
+        EXPECT_THAT(sinh->Evaluate(input).value(), COMPLEX_NEAR(sinhDefinition->Evaluate(input).value()));
+        EXPECT_THAT(expi->Evaluate(input).value(), COMPLEX_NEAR(expiDefinition->Evaluate(input).value()));
+    }
+
+    EXPECT_FALSE(parser.Parse("atan(z)")->Evaluate(1.0i).has_value());
+    EXPECT_TRUE(parser.Parse("arg(z)")->Evaluate(0.0).has_value());
+}
+
+TEST(BackendTest, RegisteredFunctionsShallBeAcceptedByValidation)
+{
+    // Arrange
+    Backend::Parser parser(false);
+    bool parseableBefore = parser.IsParseable("wave(z)");
+
+    // Act
+    bool registered = Backend::Parser::Register("wave", &Backend::Sine::Create);
+    bool registeredAgain = Backend::Parser::Register("wave", &Backend::Cosine::Create);
+    auto expression = parser.Parse("wave(z)");
+
+    // the registry is global, so the function must not outlive the test
+    bool unregistered = Backend::Parser::Unregister("wave");
+    bool unregisteredAgain = Backend::Parser::Unregister("wave");
+    bool parseableAfter = parser.IsParseable("wave(z)");
+
+    // Assert
+    EXPECT_FALSE(parseableBefore);
+    EXPECT_TRUE(registered);
+    EXPECT_FALSE(registeredAgain);
+    EXPECT_TRUE(unregistered);
+    EXPECT_FALSE(unregisteredAgain);
+    EXPECT_FALSE(parseableAfter);
+    ASSERT_TRUE(expression);
+    EXPECT_THAT(expression->Evaluate(0.5).value(), COMPLEX_NEAR(std::sin(Backend::complex(0.5))));
+}
+
 #endif // TST_FUNCTIONS_H
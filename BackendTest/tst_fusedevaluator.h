@@ -0,0 +1,134 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TST_FUSEDEVALUATOR_H
+#define TST_FUSEDEVALUATOR_H
+
+#include <gmock/gmock-matchers.h>
+#include <future>
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+#include "../Backend/fusedevaluator.h"
+#include "../Backend/gridgenerator.h"
+#include "../Backend/parser.h"
+
+TEST(BackendTest, FusedEvaluatorShallAgreeWithDirectEvaluation)
+{
+    // Arrange
+    Backend::Parser parser(true);
+    std::vector<std::shared_ptr<Backend::Expression>> expressions(
+        {
+            parser.Parse(u8"sin(z^2)*exp(z)+z"),
+            parser.Parse(u8"exp(z)-sin(z^2)"),
+            parser.Parse(u8"cos(z)/(z^2+1)"),
+            parser.Parse(u8"z^2"),
+        });
+    Backend::GridGenerator gridGenerator(-2.0, 2.0, -2.0, 2.0);
+    auto grid = gridGenerator.CreateSquare(0.25);
+
+    // Act
+    Backend::FusedEvaluator evaluator(expressions);
+    auto results = evaluator.EvaluateAll(grid);
+
+    // Assert
+    EXPECT_EQ(3, evaluator.GetSharedCount());
+    ASSERT_EQ(expressions.size(), results.size());
+
+    for (std::size_t expressionIndex = 0; expressionIndex < expressions.size(); ++expressionIndex)
+    {
+        ASSERT_EQ(grid.size(), results[expressionIndex].size());
+
+        for (std::size_t index = 0; index < grid.size(); ++index)
+        {
+            EXPECT_EQ(grid[index], results[expressionIndex][index].input);
+            EXPECT_EQ(expressions[expressionIndex]->Evaluate(grid[index]), results[expressionIndex][index].output);
+        }
+    }
+}
+
+TEST(BackendTest, FusedEvaluatorShallShareEqualSubexpressionsRegardlessOfOrder)
+{
+    // Arrange
+    Backend::Parser parser(true);
+    std::vector<std::shared_ptr<Backend::Expression>> expressions({ parser.Parse(u8"z*sin(z)+1"), parser.Parse(u8"sin(z)*z-1") });
+    Backend::complex input(0.5, -1.5);
+
+    // Act
+    Backend::FusedEvaluator evaluator(expressions);
+    auto results = evaluator.Evaluate(input);
+    auto again = evaluator.Evaluate(input);
+
+    // Assert
+    EXPECT_EQ(1, evaluator.GetSharedCount());
+    ASSERT_EQ(2, results.size());
+    EXPECT_EQ(expressions[0]->Evaluate(input), results[0]);
+    EXPECT_EQ(expressions[1]->Evaluate(input), results[1]);
+    EXPECT_EQ(results, again);
+}
+
+TEST(BackendTest, FusedEvaluatorShallNotShareSubexpressionsWithParameters)
+{
+    // Arrange
+    Backend::Parser parser(true, {u8"a"});
+    auto first = parser.ParseParameterized(u8"sin(a*z)+cos(z)");
+    auto second = parser.ParseParameterized(u8"sin(a*z)-cos(z)");
+    Backend::complex input(1.0, 0.5);
+
+    // Act
+    Backend::FusedEvaluator evaluator({ first->GetExpression(), second->GetExpression() });
+    second->Bind(u8"a", Backend::complex(2.0));
+    auto results = evaluator.Evaluate(input);
+
+    // Assert
+    EXPECT_EQ(1, evaluator.GetSharedCount());
+    EXPECT_EQ(first->GetExpression()->Evaluate(input), results[0]);
+    EXPECT_EQ(second->GetExpression()->Evaluate(input), results[1]);
+}
+
+TEST(BackendTest, FusedEvaluatorShallAgreeWhenUsedFromSeveralThreads)
+{
+    // Arrange
+    Backend::Parser parser(true);
+    std::vector<std::shared_ptr<Backend::Expression>> expressions({ parser.Parse(u8"sin(z^2)*exp(z)+z"), parser.Parse(u8"exp(z)-sin(z^2)") });
+    Backend::FusedEvaluator evaluator(expressions);
+    Backend::GridGenerator gridGenerator(-2.0, 2.0, -2.0, 2.0);
+    auto grid = gridGenerator.CreateSquare(0.01);
+    auto reversed = std::vector<Backend::complex>(grid.rbegin(), grid.rend());
+
+    // Act
+    auto forwardFuture = std::async(std::launch::async, [&evaluator, &grid]() { return evaluator.EvaluateAll(grid); });
+    auto backward = evaluator.EvaluateAll(reversed);
+    auto forward = forwardFuture.get();
+
+    // Assert
+    ASSERT_EQ(2, evaluator.GetSharedCount());
+
+    for (std::size_t expressionIndex = 0; expressionIndex < expressions.size(); ++expressionIndex)
+    {
+        for (std::size_t index = 0; index < grid.size(); ++index)
+        {
+            auto expected = expressions[expressionIndex]->Evaluate(grid[index]);
+            EXPECT_EQ(expected, forward[expressionIndex][index].output);
+            EXPECT_EQ(expected, backward[expressionIndex][grid.size() - 1 - index].output);
+        }
+    }
+}
+
+#endif // TST_FUSEDEVALUATOR_H
@@ -23,7 +23,9 @@
 #include <gmock/gmock-matchers.h>
 #include <gtest/gtest.h>
 
+#include "../Backend/basez.h"
 #include "../Backend/gridgenerator.h"
+#include "../Backend/parser.h"
 #include "doublehelper.h"
 
 TEST(BackendTest, GridGeneratorShouldCreateRectangularGrid1)
@@ -161,4 +163,160 @@ TEST(BackendTest, GridGeneratorShouldCreateAngularFromApproximateDistance)
     ASSERT_EQ(171, rect.size());
 }
 
+TEST(BackendTest, GridGeneratorShouldCreateAdaptiveGridWithoutRefinement)
+{
+    // Arrange
+    Backend::GridGenerator gridGenerator(1.0, 1.0);
+    auto expression = std::make_shared<Backend::BaseZ>();
+
+    // Act
+    auto adaptive = gridGenerator.CreateAdaptive(0.5, expression, 10.0, 3);
+    auto square = gridGenerator.CreateSquare(0.5);
+
+    // Assert
+    ASSERT_EQ(square.size(), adaptive.size());
+
+    for (const auto & point : square)
+    {
+        EXPECT_EQ(1, std::count_if(adaptive.begin(), adaptive.end(), [&](auto & element){ return AreClose(element.real(), point.real()) && AreClose(element.imag(), point.imag()); }));
+    }
+}
+
+TEST(BackendTest, GridGeneratorShouldCreateAdaptiveGridWithFullRefinement)
+{
+    // Arrange
+    Backend::GridGenerator gridGenerator(1.0, 1.0);
+    auto expression = std::make_shared<Backend::BaseZ>();
+
+    // Act
+    auto adaptive = gridGenerator.CreateAdaptive(1.0, expression, 0.1, 1);
+
+    // Assert
+    ASSERT_EQ(25, adaptive.size());
+}
+
+TEST(BackendTest, GridGeneratorShouldCreateAdaptiveGridRefinedNearPole)
+{
+    // Arrange
+    Backend::GridGenerator gridGenerator(10.0, 10.0);
+    Backend::Parser parser(true);
+    auto expression = parser.Parse("1/z");
+
+    // Act
+    auto adaptive = gridGenerator.CreateAdaptive(1.0, expression, 1.0, 2);
+
+    // Assert
+    EXPECT_GT(adaptive.size(), 441);
+    EXPECT_LT(adaptive.size(), 81 * 81);
+
+    auto begin = adaptive.begin();
+    auto end = adaptive.end();
+
+    EXPECT_EQ(1, std::count_if(begin, end, [](auto & element){ return AreClose(element.real(), 0.25) && AreClose(element.imag(), 0.25); }));
+    EXPECT_EQ(0, std::count_if(begin, end, [](auto & element){ return AreClose(element.real(), 9.25) && AreClose(element.imag(), 9.25); }));
+}
+
+TEST(BackendTest, GridGeneratorShouldCreateAdaptiveGridRefinedNearPoleBetweenCorners)
+{
+    // Arrange
+    Backend::GridGenerator gridGenerator(2.0, 2.0);
+    Backend::Parser parser(true);
+    auto expression = parser.Parse("1/(z-0.5-0.5*i)");
+
+    // Act
+    auto adaptive = gridGenerator.CreateAdaptive(1.0, expression, 100.0, 1);
+
+    // Assert
+    auto begin = adaptive.begin();
+    auto end = adaptive.end();
+
+    EXPECT_EQ(1, std::count_if(begin, end, [](auto & element){ return AreClose(element.real(), 0.5) && AreClose(element.imag(), 0.5); }));
+    EXPECT_EQ(0, std::count_if(begin, end, [](auto & element){ return AreClose(element.real(), 1.5) && AreClose(element.imag(), 1.5); }));
+}
+
+TEST(BackendTest, GridGeneratorShouldKeepAdaptiveOutputs)
+{
+    // Arrange
+    Backend::GridGenerator gridGenerator(10.0, 10.0);
+    Backend::Parser parser(true);
+    auto expression = parser.Parse("1/z");
+
+    // Act
+    auto adaptive = gridGenerator.CreateAdaptive(1.0, expression, 1.0, 2);
+    auto samples = gridGenerator.CreateAdaptiveSamples(1.0, expression, 1.0, 2);
+
+    // Assert
+    ASSERT_EQ(adaptive.size(), samples.size());
+
+    for (std::size_t index = 0; index < samples.size(); ++index)
+    {
+        EXPECT_EQ(adaptive[index], samples[index].input);
+
+        auto expected = expression->Evaluate(samples[index].input);
+        ASSERT_EQ(expected.has_value(), samples[index].output.has_value());
+
+        if (expected.has_value())
+        {
+            EXPECT_EQ(expected.value(), samples[index].output.value());
+        }
+    }
+}
+
+TEST(BackendTest, GridGeneratorShouldLimitEveryKindOfGrid)
+{
+    // Arrange
+    Backend::GridGenerator gridGenerator(-1000.0, 1000.0, -1000.0, 1000.0);
+    Backend::Parser parser(true);
+    auto expression = parser.Parse("z");
+    const double maxCount = 2000.0;
+
+    std::vector<Backend::GridSpecification> specifications({
+        { Backend::GridSpecification::Type::Square, 0.5, 0.0, 0.0, 0 },
+        { Backend::GridSpecification::Type::AngularFromConstantAngle, 0.5, 10.0, 0.0, 0 },
+        { Backend::GridSpecification::Type::AngularFromApproximateDistance, 0.5, 0.0, 0.0, 0 },
+        { Backend::GridSpecification::Type::Adaptive, 0.5, 0.0, 0.1, 3 },
+    });
+
+    for (const auto & specification : specifications)
+    {
+        // Act
+        auto limited = gridGenerator.Limit(specification, maxCount);
+        auto grid = gridGenerator.Create(limited, expression);
+
+        // Assert
+        EXPECT_GT(limited.distLike, specification.distLike);
+        EXPECT_EQ(specification.type, limited.type);
+        EXPECT_EQ(specification.depth, limited.depth);
+        EXPECT_FALSE(grid.empty());
+        EXPECT_LE(grid.size(), static_cast<std::size_t>(maxCount));
+    }
+}
+
+TEST(BackendTest, GridGeneratorShouldKeepSmallGridsWhenLimiting)
+{
+    // Arrange
+    Backend::GridGenerator gridGenerator(10.0, 10.0);
+    Backend::GridSpecification specification { Backend::GridSpecification::Type::AngularFromApproximateDistance, 0.5, 0.0, 0.0, 0 };
+
+    // Act
+    auto limited = gridGenerator.Limit(specification, 40000.0);
+
+    // Assert
+    EXPECT_EQ(specification, limited);
+}
+
+TEST(BackendTest, GridGeneratorShouldCreateSquareGridBeyondIntRange)
+{
+    // Arrange
+    Backend::GridGenerator gridGenerator(3e9, 3e9 + 1.0, 0.0, 0.0);
+
+    // Act
+    auto grid = gridGenerator.CreateSquare(1.0);
+
+    // Assert
+    ASSERT_EQ(2, grid.size());
+    EXPECT_EQ(3e9, grid[0].real());
+    EXPECT_EQ(3e9 + 1.0, grid[1].real());
+}
+
 #endif // TST_GRIDGENERATOR_H
@@ -0,0 +1,119 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TST_ORBITEVALUATOR_H
+#define TST_ORBITEVALUATOR_H
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+#include "../Backend/orbitevaluator.h"
+#include "../Backend/parser.h"
+
+TEST(BackendTest, OrbitsShallEndAccordingToTheirFate)
+{
+    // Arrange
+    Backend::Parser parser(false);
+    auto square = parser.Parse("z*z");
+    auto rotation = parser.Parse("i*z");
+    auto reciprocal = parser.Parse("1/z");
+    Backend::OrbitEvaluator squareEvaluator(square, 100, 1e3, 1e-12);
+    Backend::OrbitEvaluator rotationEvaluator(rotation, 10, 1e3, 1e-12);
+    Backend::OrbitEvaluator reciprocalEvaluator(reciprocal, 10, 1e3, 1e-12);
+
+    // Act
+    auto squareResults = squareEvaluator.EvaluateAll({ Backend::complex(0.5, 0.0), Backend::complex(2.0, 0.0), Backend::complex(0.0, 1.0) }, 1);
+    auto rotationResults = rotationEvaluator.EvaluateAll({ Backend::complex(1.0, 0.0) }, 1);
+    auto reciprocalResults = reciprocalEvaluator.EvaluateAll({ Backend::complex(0.0, 0.0), Backend::complex(2.0, 0.0) }, 1);
+
+    // Assert
+    ASSERT_EQ(3ULL, squareResults.size());
+    EXPECT_EQ(Backend::OrbitResult::Outcome::Converged, squareResults[0].outcome);
+    EXPECT_NEAR(0.0, std::abs(squareResults[0].last), 1e-12);
+    EXPECT_EQ(Backend::OrbitResult::Outcome::Escaped, squareResults[1].outcome);
+    EXPECT_EQ(4, squareResults[1].iterations);
+    EXPECT_EQ(Backend::OrbitResult::Outcome::Converged, squareResults[2].outcome);
+    EXPECT_EQ(3, squareResults[2].iterations);
+    EXPECT_EQ(Backend::complex(1.0, 0.0), squareResults[2].last);
+
+    ASSERT_EQ(1ULL, rotationResults.size());
+    EXPECT_EQ(Backend::OrbitResult::Outcome::Bounded, rotationResults[0].outcome);
+    EXPECT_EQ(10, rotationResults[0].iterations);
+
+    ASSERT_EQ(2ULL, reciprocalResults.size());
+    EXPECT_EQ(Backend::OrbitResult::Outcome::Undefined, reciprocalResults[0].outcome);
+    EXPECT_EQ(0, reciprocalResults[0].iterations);
+    EXPECT_EQ(Backend::OrbitResult::Outcome::Bounded, reciprocalResults[1].outcome);
+}
+
+TEST(BackendTest, TracedOrbitShallMatchEvaluatedOrbit)
+{
+    // Arrange
+    Backend::Parser parser(false);
+    auto expression = parser.Parse("z*z");
+    Backend::OrbitEvaluator evaluator(expression, 100, 1e3, 1e-12);
+
+    // Act
+    auto orbit = evaluator.Trace(Backend::complex(2.0, 0.0));
+    auto result = evaluator.EvaluateAll({ Backend::complex(2.0, 0.0) }, 1);
+
+    // Assert
+    std::vector<Backend::complex> expected { 2.0, 4.0, 16.0, 256.0, 65536.0 };
+    EXPECT_EQ(expected, orbit);
+    EXPECT_EQ(orbit.back(), result[0].last);
+    EXPECT_EQ(static_cast<int>(orbit.size()) - 1, result[0].iterations);
+}
+
+TEST(BackendTest, ParallelOrbitsShallEqualSerialOnes)
+{
+    // Arrange
+    Backend::Parser parser(false);
+    auto expression = parser.Parse("z*z+(0-0.75)+0.1*i");
+    Backend::OrbitEvaluator evaluator(expression, 200, 2.0, 1e-12);
+    std::vector<Backend::complex> starts;
+    for (int x = -60; x <= 60; ++x)
+    {
+        for (int y = -40; y <= 40; ++y)
+        {
+            starts.emplace_back(x / 40.0, y / 40.0);
+        }
+    }
+
+    // Act
+    auto parallel = evaluator.EvaluateAll(starts, 4);
+    auto serial = evaluator.EvaluateAll(starts, 1);
+
+    // Assert
+    ASSERT_EQ(starts.size(), parallel.size());
+    int escaped = 0;
+    int bounded = 0;
+    for (std::size_t index = 0; index < starts.size(); ++index)
+    {
+        EXPECT_EQ(serial[index].outcome, parallel[index].outcome);
+        EXPECT_EQ(serial[index].iterations, parallel[index].iterations);
+        EXPECT_EQ(serial[index].last, parallel[index].last);
+        escaped += serial[index].outcome == Backend::OrbitResult::Outcome::Escaped ? 1 : 0;
+        bounded += serial[index].outcome == Backend::OrbitResult::Outcome::Bounded ? 1 : 0;
+    }
+    EXPECT_GT(escaped, 0);
+    EXPECT_GT(bounded, 0);
+}
+
+#endif // TST_ORBITEVALUATOR_H
@@ -0,0 +1,79 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef TST_PARALLELFOR_H
+#define TST_PARALLELFOR_H
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <vector>
+
+#include "../Backend/parallelfor.h"
+
+TEST(BackendTest, ParallelForShallVisitEveryIndexExactlyOnce)
+{
+    // Arrange
+    const std::size_t count = 1000;
+    std::vector<std::atomic<int>> visits(count);
+    std::vector<std::atomic<int>> threadUses(4);
+
+    // Act
+    Backend::ParallelFor(count, 4, 7, [&](std::size_t begin, std::size_t end, unsigned int thread)
+    {
+        ++threadUses[thread];
+
+        for (auto index = begin; index < end; ++index)
+        {
+            ++visits[index];
+        }
+    });
+
+    // Assert
+    for (const auto & visit : visits)
+    {
+        EXPECT_EQ(1, visit.load());
+    }
+
+    int blockCount = 0;
+    for (const auto & uses : threadUses)
+    {
+        blockCount += uses.load();
+    }
+
+    EXPECT_EQ(143, blockCount);
+}
+
+TEST(BackendTest, ParallelForShallHandleNoWork)
+{
+    // Arrange
+    std::atomic<int> calls(0);
+
+    // Act
+    Backend::ParallelFor(0, 0, 1, [&](std::size_t, std::size_t, unsigned int)
+    {
+        ++calls;
+    });
+
+    // Assert
+    EXPECT_EQ(0, calls.load());
+    EXPECT_GE(Backend::GetThreadCount(0), 1U);
+    EXPECT_EQ(3U, Backend::GetThreadCount(3));
+}
+
+#endif // TST_PARALLELFOR_H
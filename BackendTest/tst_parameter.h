@@ -0,0 +1,140 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TST_PARAMETER_H
+#define TST_PARAMETER_H
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "../Backend/gridgenerator.h"
+#include "../Backend/parameter.h"
+#include "../Backend/parametersweep.h"
+#include "../Backend/parser.h"
+#include "ComplexMatcher.h"
+
+TEST(BackendTest, ParameterShallEvaluateToBoundValue)
+{
+    // Arrange
+    Backend::Parameter parameter(u8"a", Backend::complex(1.0, 2.0));
+
+    // Act
+    auto before = parameter.Evaluate(Backend::complex(5.0, 5.0));
+    parameter.SetValue(Backend::complex(-3.0, 0.5));
+    auto after = parameter.Evaluate(Backend::complex(5.0, 5.0));
+
+    // Assert
+    EXPECT_FALSE(parameter.IsConstant());
+    ASSERT_TRUE(before.has_value());
+    ASSERT_TRUE(after.has_value());
+    EXPECT_EQ(Backend::complex(1.0, 2.0), before.value());
+    EXPECT_EQ(Backend::complex(-3.0, 0.5), after.value());
+}
+
+TEST(BackendTest, ParameterizedExpressionShallRebindWithoutReparsing)
+{
+    // Arrange
+    Backend::Parser parser(true, {u8"a", u8"t"});
+    auto parameterized = parser.ParseParameterized(u8"a*z^2+sin(t*z)-a");
+    ASSERT_NE(nullptr, parameterized);
+    auto expression = parameterized->GetExpression();
+
+    // Act
+    bool boundA = parameterized->Bind(u8"a", Backend::complex(2.0, -1.0));
+    bool boundT = parameterized->Bind(u8"t", Backend::complex(0.5, 0.0));
+    bool boundB = parameterized->Bind(u8"b", Backend::complex(1.0, 0.0));
+    auto result = parameterized->GetExpression()->Evaluate(Backend::complex(1.0, 1.0));
+
+    // Assert
+    EXPECT_TRUE(boundA);
+    EXPECT_TRUE(boundT);
+    EXPECT_FALSE(boundB);
+    EXPECT_EQ(expression, parameterized->GetExpression());
+    EXPECT_EQ(std::vector<std::string>({u8"a", u8"t"}), parameterized->GetParameterNames());
+    ASSERT_TRUE(result.has_value());
+    auto expected = parser.Parse(u8"(2-i)*z^2+sin(0.5*z)-(2-i)")->Evaluate(Backend::complex(1.0, 1.0));
+    EXPECT_THAT(result.value(), COMPLEX_NEAR(expected.value()));
+}
+
+TEST(BackendTest, ParserShallOnlyAcceptDeclaredParameters)
+{
+    // Arrange
+    Backend::Parser plainParser(true);
+    Backend::Parser parameterParser(true, {u8"a"});
+
+    // Act, Assert
+    EXPECT_EQ(nullptr, plainParser.Parse(u8"a*z"));
+    EXPECT_FALSE(plainParser.IsParseable(u8"a*z"));
+    EXPECT_NE(nullptr, parameterParser.Parse(u8"a*z"));
+    EXPECT_TRUE(parameterParser.IsParseable(u8"a*z"));
+    EXPECT_EQ(nullptr, parameterParser.Parse(u8"aa*z"));
+    EXPECT_FALSE(parameterParser.IsParseable(u8"aa*z"));
+    EXPECT_EQ(nullptr, parameterParser.Parse(u8"a(z)"));
+    EXPECT_FALSE(parameterParser.IsParseable(u8"a(z)"));
+
+    EXPECT_THROW(Backend::Parser(true, {u8"z"}), std::logic_error);
+    EXPECT_THROW(Backend::Parser(true, {u8"sin"}), std::logic_error);
+    EXPECT_THROW(Backend::Parser(true, {u8"a1"}), std::logic_error);
+    EXPECT_THROW(Backend::Parser(true, {u8""}), std::logic_error);
+}
+
+TEST(BackendTest, ParameterSweepShallAgreeWithDirectEvaluation)
+{
+    // Arrange
+    Backend::Parser parser(true, {u8"t"});
+    auto parameterized = parser.ParseParameterized(u8"exp(z)*sin(z^2-1)+t*cos(z)/(z-2)+conj(z)^t");
+    ASSERT_NE(nullptr, parameterized);
+    Backend::GridGenerator gridGenerator(-1.5, 1.5, -1.5, 1.5);
+    auto grid = gridGenerator.CreateSquare(0.25);
+    std::vector<Backend::complex> values({Backend::complex(0.0, 0.0), Backend::complex(1.5, -0.5), Backend::complex(-2.0, 1.0)});
+
+    // Act
+    Backend::ParameterSweep sweep(parameterized, grid);
+    auto frames = sweep.Sweep(u8"t", values);
+
+    // Assert
+    EXPECT_EQ(4, sweep.GetCachedCount());
+    EXPECT_EQ(Backend::complex(0.0, 0.0), parameterized->GetValue(u8"t").value());
+    ASSERT_EQ(values.size(), frames.size());
+
+    for (std::size_t frame = 0; frame < values.size(); ++frame)
+    {
+        parameterized->Bind(u8"t", values[frame]);
+        ASSERT_EQ(grid.size(), frames[frame].size());
+
+        for (std::size_t index = 0; index < grid.size(); ++index)
+        {
+            auto expected = parameterized->GetExpression()->Evaluate(grid[index]);
+            const auto & sample = frames[frame][index];
+
+            EXPECT_EQ(grid[index], sample.input);
+            ASSERT_EQ(expected.has_value(), sample.output.has_value());
+
+            if (expected.has_value())
+            {
+                EXPECT_EQ(expected.value(), sample.output.value());
+            }
+        }
+    }
+}
+
+#endif // TST_PARAMETER_H
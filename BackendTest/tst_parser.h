@@ -21,6 +21,8 @@
 
 #include <gmock/gmock-matchers.h>
 #include <gtest/gtest.h>
+#include <thread>
+#include <vector>
 
 #include "SubsetGenerator.h"
 
@@ -110,6 +112,45 @@ TEST(BackendTest, ParserShallParseImaginaryNumber)
     EXPECT_EQ(referenceConstant2, *expression2);
 }
 
+TEST(BackendTest, ParserShallParseNumbersOnSeveralThreadsAlike)
+{
+    // Arrange
+    const std::string input(u8"1,5*z+0.25i-2,75");
+    Backend::Parser referenceParser(false);
+    auto reference = referenceParser.Parse(input);
+    std::vector<std::shared_ptr<Backend::Expression>> expressions(8);
+    std::vector<std::thread> threads;
+
+    // Act
+    for (auto & expression : expressions)
+    {
+        threads.emplace_back([&input, &expression]()
+        {
+            Backend::Parser parser(false);
+
+            for (int repetition = 0; repetition < 200 && parser.IsParseable(input); ++repetition)
+            {
+                expression = parser.Parse(input);
+            }
+        });
+    }
+
+    for (auto & thread : threads)
+    {
+        thread.join();
+    }
+
+    // Assert
+    ASSERT_NE(nullptr, reference);
+
+    for (const auto & expression : expressions)
+    {
+        ASSERT_NE(nullptr, expression);
+        EXPECT_EQ(*reference, *expression);
+        EXPECT_EQ(reference->Evaluate(Backend::complex(1.0, 1.0)), expression->Evaluate(Backend::complex(1.0, 1.0)));
+    }
+}
+
 TEST(BackendTest, ParserShallParseSum)
 {
     using namespace std::complex_literals;
@@ -613,8 +654,8 @@ INSTANTIATE_TEST_SUITE_P(BackendTest, InputParsingTest, // clazy:exclude=non-pod
     TestParsing{u8"3-2*i", true, std::make_shared<Backend::Constant>(3.0-2.0i)},
     TestParsing{u8"+3.0-2.0*i", true, std::make_shared<Backend::Constant>(3.0-2.0i)},
     TestParsing{u8"+3-2*i", true, std::make_shared<Backend::Constant>(3.0-2.0i)},
-    TestParsing{u8"-3.0+2.0*i", true, std::make_shared<Backend::Constant>(-3.0-2.0i)},
-    TestParsing{u8"-3+2*i", true, std::make_shared<Backend::Constant>(-3.0-2.0i)},
+    TestParsing{u8"-3.0+2.0*i", true, std::make_shared<Backend::Constant>(-3.0+2.0i)},
+    TestParsing{u8"-3+2*i", true, std::make_shared<Backend::Constant>(-3.0+2.0i)},
     TestParsing{u8"-3.0-2.0*i", true, std::make_shared<Backend::Constant>(-3.0-2.0i)},
     TestParsing{u8"-3-2*i", true, std::make_shared<Backend::Constant>(-3.0-2.0i)},
     TestParsing{u8"-3-2*i-4+5i", true, std::make_shared<Backend::Constant>(-7.0+3.0i)},
@@ -766,4 +807,79 @@ TEST_P(ParseabilityTest, CheckingForParseabilityShouldNotCrashAndYieldCorrectRes
             << "\" expectedParseability: " << (tfr.expectedParseability ? "true" : "false");
 }
 
+TEST_P(ParseabilityTest, RecognizingShallAgreeWithParsing)
+{
+    // Arrange
+    Backend::Parser parser(false);
+    Backend::Parser optimizingParser(true);
+    TestFunctionResult tfr = GetParam();
+
+    std::vector<std::string> inputs;
+
+#ifdef _SKIP_LONG_TEST
+    if(tfr.text.length() < 9)
+#else // _USE_LONG_TEST
+    if(tfr.text.length() < 16)
+#endif // _SKIP_LONG_TEST
+    {
+        // all subsets, as when checking for parseability
+        SubsetGenerator generator(tfr.text);
+        while(generator.HasNext())
+        {
+            inputs.push_back(generator.GetNext());
+        }
+    }
+
+    for(size_t i = 1; i <= tfr.text.length(); ++i)
+    {
+        inputs.push_back(tfr.text.substr(0, i));
+    }
+
+    inputs.push_back(tfr.text);
+
+    for(const auto & input : inputs)
+    {
+        // Act
+        bool parsed = parser.Parse(input) != nullptr;
+        bool recognized = parser.IsParseable(input);
+        bool optimizedParsed = optimizingParser.Parse(input) != nullptr;
+        bool optimizedRecognized = optimizingParser.IsParseable(input);
+
+        // Assert
+        EXPECT_EQ(parsed, recognized) << "testname: \"" << tfr.testname << "\" input: \"" << input << "\"";
+        EXPECT_EQ(optimizedParsed, optimizedRecognized) << "testname: \"" << tfr.testname << "\" optimized input: \"" << input << "\"";
+    }
+}
+
+TEST(BackendTest, RecognizingShallAgreeWithParsingOnCornerCases)
+{
+    // Arrange
+    Backend::Parser parser(false);
+    Backend::Parser optimizingParser(true);
+
+    std::vector<std::string> inputs {
+        "1/0", "2/(1-1)", "z+1/0", "1/0*z", "-(1/0)", "z/(0,0000000001)", "1/2/0", "0^(0-1)",
+        "2*3+1/(2-2)*z", "-(2)/-(2)", "1/(i-i)", "sin", "sin(z)z", "(z)(z)", "z/", "-z/", "--z", "+-z", "z*-2",
+        "-i/+i", "1,5*2", " 1 / 0 ", "\tz\t", "()", "(()", ".5", "5.", "3,i", "-+3i", "z^2^-1",
+        std::string(400, '9'), std::string(400, '9') + "i", "1/" + std::string(400, '9'), "0," + std::string(400, '0') + "1",
+        "z*" + std::string(400, '9') + "," + std::string(400, '9')
+    };
+
+    for(const auto & input : inputs)
+    {
+        // Act
+        bool parsed = parser.Parse(input) != nullptr;
+        bool recognized = parser.IsParseable(input);
+        bool optimizedParsed = optimizingParser.Parse(input) != nullptr;
+        bool optimizedRecognized = optimizingParser.IsParseable(input);
+
+        // Assert
+        EXPECT_EQ(parsed, recognized) << "input: \"" << input << "\"";
+        EXPECT_EQ(optimizedParsed, optimizedRecognized) << "optimized input: \"" << input << "\"";
+    }
+
+    EXPECT_TRUE(parser.IsParseable("1/0"));
+    EXPECT_FALSE(optimizingParser.IsParseable("1/0"));
+}
+
 #endif // TST_PARSER_H
@@ -25,10 +25,13 @@
 #include "tst_complexmatcher.h"
 
 #include "../Backend/basez.h"
+#include "../Backend/compiledexpression.h"
 #include "../Backend/constant.h"
 #include "../Backend/expression.h"
+#include "../Backend/parser.h"
 #include "../Backend/power.h"
 #include "../Backend/product.h"
+#include "../Backend/rationalfunction.h"
 #include "../Backend/sum.h"
 
 TEST(BackendTest, PowerShallEvaluateRealCorrectly)
@@ -149,4 +152,43 @@ TEST(BackendTest, PowerShallEvaluateComplexCasesCorrectly)
     EXPECT_THAT(result6.value(), COMPLEX_NEAR(0.766024004703597+0.636324561250512i)); // WolframAlpha
 }
 
+TEST(BackendTest, PowerShallMultiplyOutIntegerExponentsLikeRationalFunction)
+{
+    using namespace std::complex_literals;
+
+    // Arrange
+    Backend::Parser parser(true);
+    std::vector<std::string> formulas { u8"z^2", u8"z^3", u8"z^2+1", u8"z^(0-2)", u8"(z-1)^0" };
+    std::vector<Backend::complex> inputs { 0.0, -0.0, 1.5-0.5i, 1e-6 };
+
+    for (const auto & formula : formulas)
+    {
+        auto expression = parser.Parse(formula);
+        auto rational = Backend::RationalFunction::Compile(expression);
+        Backend::CompiledExpression compiled(expression);
+        ASSERT_NE(nullptr, rational) << formula;
+
+        for (const auto & input : inputs)
+        {
+            // Act
+            auto tree = expression->Evaluate(input);
+            auto horner = rational->Evaluate(input);
+            auto program = compiled.Evaluate(input);
+
+            // Assert
+            ASSERT_EQ(horner.has_value(), tree.has_value()) << formula << " at " << input;
+            ASSERT_EQ(horner.has_value(), program.has_value()) << formula << " at " << input;
+
+            if (tree.has_value())
+            {
+                EXPECT_THAT(tree.value(), COMPLEX_NEAR(horner.value())) << formula << " at " << input;
+                EXPECT_EQ(tree.value(), program.value()) << formula << " at " << input;
+            }
+        }
+    }
+
+    EXPECT_EQ(Backend::complex(0.0), parser.Parse(u8"z^3")->Evaluate(0.0));
+    EXPECT_FALSE(parser.Parse(u8"z^(0-2)")->Evaluate(0.0).has_value());
+}
+
 #endif // TST_POWER_H
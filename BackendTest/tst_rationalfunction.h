@@ -0,0 +1,142 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TST_RATIONALFUNCTION_H
+#define TST_RATIONALFUNCTION_H
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "ComplexMatcher.h"
+
+#include "../Backend/parser.h"
+#include "../Backend/rationalfunction.h"
+
+TEST(BackendTest, RationalFunctionShallCompilePolynomialCoefficients)
+{
+    // Arrange
+    Backend::Parser parser(true);
+    auto expression = parser.Parse(u8"z*z*z-2*z+1");
+
+    // Act
+    auto rational = Backend::RationalFunction::Compile(expression);
+
+    // Assert
+    ASSERT_TRUE(rational);
+    EXPECT_TRUE(rational->IsPolynomial());
+    EXPECT_EQ((Backend::RationalFunction::Coefficients{1.0, -2.0, 0.0, 1.0}), rational->GetNumerator());
+    EXPECT_EQ((Backend::RationalFunction::Coefficients{1.0}), rational->GetDenominator());
+}
+
+TEST(BackendTest, RationalFunctionShallAgreeWithTheExpression)
+{
+    using namespace std::complex_literals;
+
+    // Arrange
+    Backend::Parser parser(true);
+    std::vector<std::string> formulas { u8"(z^2+1)/(z^2-1)", u8"1/z+1/(z-1)*(2-i)", u8"-(z-1)^3*(z+2i)/4", u8"z^(-2)-3" };
+    std::vector<Backend::complex> inputs { 0.5 + 0.25i, -1.5 + 2.0i, 3.0 - 0.75i, -0.25 - 1.0i };
+
+    for (const auto & formula : formulas)
+    {
+        auto expression = parser.Parse(formula);
+
+        // Act
+        auto rational = Backend::RationalFunction::Compile(expression);
+
+        // Assert
+        ASSERT_TRUE(rational) << formula;
+        EXPECT_FALSE(formula == u8"-(z-1)^3*(z+2i)/4" ? !rational->IsPolynomial() : rational->IsPolynomial()) << formula;
+
+        for (const auto & input : inputs)
+        {
+            auto expected = expression->Evaluate(input);
+            auto actual = rational->Evaluate(input);
+
+            ASSERT_TRUE(expected.has_value());
+            ASSERT_TRUE(actual.has_value());
+            EXPECT_THAT(actual.value(), COMPLEX_NEAR(expected.value())) << formula;
+        }
+    }
+}
+
+TEST(BackendTest, RationalFunctionShallBeUndefinedAtPoles)
+{
+    // Arrange
+    Backend::Parser parser(true);
+    auto quotient = Backend::RationalFunction::Compile(parser.Parse(u8"(z^2+1)/(z^2-1)"));
+    auto square = Backend::RationalFunction::Compile(parser.Parse(u8"z^2"));
+
+    // Act
+    auto atPole = quotient->Evaluate(1.0);
+    auto atZero = square->Evaluate(0.0);
+
+    // Assert
+    EXPECT_FALSE(atPole.has_value());
+    ASSERT_TRUE(atZero.has_value());
+    EXPECT_EQ(Backend::complex(0.0), atZero.value());
+}
+
+TEST(BackendTest, RationalFunctionShallRejectOtherExpressions)
+{
+    // Arrange
+    Backend::Parser parser(true);
+    std::vector<std::string> formulas { u8"z^0.5", u8"sin(z)", u8"z^z", u8"2^z", u8"z^40", u8"(z^20+1)*(z^20-1)" };
+
+    for (const auto & formula : formulas)
+    {
+        // Act
+        auto rational = Backend::RationalFunction::Compile(parser.Parse(formula));
+
+        // Assert
+        EXPECT_FALSE(rational) << formula;
+    }
+}
+
+TEST(BackendTest, RationalFunctionShallEvaluateLinesByForwardDifferencing)
+{
+    // Arrange
+    Backend::Parser parser(true);
+    auto rational = Backend::RationalFunction::Compile(parser.Parse(u8"(z^3-3*z^2+z)/(z^2+4)"));
+    std::vector<Backend::complex> inputs;
+
+    for (int index = 0; index < 200; ++index)
+    {
+        inputs.emplace_back(-1.25, -5.0 + 0.05 * index);
+    }
+
+    std::vector<std::optional<Backend::complex>> outputs(inputs.size());
+
+    // Act
+    rational->EvaluateLine(inputs.data(), outputs.data(), inputs.size());
+
+    // Assert
+    for (std::size_t index = 0; index < inputs.size(); ++index)
+    {
+        auto expected = rational->Evaluate(inputs[index]);
+
+        ASSERT_TRUE(expected.has_value());
+        ASSERT_TRUE(outputs[index].has_value());
+        EXPECT_LT(std::abs(expected.value() - outputs[index].value()), 1e-9 * (1.0 + std::abs(expected.value())));
+    }
+}
+
+#endif // TST_RATIONALFUNCTION_H
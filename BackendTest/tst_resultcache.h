@@ -0,0 +1,142 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TST_RESULTCACHE_H
+#define TST_RESULTCACHE_H
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+#include <memory>
+
+#include "../Backend/gridgenerator.h"
+#include "../Backend/parser.h"
+#include "../Backend/resultcache.h"
+
+namespace {
+    const Backend::GridSpecification squareSpecification { Backend::GridSpecification::Type::Square, 1.0, 0.0, 0.0, 0 };
+}
+
+TEST(BackendTest, StructurallyEqualExpressionsShallHaveEqualHashes)
+{
+    // Arrange
+    Backend::Parser parser(false);
+
+    // Act
+    auto first = parser.Parse("z+1");
+    auto second = parser.Parse("1+z");
+    auto third = parser.Parse("sin(z*2)");
+    auto fourth = parser.Parse("sin(2*z)");
+
+    // Assert
+    ASSERT_TRUE(first);
+    ASSERT_TRUE(second);
+    ASSERT_TRUE(third);
+    ASSERT_TRUE(fourth);
+    EXPECT_EQ(first->GetHash(), second->GetHash());
+    EXPECT_EQ(third->GetHash(), fourth->GetHash());
+}
+
+TEST(BackendTest, ResultCacheShallReturnStoredSamplesForEqualExpression)
+{
+    // Arrange
+    Backend::Parser parser(true);
+    Backend::ResultCache cache(1 << 20);
+    auto expression = parser.Parse("z*z+i");
+    auto reparsed = parser.Parse("z*z+i");
+
+    // Act
+    auto evaluated = cache.GetOrEvaluate(expression, squareSpecification, -3.0, 3.0, -3.0, 3.0);
+    auto found = cache.Find(reparsed, squareSpecification, -3.0, 3.0, -3.0, 3.0);
+
+    // Assert
+    ASSERT_TRUE(evaluated);
+    EXPECT_EQ(49ULL, evaluated->size());
+    EXPECT_EQ(evaluated.get(), found.get());
+}
+
+TEST(BackendTest, ResultCacheShallMissForDifferentKeys)
+{
+    // Arrange
+    Backend::Parser parser(true);
+    Backend::ResultCache cache(1 << 20);
+    auto expression = parser.Parse("z+i");
+    auto other = parser.Parse("z+2*i");
+    auto otherSpecification = squareSpecification;
+    otherSpecification.distLike = 0.5;
+
+    // Act
+    static_cast<void>(cache.GetOrEvaluate(expression, squareSpecification, -3.0, 3.0, -3.0, 3.0));
+
+    // Assert
+    EXPECT_EQ(expression->GetHash(), parser.Parse("z+i")->GetHash());
+    EXPECT_FALSE(cache.Find(other, squareSpecification, -3.0, 3.0, -3.0, 3.0));
+    EXPECT_FALSE(cache.Find(expression, otherSpecification, -3.0, 3.0, -3.0, 3.0));
+    EXPECT_FALSE(cache.Find(expression, squareSpecification, -3.0, 4.0, -3.0, 3.0));
+    EXPECT_TRUE(cache.Find(expression, squareSpecification, -3.0, 3.0, -3.0, 3.0));
+}
+
+TEST(BackendTest, ResultCacheShallEvictLeastRecentlyUsed)
+{
+    // Arrange
+    Backend::Parser parser(true);
+    auto first = parser.Parse("z");
+    auto second = parser.Parse("z+1");
+    auto third = parser.Parse("z+2");
+
+    Backend::ResultCache probe(1 << 20);
+    static_cast<void>(probe.GetOrEvaluate(first, squareSpecification, -3.0, 3.0, -3.0, 3.0));
+    auto entrySize = probe.GetUsedSize();
+
+    Backend::ResultCache cache(2 * entrySize);
+
+    // Act
+    static_cast<void>(cache.GetOrEvaluate(first, squareSpecification, -3.0, 3.0, -3.0, 3.0));
+    static_cast<void>(cache.GetOrEvaluate(second, squareSpecification, -3.0, 3.0, -3.0, 3.0));
+    static_cast<void>(cache.Find(first, squareSpecification, -3.0, 3.0, -3.0, 3.0));
+    static_cast<void>(cache.GetOrEvaluate(third, squareSpecification, -3.0, 3.0, -3.0, 3.0));
+
+    // Assert
+    EXPECT_EQ(2 * entrySize, cache.GetUsedSize());
+    EXPECT_TRUE(cache.Find(first, squareSpecification, -3.0, 3.0, -3.0, 3.0));
+    EXPECT_FALSE(cache.Find(second, squareSpecification, -3.0, 3.0, -3.0, 3.0));
+    EXPECT_TRUE(cache.Find(third, squareSpecification, -3.0, 3.0, -3.0, 3.0));
+}
+
+TEST(BackendTest, ResultCacheShallHitForAreasCoveringTheSameLattice)
+{
+    // Arrange
+    Backend::Parser parser(true);
+    Backend::ResultCache cache(1 << 20);
+    auto expression = parser.Parse("z*z+i");
+    auto angularSpecification = Backend::GridSpecification { Backend::GridSpecification::Type::AngularFromApproximateDistance, 1.0, 0.0, 0.0, 0 };
+
+    // Act
+    auto evaluated = cache.GetOrEvaluate(expression, squareSpecification, -3.0, 3.0, -3.0, 3.0);
+    auto shifted = cache.Find(expression, squareSpecification, -3.5, 3.7, -3.2, 3.01);
+    auto grown = cache.Find(expression, squareSpecification, -3.5, 4.0, -3.2, 3.01);
+    static_cast<void>(cache.GetOrEvaluate(expression, angularSpecification, -3.0, 3.0, -3.0, 3.0));
+    auto angularShifted = cache.Find(expression, angularSpecification, -3.5, 3.7, -3.2, 3.01);
+
+    // Assert
+    ASSERT_TRUE(evaluated);
+    EXPECT_EQ(evaluated.get(), shifted.get());
+    EXPECT_FALSE(grown);
+    EXPECT_FALSE(angularShifted);
+}
+
+#endif // TST_RESULTCACHE_H
@@ -0,0 +1,97 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TST_ROOTFINDER_H
+#define TST_ROOTFINDER_H
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+#include "../Backend/parser.h"
+#include "../Backend/rootfinder.h"
+
+TEST(BackendTest, RootFinderShallLocateZerosAndPoles)
+{
+    // Arrange
+    Backend::Parser parser(false);
+    auto expression = parser.Parse("(z-1.3)*(z+0.7*i)^2/(z-2-2*i)");
+    Backend::RootFinder finder(expression, -5.0, 5.0, -5.0, 5.0);
+
+    // Act
+    auto roots = finder.Find(1.0);
+
+    // Assert
+    ASSERT_EQ(3ULL, roots.size());
+
+    EXPECT_EQ(Backend::Root::Kind::Zero, roots[0].kind);
+    EXPECT_NEAR(0.0, std::abs(roots[0].location - Backend::complex(0.0, -0.7)), 1e-6);
+    EXPECT_EQ(2, roots[0].order);
+
+    EXPECT_EQ(Backend::Root::Kind::Zero, roots[1].kind);
+    EXPECT_NEAR(0.0, std::abs(roots[1].location - Backend::complex(1.3, 0.0)), 1e-9);
+    EXPECT_EQ(1, roots[1].order);
+
+    EXPECT_EQ(Backend::Root::Kind::Pole, roots[2].kind);
+    EXPECT_NEAR(0.0, std::abs(roots[2].location - Backend::complex(2.0, 2.0)), 1e-9);
+    EXPECT_EQ(1, roots[2].order);
+}
+
+TEST(BackendTest, RootFinderShallLocateRootsOnCellBoundaries)
+{
+    // Arrange
+    Backend::Parser parser(false);
+    auto expression = parser.Parse("(z-0.5)/z");
+    Backend::RootFinder finder(expression, -2.0, 2.0, -2.0, 2.0);
+
+    // Act
+    auto roots = finder.Find(1.0);
+
+    // Assert
+    ASSERT_EQ(2ULL, roots.size());
+    EXPECT_EQ(Backend::Root::Kind::Pole, roots[0].kind);
+    EXPECT_NEAR(0.0, std::abs(roots[0].location), 1e-9);
+    EXPECT_EQ(Backend::Root::Kind::Zero, roots[1].kind);
+    EXPECT_NEAR(0.0, std::abs(roots[1].location - Backend::complex(0.5, 0.0)), 1e-9);
+}
+
+TEST(BackendTest, RootFinderShallFindPeriodicZerosInParallel)
+{
+    // Arrange
+    Backend::Parser parser(false);
+    auto expression = parser.Parse("sin(z)");
+    Backend::RootFinder finder(expression, -10.0, 10.0, -2.0, 2.0);
+
+    // Act
+    auto parallel = finder.Find(0.75, 4);
+    auto serial = finder.Find(0.75, 1);
+
+    // Assert
+    ASSERT_EQ(7ULL, parallel.size());
+    ASSERT_EQ(serial.size(), parallel.size());
+    for (std::size_t index = 0; index < parallel.size(); ++index)
+    {
+        auto multiple = static_cast<double>(index) - 3.0;
+        EXPECT_EQ(Backend::Root::Kind::Zero, parallel[index].kind);
+        EXPECT_NEAR(0.0, std::abs(parallel[index].location - Backend::complex(multiple * M_PI, 0.0)), 1e-9);
+        EXPECT_EQ(serial[index].location, parallel[index].location);
+    }
+}
+
+#endif // TST_ROOTFINDER_H
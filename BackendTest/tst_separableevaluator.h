@@ -0,0 +1,133 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TST_SEPARABLEEVALUATOR_H
+#define TST_SEPARABLEEVALUATOR_H
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../Backend/gridgenerator.h"
+#include "../Backend/parser.h"
+#include "../Backend/separableevaluator.h"
+
+TEST(BackendTest, SeparableEvaluatorShallAgreeWithDirectEvaluation)
+{
+    // Arrange
+    Backend::Parser parser(true);
+    auto expression = parser.Parse(u8"exp(z)*sin(2*z+i)-cos(z/2-1)+expi(0.5i*z)/sinh(3-z)+cosh(-z)");
+    Backend::GridGenerator gridGenerator(-3.0, 3.0, -2.5, 2.5);
+    auto grid = gridGenerator.CreateSquare(0.25);
+
+    // Act
+    Backend::SeparableEvaluator evaluator(expression, 0.25);
+    evaluator.Tabulate(-3.0, 3.0, -2.5, 2.5);
+
+    // Assert
+    EXPECT_EQ(6, evaluator.GetTabulatedCount());
+
+    for (const auto & input : grid)
+    {
+        auto expected = expression->Evaluate(input);
+        auto actual = evaluator.Evaluate(input);
+
+        ASSERT_EQ(expected.has_value(), actual.has_value());
+
+        if (expected.has_value())
+        {
+            EXPECT_LT(std::abs(expected.value() - actual.value()), 1e-12 * (1.0 + std::abs(expected.value())));
+        }
+    }
+}
+
+TEST(BackendTest, SeparableEvaluatorShallOnlyTabulateAffineArguments)
+{
+    // Arrange
+    Backend::Parser parser(true);
+    auto expression = parser.Parse(u8"sin(z^2)+exp(z*z)+cos(conj(z))");
+
+    // Act
+    Backend::SeparableEvaluator evaluator(expression, 0.5);
+    evaluator.Tabulate(-2.0, 2.0, -2.0, 2.0);
+    auto result = evaluator.Evaluate(Backend::complex(0.5, -1.5));
+
+    // Assert
+    EXPECT_EQ(0, evaluator.GetTabulatedCount());
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(expression->Evaluate(Backend::complex(0.5, -1.5)).value(), result.value());
+}
+
+TEST(BackendTest, SeparableEvaluatorShallEvaluateOffGridPointsDirectly)
+{
+    // Arrange
+    Backend::Parser parser(true);
+    auto expression = parser.Parse(u8"exp(z)");
+    Backend::SeparableEvaluator evaluator(expression, 0.5);
+    evaluator.Tabulate(-2.0, 2.0, -2.0, 2.0);
+
+    // Act
+    auto between = evaluator.Evaluate(Backend::complex(0.3, 0.7));
+    auto outside = evaluator.Evaluate(Backend::complex(4.0, 0.5));
+
+    // Assert
+    EXPECT_EQ(1, evaluator.GetTabulatedCount());
+    ASSERT_TRUE(between.has_value());
+    ASSERT_TRUE(outside.has_value());
+    EXPECT_EQ(expression->Evaluate(Backend::complex(0.3, 0.7)).value(), between.value());
+    EXPECT_EQ(expression->Evaluate(Backend::complex(4.0, 0.5)).value(), outside.value());
+}
+
+TEST(BackendTest, SeparableEvaluatorShallAgreeWithDirectEvaluationForComplexSlopes)
+{
+    // Arrange
+    Backend::Parser parser(true);
+    std::vector<std::string> formulas({ u8"sin((1+i)*z)", u8"cos((1+i)*z)", u8"sinh((1+i)*z)", u8"cosh((1-2i)*z+3i)", u8"expi((2+i)*z)" });
+    Backend::GridGenerator gridGenerator(-20.0, 20.0, -20.0, 20.0);
+    auto grid = gridGenerator.CreateSquare(0.5);
+
+    for (const auto & formula : formulas)
+    {
+        auto expression = parser.Parse(formula);
+
+        // Act
+        Backend::SeparableEvaluator evaluator(expression, 0.5);
+        evaluator.Tabulate(-20.0, 20.0, -20.0, 20.0);
+
+        // Assert
+        EXPECT_EQ(1, evaluator.GetTabulatedCount()) << formula;
+
+        for (const auto & input : grid)
+        {
+            auto expected = expression->Evaluate(input);
+            auto actual = evaluator.Evaluate(input);
+
+            ASSERT_EQ(expected.has_value(), actual.has_value()) << formula << " at " << input;
+
+            if (expected.has_value())
+            {
+                EXPECT_LT(std::abs(expected.value() - actual.value()), 1e-12 * (1.0 + std::abs(expected.value()))) << formula << " at " << input;
+            }
+        }
+    }
+}
+
+#endif // TST_SEPARABLEEVALUATOR_H
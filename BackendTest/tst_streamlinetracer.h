@@ -0,0 +1,142 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TST_STREAMLINETRACER_H
+#define TST_STREAMLINETRACER_H
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "../Backend/parser.h"
+#include "../Backend/streamlinetracer.h"
+
+TEST(BackendTest, StreamlinesOfRotationShallBeClosedCircles)
+{
+    // Arrange
+    Backend::Parser parser(false);
+    auto expression = parser.Parse("i*z");
+    Backend::StreamlineTracer tracer(expression, Backend::StreamlineTracer::Method::RungeKutta4, 0.05, 0.0, 10000, -3.0, 3.0, -3.0, 3.0);
+
+    // Act
+    auto line = tracer.Trace(Backend::complex(2.0, 0.0));
+
+    // Assert
+    ASSERT_FALSE(line.empty());
+    EXPECT_LT(line.size(), 10000ULL);
+    EXPECT_LT(std::abs(line.back() - Backend::complex(2.0, 0.0)), 0.05);
+    for (const auto & point : line)
+    {
+        EXPECT_NEAR(2.0, std::abs(point), 1e-6);
+    }
+
+    // counterclockwise in the direction of the field
+    EXPECT_GT((line[line.size() - 1] - line[line.size() - 2]).imag(), 0.0);
+}
+
+TEST(BackendTest, AdaptiveStreamlinesShallBeAccurate)
+{
+    // Arrange
+    Backend::Parser parser(false);
+    auto expression = parser.Parse("i*z");
+    Backend::StreamlineTracer tracer(expression, Backend::StreamlineTracer::Method::DormandPrince45, 0.5, 1e-9, 10000, -3.0, 3.0, -3.0, 3.0);
+
+    // Act
+    auto line = tracer.Trace(Backend::complex(0.0, 1.5));
+
+    // Assert
+    ASSERT_GT(line.size(), 10ULL);
+    EXPECT_LT(line.size(), 1000ULL);
+    for (const auto & point : line)
+    {
+        EXPECT_NEAR(1.5, std::abs(point), 1e-7);
+    }
+}
+
+TEST(BackendTest, StreamlinesShallEndAtSinksAndArea)
+{
+    // Arrange
+    Backend::Parser parser(false);
+    auto expression = parser.Parse("(0-1)*z");
+    Backend::StreamlineTracer rungeKutta(expression, Backend::StreamlineTracer::Method::RungeKutta4, 0.1, 0.0, 1000, -2.0, 2.0, -2.0, 2.0);
+    Backend::StreamlineTracer dormandPrince(expression, Backend::StreamlineTracer::Method::DormandPrince45, 0.1, 1e-8, 1000, -2.0, 2.0, -2.0, 2.0);
+
+    for (const auto & tracer : { &rungeKutta, &dormandPrince })
+    {
+        // Act
+        auto line = tracer->Trace(Backend::complex(1.0, 1.0));
+        auto outside = tracer->Trace(Backend::complex(3.0, 0.0));
+
+        // Assert
+        ASSERT_FALSE(line.empty());
+        EXPECT_LT(line.size(), 200ULL);
+        EXPECT_LT(std::abs(line.back()), 0.1);
+        EXPECT_GT(std::abs(line.front()), 2.0 - 0.15);
+        EXPECT_TRUE(outside.empty());
+    }
+}
+
+TEST(BackendTest, StreamlinesShallEndAtUndefinedPoints)
+{
+    // Arrange
+    Backend::Parser parser(false);
+    auto expression = parser.Parse("1/(z-1)");
+    Backend::StreamlineTracer tracer(expression, Backend::StreamlineTracer::Method::DormandPrince45, 0.1, 1e-8, 1000, -3.0, 3.0, -3.0, 3.0);
+
+    // Act
+    auto line = tracer.Trace(Backend::complex(1.0, 1.0));
+
+    // Assert
+    ASSERT_FALSE(line.empty());
+    EXPECT_LT(line.size(), 200ULL);
+    EXPECT_LT(std::abs(line.back() - Backend::complex(1.0, 0.0)), 0.1);
+}
+
+TEST(BackendTest, ParallelStreamlinesShallEqualSerialOnes)
+{
+    // Arrange
+    Backend::Parser parser(false);
+    auto expression = parser.Parse("z*z-1");
+    Backend::StreamlineTracer tracer(expression, Backend::StreamlineTracer::Method::DormandPrince45, 0.1, 1e-6, 500, -2.0, 2.0, -2.0, 2.0);
+    std::vector<Backend::complex> seeds;
+    for (int x = -4; x <= 4; ++x)
+    {
+        for (int y = -4; y <= 4; ++y)
+        {
+            seeds.emplace_back(0.45 * x + 0.01, 0.45 * y + 0.02);
+        }
+    }
+
+    // Act
+    auto parallel = tracer.TraceAll(seeds, 4);
+    auto serial = tracer.TraceAll(seeds, 1);
+
+    // Assert
+    ASSERT_EQ(seeds.size(), parallel.size());
+    EXPECT_EQ(serial, parallel);
+
+    // seeds traced in lockstep with others end up where they end up alone
+    for (std::size_t index = 0; index < seeds.size(); ++index)
+    {
+        EXPECT_EQ(tracer.Trace(seeds[index]), parallel[index]) << "seed " << seeds[index];
+    }
+}
+
+#endif // TST_STREAMLINETRACER_H
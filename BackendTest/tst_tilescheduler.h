@@ -0,0 +1,178 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TST_TILESCHEDULER_H
+#define TST_TILESCHEDULER_H
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+#include <memory>
+
+#include "ComplexMatcher.h"
+
+#include "../Backend/basez.h"
+#include "../Backend/gridgenerator.h"
+#include "../Backend/parser.h"
+#include "../Backend/tilescheduler.h"
+
+TEST(BackendTest, TileSchedulerShallEvaluateEveryPointExactlyOnce)
+{
+    // Arrange
+    Backend::GridGenerator gridGenerator(10.0, 10.0);
+    auto grid = gridGenerator.CreateSquare(0.5);
+    auto expression = std::make_shared<Backend::BaseZ>();
+    Backend::TileScheduler scheduler(expression, grid, 0.0, 2.5);
+
+    // Act
+    std::vector<Backend::complex> evaluated;
+    while (scheduler.HasNext())
+    {
+        for (const auto & sample : scheduler.GetNext())
+        {
+            ASSERT_TRUE(sample.output.has_value());
+            EXPECT_THAT(sample.output.value(), COMPLEX_NEAR(sample.input));
+            evaluated.push_back(sample.input);
+        }
+    }
+
+    // Assert
+    ASSERT_EQ(grid.size(), evaluated.size());
+
+    auto less = [](const Backend::complex & a, const Backend::complex & b)
+    {
+        return a.real() < b.real() || (a.real() == b.real() && a.imag() < b.imag());
+    };
+
+    std::sort(grid.begin(), grid.end(), less);
+    std::sort(evaluated.begin(), evaluated.end(), less);
+
+    EXPECT_EQ(grid, evaluated);
+}
+
+TEST(BackendTest, TileSchedulerShallStartWithCoarseGrid)
+{
+    // Arrange
+    Backend::GridGenerator gridGenerator(10.0, 10.0);
+    auto grid = gridGenerator.CreateSquare(0.5);
+    auto expression = std::make_shared<Backend::BaseZ>();
+    Backend::TileScheduler scheduler(expression, grid, 0.0, 5.0);
+
+    // Act
+    auto coarse = scheduler.GetNext();
+
+    // Assert
+    ASSERT_TRUE(scheduler.HasNext());
+    EXPECT_LT(coarse.size(), 40);
+    EXPECT_GE(coarse.size(), 16);
+}
+
+TEST(BackendTest, TileSchedulerShallRefineCenterFirst)
+{
+    // Arrange
+    Backend::GridGenerator gridGenerator(10.0, 10.0);
+    auto grid = gridGenerator.CreateSquare(0.5);
+    Backend::Parser parser(true);
+    auto expression = parser.Parse("2*z");
+    Backend::TileScheduler scheduler(expression, grid, 0.0, 2.5);
+
+    // Act
+    auto coarse = scheduler.GetNext();
+    auto firstTile = scheduler.GetNext();
+
+    // Assert
+    ASSERT_FALSE(firstTile.empty());
+
+    for (const auto & sample : firstTile)
+    {
+        EXPECT_LE(std::abs(sample.input), 2.5 * std::sqrt(2.0));
+    }
+}
+
+TEST(BackendTest, TileSchedulerShallRefineAroundUndefinedPointsFirst)
+{
+    // Arrange
+    Backend::GridGenerator gridGenerator(10.0, 10.0);
+    auto grid = gridGenerator.CreateSquare(0.5);
+    Backend::Parser parser(true);
+    auto expression = parser.Parse("1/(z-8.5-8.5i)");
+    Backend::TileScheduler scheduler(expression, grid, 0.0, 2.5);
+
+    // Act
+    auto coarse = scheduler.GetNext();
+    auto firstTile = scheduler.GetNext();
+
+    // Assert
+    ASSERT_FALSE(firstTile.empty());
+
+    for (const auto & sample : firstTile)
+    {
+        EXPECT_GE(sample.input.real(), 5.0);
+        EXPECT_GE(sample.input.imag(), 5.0);
+    }
+}
+
+TEST(BackendTest, TileSchedulerShallStopWhenCancelled)
+{
+    // Arrange
+    Backend::GridGenerator gridGenerator(10.0, 10.0);
+    auto grid = gridGenerator.CreateSquare(0.5);
+    auto expression = std::make_shared<Backend::BaseZ>();
+    Backend::TileScheduler scheduler(expression, grid, 0.0, 2.5);
+
+    // Act
+    auto coarse = scheduler.GetNext();
+    scheduler.Cancel();
+
+    // Assert
+    EXPECT_FALSE(scheduler.HasNext());
+    EXPECT_TRUE(scheduler.GetNext().empty());
+}
+
+TEST(BackendTest, TileSchedulerShallAgreeWithTreeEvaluation)
+{
+    // Arrange
+    Backend::GridGenerator gridGenerator(10.0, 10.0);
+    auto grid = gridGenerator.CreateSquare(0.5);
+    Backend::Parser parser(true);
+    auto expression = parser.Parse(u8"(z^2 - 3i*z + 1) / (z - 2) + sin(z) * 0.5");
+    Backend::TileScheduler scheduler(expression, grid, 0.0, 2.5);
+
+    // Act
+    std::vector<Backend::Sample> samples;
+    while (scheduler.HasNext())
+    {
+        auto batch = scheduler.GetNext();
+        samples.insert(samples.end(), batch.begin(), batch.end());
+    }
+
+    // Assert
+    ASSERT_EQ(grid.size(), samples.size());
+
+    for (const auto & sample : samples)
+    {
+        auto expected = expression->Evaluate(sample.input);
+        ASSERT_EQ(expected.has_value(), sample.output.has_value());
+
+        if (expected.has_value())
+        {
+            EXPECT_THAT(sample.output.value(), COMPLEX_NEAR(expected.value()));
+        }
+    }
+}
+
+#endif // TST_TILESCHEDULER_H
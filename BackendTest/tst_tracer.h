@@ -0,0 +1,145 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TST_TRACER_H
+#define TST_TRACER_H
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <string>
+#include <thread>
+
+#include "../Backend/gridgenerator.h"
+#include "../Backend/parser.h"
+#include "../Backend/tracer.h"
+
+TEST(BackendTest, TracerShallRecordNothingWhenDisabled)
+{
+    // Arrange
+    Backend::Tracer::Enable();
+    Backend::Tracer::Disable();
+    Backend::Parser parser(true);
+
+    // Act
+    {
+        Backend::TraceSpan span(u8"test", u8"disabled");
+    }
+
+    (void)parser.Parse(u8"z*z");
+
+    // Assert
+    EXPECT_FALSE(Backend::Tracer::IsEnabled());
+    EXPECT_TRUE(Backend::Tracer::GetEvents().empty());
+}
+
+TEST(BackendTest, TracerShallRecordSpansWithThreadIds)
+{
+    // Arrange
+    Backend::Parser parser(true);
+    Backend::GridGenerator gridGenerator(-1.0, 1.0, -1.0, 1.0);
+
+    // Act
+    Backend::Tracer::Enable();
+
+    {
+        Backend::TraceSpan span(u8"test", u8"outer");
+        auto expression = parser.Parse(u8"sin(z)");
+        (void)gridGenerator.CreateSquare(0.5);
+    }
+
+    std::thread thread([]
+    {
+        Backend::TraceSpan span(u8"test", u8"worker");
+    });
+    thread.join();
+
+    Backend::Tracer::Disable();
+    auto events = Backend::Tracer::GetEvents();
+
+    // Assert
+    auto find = [&events](const std::string & name)
+    {
+        return std::find_if(events.begin(), events.end(), [&name](const Backend::Tracer::Event & event){ return name == event.name; });
+    };
+
+    auto outer = find(u8"outer");
+    auto parse = find(u8"Parser::Parse");
+    auto grid = find(u8"GridGenerator::CreateSquare");
+    auto worker = find(u8"worker");
+
+    ASSERT_NE(events.end(), outer);
+    ASSERT_NE(events.end(), parse);
+    ASSERT_NE(events.end(), grid);
+    ASSERT_NE(events.end(), worker);
+
+    EXPECT_EQ(std::string(u8"parse"), parse->category);
+    EXPECT_LE(outer->start, parse->start);
+    EXPECT_GE(outer->end, parse->end);
+    EXPECT_LE(parse->end, grid->start);
+    EXPECT_EQ(outer->threadId, parse->threadId);
+    EXPECT_NE(outer->threadId, worker->threadId);
+}
+
+TEST(BackendTest, TracerShallFormatTraceEventFormat)
+{
+    // Arrange
+    Backend::Tracer::Enable();
+
+    {
+        Backend::TraceSpan span(u8"test", u8"quoted \"span\"");
+    }
+
+    Backend::Tracer::Disable();
+
+    // Act
+    auto text = Backend::Tracer::ToJson();
+
+    // Assert
+    EXPECT_THAT(text, ::testing::StartsWith(u8"{\"traceEvents\":[\n{"));
+    EXPECT_THAT(text, ::testing::EndsWith(u8"}\n],\"displayTimeUnit\":\"ms\"}\n"));
+    EXPECT_THAT(text, ::testing::HasSubstr(u8"\"name\":\"quoted \\\"span\\\"\""));
+    EXPECT_THAT(text, ::testing::HasSubstr(u8"\"cat\":\"test\""));
+    EXPECT_THAT(text, ::testing::HasSubstr(u8"\"ph\":\"X\""));
+    EXPECT_THAT(text, ::testing::HasSubstr(u8"\"tid\":"));
+    EXPECT_THAT(text, ::testing::Not(::testing::HasSubstr(u8"\"ts\":-")));
+}
+
+TEST(BackendTest, TracerShallDropSpansOpenedBeforeEnabling)
+{
+    // Arrange
+    Backend::Tracer::Enable();
+
+    // Act
+    {
+        Backend::TraceSpan stale(u8"test", u8"stale");
+        Backend::Tracer::Enable();
+        Backend::TraceSpan fresh(u8"test", u8"fresh");
+    }
+
+    Backend::Tracer::Disable();
+    auto events = Backend::Tracer::GetEvents();
+    auto text = Backend::Tracer::ToJson();
+
+    // Assert
+    ASSERT_EQ(1, events.size());
+    EXPECT_EQ(std::string(u8"fresh"), events.front().name);
+    EXPECT_THAT(text, ::testing::Not(::testing::HasSubstr(u8"\"ts\":-")));
+}
+
+#endif // TST_TRACER_H
@@ -0,0 +1,187 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TST_VIEWPORTEVALUATOR_H
+#define TST_VIEWPORTEVALUATOR_H
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+
+#include "ComplexMatcher.h"
+
+#include "../Backend/basez.h"
+#include "../Backend/gridgenerator.h"
+#include "../Backend/viewportevaluator.h"
+
+TEST(BackendTest, ViewportEvaluatorShallMatchSquareGrid)
+{
+    // Arrange
+    auto expression = std::make_shared<Backend::BaseZ>();
+    Backend::ViewportEvaluator evaluator(expression, 1.0);
+    Backend::GridGenerator gridGenerator(-3.5, 2.0, -1.0, 4.5);
+
+    // Act
+    auto samples = evaluator.Evaluate(-3.5, 2.0, -1.0, 4.5);
+    auto grid = gridGenerator.CreateSquare(1.0);
+
+    // Assert
+    ASSERT_EQ(grid.size(), samples.size());
+    EXPECT_EQ(grid.size(), evaluator.GetLastEvaluationCount());
+
+    for (unsigned long long index = 0; index < grid.size(); ++index)
+    {
+        EXPECT_THAT(samples[index].input, COMPLEX_NEAR(grid[index]));
+        ASSERT_TRUE(samples[index].output.has_value());
+        EXPECT_THAT(samples[index].output.value(), COMPLEX_NEAR(grid[index]));
+    }
+}
+
+TEST(BackendTest, ViewportEvaluatorShallOnlyEvaluateExposedPointsWhenPanning)
+{
+    // Arrange
+    auto expression = std::make_shared<Backend::BaseZ>();
+    Backend::ViewportEvaluator evaluator(expression, 1.0);
+
+    // Act
+    auto first = evaluator.Evaluate(-10.0, 10.0, -10.0, 10.0);
+    auto firstCount = evaluator.GetLastEvaluationCount();
+    auto second = evaluator.Evaluate(-8.0, 12.0, -10.0, 10.0);
+    auto secondCount = evaluator.GetLastEvaluationCount();
+
+    // Assert
+    EXPECT_EQ(441, first.size());
+    EXPECT_EQ(441, firstCount);
+    EXPECT_EQ(441, second.size());
+    EXPECT_EQ(2 * 21, secondCount);
+}
+
+TEST(BackendTest, ViewportEvaluatorShallNotEvaluateWhenZoomingIn)
+{
+    // Arrange
+    auto expression = std::make_shared<Backend::BaseZ>();
+    Backend::ViewportEvaluator evaluator(expression, 1.0);
+
+    // Act
+    auto first = evaluator.Evaluate(-10.0, 10.0, -10.0, 10.0);
+    auto second = evaluator.Evaluate(-5.0, 5.0, -5.0, 5.0);
+    auto secondCount = evaluator.GetLastEvaluationCount();
+
+    // Assert
+    EXPECT_EQ(121, second.size());
+    EXPECT_EQ(0, secondCount);
+}
+
+TEST(BackendTest, ViewportEvaluatorShallDropDistantResults)
+{
+    // Arrange
+    auto expression = std::make_shared<Backend::BaseZ>();
+    Backend::ViewportEvaluator evaluator(expression, 1.0);
+
+    // Act
+    auto first = evaluator.Evaluate(-10.0, 10.0, -10.0, 10.0);
+    auto second = evaluator.Evaluate(90.0, 110.0, -10.0, 10.0);
+    auto third = evaluator.Evaluate(-10.0, 10.0, -10.0, 10.0);
+    auto thirdCount = evaluator.GetLastEvaluationCount();
+
+    // Assert
+    EXPECT_EQ(441, thirdCount);
+}
+
+TEST(BackendTest, ViewportEvaluatorShallHandOutExposedPointsAndKeepStoredResults)
+{
+    // Arrange
+    auto expression = std::make_shared<Backend::BaseZ>();
+    Backend::ViewportEvaluator evaluator(expression, 1.0);
+    std::vector<Backend::complex> exposed;
+
+    // Act
+    auto firstKnown = evaluator.Collect(-10.0, 10.0, -10.0, 10.0, exposed);
+    auto firstExposedCount = exposed.size();
+
+    std::vector<Backend::Sample> evaluated;
+    for (const auto & input : exposed)
+    {
+        evaluated.push_back(Backend::Sample{input, evaluator.GetEvaluationExpression()->Evaluate(input)});
+    }
+
+    evaluator.Store(evaluated);
+    auto secondKnown = evaluator.Collect(-8.0, 12.0, -10.0, 10.0, exposed);
+
+    // Assert
+    EXPECT_EQ(0, firstKnown.size());
+    EXPECT_EQ(441, firstExposedCount);
+    EXPECT_EQ(441 - 2 * 21, secondKnown.size());
+    EXPECT_EQ(2 * 21, exposed.size());
+
+    for (const auto & sample : secondKnown)
+    {
+        ASSERT_TRUE(sample.output.has_value());
+        EXPECT_THAT(sample.output.value(), COMPLEX_NEAR(sample.input));
+    }
+}
+
+TEST(BackendTest, ViewportEvaluatorShallLimitTheNumberOfPoints)
+{
+    // Arrange, Act
+    auto unchanged = Backend::ViewportEvaluator::LimitDistance(0.5, -10.0, 10.0, -10.0, 10.0, 40000.0);
+    auto coarsened = Backend::ViewportEvaluator::LimitDistance(0.5, -10000.0, 10000.0, -10000.0, 10000.0, 40000.0);
+
+    // Assert
+    EXPECT_EQ(0.5, unchanged);
+    EXPECT_EQ(128.0, coarsened);
+}
+
+TEST(BackendTest, ViewportEvaluatorShallKeepResultsOfACoarserOrFinerGrid)
+{
+    // Arrange
+    auto expression = std::make_shared<Backend::BaseZ>();
+    Backend::ViewportEvaluator evaluator(expression, 1.0);
+    static_cast<void>(evaluator.Evaluate(-10.0, 10.0, -10.0, 10.0));
+
+    Backend::ViewportEvaluator coarser(evaluator, 2.0);
+    Backend::ViewportEvaluator finer(evaluator, 0.5);
+    Backend::ViewportEvaluator unrelated(evaluator, 0.75);
+
+    // Act
+    auto coarserSamples = coarser.Evaluate(-10.0, 10.0, -10.0, 10.0);
+    auto coarserCount = coarser.GetLastEvaluationCount();
+    auto finerSamples = finer.Evaluate(-10.0, 10.0, -10.0, 10.0);
+    auto finerCount = finer.GetLastEvaluationCount();
+    static_cast<void>(unrelated.Evaluate(-10.0, 10.0, -10.0, 10.0));
+    auto unrelatedCount = unrelated.GetLastEvaluationCount();
+
+    // Assert
+    EXPECT_EQ(121, coarserSamples.size());
+    EXPECT_EQ(0, coarserCount);
+    EXPECT_EQ(1681, finerSamples.size());
+    EXPECT_EQ(1681 - 441, finerCount);
+    EXPECT_EQ(27 * 27, unrelatedCount);
+
+    for (const auto & samples : { coarserSamples, finerSamples })
+    {
+        for (const auto & sample : samples)
+        {
+            ASSERT_TRUE(sample.output.has_value());
+            EXPECT_THAT(sample.output.value(), COMPLEX_NEAR(sample.input));
+        }
+    }
+}
+
+#endif // TST_VIEWPORTEVALUATOR_H
@@ -17,14 +17,18 @@
 #
 
 SOURCES += \
+    $$PWD/arrowfield.cpp \
     $$PWD/griddialog.cpp \
     $$PWD/mainwindow.cpp \
+    $$PWD/offscreenrenderer.cpp \
     $$PWD/qcustomplot.cpp
 
 HEADERS += \
+    $$PWD/arrowfield.h \
     $$PWD/griddialog.h \
     $$PWD/mainwindow.h \
     $$PWD/mainwindow_ui.h \
+    $$PWD/offscreenrenderer.h \
     $$PWD/qcustomplot.h
 
 TRANSLATIONS += \
@@ -36,6 +36,48 @@
         <source>Grid ... </source>
         <translation>Gitter ... </translation>
     </message>
+    <message>
+        <source>Streamlines</source>
+        <translation>Stromlinien</translation>
+    </message>
+    <message>
+        <source>Orbits</source>
+        <translation>Orbits</translation>
+    </message>
+    <message>
+        <source>Zeros/Poles</source>
+        <translation>Null-/Polstellen</translation>
+    </message>
+    <message>
+        <source>Animate</source>
+        <translation>Animieren</translation>
+    </message>
+    <message>
+        <source>Profile</source>
+        <translation>Profil</translation>
+    </message>
+    <message>
+        <source>Trace</source>
+        <translation>Aufzeichnen</translation>
+    </message>
+    <message>
+        <source>Save Trace</source>
+        <translation>Aufzeichnung speichern</translation>
+    </message>
+    <message>
+        <source>Tree evaluation of the first formula at %1 points. Square grids are evaluated from row and column tables, which this profile does not cover.</source>
+        <extracomment>Arg 1 is a placeholder for the number of points.</extracomment>
+        <translation>Baumauswertung der ersten Formel an %1 Punkten. Quadratische Gitter werden aus Zeilen- und Spaltentabellen ausgewertet, die dieses Profil nicht abdeckt.</translation>
+    </message>
+    <message>
+        <source>The trace could not be saved to %1.</source>
+        <extracomment>Arg 1 is a placeholder for the name of the file.</extracomment>
+        <translation>Die Aufzeichnung konnte nicht unter %1 gespeichert werden.</translation>
+    </message>
+    <message>
+        <source>Trace Event Files (*.json)</source>
+        <translation>Trace-Event-Dateien (*.json)</translation>
+    </message>
 </context>
 <context>
     <name>Ui::GridDialog</name>
@@ -75,5 +117,13 @@
         <source>Angular grid with fixed angle</source>
         <translation>Radiales Gitter mit festem Winkel</translation>
     </message>
+    <message>
+        <source>Adaptive grid refined by variation</source>
+        <translation>Adaptives Gitter nach Variation verfeinert</translation>
+    </message>
+    <message>
+        <source>Variation</source>
+        <translation>Variation</translation>
+    </message>
 </context>
 </TS>
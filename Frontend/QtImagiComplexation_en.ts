@@ -36,6 +36,48 @@
         <source>Grid ... </source>
         <translation>Grid ... </translation>
     </message>
+    <message>
+        <source>Streamlines</source>
+        <translation>Streamlines</translation>
+    </message>
+    <message>
+        <source>Orbits</source>
+        <translation>Orbits</translation>
+    </message>
+    <message>
+        <source>Zeros/Poles</source>
+        <translation>Zeros/Poles</translation>
+    </message>
+    <message>
+        <source>Animate</source>
+        <translation>Animate</translation>
+    </message>
+    <message>
+        <source>Profile</source>
+        <translation>Profile</translation>
+    </message>
+    <message>
+        <source>Trace</source>
+        <translation>Trace</translation>
+    </message>
+    <message>
+        <source>Save Trace</source>
+        <translation>Save Trace</translation>
+    </message>
+    <message>
+        <source>Tree evaluation of the first formula at %1 points. Square grids are evaluated from row and column tables, which this profile does not cover.</source>
+        <extracomment>Arg 1 is a placeholder for the number of points.</extracomment>
+        <translation>Tree evaluation of the first formula at %1 points. Square grids are evaluated from row and column tables, which this profile does not cover.</translation>
+    </message>
+    <message>
+        <source>The trace could not be saved to %1.</source>
+        <extracomment>Arg 1 is a placeholder for the name of the file.</extracomment>
+        <translation>The trace could not be saved to %1.</translation>
+    </message>
+    <message>
+        <source>Trace Event Files (*.json)</source>
+        <translation>Trace Event Files (*.json)</translation>
+    </message>
 </context>
 <context>
     <name>Ui::GridDialog</name>
@@ -75,5 +117,13 @@
         <source>Add</source>
         <translation>Add</translation>
     </message>
+    <message>
+        <source>Adaptive grid refined by variation</source>
+        <translation>Adaptive grid refined by variation</translation>
+    </message>
+    <message>
+        <source>Variation</source>
+        <translation>Variation</translation>
+    </message>
 </context>
 </TS>
@@ -0,0 +1,207 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "arrowfield.h"
+
+#include <algorithm>
+#include <cmath>
+
+ArrowField::ArrowField(QCustomPlot * parentPlot, int cellSize)
+    : QCPAbstractItem(parentPlot),
+      cellSize(cellSize),
+      penStyle(Qt::SolidLine),
+      visibleCount(0),
+      indexedCount(0)
+{
+    this->setSelectable(false);
+}
+
+void ArrowField::AddArrow(Backend::complex input, Backend::complex output, const QColor & color)
+{
+    this->arrows.push_back(Arrow{input, output, color.rgb()});
+}
+
+void ArrowField::Clear()
+{
+    this->arrows.clear();
+    this->bins.clear();
+    this->visible.clear();
+    this->visibleCount = 0;
+    this->indexedCount = 0;
+}
+
+void ArrowField::SetPenStyle(Qt::PenStyle style)
+{
+    this->penStyle = style;
+}
+
+Qt::PenStyle ArrowField::GetPenStyle() const
+{
+    return this->penStyle;
+}
+
+std::size_t ArrowField::GetArrowCount() const
+{
+    return this->arrows.size();
+}
+
+std::size_t ArrowField::GetVisibleCount() const
+{
+    this->UpdateIndex();
+
+    return this->visibleCount;
+}
+
+bool ArrowField::IsAggregating() const
+{
+    this->UpdateIndex();
+
+    return this->visibleCount > this->GetAggregationLimit();
+}
+
+double ArrowField::selectTest(const QPointF &, bool, QVariant *) const //NOLINT(misc-unused-parameter, hicpp-named-parameter, readability-named-parameter)
+{
+    return -1.0;
+}
+
+void ArrowField::draw(QCPPainter * painter)
+{
+    if (!this->IsAggregating())
+    {
+        for (auto index : this->visible)
+        {
+            const auto & arrow = this->arrows[index];
+            ArrowField::DrawArrow(painter, this->ToPixel(arrow.input), this->ToPixel(arrow.output), QColor(arrow.color), this->penStyle);
+        }
+
+        return;
+    }
+
+    for (const auto & bin : this->bins)
+    {
+        if (bin.count == 0)
+        {
+            continue;
+        }
+
+        auto count = static_cast<double>(bin.count);
+        QPointF start(bin.x / count, bin.y / count);
+        QPointF end(start.x() + bin.dx / count, start.y() + bin.dy / count);
+
+        ArrowField::DrawArrow(painter, start, end, QColor(bin.color), this->penStyle);
+    }
+}
+
+std::size_t ArrowField::GetAggregationLimit() const
+{
+    // the arrows aggregate once their mean distance on screen, assuming an even spread, falls below the cell size
+    auto area = static_cast<std::size_t>(std::max(this->indexedRect.width(), 0)) * static_cast<std::size_t>(std::max(this->indexedRect.height(), 0));
+
+    return area / (static_cast<std::size_t>(this->cellSize) * static_cast<std::size_t>(this->cellSize));
+}
+
+void ArrowField::UpdateIndex() const
+{
+    auto rect = this->clipRect();
+    auto xRange = this->parentPlot()->xAxis->range();
+    auto yRange = this->parentPlot()->yAxis->range();
+
+    // the number of bins depends on the screen size only
+    auto columns = rect.width() / this->cellSize + 1;
+    auto rows = rect.height() / this->cellSize + 1;
+
+    if (rect != this->indexedRect || xRange != this->indexedXRange || yRange != this->indexedYRange || this->indexedCount > this->arrows.size())
+    {
+        this->indexedRect = rect;
+        this->indexedXRange = xRange;
+        this->indexedYRange = yRange;
+        this->indexedCount = 0;
+        this->visibleCount = 0;
+        this->visible.clear();
+        this->bins.assign(static_cast<std::size_t>(std::max(columns, 0)) * static_cast<std::size_t>(std::max(rows, 0)), Bin{0.0, 0.0, 0.0, 0.0, 0, -1.0, 0});
+    }
+
+    auto limit = this->GetAggregationLimit();
+
+    for (; this->indexedCount < this->arrows.size(); ++this->indexedCount)
+    {
+        const auto & arrow = this->arrows[this->indexedCount];
+        auto start = this->ToPixel(arrow.input);
+        auto end = this->ToPixel(arrow.output);
+        auto startIsVisible = rect.contains(start.toPoint());
+
+        // arrows pointing into the plot area from outside are visible as well
+        if (!startIsVisible && !rect.contains(end.toPoint()))
+        {
+            continue;
+        }
+
+        ++this->visibleCount;
+
+        // individual arrows are only needed as long as they are drawn individually
+        if (this->visible.size() <= limit)
+        {
+            this->visible.push_back(this->indexedCount);
+        }
+
+        // such arrows are binned by their end, which is the part on screen
+        auto anchor = startIsVisible ? start : end;
+        auto column = (static_cast<int>(anchor.x()) - rect.left()) / this->cellSize;
+        auto row = (static_cast<int>(anchor.y()) - rect.top()) / this->cellSize;
+
+        auto & bin = this->bins[static_cast<std::size_t>(row) * static_cast<std::size_t>(columns) + static_cast<std::size_t>(column)];
+        bin.x += start.x();
+        bin.y += start.y();
+        bin.dx += end.x() - start.x();
+        bin.dy += end.y() - start.y();
+        ++bin.count;
+
+        // the longest arrow, the first one on ties, gives the color, averaging the colors would drown them in gray
+        auto length = (end.x() - start.x()) * (end.x() - start.x()) + (end.y() - start.y()) * (end.y() - start.y());
+
+        if (length > bin.length)
+        {
+            bin.color = arrow.color;
+            bin.length = length;
+        }
+    }
+}
+
+QPointF ArrowField::ToPixel(Backend::complex value) const
+{
+    return QPointF(this->parentPlot()->xAxis->coordToPixel(value.real()), this->parentPlot()->yAxis->coordToPixel(value.imag()));
+}
+
+void ArrowField::DrawArrow(QCPPainter * painter, const QPointF & start, const QPointF & end, const QColor & color, Qt::PenStyle penStyle)
+{
+    static const QCPLineEnding head(QCPLineEnding::esSpikeArrow);
+
+    QCPVector2D startVec(start);
+    QCPVector2D endVec(end);
+
+    if (qFuzzyIsNull((endVec - startVec).lengthSquared()))
+    {
+        return;
+    }
+
+    // the head is always drawn solid, so that it stays recognizable
+    painter->setPen(QPen(QBrush(color), 1.0, penStyle));
+    painter->drawLine(QLineF(start, end));
+    painter->setPen(QPen(color));
+    head.draw(painter, endVec, endVec - startVec);
+}
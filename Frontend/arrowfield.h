@@ -0,0 +1,157 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef ARROWFIELD_H
+#define ARROWFIELD_H
+
+#include <QColor>
+
+#include <vector>
+
+#include "../Backend/expression.h"
+#include "qcustomplot.h"
+
+/*!
+ * \class ArrowField
+ * \brief The ArrowField class draws many arrows as a single plot item.
+ *
+ * If the arrows are denser on screen than the cell size, they are binned by
+ * screen cell and one arrow with averaged position, direction and length
+ * is drawn per cell, in the color of the longest arrow of the cell. Zooming in restores the full detail.
+ * An arrow counts as visible if its start or its end is inside the plot area.
+ *
+ * The bins are kept between replots and are only rebuilt if the axis ranges
+ * or the plot area change, arrows added in the meantime are binned incrementally.
+ */
+class ArrowField : public QCPAbstractItem //NOLINT(cppcoreguidelines-special-member-functions)
+{
+private:
+    struct Arrow
+    {
+    public:
+        Backend::complex input;
+        Backend::complex output;
+        QRgb color;
+    };
+
+    struct Bin
+    {
+    public:
+        double x;
+        double y;
+        double dx;
+        double dy;
+        QRgb color;
+        double length;
+        int count;
+    };
+
+    const int cellSize;
+    Qt::PenStyle penStyle;
+    std::vector<Arrow> arrows;
+
+    mutable std::vector<Bin> bins;
+    mutable std::vector<std::size_t> visible;
+    mutable std::size_t visibleCount;
+    mutable std::size_t indexedCount;
+    mutable QCPRange indexedXRange;
+    mutable QCPRange indexedYRange;
+    mutable QRect indexedRect;
+
+public:
+    /*!
+     * \brief Initializes a new instance owned by the supplied plot.
+     * \param parentPlot The plot to draw on.
+     * \param cellSize The edge length in pixels of the screen cells used for aggregation.
+     */
+    explicit ArrowField(QCustomPlot * parentPlot, int cellSize = 12);
+    ~ArrowField() override = default;
+
+    /*!
+     * \brief AddArrow adds an arrow pointing from \a input to \a output.
+     * \param input The start of the arrow.
+     * \param output The end of the arrow.
+     * \param color The color of the arrow.
+     */
+    void AddArrow(Backend::complex input, Backend::complex output, const QColor & color);
+
+    /*!
+     * \brief Clear removes all arrows.
+     */
+    void Clear();
+
+    /*!
+     * \brief SetPenStyle sets the style of the lines of all arrows,
+     *        telling several fields on the same plot apart.
+     * \param style The style.
+     */
+    void SetPenStyle(Qt::PenStyle style);
+
+    /*!
+     * \brief GetPenStyle gets the style of the lines of all arrows.
+     * \return The style.
+     */
+    [[nodiscard]] Qt::PenStyle GetPenStyle() const;
+
+    /*!
+     * \brief GetArrowCount gets the number of arrows held.
+     * \return The number of arrows.
+     */
+    [[nodiscard]] std::size_t GetArrowCount() const;
+
+    /*!
+     * \brief GetVisibleCount gets the number of arrows starting or ending inside the plot area.
+     * \return The number of visible arrows.
+     */
+    [[nodiscard]] std::size_t GetVisibleCount() const;
+
+    /*!
+     * \brief IsAggregating gets a value indicating whether the arrows
+     *        are too dense to be drawn individually at the current axis ranges.
+     * \return A value indicating aggregation.
+     */
+    [[nodiscard]] bool IsAggregating() const;
+
+    /*!
+     * \brief DrawArrow draws a single arrow in pixel coordinates.
+     * \param painter The painter to use.
+     * \param start The start of the arrow.
+     * \param end The end of the arrow, marked by the head.
+     * \param color The color of the arrow.
+     * \param penStyle The style of the line of the arrow.
+     */
+    static void DrawArrow(QCPPainter * painter, const QPointF & start, const QPointF & end, const QColor & color, Qt::PenStyle penStyle = Qt::SolidLine);
+
+    /*!
+     * \reimp
+     */
+    double selectTest(const QPointF & pos, bool onlySelectable, QVariant * details = nullptr) const override;
+
+protected:
+    /*!
+     * \reimp
+     */
+    void draw(QCPPainter * painter) override;
+
+private:
+    [[nodiscard]] QPointF ToPixel(Backend::complex value) const;
+    [[nodiscard]] std::size_t GetAggregationLimit() const;
+    void UpdateIndex() const;
+};
+
+#endif // ARROWFIELD_H
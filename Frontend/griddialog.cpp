@@ -18,39 +18,44 @@
 
 #include "griddialog.h"
 
-Ui::GridDialog::GridDialog(QWidget * parent, double viewportX, double viewportY)
+#include <utility>
+
+Ui::GridDialog::GridDialog(QWidget * parent, double minX, double maxX, double minY, double maxY)
     : QDialog(parent),
-      viewportX(viewportX),
-      viewportY(viewportY),
-      gridType(GridType::NotSet),
-      distLike(0.0),
-      angleDegrees(0.0)
+      minX(minX),
+      maxX(maxX),
+      minY(minY),
+      maxY(maxY)
 {
     this->SetupUi();
     connect(this->squareGridAcceptButton, &QAbstractButton::pressed, this, &GridDialog::OnSquareGridAcceptButtonPressed);
     connect(this->rcaGridAcceptButton, &QAbstractButton::pressed, this, &GridDialog::OnRadialConstantAngleGridAcceptButtonPressed);
     connect(this->radGridAcceptButton, &QAbstractButton::pressed, this, &GridDialog::OnRadialApproximateDistanceAcceptButtonPressed);
+    connect(this->adaGridAcceptButton, &QAbstractButton::pressed, this, &GridDialog::OnAdaptiveAcceptButtonPressed);
     connect(this->cancelButton, &QAbstractButton::pressed, this, &GridDialog::OnCancelPressed);
 }
 
-std::vector<Backend::complex> Ui::GridDialog::GetResult() const
+void Ui::GridDialog::SetExpression(std::shared_ptr<Backend::Expression> expression)
 {
-    Backend::GridGenerator gridGenerator(this->viewportX, this->viewportY);
+    this->expression = std::move(expression);
+    this->adaGridGroupBox->setEnabled(this->expression != nullptr);
+}
 
-    switch (this->gridType)
+std::vector<Backend::complex> Ui::GridDialog::GetResult() const
+{
+    if (!this->specification.has_value())
     {
-    case GridType::Square:
-        return gridGenerator.CreateSquare(this->distLike);
+        return std::vector<Backend::complex>();
+    }
 
-    case GridType::RadialConstantAngle:
-       return gridGenerator.CreateAngularFromConstantAngle(this->distLike, this->angleDegrees);
+    Backend::GridGenerator gridGenerator(this->minX, this->maxX, this->minY, this->maxY);
 
-    case GridType::RadialApproximateDistance:
-        return gridGenerator.CreateAngularFromApproximateDistance(this->distLike);
+    return gridGenerator.Create(this->specification.value(), this->expression);
+}
 
-    default:
-        return std::vector<Backend::complex>();
-    }
+std::optional<Backend::GridSpecification> Ui::GridDialog::GetSpecification() const
+{
+    return this->specification;
 }
 
 void Ui::GridDialog::SetupUi()
@@ -159,6 +164,46 @@ void Ui::GridDialog::SetupUi()
 
     // ---------------------------------------------------------------------------------
 
+    adaGridGroupBox = new QGroupBox(this); //NOLINT(cppcoreguidelines-owning-memory)
+    adaGridGroupBox->setObjectName(QString::fromUtf8(u8"adaGridGroupBox"));
+    adaGridGroupBox->setEnabled(false);
+    verticalDialogLayout->addWidget(adaGridGroupBox);
+
+    adaGridLayout = new QGridLayout(adaGridGroupBox); //NOLINT(cppcoreguidelines-owning-memory)
+    adaGridLayout->setObjectName(QString::fromUtf8(u8"adaGridLayout"));
+
+    adaGridDistLabel = new QLabel(adaGridGroupBox); //NOLINT(cppcoreguidelines-owning-memory)
+    adaGridDistLabel->setObjectName(QString::fromUtf8(u8"adaGridDistLabel"));
+    adaGridLayout->addWidget(adaGridDistLabel, 0, 0, 1, 1);
+
+    adaGridDistSpinBox = new QDoubleSpinBox(adaGridGroupBox); //NOLINT(cppcoreguidelines-owning-memory)
+    adaGridDistSpinBox->setObjectName(QString::fromUtf8(u8"adaGridDistSpinBox"));
+    adaGridLayout->addWidget(adaGridDistSpinBox, 0, 1, 1, 1);
+
+    adaGridDistSpinBox->setValue(1.5);
+    adaGridDistSpinBox->setRange(0.5, 5.0);
+    adaGridDistSpinBox->setDecimals(2);
+    adaGridDistSpinBox->setSingleStep(0.25);
+
+    adaGridVariationLabel = new QLabel(adaGridGroupBox); //NOLINT(cppcoreguidelines-owning-memory)
+    adaGridVariationLabel->setObjectName(QString::fromUtf8(u8"adaGridVariationLabel"));
+    adaGridLayout->addWidget(adaGridVariationLabel, 1, 0, 1, 1);
+
+    adaGridVariationSpinBox = new QDoubleSpinBox(adaGridGroupBox); //NOLINT(cppcoreguidelines-owning-memory)
+    adaGridVariationSpinBox->setObjectName(QString::fromUtf8(u8"adaGridVariationSpinBox"));
+    adaGridLayout->addWidget(adaGridVariationSpinBox, 1, 1, 1, 1);
+
+    adaGridVariationSpinBox->setValue(2.0);
+    adaGridVariationSpinBox->setRange(0.25, 10.0);
+    adaGridVariationSpinBox->setDecimals(2);
+    adaGridVariationSpinBox->setSingleStep(0.25);
+
+    adaGridAcceptButton = new QPushButton(adaGridGroupBox); //NOLINT(cppcoreguidelines-owning-memory)
+    adaGridAcceptButton->setObjectName(QString::fromUtf8(u8"adaGridAcceptButton"));
+    adaGridLayout->addWidget(adaGridAcceptButton, 2, 1, 1, 1);
+
+    // ---------------------------------------------------------------------------------
+
     cancelButton = new QPushButton(this); //NOLINT(cppcoreguidelines-owning-memory)
     cancelButton->setObjectName(QString::fromUtf8(u8"cancelButton"));
     verticalDialogLayout->addWidget(cancelButton);
@@ -180,28 +225,67 @@ void Ui::GridDialog::SetupUi()
     radGridDistLabel->setText(tr("Distance"));
     radGridAcceptButton->setText(tr("Add"));
 
+    adaGridGroupBox->setTitle(tr("Adaptive grid refined by variation"));
+    adaGridDistLabel->setText(tr("Distance"));
+    adaGridVariationLabel->setText(tr("Variation"));
+    adaGridAcceptButton->setText(tr("Add"));
+
     cancelButton->setText(tr("Cancel"));
 }
 
 void Ui::GridDialog::OnSquareGridAcceptButtonPressed()
 {
-    this->gridType = GridType::Square;
-    this->distLike = this->squareGridDistSpinBox->value();
+    this->specification = Backend::GridSpecification
+    {
+        Backend::GridSpecification::Type::Square,
+        this->squareGridDistSpinBox->value(),
+        0.0,
+        0.0,
+        0
+    };
+
     this->accept();
 }
 
 void Ui::GridDialog::OnRadialConstantAngleGridAcceptButtonPressed()
 {
-    this->gridType = GridType::RadialConstantAngle;
-    this->distLike = this->rcaGridRadialSpinBox->value();
-    this->angleDegrees = this->rcaGridAngleSpinBox->value();
+    this->specification = Backend::GridSpecification
+    {
+        Backend::GridSpecification::Type::AngularFromConstantAngle,
+        this->rcaGridRadialSpinBox->value(),
+        static_cast<double>(this->rcaGridAngleSpinBox->value()),
+        0.0,
+        0
+    };
+
     this->accept();
 }
 
 void Ui::GridDialog::OnRadialApproximateDistanceAcceptButtonPressed()
 {
-    this->gridType = GridType::RadialApproximateDistance;
-    this->distLike = this->radGridDistSpinBox->value();
+    this->specification = Backend::GridSpecification
+    {
+        Backend::GridSpecification::Type::AngularFromApproximateDistance,
+        this->radGridDistSpinBox->value(),
+        0.0,
+        0.0,
+        0
+    };
+
+    this->accept();
+}
+
+void Ui::GridDialog::OnAdaptiveAcceptButtonPressed()
+{
+    this->specification = Backend::GridSpecification
+    {
+        Backend::GridSpecification::Type::Adaptive,
+        this->adaGridDistSpinBox->value(),
+        0.0,
+        this->adaGridVariationSpinBox->value(),
+        this->adaptiveDepth
+    };
+
     this->accept();
 }
 
@@ -35,6 +35,10 @@
 #include <QtWidgets/QVBoxLayout>
 #include <QtWidgets/QWidget>
 
+#include <memory>
+#include <optional>
+
+#include "../Backend/expression.h"
 #include "../Backend/gridgenerator.h"
 
 class FrontendTest;
@@ -49,21 +53,14 @@ namespace Ui
         friend FrontendTest;
 
     private:
-        enum class GridType
-        {
-            NotSet,
-            Square,
-            RadialConstantAngle,
-            RadialApproximateDistance,
-        };
-
-    private:
-        const double viewportX;
-        const double viewportY;
+        const double minX;
+        const double maxX;
+        const double minY;
+        const double maxY;
+        const int adaptiveDepth = 3;
 
-        GridType gridType;
-        double distLike;
-        double angleDegrees;
+        std::optional<Backend::GridSpecification> specification;
+        std::shared_ptr<Backend::Expression> expression;
 
         QVBoxLayout * verticalDialogLayout{};
 
@@ -87,16 +84,33 @@ namespace Ui
         QDoubleSpinBox * radGridDistSpinBox{};
         QPushButton * radGridAcceptButton{};
 
+        QGroupBox * adaGridGroupBox{};
+        QGridLayout * adaGridLayout{};
+        QLabel * adaGridDistLabel{};
+        QDoubleSpinBox * adaGridDistSpinBox{};
+        QLabel * adaGridVariationLabel{};
+        QDoubleSpinBox * adaGridVariationSpinBox{};
+        QPushButton * adaGridAcceptButton{};
+
         QPushButton * cancelButton{};
 
     public:
         /*!
          * \brief Initializes a new instance.
          * \param parent The Qt parent widget
-         * \param viewportX The maximum absolute value in x-direction.
-         * \param viewportY The maximum absolute value in y-direction.
+         * \param minX The minimum value in x-direction.
+         * \param maxX The maximum value in x-direction.
+         * \param minY The minimum value in y-direction.
+         * \param maxY The maximum value in y-direction.
+         */
+        GridDialog(QWidget * parent, double minX, double maxX, double minY, double maxY);
+
+        /*!
+         * \brief SetExpression sets the expression driving the adaptive grid.
+         *        The adaptive grid is only offered if an expression is set.
+         * \param expression The expression to refine the grid for.
          */
-        GridDialog(QWidget * parent, double viewportX, double viewportY);
+        void SetExpression(std::shared_ptr<Backend::Expression> expression);
 
         /*!
          * \brief GetResult gets the result of the grid generation, if any.
@@ -104,6 +118,12 @@ namespace Ui
          */
         [[nodiscard]] std::vector<Backend::complex> GetResult() const;
 
+        /*!
+         * \brief GetSpecification gets the description of the chosen grid, if any.
+         * \return The description of the grid, allowing it to be recreated for another area.
+         */
+        [[nodiscard]] std::optional<Backend::GridSpecification> GetSpecification() const;
+
     private:
         void SetupUi();
 
@@ -112,6 +132,7 @@ namespace Ui
         void OnSquareGridAcceptButtonPressed();
         void OnRadialConstantAngleGridAcceptButtonPressed();
         void OnRadialApproximateDistanceAcceptButtonPressed();
+        void OnAdaptiveAcceptButtonPressed();
     };
 
 }
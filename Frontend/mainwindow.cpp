@@ -18,35 +18,102 @@
 
 #include "mainwindow.h"
 #include "mainwindow_ui.h"
+#include "arrowfield.h"
 
+#include "../Backend/expressionprofiler.h"
 #include "../Backend/gridgenerator.h"
 
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileDialog>
 #include <QMessageBox>
+#include <QSaveFile>
+#include <algorithm>
+#include <array>
+#include <chrono>
 #include <utility>
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent),
       plotting(false),
+      appendPending(false),
       ui(new Ui::MainWindow),
-      parser(Backend::Parser(true))
+      arrowLayer(nullptr),
+      parser(Backend::Parser(true, {timeParameter})),
+      gridField(nullptr),
+      resultCache(resultCacheCapacity),
+      pendingSpecification(),
+      pendingMinX(0.0),
+      pendingMaxX(0.0),
+      pendingMinY(0.0),
+      pendingMaxY(0.0),
+      animationTime(0.0)
 {
     ui->setupUi(this);
 
-    ui->plot->xAxis->setRange(-viewport, viewport);
-    ui->plot->yAxis->setRange(-viewport, viewport);
+    ui->plot->xAxis->setRange(-initialViewport, initialViewport);
+    ui->plot->yAxis->setRange(-initialViewport, initialViewport);
+    ui->plot->setInteractions(QCP::iRangeDrag | QCP::iRangeZoom);
+
+    // arrows live on a buffered layer of their own, such that new arrows can be drawn on top of the existing ones
+    ui->plot->addLayer(QString::fromUtf8(u8"arrows"), ui->plot->layer(QString::fromUtf8(u8"main")), QCustomPlot::limAbove);
+    this->arrowLayer = ui->plot->layer(QString::fromUtf8(u8"arrows"));
+    this->arrowLayer->setMode(QCPLayer::lmBuffered);
+    ui->plot->setCurrentLayer(this->arrowLayer);
+
     ui->plot->replot();
 
     ui->funcLineEdit->setText(QString::fromUtf8(u8"z * i"));
     this->UpdateUiState();
 
-    connect(ui->plot, &QCustomPlot::mousePress, this, &MainWindow::OnPlotClick);
+    connect(ui->plot, &QCustomPlot::mousePress, this, &MainWindow::OnPlotPress);
+    connect(ui->plot, &QCustomPlot::mouseRelease, this, &MainWindow::OnPlotClick);
+    connect(ui->plot->xAxis, QOverload<const QCPRange &>::of(&QCPAxis::rangeChanged), this, &MainWindow::OnRangeChanged);
+    connect(ui->plot->yAxis, QOverload<const QCPRange &>::of(&QCPAxis::rangeChanged), this, &MainWindow::OnRangeChanged);
     connect(ui->funcLineEdit, &QLineEdit::textChanged, this, &MainWindow::OnFuncLineEditTextChanged);
     connect(ui->funcLineEdit, &QLineEdit::returnPressed, this, &MainWindow::OnReturnKeyPressed);
     connect(ui->funcSetButton, &QAbstractButton::pressed, this, &MainWindow::OnSetPressed);
     connect(ui->funcClearButton, &QAbstractButton::pressed, this, &MainWindow::OnClearPressed);
     connect(ui->gridButton, &QAbstractButton::pressed, this, &MainWindow::OnGridPressed);
+    connect(ui->flowButton, &QAbstractButton::pressed, this, &MainWindow::OnFlowPressed);
+    connect(ui->orbitButton, &QAbstractButton::toggled, this, &MainWindow::OnOrbitToggled);
+    connect(ui->rootButton, &QAbstractButton::pressed, this, &MainWindow::OnRootPressed);
+    connect(ui->animateButton, &QAbstractButton::toggled, this, &MainWindow::OnAnimateToggled);
+    connect(ui->profileButton, &QAbstractButton::toggled, this, &MainWindow::OnProfileToggled);
+    connect(ui->traceButton, &QAbstractButton::toggled, this, &MainWindow::OnTraceToggled);
+    connect(ui->plot, &QCustomPlot::beforeReplot, this, &MainWindow::OnBeforeReplot);
+    connect(ui->plot, &QCustomPlot::afterReplot, this, &MainWindow::OnAfterReplot);
     connect(ui->aboutButton, &QAbstractButton::pressed, this, &MainWindow::OnAboutPressed);
 
+    this->refinementTimer.setInterval(0);
+    connect(&this->refinementTimer, &QTimer::timeout, this, &MainWindow::OnRefinementTimeout);
+
+    // rapid panning and zooming is coalesced into a single grid update
+    this->viewportTimer.setInterval(this->viewportDebounce);
+    this->viewportTimer.setSingleShot(true);
+    connect(&this->viewportTimer, &QTimer::timeout, this, &MainWindow::OnViewportTimeout);
+
+    // frames are precomputed, so the timer only has to pick them up at a steady pace
+    this->animationTimer.setInterval(this->animationFrameInterval);
+    this->animationTimer.setTimerType(Qt::PreciseTimer);
+    connect(&this->animationTimer, &QTimer::timeout, this, &MainWindow::OnAnimationTimeout);
+
+    // streamlines are traced on a worker thread, the timer picks them up once they are done
+    this->streamlineTimer.setInterval(this->streamlinePollInterval);
+    connect(&this->streamlineTimer, &QTimer::timeout, this, &MainWindow::OnStreamlineTimeout);
+
+    // orbits of a grid are iterated on a worker thread as well
+    this->orbitGridTimer.setInterval(this->streamlinePollInterval);
+    connect(&this->orbitGridTimer, &QTimer::timeout, this, &MainWindow::OnOrbitGridTimeout);
+
+    // and so are the zeros and poles
+    this->rootTimer.setInterval(this->streamlinePollInterval);
+    connect(&this->rootTimer, &QTimer::timeout, this, &MainWindow::OnRootTimeout);
+
+    // several formulas are evaluated together on a worker thread
+    this->fusedGridTimer.setInterval(this->streamlinePollInterval);
+    connect(&this->fusedGridTimer, &QTimer::timeout, this, &MainWindow::OnFusedGridTimeout);
+
     QColor lightPink = QColor(0xFF, 0xB6, 0xC1);
 
     this->parseablePalette.setColor(QPalette::Base, Qt::white);
@@ -62,6 +129,11 @@ MainWindow::~MainWindow()
     delete ui;
 }
 
+void MainWindow::OnPlotPress(QMouseEvent * event)
+{
+    this->pressPosition = event->pos();
+}
+
 void MainWindow::OnPlotClick(QMouseEvent * event)
 {
     if (!this->plotting)
@@ -69,12 +141,40 @@ void MainWindow::OnPlotClick(QMouseEvent * event)
         return;
     }
 
+    // a release after dragging the plot is not a click
+    if ((event->pos() - this->pressPosition).manhattanLength() > this->clickTolerance)
+    {
+        return;
+    }
+
     double inputX = ui->plot->xAxis->pixelToCoord(event->pos().x());
     double inputY = ui->plot->yAxis->pixelToCoord(event->pos().y());
 
-    this->PlotFrom(inputX, inputY);
+    if (ui->orbitButton->isChecked())
+    {
+        this->PlotOrbitFrom(inputX, inputY);
+    }
+    else
+    {
+        this->PlotFrom(inputX, inputY);
+    }
 
-    ui->plot->replot();
+    this->ScheduleAppend();
+}
+
+void MainWindow::OnRangeChanged()
+{
+    if (this->gridSpecification.has_value() || this->framePipeline)
+    {
+        this->viewportTimer.start();
+    }
+}
+
+void MainWindow::OnViewportTimeout()
+{
+    this->PlotGrid();
+
+    ui->plot->replot(QCustomPlot::rpQueuedReplot);
 }
 
 void MainWindow::OnFuncLineEditTextChanged()
@@ -101,7 +201,94 @@ void MainWindow::OnGridPressed()
 {
     this->HandleGrid();
 
-    ui->plot->replot();
+    ui->plot->replot(QCustomPlot::rpQueuedReplot);
+}
+
+void MainWindow::OnFlowPressed()
+{
+    this->PlotStreamlines();
+}
+
+void MainWindow::OnOrbitToggled()
+{
+    // the grid shows either the images or the orbit ends
+    if (this->gridSpecification.has_value())
+    {
+        this->PlotGrid();
+
+        this->arrowLayer->replot();
+        ui->plot->replot(QCustomPlot::rpQueuedReplot);
+    }
+}
+
+void MainWindow::OnRootPressed()
+{
+    this->PlotRoots();
+}
+
+void MainWindow::OnAnimateToggled()
+{
+    if (ui->animateButton->isChecked())
+    {
+        this->StartAnimation();
+    }
+    else
+    {
+        this->StopAnimation();
+        this->PlotGrid();
+
+        this->arrowLayer->replot();
+        ui->plot->replot(QCustomPlot::rpQueuedReplot);
+    }
+}
+
+void MainWindow::OnProfileToggled()
+{
+    if (ui->profileButton->isChecked())
+    {
+        this->ShowProfile();
+    }
+    else
+    {
+        ui->profilePanel->setVisible(false);
+        ui->profilePanel->clear();
+    }
+}
+
+void MainWindow::OnTraceToggled()
+{
+    if (ui->traceButton->isChecked())
+    {
+        Backend::Tracer::Enable();
+        return;
+    }
+
+    Backend::Tracer::Disable();
+
+    auto title = QCoreApplication::translate("MainWindow", "Save Trace", nullptr);
+    auto fileName = QFileDialog::getSaveFileName(
+                this,
+                title,
+                QString::fromUtf8(u8"trace.json"),
+                QCoreApplication::translate("MainWindow", "Trace Event Files (*.json)", nullptr));
+
+    if (!fileName.isEmpty() && !this->SaveTrace(fileName))
+    {
+        //: Arg 1 is a placeholder for the name of the file.
+        auto messageTemplate = QCoreApplication::translate("MainWindow", "The trace could not be saved to %1.", nullptr);
+        QMessageBox::warning(this, title, messageTemplate.arg(QDir::toNativeSeparators(fileName)));
+    }
+}
+
+void MainWindow::OnBeforeReplot()
+{
+    // queued replots happen later than they are requested, so the span follows the plot itself
+    this->replotSpan.emplace(u8"plot", u8"QCustomPlot::replot");
+}
+
+void MainWindow::OnAfterReplot()
+{
+    this->replotSpan.reset();
 }
 
 void MainWindow::OnAboutPressed()
@@ -109,18 +296,129 @@ void MainWindow::OnAboutPressed()
     this->ShowAboutDialog();
 }
 
+void MainWindow::OnRefinementTimeout()
+{
+    this->RefineGrid();
+
+    // the grid arrows are held by a single item, so the whole arrow layer has to be drawn again
+    this->arrowLayer->replot();
+}
+
+void MainWindow::OnAppendTimeout()
+{
+    this->appendPending = false;
+
+    // falls back to a full replot if anything but the addition of arrows happened in between
+    this->arrowLayer->replotAppended();
+}
+
+void MainWindow::OnAnimationTimeout()
+{
+    if (!this->framePipeline)
+    {
+        return;
+    }
+
+    // if the producer falls behind, the current frame stays on screen
+    auto frame = this->framePipeline->TakeFrame();
+    if (!frame.has_value())
+    {
+        return;
+    }
+
+    this->PlotFrame(frame.value());
+
+    this->arrowLayer->replot();
+    ui->plot->replot(QCustomPlot::rpQueuedReplot);
+}
+
+void MainWindow::OnStreamlineTimeout()
+{
+    if (!this->streamlineFuture.valid() || this->streamlineFuture.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+    {
+        return;
+    }
+
+    this->streamlineTimer.stop();
+    this->ShowStreamlines(this->streamlineFuture.get());
+
+    this->arrowLayer->replot();
+    ui->plot->replot(QCustomPlot::rpQueuedReplot);
+}
+
+void MainWindow::OnOrbitGridTimeout()
+{
+    if (!this->orbitGridFuture.valid() || this->orbitGridFuture.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+    {
+        return;
+    }
+
+    this->orbitGridTimer.stop();
+    this->PlotSamples(this->orbitGridFuture.get());
+
+    this->arrowLayer->replot();
+    ui->plot->replot(QCustomPlot::rpQueuedReplot);
+}
+
+void MainWindow::OnRootTimeout()
+{
+    if (!this->rootFuture.valid() || this->rootFuture.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+    {
+        return;
+    }
+
+    this->rootTimer.stop();
+    this->ShowRoots(this->rootFuture.get());
+
+    this->arrowLayer->replot();
+    ui->plot->replot(QCustomPlot::rpQueuedReplot);
+}
+
+void MainWindow::OnFusedGridTimeout()
+{
+    if (!this->fusedGridFuture.valid() || this->fusedGridFuture.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+    {
+        return;
+    }
+
+    this->fusedGridTimer.stop();
+    auto results = this->fusedGridFuture.get();
+
+    // every formula is kept on its own, like the single formula
+    std::vector<std::shared_ptr<Backend::Expression>> expressions({ this->expression });
+    expressions.insert(expressions.end(), this->overlayExpressions.begin(), this->overlayExpressions.end());
+
+    std::vector<Backend::ResultCache::Samples> stored;
+
+    for (std::size_t index = 0; index < results.size(); ++index)
+    {
+        stored.push_back(this->resultCache.Insert(expressions[index], this->pendingSpecification, this->pendingMinX, this->pendingMaxX, this->pendingMinY, this->pendingMaxY, std::move(results[index])));
+    }
+
+    this->PlotFusedSamples(stored);
+
+    this->arrowLayer->replot();
+    ui->plot->replot(QCustomPlot::rpQueuedReplot);
+}
+
 void MainWindow::UpdateUiState()
 {
     ui->funcLineEdit->setDisabled(this->plotting);
     ui->funcSetButton->setDisabled(this->plotting);
     ui->funcClearButton->setDisabled(!this->plotting);
     ui->gridButton->setDisabled(!this->plotting);
+    ui->flowButton->setDisabled(!this->plotting);
+    ui->orbitButton->setDisabled(!this->plotting);
+    ui->rootButton->setDisabled(!this->plotting);
+    ui->animateButton->setDisabled(!this->plotting);
+    ui->profileButton->setDisabled(!this->plotting);
 }
 
 void MainWindow::UpdateParseability()
 {
     std::string funcString = ui->funcLineEdit->text().toStdString();
-    bool isParseable = funcString.empty() || this->parser.IsParseable(funcString);
+    auto formulas = MainWindow::SplitFormulas(funcString);
+    bool isParseable = funcString.empty() || std::all_of(formulas.begin(), formulas.end(), [this](const std::string & formula){ return this->parser.IsParseable(formula); });
     QPalette & palette = isParseable ? this->parseablePalette : this->nonParseablePalette;
 
     ui->funcLineEdit->setPalette(palette);
@@ -129,9 +427,18 @@ void MainWindow::UpdateParseability()
 void MainWindow::UpdateExpression()
 {
     auto input = std::string(ui->funcLineEdit->text().toStdString());
-    if (this->parser.IsParseable(input))
+    auto formulas = MainWindow::SplitFormulas(input);
+
+    // several formulas are separated by semicolons, the first one is the main one
+    if (std::all_of(formulas.begin(), formulas.end(), [this](const std::string & formula){ return this->parser.IsParseable(formula); }))
     {
-        this->expression = this->parser.Parse(input);
+        this->expression = this->parser.Parse(formulas.front());
+        this->overlayExpressions.clear();
+
+        for (std::size_t index = 1; index < formulas.size(); ++index)
+        {
+            this->overlayExpressions.push_back(this->parser.Parse(formulas[index]));
+        }
 
         this->plotting = true;
     }
@@ -141,14 +448,42 @@ void MainWindow::UpdateExpression()
 
 void MainWindow::ClearPlot()
 {
+    this->StopAnimation();
+    this->animationTime = 0.0;
+    this->StopRefinement();
+    this->StopStreamlines();
+    this->StopOrbitGrid();
+    this->StopRoots();
+    this->StopFusedGrid();
+    this->viewportTimer.stop();
+    this->gridSpecification.reset();
+    this->viewportEvaluator.reset();
+    this->gridField = nullptr;
+    this->overlayFields.clear();
+    this->rootMarkers.clear();
+    this->streamlineCurves.clear();
     ui->plot->clearItems();
+    ui->plot->clearPlottables();
     ui->plot->replot();
     this->expression.reset();
+    this->overlayExpressions.clear();
     this->plotting = false;
+    ui->animateButton->setChecked(false);
+    ui->profileButton->setChecked(false);
 
     this->UpdateUiState();
 }
 
+void MainWindow::ScheduleAppend()
+{
+    // bursts of clicks and refinement steps are drawn together
+    if (!this->appendPending)
+    {
+        this->appendPending = true;
+        QTimer::singleShot(0, this, &MainWindow::OnAppendTimeout);
+    }
+}
+
 QColor MainWindow::GenerateColor() const
 {
     static std::random_device rd;
@@ -160,22 +495,78 @@ QColor MainWindow::GenerateColor() const
     return QColor::fromHsv(distHue(gen), distSaturation(gen), distValue(gen));
 }
 
+std::vector<std::string> MainWindow::SplitFormulas(const std::string & input)
+{
+    std::vector<std::string> formulas;
+    std::string::size_type start = 0;
+
+    while (true)
+    {
+        auto end = input.find(';', start);
+        formulas.push_back(input.substr(start, end == std::string::npos ? std::string::npos : end - start));
+
+        if (end == std::string::npos)
+        {
+            return formulas;
+        }
+
+        start = end + 1;
+    }
+}
+
+Qt::PenStyle MainWindow::GetPenStyle(std::size_t formulaIndex)
+{
+    static const std::array<Qt::PenStyle, 5> styles = { Qt::SolidLine, Qt::DashLine, Qt::DotLine, Qt::DashDotLine, Qt::DashDotDotLine };
+
+    return styles.at(formulaIndex % styles.size());
+}
+
 void MainWindow::PlotFrom(double inputX, double inputY)
 {
-    auto result = this->expression->Evaluate(Backend::complex(inputX, inputY));
+    Backend::TraceSpan span(u8"plot", u8"MainWindow::PlotFrom");
+
+    auto input = Backend::complex(inputX, inputY);
+    auto result = this->expression->Evaluate(input);
 
-    if (!result.has_value())
+    if (result.has_value())
     {
-        return;
+        this->PlotArrow(input, result.value());
+    }
+
+    for (std::size_t index = 0; index < this->overlayExpressions.size(); ++index)
+    {
+        auto overlayResult = this->overlayExpressions[index]->Evaluate(input);
+
+        if (overlayResult.has_value())
+        {
+            this->PlotArrow(input, overlayResult.value(), MainWindow::GetPenStyle(index + 1));
+        }
     }
+}
+
+void MainWindow::PlotOrbitFrom(double inputX, double inputY)
+{
+    Backend::OrbitEvaluator orbitEvaluator(this->expression, this->orbitIterations, this->orbitEscapeRadius, this->orbitTolerance);
+    auto orbit = orbitEvaluator.Trace(Backend::complex(inputX, inputY));
 
+    for (std::size_t index = 1; index < orbit.size(); ++index)
+    {
+        this->PlotArrow(orbit[index - 1], orbit[index]);
+    }
+}
+
+QCPAbstractItem * MainWindow::PlotArrow(Backend::complex input, Backend::complex output, Qt::PenStyle penStyle)
+{
     auto pen = QPen(this->GenerateColor());
+    pen.setStyle(penStyle);
 
     auto *arrow = new QCPItemLine(ui->plot); //NOLINT(cppcoreguidelines-owning-memory)
     arrow->setHead(QCPLineEnding::esSpikeArrow);
-    arrow->start->setCoords(inputX, inputY);
-    arrow->end->setCoords(result.value().real(), result.value().imag());
+    arrow->start->setCoords(input.real(), input.imag());
+    arrow->end->setCoords(output.real(), output.imag());
     arrow->setPen(pen);
+
+    return arrow;
 }
 
 void MainWindow::HandleGrid()
@@ -185,7 +576,11 @@ void MainWindow::HandleGrid()
         return;
     }
 
-    this->gridDialog = std::make_unique<Ui::GridDialog>(this, this->viewport, this->viewport);
+    auto xRange = ui->plot->xAxis->range();
+    auto yRange = ui->plot->yAxis->range();
+
+    this->gridDialog = std::make_unique<Ui::GridDialog>(this, xRange.lower, xRange.upper, yRange.lower, yRange.upper);
+    this->gridDialog->SetExpression(this->expression);
     this->gridDialog->setModal(true);
     this->gridDialog->show();
     int dialogCode = this->gridDialog->exec();
@@ -195,15 +590,575 @@ void MainWindow::HandleGrid()
         return;
     }
 
-    auto result = this->gridDialog->GetResult();
+    this->gridSpecification = this->gridDialog->GetSpecification();
     this->gridDialog.reset();
 
-    for (auto & input : result)
+    this->PlotGrid();
+}
+
+void MainWindow::PlotGrid()
+{
+    Backend::TraceSpan span(u8"plot", u8"MainWindow::PlotGrid");
+
+    // an animation shows the grid itself, restarting for the new viewport or specification
+    if (this->framePipeline)
+    {
+        this->StartAnimation();
+        return;
+    }
+
+    this->StopRefinement();
+    this->StopOrbitGrid();
+    this->StopFusedGrid();
+    this->RemoveGridArrows();
+
+    if (!this->plotting || !this->gridSpecification.has_value())
+    {
+        return;
+    }
+
+    auto xRange = ui->plot->xAxis->range();
+    auto yRange = ui->plot->yAxis->range();
+
+    // every kind of grid gets coarser when zooming out, such that the number of points stays bounded
+    Backend::GridGenerator gridGenerator(xRange.lower, xRange.upper, yRange.lower, yRange.upper);
+    auto specification = gridGenerator.Limit(this->gridSpecification.value(), this->maxPointsPerViewport);
+
+    if (ui->orbitButton->isChecked())
+    {
+        this->PlotOrbitGrid(xRange.lower, xRange.upper, yRange.lower, yRange.upper);
+        return;
+    }
+
+    // several formulas are evaluated together, sharing their common parts
+    if (!this->overlayExpressions.empty())
+    {
+        this->PlotFusedGrid(xRange.lower, xRange.upper, yRange.lower, yRange.upper);
+        return;
+    }
+
+    // revisiting a viewport with the same expression and grid does not evaluate again
+    auto cached = this->resultCache.Find(this->expression, specification, xRange.lower, xRange.upper, yRange.lower, yRange.upper);
+    if (cached)
+    {
+        this->PlotSamples(*cached);
+        return;
+    }
+
+    this->pendingSamples.clear();
+    this->pendingSpecification = specification;
+    this->pendingMinX = xRange.lower;
+    this->pendingMaxX = xRange.upper;
+    this->pendingMinY = yRange.lower;
+    this->pendingMaxY = yRange.upper;
+
+    Backend::complex center(xRange.center(), yRange.center());
+    auto tileSize = std::max(xRange.size(), yRange.size()) / this->tilesPerViewport;
+
+    // square grids share their points between viewports, so only newly exposed points are evaluated
+    if (specification.type == Backend::GridSpecification::Type::Square)
+    {
+        auto dist = specification.distLike;
+
+        // zooming changes the distance by doubling or halving, so the points shared with the previous grid are kept
+        if (!this->viewportEvaluator)
+        {
+            this->viewportEvaluator = std::make_unique<Backend::ViewportEvaluator>(this->expression, dist);
+        }
+        else if (this->viewportEvaluator->GetDistance() != dist)
+        {
+            this->viewportEvaluator = std::make_unique<Backend::ViewportEvaluator>(*this->viewportEvaluator, dist);
+        }
+
+        std::vector<Backend::complex> exposed;
+        auto known = this->viewportEvaluator->Collect(xRange.lower, xRange.upper, yRange.lower, yRange.upper, exposed);
+        this->PlotSamples(known);
+        this->pendingSamples = std::move(known);
+
+        if (exposed.empty())
+        {
+            static_cast<void>(this->resultCache.Insert(this->expression, specification, xRange.lower, xRange.upper, yRange.lower, yRange.upper, std::move(this->pendingSamples)));
+            this->pendingSamples.clear();
+            return;
+        }
+
+        this->tileScheduler = std::make_unique<Backend::TileScheduler>(this->viewportEvaluator->GetEvaluationExpression(), exposed, center, tileSize);
+    }
+    else if (specification.type == Backend::GridSpecification::Type::Adaptive)
+    {
+        // the refinement has evaluated every point already, so there is nothing left to schedule
+        auto samples = gridGenerator.CreateAdaptiveSamples(specification.distLike, this->expression, specification.variation, specification.depth);
+
+        this->PlotSamples(samples);
+        static_cast<void>(this->resultCache.Insert(this->expression, specification, xRange.lower, xRange.upper, yRange.lower, yRange.upper, std::move(samples)));
+        return;
+    }
+    else
+    {
+        auto grid = gridGenerator.Create(specification, this->expression);
+
+        this->tileScheduler = std::make_unique<Backend::TileScheduler>(this->expression, grid, center, tileSize);
+    }
+
+    // the coarse grid is shown right away, the tiles follow in the background
+    this->RefineGrid();
+
+    if (this->tileScheduler && this->tileScheduler->HasNext())
+    {
+        this->refinementTimer.start();
+    }
+}
+
+void MainWindow::RemoveGridArrows()
+{
+    if (this->gridField != nullptr)
+    {
+        this->gridField->Clear();
+    }
+
+    for (auto * overlayField : this->overlayFields)
     {
-        this->PlotFrom(input.real(), input.imag());
+        overlayField->Clear();
     }
 }
 
+void MainWindow::RefineGrid()
+{
+    if (!this->tileScheduler)
+    {
+        this->refinementTimer.stop();
+        return;
+    }
+
+    QElapsedTimer elapsedTimer;
+    elapsedTimer.start();
+
+    do
+    {
+        auto samples = this->tileScheduler->GetNext();
+        this->PlotSamples(samples);
+
+        // newly exposed points of the square grid are kept for the next viewport
+        if (this->viewportEvaluator && this->gridSpecification.value().type == Backend::GridSpecification::Type::Square)
+        {
+            this->viewportEvaluator->Store(samples);
+        }
+
+        this->pendingSamples.insert(this->pendingSamples.end(), samples.begin(), samples.end());
+    }
+    while (this->tileScheduler->HasNext() && elapsedTimer.elapsed() < this->refinementBudget);
+
+    if (!this->tileScheduler->HasNext())
+    {
+        // only complete grids are worth keeping
+        static_cast<void>(this->resultCache.Insert(this->expression, this->pendingSpecification, this->pendingMinX, this->pendingMaxX, this->pendingMinY, this->pendingMaxY, std::move(this->pendingSamples)));
+        this->pendingSamples.clear();
+        this->StopRefinement();
+    }
+}
+
+void MainWindow::PlotStreamlines()
+{
+    if (!this->plotting)
+    {
+        return;
+    }
+
+    this->StopStreamlines();
+
+    auto xRange = ui->plot->xAxis->range();
+    auto yRange = ui->plot->yAxis->range();
+    auto viewportSize = std::max(xRange.size(), yRange.size());
+
+    // the lines always start on a coarse square grid, independent of the chosen grid, which may be arbitrarily dense
+    Backend::GridSpecification specification { Backend::GridSpecification::Type::Square, viewportSize / this->streamlineSeedsPerViewport, 0.0, 0.0, 0 };
+
+    Backend::GridGenerator gridGenerator(xRange.lower, xRange.upper, yRange.lower, yRange.upper);
+    auto seeds = gridGenerator.Create(specification, this->expression);
+
+    auto step = viewportSize / this->streamlineStepsPerViewport;
+    auto tracer = std::make_shared<Backend::StreamlineTracer>(this->expression, Backend::StreamlineTracer::Method::DormandPrince45, step, step * this->streamlineTolerance, this->streamlineMaxSteps, xRange.lower, xRange.upper, yRange.lower, yRange.upper);
+
+    this->streamlineFuture = std::async(std::launch::async, [tracer, seeds = std::move(seeds)]()
+    {
+        return tracer->TraceAll(seeds);
+    });
+
+    this->streamlineTimer.start();
+}
+
+void MainWindow::ShowStreamlines(const std::vector<std::vector<Backend::complex>> & lines)
+{
+    this->RemoveStreamlines();
+
+    for (const auto & line : lines)
+    {
+        if (line.size() < 2)
+        {
+            continue;
+        }
+
+        QVector<QCPCurveData> data;
+        data.reserve(static_cast<int>(line.size()));
+
+        for (const auto & point : line)
+        {
+            data.append(QCPCurveData(data.size(), point.real(), point.imag()));
+        }
+
+        auto *curve = new QCPCurve(ui->plot->xAxis, ui->plot->yAxis); //NOLINT(cppcoreguidelines-owning-memory)
+        curve->data()->set(data, true);
+        curve->setPen(QPen(this->GenerateColor()));
+        this->streamlineCurves.append(curve);
+    }
+}
+
+void MainWindow::RemoveStreamlines()
+{
+    // other plottables stay, only the streamlines of an earlier run are replaced
+    for (auto * curve : this->streamlineCurves)
+    {
+        static_cast<void>(ui->plot->removePlottable(curve));
+    }
+
+    this->streamlineCurves.clear();
+}
+
+void MainWindow::StopStreamlines()
+{
+    this->streamlineTimer.stop();
+
+    // the seeds are capped, so waiting for a running trace is short
+    if (this->streamlineFuture.valid())
+    {
+        this->streamlineFuture.wait();
+        this->streamlineFuture = std::future<std::vector<std::vector<Backend::complex>>>();
+    }
+}
+
+void MainWindow::PlotRoots()
+{
+    if (!this->plotting)
+    {
+        return;
+    }
+
+    this->StopRoots();
+
+    auto xRange = ui->plot->xAxis->range();
+    auto yRange = ui->plot->yAxis->range();
+    auto cellSize = std::max(xRange.size(), yRange.size()) / this->rootCellsPerViewport;
+
+    auto rootFinder = std::make_shared<Backend::RootFinder>(this->expression, xRange.lower, xRange.upper, yRange.lower, yRange.upper);
+
+    this->rootFuture = std::async(std::launch::async, [rootFinder, cellSize]()
+    {
+        return rootFinder->Find(cellSize);
+    });
+
+    this->rootTimer.start();
+}
+
+void MainWindow::ShowRoots(const std::vector<Backend::Root> & roots)
+{
+    // other items stay, only the markers of an earlier run are replaced
+    ui->plot->removeItems(this->rootMarkers);
+    this->rootMarkers.clear();
+
+    for (const auto & root : roots)
+    {
+        auto isZero = root.kind == Backend::Root::Kind::Zero;
+
+        auto *marker = new QCPItemTracer(ui->plot); //NOLINT(cppcoreguidelines-owning-memory)
+        marker->position->setCoords(root.location.real(), root.location.imag());
+        marker->setStyle(isZero ? QCPItemTracer::tsCircle : QCPItemTracer::tsPlus);
+        marker->setSize(8.0 + 2.0 * root.order);
+        marker->setPen(QPen(isZero ? Qt::darkBlue : Qt::darkRed, 2.0));
+
+        this->rootMarkers.append(marker);
+    }
+}
+
+void MainWindow::StopRoots()
+{
+    this->rootTimer.stop();
+
+    // the number of cells is fixed per viewport, so waiting for a running search is short
+    if (this->rootFuture.valid())
+    {
+        this->rootFuture.wait();
+        this->rootFuture = std::future<std::vector<Backend::Root>>();
+    }
+}
+
+void MainWindow::PlotSamples(const std::vector<Backend::Sample> & samples)
+{
+    Backend::TraceSpan span(u8"plot", u8"MainWindow::PlotSamples");
+
+    // grid arrows share a single item, which aggregates them when they get too dense on screen
+    if (this->gridField == nullptr)
+    {
+        this->gridField = new ArrowField(ui->plot); //NOLINT(cppcoreguidelines-owning-memory)
+    }
+
+    for (const auto & sample : samples)
+    {
+        if (sample.output.has_value())
+        {
+            this->gridField->AddArrow(sample.input, sample.output.value(), this->GenerateColor());
+        }
+    }
+}
+
+void MainWindow::PlotFusedGrid(double minX, double maxX, double minY, double maxY)
+{
+    Backend::GridGenerator gridGenerator(minX, maxX, minY, maxY);
+    auto specification = gridGenerator.Limit(this->gridSpecification.value(), this->maxPointsPerViewport);
+
+    std::vector<std::shared_ptr<Backend::Expression>> expressions({ this->expression });
+    expressions.insert(expressions.end(), this->overlayExpressions.begin(), this->overlayExpressions.end());
+
+    // revisiting a viewport does not evaluate again, if all formulas are still known
+    std::vector<Backend::ResultCache::Samples> cached;
+
+    for (const auto & expression : expressions)
+    {
+        auto samples = this->resultCache.Find(expression, specification, minX, maxX, minY, maxY);
+        if (!samples)
+        {
+            break;
+        }
+
+        cached.push_back(samples);
+    }
+
+    if (cached.size() == expressions.size())
+    {
+        this->PlotFusedSamples(cached);
+        return;
+    }
+
+    this->pendingSpecification = specification;
+    this->pendingMinX = minX;
+    this->pendingMaxX = maxX;
+    this->pendingMinY = minY;
+    this->pendingMaxY = maxY;
+
+    auto grid = gridGenerator.Create(specification, this->expression);
+
+    auto fusedEvaluator = std::make_shared<Backend::FusedEvaluator>(expressions);
+
+    this->fusedGridFuture = std::async(std::launch::async, [fusedEvaluator, grid = std::move(grid)]()
+    {
+        return fusedEvaluator->EvaluateAll(grid);
+    });
+
+    this->fusedGridTimer.start();
+}
+
+void MainWindow::PlotFusedSamples(const std::vector<Backend::ResultCache::Samples> & results)
+{
+    this->PlotSamples(*results.front());
+
+    // every overlay has a field of its own, such that aggregation does not mix the formulas
+    for (std::size_t index = 0; index < this->overlayExpressions.size(); ++index)
+    {
+        if (this->overlayFields.size() <= index)
+        {
+            auto *overlayField = new ArrowField(ui->plot); //NOLINT(cppcoreguidelines-owning-memory)
+            overlayField->SetPenStyle(MainWindow::GetPenStyle(index + 1));
+            this->overlayFields.push_back(overlayField);
+        }
+
+        for (const auto & sample : *results[index + 1])
+        {
+            if (sample.output.has_value())
+            {
+                this->overlayFields[index]->AddArrow(sample.input, sample.output.value(), this->GenerateColor());
+            }
+        }
+    }
+}
+
+void MainWindow::StopFusedGrid()
+{
+    this->fusedGridTimer.stop();
+
+    // the grid is capped, so waiting for a running evaluation is short
+    if (this->fusedGridFuture.valid())
+    {
+        this->fusedGridFuture.wait();
+        this->fusedGridFuture = std::future<std::vector<std::vector<Backend::Sample>>>();
+    }
+}
+
+void MainWindow::PlotOrbitGrid(double minX, double maxX, double minY, double maxY)
+{
+    Backend::GridGenerator gridGenerator(minX, maxX, minY, maxY);
+    auto grid = gridGenerator.Create(gridGenerator.Limit(this->gridSpecification.value(), this->maxPointsPerViewport), this->expression);
+
+    auto orbitEvaluator = std::make_shared<Backend::OrbitEvaluator>(this->expression, this->orbitIterations, this->orbitEscapeRadius, this->orbitTolerance);
+
+    this->orbitGridFuture = std::async(std::launch::async, [orbitEvaluator, grid = std::move(grid)]()
+    {
+        auto results = orbitEvaluator->EvaluateAll(grid);
+
+        // escaped and undefined orbits are left out, like undefined values of the plain grid
+        std::vector<Backend::Sample> samples;
+        samples.reserve(grid.size());
+
+        for (std::size_t index = 0; index < grid.size(); ++index)
+        {
+            const auto & result = results[index];
+            auto isKept = result.outcome == Backend::OrbitResult::Outcome::Bounded || result.outcome == Backend::OrbitResult::Outcome::Converged;
+            samples.push_back(Backend::Sample{grid[index], isKept ? std::optional<Backend::complex>(result.last) : std::nullopt});
+        }
+
+        return samples;
+    });
+
+    this->orbitGridTimer.start();
+}
+
+void MainWindow::StopOrbitGrid()
+{
+    this->orbitGridTimer.stop();
+
+    // the grid is capped, so waiting for running orbits is short
+    if (this->orbitGridFuture.valid())
+    {
+        this->orbitGridFuture.wait();
+        this->orbitGridFuture = std::future<std::vector<Backend::Sample>>();
+    }
+}
+
+void MainWindow::StopRefinement()
+{
+    this->refinementTimer.stop();
+    this->pendingSamples.clear();
+
+    if (this->tileScheduler)
+    {
+        this->tileScheduler->Cancel();
+        this->tileScheduler.reset();
+    }
+}
+
+void MainWindow::StartAnimation()
+{
+    this->StopAnimation();
+    this->StopRefinement();
+
+    if (!this->plotting)
+    {
+        return;
+    }
+
+    // the producer gets an expression of its own, such that the GUI thread may keep evaluating this->expression
+    auto parameterized = this->parser.ParseParameterized(MainWindow::SplitFormulas(ui->funcLineEdit->text().toStdString()).front());
+    if (!parameterized)
+    {
+        return;
+    }
+
+    auto xRange = ui->plot->xAxis->range();
+    auto yRange = ui->plot->yAxis->range();
+    auto viewportSize = std::max(xRange.size(), yRange.size());
+    auto specification = this->gridSpecification.value_or(Backend::GridSpecification { Backend::GridSpecification::Type::Square, viewportSize / this->animationPointsPerViewport, 0.0, 0.0, 0 });
+
+    Backend::GridGenerator gridGenerator(xRange.lower, xRange.upper, yRange.lower, yRange.upper);
+    auto grid = gridGenerator.Create(gridGenerator.Limit(specification, this->maxPointsPerViewport), parameterized->GetExpression());
+
+    // every point keeps its color, such that the arrows appear to move
+    this->animationColors.clear();
+    this->animationColors.reserve(grid.size());
+
+    for (std::size_t index = 0; index < grid.size(); ++index)
+    {
+        this->animationColors.push_back(this->GenerateColor());
+    }
+
+    this->framePipeline = std::make_unique<Backend::FramePipeline>(parameterized, this->timeParameter, std::move(grid), this->animationTime, this->animationTimeStep, this->animationFrameInterval / 1000.0, this->animationMaxDepth);
+    this->animationTimer.start();
+}
+
+void MainWindow::StopAnimation()
+{
+    this->animationTimer.stop();
+    this->framePipeline.reset();
+}
+
+void MainWindow::PlotFrame(const Backend::Frame & frame)
+{
+    this->RemoveGridArrows();
+
+    if (this->gridField == nullptr)
+    {
+        this->gridField = new ArrowField(ui->plot); //NOLINT(cppcoreguidelines-owning-memory)
+    }
+
+    for (std::size_t index = 0; index < frame.samples.size(); ++index)
+    {
+        const auto & sample = frame.samples[index];
+
+        if (sample.output.has_value())
+        {
+            this->gridField->AddArrow(sample.input, sample.output.value(), this->animationColors[index]);
+        }
+    }
+
+    // a restart continues where the animation stopped
+    this->animationTime = frame.time + this->animationTimeStep;
+}
+
+void MainWindow::ShowProfile()
+{
+    if (!this->plotting)
+    {
+        return;
+    }
+
+    auto xRange = ui->plot->xAxis->range();
+    auto yRange = ui->plot->yAxis->range();
+    auto viewportSize = std::max(xRange.size(), yRange.size());
+
+    // the profile always uses a coarse square grid, independent of the chosen grid, which may be arbitrarily dense
+    Backend::GridSpecification specification { Backend::GridSpecification::Type::Square, viewportSize / this->profilePointsPerViewport, 0.0, 0.0, 0 };
+
+    Backend::GridGenerator gridGenerator(xRange.lower, xRange.upper, yRange.lower, yRange.upper);
+    auto grid = gridGenerator.Create(specification, this->expression);
+
+    // the profile covers the first formula on the points of the current view
+    Backend::ExpressionProfiler profiler(this->expression);
+
+    for (const auto & input : grid)
+    {
+        static_cast<void>(profiler.GetExpression()->Evaluate(input));
+    }
+
+    //: Arg 1 is a placeholder for the number of points.
+    auto noteTemplate = QCoreApplication::translate("MainWindow", "Tree evaluation of the first formula at %1 points. Square grids are evaluated from row and column tables, which this profile does not cover.", nullptr);
+    auto note = noteTemplate.arg(grid.size());
+
+    ui->profilePanel->setPlainText(note + QString::fromUtf8(u8"\n\n") + QString::fromStdString(profiler.FormatReport()));
+    ui->profilePanel->setVisible(true);
+}
+
+bool MainWindow::SaveTrace(const QString & fileName)
+{
+    // Qt takes care of the encoding of the file name, which std::ofstream does not on every platform
+    QSaveFile file(fileName);
+
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        return false;
+    }
+
+    auto json = QByteArray::fromStdString(Backend::Tracer::ToJson());
+
+    return file.write(json) == json.size() && file.commit();
+}
+
 void MainWindow::ShowAboutDialog()
 {
     auto messageBoxTitleTemplate = QCoreApplication::translate("MainWindow", "About %1", nullptr);
@@ -19,16 +19,36 @@
 #ifndef MAINWINDOW_H
 #define MAINWINDOW_H
 
+#include <QList>
 #include <QMainWindow>
 #include <QMessageBox>
+#include <QTimer>
 
+#include <future>
 #include <memory>
+#include <optional>
+#include <string>
+#include <vector>
 
 #include "../Backend/expression.h"
+#include "../Backend/framepipeline.h"
+#include "../Backend/fusedevaluator.h"
+#include "../Backend/gridgenerator.h"
+#include "../Backend/orbitevaluator.h"
 #include "../Backend/parser.h"
+#include "../Backend/resultcache.h"
+#include "../Backend/rootfinder.h"
+#include "../Backend/streamlinetracer.h"
+#include "../Backend/tilescheduler.h"
+#include "../Backend/tracer.h"
+#include "../Backend/viewportevaluator.h"
 #include "griddialog.h"
 
+class ArrowField;
 class FrontendTest;
+class QCPAbstractItem;
+class QCPAbstractPlottable;
+class QCPLayer;
 
 QT_BEGIN_NAMESPACE
 namespace Ui { class MainWindow; }
@@ -41,23 +61,77 @@ class MainWindow : public QMainWindow //NOLINT(cppcoreguidelines-special-member-
     Q_OBJECT
 
 private:
-    const double viewport = 10.0;
+    const double initialViewport = 10.0;
     const int minHue = 0;
     const int maxHue = 359;
     const int minSaturation = 150;
     const int maxSaturation = 255;
     const int minValue = 180;
     const int maxValue = 240;
+    const int refinementBudget = 30;
+    const double tilesPerViewport = 4.0;
+    const double maxPointsPerViewport = 40000.0;
+    const int viewportDebounce = 150;
+    const int clickTolerance = 3;
+    const std::size_t resultCacheCapacity = 64ULL * 1024ULL * 1024ULL;
+    const double streamlineSeedsPerViewport = 8.0;
+    const double streamlineStepsPerViewport = 200.0;
+    const double streamlineTolerance = 1e-3;
+    const int streamlineMaxSteps = 2000;
+    const int streamlinePollInterval = 16;
+    const int orbitIterations = 64;
+    const double orbitEscapeRadius = 1e3;
+    const double orbitTolerance = 1e-9;
+    const double rootCellsPerViewport = 16.0;
+    const std::string timeParameter = u8"t";
+    const int animationFrameInterval = 16;
+    const double animationTimeStep = 1.0 / 60.0;
+    const double animationPointsPerViewport = 24.0;
+    const std::size_t animationMaxDepth = 16;
+    const double profilePointsPerViewport = 64.0;
 
     QPalette parseablePalette;
     QPalette nonParseablePalette;
 
     bool plotting;
+    bool appendPending;
     Ui::MainWindow * ui;
+    QCPLayer * arrowLayer;
     Backend::Parser parser;
     std::unique_ptr<Ui::GridDialog> gridDialog;
     std::unique_ptr<QMessageBox> aboutMessageBox;
     std::shared_ptr<Backend::Expression> expression;
+    std::vector<std::shared_ptr<Backend::Expression>> overlayExpressions;
+    std::unique_ptr<Backend::TileScheduler> tileScheduler;
+    QTimer refinementTimer;
+    std::optional<Backend::GridSpecification> gridSpecification;
+    std::unique_ptr<Backend::ViewportEvaluator> viewportEvaluator;
+    ArrowField * gridField;
+    std::vector<ArrowField *> overlayFields;
+    QList<QCPAbstractItem *> rootMarkers;
+    QList<QCPAbstractPlottable *> streamlineCurves;
+    QTimer streamlineTimer;
+    std::future<std::vector<std::vector<Backend::complex>>> streamlineFuture;
+    QTimer orbitGridTimer;
+    std::future<std::vector<Backend::Sample>> orbitGridFuture;
+    QTimer fusedGridTimer;
+    std::future<std::vector<std::vector<Backend::Sample>>> fusedGridFuture;
+    QTimer rootTimer;
+    std::future<std::vector<Backend::Root>> rootFuture;
+    QTimer viewportTimer;
+    QPoint pressPosition;
+    Backend::ResultCache resultCache;
+    std::vector<Backend::Sample> pendingSamples;
+    Backend::GridSpecification pendingSpecification;
+    double pendingMinX;
+    double pendingMaxX;
+    double pendingMinY;
+    double pendingMaxY;
+    QTimer animationTimer;
+    std::unique_ptr<Backend::FramePipeline> framePipeline;
+    std::vector<QColor> animationColors;
+    double animationTime;
+    std::optional<Backend::TraceSpan> replotSpan;
 
 public:
     explicit MainWindow(QWidget *parent = nullptr);
@@ -68,22 +142,67 @@ public:
     ~MainWindow() override;
 
 private slots:
+    void OnPlotPress(QMouseEvent * event);
     void OnPlotClick(QMouseEvent * event);
+    void OnRangeChanged();
+    void OnViewportTimeout();
     void OnFuncLineEditTextChanged();
     void OnReturnKeyPressed();
     void OnSetPressed();
     void OnClearPressed();
     void OnGridPressed();
+    void OnFlowPressed();
+    void OnOrbitToggled();
+    void OnRootPressed();
+    void OnAnimateToggled();
+    void OnProfileToggled();
+    void OnTraceToggled();
+    void OnBeforeReplot();
+    void OnAfterReplot();
     void OnAboutPressed();
+    void OnRefinementTimeout();
+    void OnAppendTimeout();
+    void OnAnimationTimeout();
+    void OnStreamlineTimeout();
+    void OnOrbitGridTimeout();
+    void OnRootTimeout();
+    void OnFusedGridTimeout();
 
 private:
     void UpdateUiState();
     void UpdateParseability();
     void UpdateExpression();
     void ClearPlot();
+    void ScheduleAppend();
     [[nodiscard]] QColor GenerateColor() const;
+    [[nodiscard]] static std::vector<std::string> SplitFormulas(const std::string & input);
+    [[nodiscard]] static Qt::PenStyle GetPenStyle(std::size_t formulaIndex);
     void PlotFrom(double inputX, double inputY);
+    void PlotOrbitFrom(double inputX, double inputY);
+    QCPAbstractItem * PlotArrow(Backend::complex input, Backend::complex output, Qt::PenStyle penStyle = Qt::SolidLine);
     void HandleGrid();
+    void PlotGrid();
+    void PlotSamples(const std::vector<Backend::Sample> & samples);
+    void PlotFusedGrid(double minX, double maxX, double minY, double maxY);
+    void PlotFusedSamples(const std::vector<Backend::ResultCache::Samples> & results);
+    void StopFusedGrid();
+    void PlotOrbitGrid(double minX, double maxX, double minY, double maxY);
+    void StopOrbitGrid();
+    void RemoveGridArrows();
+    void RefineGrid();
+    void PlotStreamlines();
+    void ShowStreamlines(const std::vector<std::vector<Backend::complex>> & lines);
+    void RemoveStreamlines();
+    void StopStreamlines();
+    void PlotRoots();
+    void ShowRoots(const std::vector<Backend::Root> & roots);
+    void StopRoots();
+    void StopRefinement();
+    void StartAnimation();
+    void StopAnimation();
+    void PlotFrame(const Backend::Frame & frame);
+    void ShowProfile();
+    bool SaveTrace(const QString & fileName);
     void ShowAboutDialog();
 };
 
@@ -22,6 +22,7 @@
 #include "qcustomplot.h"
 
 #include <QtCore/QVariant>
+#include <QtGui/QFontDatabase>
 #include <QtWidgets/QApplication>
 #include <QtWidgets/QGridLayout>
 #include <QtWidgets/QGroupBox>
@@ -29,6 +30,7 @@
 #include <QtWidgets/QLabel>
 #include <QtWidgets/QLineEdit>
 #include <QtWidgets/QMainWindow>
+#include <QtWidgets/QPlainTextEdit>
 #include <QtWidgets/QPushButton>
 #include <QtWidgets/QSpacerItem>
 #include <QtWidgets/QSpinBox>
@@ -63,9 +65,16 @@ private:
     QPushButton *funcSetButton{};
     QPushButton *funcClearButton{};
     QPushButton *gridButton{};
+    QPushButton *flowButton{};
+    QPushButton *orbitButton{};
+    QPushButton *rootButton{};
+    QPushButton *animateButton{};
+    QPushButton *profileButton{};
+    QPushButton *traceButton{};
     QPushButton *aboutButton{};
 
     QCustomPlot * plot{};
+    QPlainTextEdit * profilePanel{};
 
 public:
     void setupUi(QMainWindow *MainWindow)
@@ -114,6 +123,34 @@ public:
         gridButton->setObjectName(QString::fromUtf8(u8"gridButton"));
         functionLayout->addWidget(gridButton);
 
+        flowButton = new QPushButton(functionFrame); //NOLINT(cppcoreguidelines-owning-memory)
+        flowButton->setObjectName(QString::fromUtf8(u8"flowButton"));
+        functionLayout->addWidget(flowButton);
+
+        orbitButton = new QPushButton(functionFrame); //NOLINT(cppcoreguidelines-owning-memory)
+        orbitButton->setObjectName(QString::fromUtf8(u8"orbitButton"));
+        orbitButton->setCheckable(true);
+        functionLayout->addWidget(orbitButton);
+
+        rootButton = new QPushButton(functionFrame); //NOLINT(cppcoreguidelines-owning-memory)
+        rootButton->setObjectName(QString::fromUtf8(u8"rootButton"));
+        functionLayout->addWidget(rootButton);
+
+        animateButton = new QPushButton(functionFrame); //NOLINT(cppcoreguidelines-owning-memory)
+        animateButton->setObjectName(QString::fromUtf8(u8"animateButton"));
+        animateButton->setCheckable(true);
+        functionLayout->addWidget(animateButton);
+
+        profileButton = new QPushButton(functionFrame); //NOLINT(cppcoreguidelines-owning-memory)
+        profileButton->setObjectName(QString::fromUtf8(u8"profileButton"));
+        profileButton->setCheckable(true);
+        functionLayout->addWidget(profileButton);
+
+        traceButton = new QPushButton(functionFrame); //NOLINT(cppcoreguidelines-owning-memory)
+        traceButton->setObjectName(QString::fromUtf8(u8"traceButton"));
+        traceButton->setCheckable(true);
+        functionLayout->addWidget(traceButton);
+
         aboutButton = new QPushButton(functionFrame); //NOLINT(cppcoreguidelines-owning-memory)
         aboutButton->setObjectName(QString::fromUtf8(u8"aboutButton"));
         functionLayout->addWidget(aboutButton);
@@ -125,6 +162,16 @@ public:
 
         mainLayout->addWidget(plot);
 
+        profilePanel = new QPlainTextEdit(centralwidget); //NOLINT(cppcoreguidelines-owning-memory)
+        profilePanel->setObjectName(QString::fromUtf8(u8"profilePanel"));
+        profilePanel->setReadOnly(true);
+        profilePanel->setLineWrapMode(QPlainTextEdit::NoWrap);
+        profilePanel->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+        profilePanel->setMaximumHeight(160);
+        profilePanel->setVisible(false);
+
+        mainLayout->addWidget(profilePanel);
+
         MainWindow->setCentralWidget(centralwidget);
 
         retranslateUi(MainWindow);
@@ -137,6 +184,12 @@ public:
         funcSetButton->setText(QCoreApplication::translate("MainWindow", "Set", nullptr));
         funcClearButton->setText(QCoreApplication::translate("MainWindow", "Clear", nullptr));
         gridButton->setText(QCoreApplication::translate("MainWindow", "Grid ... ", nullptr));
+        flowButton->setText(QCoreApplication::translate("MainWindow", "Streamlines", nullptr));
+        orbitButton->setText(QCoreApplication::translate("MainWindow", "Orbits", nullptr));
+        rootButton->setText(QCoreApplication::translate("MainWindow", "Zeros/Poles", nullptr));
+        animateButton->setText(QCoreApplication::translate("MainWindow", "Animate", nullptr));
+        profileButton->setText(QCoreApplication::translate("MainWindow", "Profile", nullptr));
+        traceButton->setText(QCoreApplication::translate("MainWindow", "Trace", nullptr));
         aboutButton->setText(QCoreApplication::translate("MainWindow", "About ... ", nullptr));
     } // retranslateUi
 
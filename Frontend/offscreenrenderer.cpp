@@ -0,0 +1,161 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "offscreenrenderer.h"
+#include "arrowfield.h"
+#include "qcustomplot.h"
+
+#include "../Backend/parser.h"
+
+#include <QtConcurrent>
+#include <cmath>
+#include <vector>
+
+OffscreenRenderer::OffscreenRenderer(QSize size, double minX, double maxX, double minY, double maxY, bool coloring)
+    : size(size),
+      minX(minX),
+      maxX(maxX),
+      minY(minY),
+      maxY(maxY),
+      coloring(coloring)
+{
+}
+
+QImage OffscreenRenderer::Render(const std::shared_ptr<Backend::Expression> & expression, const Backend::GridSpecification & specification, Backend::Precision precision) const
+{
+    QImage image(this->size, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::white);
+
+    if (this->coloring)
+    {
+        this->PaintColoring(image, expression, precision);
+    }
+
+    Backend::GridGenerator gridGenerator(this->minX, this->maxX, this->minY, this->maxY);
+    auto grid = gridGenerator.Create(specification, expression);
+
+    QCPPainter painter(&image);
+    painter.setRenderHint(QPainter::Antialiasing);
+
+    for (const auto & input : grid)
+    {
+        auto output = expression->Evaluate(input);
+
+        if (!output.has_value())
+        {
+            continue;
+        }
+
+        // without background coloring, the arrows are colored by the argument of the output
+        auto hue = (std::arg(output.value()) + M_PI) / (2.0 * M_PI);
+        auto color = this->coloring ? QColor(Qt::black) : QColor::fromHsvF(std::fmin(hue, 1.0), 0.8, 0.75);
+
+        ArrowField::DrawArrow(&painter, this->ToPixel(input), this->ToPixel(output.value()), color);
+    }
+
+    painter.end();
+
+    return image;
+}
+
+bool OffscreenRenderer::RenderToFile(const Job & job) const
+{
+    // the parser is cheap to create and not shared between threads, it converts numbers independent of the locale
+    Backend::Parser parser(true);
+
+    if (!parser.IsParseable(job.formula))
+    {
+        return false;
+    }
+
+    auto expression = parser.Parse(job.formula);
+
+    return this->Render(expression, job.specification, job.precision).save(job.fileName);
+}
+
+int OffscreenRenderer::RenderToFiles(const QList<Job> & jobs) const
+{
+    auto results = QtConcurrent::blockingMapped<QList<bool>>(jobs, [this](const Job & job){ return this->RenderToFile(job); });
+
+    return static_cast<int>(std::count(results.begin(), results.end(), true));
+}
+
+void OffscreenRenderer::PaintColoring(QImage & image, const std::shared_ptr<Backend::Expression> & expression, Backend::Precision precision) const
+{
+    Backend::CompiledExpression compiled(expression);
+
+    if (precision == Backend::Precision::Single)
+    {
+        this->PaintColoringIn<float>(image, compiled);
+    }
+    else
+    {
+        this->PaintColoringIn<double>(image, compiled);
+    }
+}
+
+template<typename T>
+void OffscreenRenderer::PaintColoringIn(QImage & image, const Backend::CompiledExpression & compiled) const
+{
+    const QColor undefinedColor(Qt::lightGray);
+    const auto width = static_cast<std::size_t>(image.width());
+
+    // a scan line at a time, held in the precision of evaluation
+    std::vector<std::complex<T>> inputs(width);
+    std::vector<std::optional<std::complex<T>>> outputs(width);
+
+    for (int y = 0; y < image.height(); ++y)
+    {
+        auto * line = reinterpret_cast<QRgb *>(image.scanLine(y)); //NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        auto imag = this->maxY - (this->maxY - this->minY) * (y + 0.5) / image.height();
+
+        for (std::size_t x = 0; x < width; ++x)
+        {
+            auto real = this->minX + (this->maxX - this->minX) * (static_cast<double>(x) + 0.5) / image.width();
+            inputs[x] = std::complex<T>(static_cast<T>(real), static_cast<T>(imag));
+        }
+
+        compiled.EvaluateLine(inputs.data(), outputs.data(), width);
+
+        for (std::size_t x = 0; x < width; ++x)
+        {
+            const auto & output = outputs[x];
+
+            if (!output.has_value())
+            {
+                line[x] = undefinedColor.rgb(); //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                continue;
+            }
+
+            // hue by argument, lightness rising with magnitude, pale such that arrows remain visible
+            auto hue = (static_cast<double>(std::arg(output.value())) + M_PI) / (2.0 * M_PI);
+            auto magnitude = static_cast<double>(std::abs(output.value()));
+            auto lightness = 0.55 + 0.35 * magnitude / (1.0 + magnitude);
+
+            line[x] = QColor::fromHslF(std::fmin(hue, 1.0), 0.6, lightness).rgb(); //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        }
+    }
+}
+
+QPointF OffscreenRenderer::ToPixel(Backend::complex value) const
+{
+    auto x = (value.real() - this->minX) / (this->maxX - this->minX) * this->size.width();
+    auto y = (this->maxY - value.imag()) / (this->maxY - this->minY) * this->size.height();
+
+    return QPointF(x, y);
+}
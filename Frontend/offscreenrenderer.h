@@ -0,0 +1,113 @@
+/*
+ * This file is part of QtImagiComplexation.
+ *
+ * QtImagiComplexation is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * QtImagiComplexation is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with QtImagiComplexation.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef OFFSCREENRENDERER_H
+#define OFFSCREENRENDERER_H
+
+#include <QImage>
+#include <QList>
+#include <QSize>
+#include <QString>
+
+#include <memory>
+#include <string>
+
+#include "../Backend/compiledexpression.h"
+#include "../Backend/expression.h"
+#include "../Backend/gridgenerator.h"
+
+/*!
+ * \class OffscreenRenderer
+ * \brief The OffscreenRenderer class renders the vector field of an expression into an image
+ *        without creating any widgets.
+ *
+ * An instance only holds its settings and may be used from several threads at once.
+ * With the offscreen QPA platform, no display is needed.
+ */
+class OffscreenRenderer final
+{
+public:
+    /*!
+     * \brief The Job struct describes a single image to render to a file.
+     */
+    struct Job
+    {
+    public:
+        std::string formula;
+        Backend::GridSpecification specification;
+        QString fileName;
+        Backend::Precision precision = Backend::Precision::Double;
+    };
+
+private:
+    const QSize size;
+    const double minX;
+    const double maxX;
+    const double minY;
+    const double maxY;
+    const bool coloring;
+
+public:
+    /*!
+     * \brief Initializes a new instance.
+     * \param size The size of the images in pixels.
+     * \param minX The minimum value in real/x-direction.
+     * \param maxX The maximum value in real/x-direction.
+     * \param minY The minimum value in imaginary/y-direction.
+     * \param maxY The maximum value in imaginary/y-direction.
+     * \param coloring Whether to color the background by the argument and magnitude of the expression.
+     */
+    OffscreenRenderer(QSize size, double minX, double maxX, double minY, double maxY, bool coloring);
+    ~OffscreenRenderer() = default;
+    OffscreenRenderer(const OffscreenRenderer&) = delete;
+    OffscreenRenderer(OffscreenRenderer&&) = delete;
+    OffscreenRenderer& operator=(const OffscreenRenderer&) = delete;
+    OffscreenRenderer& operator=(OffscreenRenderer&&) = delete;
+
+    /*!
+     * \brief Render renders the arrows of the grid for the supplied expression.
+     * \param expression The expression to render.
+     * \param specification The specification of the grid.
+     * \param precision The precision the coloring is evaluated and held in, the arrows always use double precision.
+     * \return The image.
+     */
+    [[nodiscard]] QImage Render(const std::shared_ptr<Backend::Expression> & expression, const Backend::GridSpecification & specification, Backend::Precision precision = Backend::Precision::Double) const;
+
+    /*!
+     * \brief RenderToFile parses the formula of the job, renders it and saves the image.
+     *        The format is determined by the file name suffix.
+     * \param job The job to execute.
+     * \return A value indicating success.
+     */
+    [[nodiscard]] bool RenderToFile(const Job & job) const;
+
+    /*!
+     * \brief RenderToFiles executes the jobs in parallel.
+     * \param jobs The jobs to execute.
+     * \return The number of successfully executed jobs.
+     */
+    [[nodiscard]] int RenderToFiles(const QList<Job> & jobs) const;
+
+private:
+    void PaintColoring(QImage & image, const std::shared_ptr<Backend::Expression> & expression, Backend::Precision precision) const;
+    template<typename T>
+    void PaintColoringIn(QImage & image, const Backend::CompiledExpression & compiled) const;
+    [[nodiscard]] QPointF ToPixel(Backend::complex value) const;
+};
+
+#endif // OFFSCREENRENDERER_H
@@ -1070,7 +1070,8 @@ QCPLayer::QCPLayer(QCustomPlot *parentPlot, const QString &layerName) :
   mName(layerName),
   mIndex(-1), // will be set to a proper value by the QCustomPlot layer creation function
   mVisible(true),
-  mMode(lmLogical)
+  mMode(lmLogical),
+  mDrawnChildCount(-1)
 {
   // Note: no need to make sure layerName is unique, because layer
   // management is done with QCustomPlot functions.
@@ -1129,6 +1130,7 @@ void QCPLayer::setMode(QCPLayer::LayerMode mode)
   if (mMode != mode)
   {
     mMode = mode;
+    mDrawnChildCount = -1;
     if (QSharedPointer<QCPAbstractPaintBuffer> pb = mPaintBuffer.toStrongRef())
       pb->setInvalidated();
   }
@@ -1143,15 +1145,24 @@ void QCPLayer::setMode(QCPLayer::LayerMode mode)
 void QCPLayer::draw(QCPPainter *painter)
 {
   foreach (QCPLayerable *child, mChildren)
+    drawChild(painter, child);
+}
+
+/*! \internal
+
+  Draws the single layerable \a child with the provided \a painter, if it is visible.
+
+  \see draw
+*/
+void QCPLayer::drawChild(QCPPainter *painter, QCPLayerable *child)
+{
+  if (child->realVisibility())
   {
-    if (child->realVisibility())
-    {
-      painter->save();
-      painter->setClipRect(child->clipRect().translated(0, -1));
-      child->applyDefaultAntialiasingHint(painter);
-      child->draw(painter);
-      painter->restore();
-    }
+    painter->save();
+    painter->setClipRect(child->clipRect().translated(0, -1));
+    child->applyDefaultAntialiasingHint(painter);
+    child->draw(painter);
+    painter->restore();
   }
 }
 
@@ -1170,8 +1181,10 @@ void QCPLayer::drawToPaintBuffer()
     if (QCPPainter *painter = pb->startPainting())
     {
       if (painter->isActive())
+      {
         draw(painter);
-      else
+        mDrawnChildCount = mChildren.size();
+      } else
         qDebug() << Q_FUNC_INFO << "paint buffer returned inactive painter";
       delete painter;
       pb->donePainting();
@@ -1211,6 +1224,49 @@ void QCPLayer::replot()
     mParentPlot->replot();
 }
 
+/*!
+  If the layer mode (\ref setMode) is set to \ref lmBuffered, this method draws only the layerables
+  that were appended to this layer since its paint buffer was last drawn, on top of the existing
+  buffer content. The cost thus depends on the number of new layerables only.
+
+  This is valid only as long as nothing else that is drawn by this layer has changed, e.g. the axis
+  ranges or properties of the existing layerables. If layerables were removed or prepended in the
+  meantime, or other paint buffers were invalidated, this falls back to \ref replot.
+
+  \see replot
+*/
+void QCPLayer::replotAppended()
+{
+  QSharedPointer<QCPAbstractPaintBuffer> pb = mPaintBuffer.toStrongRef();
+  bool othersValid = true;
+  foreach (QSharedPointer<QCPAbstractPaintBuffer> buffer, mParentPlot->mPaintBuffers)
+  {
+    if (buffer != pb && buffer->invalidated())
+      othersValid = false;
+  }
+  
+  if (mMode != lmBuffered || !pb || !othersValid || mDrawnChildCount < 0)
+  {
+    replot();
+    return;
+  }
+  
+  if (QCPPainter *painter = pb->startPainting())
+  {
+    if (painter->isActive())
+    {
+      for (int i=mDrawnChildCount; i<mChildren.size(); ++i)
+        drawChild(painter, mChildren.at(i));
+      mDrawnChildCount = mChildren.size();
+    } else
+      qDebug() << Q_FUNC_INFO << "paint buffer returned inactive painter";
+    delete painter;
+    pb->donePainting();
+  }
+  pb->setInvalidated(false);
+  mParentPlot->update();
+}
+
 /*! \internal
   
   Adds the \a layerable to the list of this layer. If \a prepend is set to true, the layerable will
@@ -1223,12 +1279,15 @@ void QCPLayer::replot()
 */
 void QCPLayer::addChild(QCPLayerable *layerable, bool prepend)
 {
-  if (!mChildren.contains(layerable))
+  if (!mChildSet.contains(layerable))
   {
     if (prepend)
+    {
       mChildren.prepend(layerable);
-    else
+      mDrawnChildCount = -1;
+    } else
       mChildren.append(layerable);
+    mChildSet.insert(layerable);
     if (QSharedPointer<QCPAbstractPaintBuffer> pb = mPaintBuffer.toStrongRef())
       pb->setInvalidated();
   } else
@@ -1246,8 +1305,11 @@ void QCPLayer::addChild(QCPLayerable *layerable, bool prepend)
 */
 void QCPLayer::removeChild(QCPLayerable *layerable)
 {
-  if (mChildren.removeOne(layerable))
+  if (mChildSet.remove(layerable))
   {
+    // recently added layerables are removed most often, so search from the back
+    mChildren.removeAt(mChildren.lastIndexOf(layerable));
+    mDrawnChildCount = -1;
     if (QSharedPointer<QCPAbstractPaintBuffer> pb = mPaintBuffer.toStrongRef())
       pb->setInvalidated();
   } else
@@ -14557,10 +14619,11 @@ QCPAbstractItem *QCustomPlot::item() const
 */
 bool QCustomPlot::removeItem(QCPAbstractItem *item)
 {
-  if (mItems.contains(item))
+  if (mItemSet.contains(item))
   {
     delete item;
-    mItems.removeOne(item);
+    mItemSet.remove(item);
+    mItems.removeAt(mItems.lastIndexOf(item));
     return true;
   } else
   {
@@ -14584,19 +14647,61 @@ bool QCustomPlot::removeItem(int index)
   }
 }
 
+/*!
+  Removes the specified \a items from the plot and deletes them. Items that are not in the plot
+  are ignored.
+  
+  In contrast to calling \ref removeItem for each item, this takes time linear in the number of
+  items in the plot, and each affected layer is updated only once.
+  
+  Returns the number of items removed.
+  
+  \see removeItem, clearItems
+*/
+int QCustomPlot::removeItems(const QList<QCPAbstractItem*> &items)
+{
+  QSet<QCPAbstractItem*> toRemove;
+  toRemove.reserve(items.size());
+  foreach (QCPAbstractItem *item, items)
+  {
+    if (mItemSet.contains(item))
+      toRemove.insert(item);
+  }
+  if (toRemove.isEmpty())
+    return 0;
+  
+  QList<QCPAbstractItem*> removed;
+  removed.reserve(toRemove.size());
+  QList<QCPAbstractItem*> remaining;
+  remaining.reserve(mItems.size() - toRemove.size());
+  foreach (QCPAbstractItem *item, mItems)
+  {
+    if (toRemove.contains(item))
+      removed.append(item);
+    else
+      remaining.append(item);
+  }
+  mItems.swap(remaining);
+  
+  deleteItems(removed);
+  return removed.size();
+}
+
 /*!
   Removes all items from the plot and deletes them.
   
+  This takes time linear in the number of items, see \ref removeItems.
+  
   Returns the number of items removed.
   
-  \see removeItem
+  \see removeItem, removeItems
 */
 int QCustomPlot::clearItems()
 {
-  int c = mItems.size();
-  for (int i=c-1; i >= 0; --i)
-    removeItem(mItems[i]);
-  return c;
+  QList<QCPAbstractItem*> removed;
+  removed.swap(mItems);
+  deleteItems(removed);
+  return removed.size();
 }
 
 /*!
@@ -14646,7 +14751,7 @@ QCPAbstractItem *QCustomPlot::itemAt(const QPointF &pos, bool onlySelectable) co
 */
 bool QCustomPlot::hasItem(QCPAbstractItem *item) const
 {
-  return mItems.contains(item);
+  return mItemSet.contains(item);
 }
 
 /*!
@@ -16251,7 +16356,7 @@ bool QCustomPlot::registerGraph(QCPGraph *graph)
 */
 bool QCustomPlot::registerItem(QCPAbstractItem *item)
 {
-  if (mItems.contains(item))
+  if (mItemSet.contains(item))
   {
     qDebug() << Q_FUNC_INFO << "item already added to this QCustomPlot:" << reinterpret_cast<quintptr>(item);
     return false;
@@ -16263,11 +16368,51 @@ bool QCustomPlot::registerItem(QCPAbstractItem *item)
   }
   
   mItems.append(item);
+  mItemSet.insert(item);
   if (!item->layer()) // usually the layer is already set in the constructor of the item (via QCPLayerable constructor)
     item->setLayer(currentLayer());
   return true;
 }
 
+/*! \internal
+
+  Deletes the specified \a items, which must already be taken out of \ref mItems.
+  
+  Instead of letting each item remove itself from its layer, every affected layer is filtered once,
+  so the total time is linear in the number of items.
+*/
+void QCustomPlot::deleteItems(const QList<QCPAbstractItem*> &items)
+{
+  QSet<QCPLayer*> layers;
+  foreach (QCPAbstractItem *item, items)
+  {
+    mItemSet.remove(item);
+    if (item->mLayer)
+    {
+      layers.insert(item->mLayer);
+      item->mLayer->mChildSet.remove(item);
+      item->mLayer = nullptr; // prevents the QCPLayerable destructor from calling QCPLayer::removeChild
+    }
+  }
+  
+  foreach (QCPLayer *layer, layers)
+  {
+    QList<QCPLayerable*> remaining;
+    remaining.reserve(layer->mChildSet.size());
+    foreach (QCPLayerable *child, layer->mChildren)
+    {
+      if (layer->mChildSet.contains(child))
+        remaining.append(child);
+    }
+    layer->mChildren.swap(remaining);
+    layer->mDrawnChildCount = -1;
+    if (QSharedPointer<QCPAbstractPaintBuffer> pb = layer->mPaintBuffer.toStrongRef())
+      pb->setInvalidated();
+  }
+  
+  qDeleteAll(items);
+}
+
 /*! \internal
   
   Assigns all layers their index (QCPLayer::mIndex) in the mLayers list. This method is thus called
@@ -686,6 +686,7 @@ public:
   
   // non-virtual methods:
   void replot();
+  void replotAppended();
   
 protected:
   // property members:
@@ -693,14 +694,17 @@ protected:
   QString mName;
   int mIndex;
   QList<QCPLayerable*> mChildren;
+  QSet<QCPLayerable*> mChildSet; // mirrors mChildren for constant time membership tests
   bool mVisible;
   LayerMode mMode;
   
   // non-property members:
   QWeakPointer<QCPAbstractPaintBuffer> mPaintBuffer;
+  int mDrawnChildCount; // number of leading children whose drawing is in the paint buffer, -1 if unknown
   
   // non-virtual methods:
   void draw(QCPPainter *painter);
+  void drawChild(QCPPainter *painter, QCPLayerable *child);
   void drawToPaintBuffer();
   void addChild(QCPLayerable *layerable, bool prepend);
   void removeChild(QCPLayerable *layerable);
@@ -3863,6 +3867,7 @@ public:
   QCPAbstractItem *item() const;
   bool removeItem(QCPAbstractItem *item);
   bool removeItem(int index);
+  int removeItems(const QList<QCPAbstractItem*> &items);
   int clearItems();
   int itemCount() const;
   QList<QCPAbstractItem*> selectedItems() const;
@@ -3937,6 +3942,7 @@ protected:
   QList<QCPAbstractPlottable*> mPlottables;
   QList<QCPGraph*> mGraphs; // extra list of plottables also in mPlottables that are of type QCPGraph
   QList<QCPAbstractItem*> mItems;
+  QSet<QCPAbstractItem*> mItemSet; // mirrors mItems for constant time membership tests
   QList<QCPLayer*> mLayers;
   QCP::AntialiasedElements mAntialiasedElements, mNotAntialiasedElements;
   QCP::Interactions mInteractions;
@@ -3998,6 +4004,7 @@ protected:
   bool registerPlottable(QCPAbstractPlottable *plottable);
   bool registerGraph(QCPGraph *graph);
   bool registerItem(QCPAbstractItem* item);
+  void deleteItems(const QList<QCPAbstractItem*> &items);
   void updateLayerIndices() const;
   QCPLayerable *layerableAt(const QPointF &pos, bool onlySelectable, QVariant *selectionDetails=nullptr) const;
   QList<QCPLayerable*> layerableListAt(const QPointF &pos, bool onlySelectable, QList<QVariant> *selectionDetails=nullptr) const;
@@ -25,6 +25,7 @@
 #include <QTest>
 #include <QtTest>
 
+#include "../Backend/basez.h"
 #include "../Frontend/griddialog.h"
 
 class FrontendTest : public QObject
@@ -42,6 +43,7 @@ private slots:
     static void AddingSquareGridShallYieldCorrectData();
     static void AddingRCAGridShallYieldCorrectData();
     static void AddingRADGridShallYieldCorrectData();
+    static void AddingAdaptiveGridShallYieldCorrectData();
 #endif // _USE_LONG_TEST
 };
 
@@ -53,7 +55,7 @@ void FrontendTest::ConstructionShallWorkCompletely() //NOLINT(google-readability
     try
     {
         // Act
-        Ui::GridDialog gd(nullptr, 10.0, 10.0);
+        Ui::GridDialog gd(nullptr, -10.0, 10.0, -10.0, 10.0);
 
         // Assert
         QVERIFY2(gd.verticalDialogLayout, qPrintable(QString::fromUtf8(u8"not created dialog layout")));
@@ -78,6 +80,14 @@ void FrontendTest::ConstructionShallWorkCompletely() //NOLINT(google-readability
         QVERIFY2(gd.radGridDistSpinBox, qPrintable(QString::fromUtf8(u8"not created RAD grid dist spin box")));
         QVERIFY2(gd.radGridAcceptButton, qPrintable(QString::fromUtf8(u8"not created RAD grid accept button")));
 
+        QVERIFY2(gd.adaGridGroupBox, qPrintable(QString::fromUtf8(u8"not created ADA grid group box")));
+        QVERIFY2(gd.adaGridLayout, qPrintable(QString::fromUtf8(u8"not created ADA grid layout")));
+        QVERIFY2(gd.adaGridDistLabel, qPrintable(QString::fromUtf8(u8"not created ADA grid dist label")));
+        QVERIFY2(gd.adaGridDistSpinBox, qPrintable(QString::fromUtf8(u8"not created ADA grid dist spin box")));
+        QVERIFY2(gd.adaGridVariationLabel, qPrintable(QString::fromUtf8(u8"not created ADA grid variation label")));
+        QVERIFY2(gd.adaGridVariationSpinBox, qPrintable(QString::fromUtf8(u8"not created ADA grid variation spin box")));
+        QVERIFY2(gd.adaGridAcceptButton, qPrintable(QString::fromUtf8(u8"not created ADA grid accept button")));
+
         QVERIFY2(gd.cancelButton, qPrintable(QString::fromUtf8(u8"not created cancel button")));
     }
     catch (std::exception & ex)
@@ -95,7 +105,7 @@ void FrontendTest::ConstructionShallWorkCompletely() //NOLINT(google-readability
 void FrontendTest::CancelShallReject()
 {
     // Arrange
-    Ui::GridDialog gd(nullptr, 10.0, 10.0);
+    Ui::GridDialog gd(nullptr, -10.0, 10.0, -10.0, 10.0);
 
     // Act
     QTest::mouseClick(gd.cancelButton, Qt::LeftButton);
@@ -109,7 +119,7 @@ void FrontendTest::CancelShallReject()
 void FrontendTest::ValuesOutOfRangeAreNotAllowed()
 {
     // Arrange
-    Ui::GridDialog gd(nullptr, 10.0, 10.0);
+    Ui::GridDialog gd(nullptr, -10.0, 10.0, -10.0, 10.0);
 
     // Act
     gd.squareGridDistSpinBox->setValue(0.1);
@@ -147,7 +157,7 @@ void FrontendTest::ValuesOutOfRangeAreNotAllowed()
 void FrontendTest::AddingSquareGridShallYieldCorrectData()
 {
     // Arrange
-    Ui::GridDialog gd(nullptr, 10.0, 10.0);
+    Ui::GridDialog gd(nullptr, -10.0, 10.0, -10.0, 10.0);
 
     // Act
     gd.squareGridDistSpinBox->setValue(1.0);
@@ -162,7 +172,7 @@ void FrontendTest::AddingSquareGridShallYieldCorrectData()
 void FrontendTest::AddingRCAGridShallYieldCorrectData()
 {
     // Arrange
-    Ui::GridDialog gd(nullptr, 10.0, 10.0);
+    Ui::GridDialog gd(nullptr, -10.0, 10.0, -10.0, 10.0);
 
     // Act
     gd.rcaGridRadialSpinBox->setValue(1.0);
@@ -178,7 +188,7 @@ void FrontendTest::AddingRCAGridShallYieldCorrectData()
 void FrontendTest::AddingRADGridShallYieldCorrectData()
 {
     // Arrange
-    Ui::GridDialog gd(nullptr, 10.0, 10.0);
+    Ui::GridDialog gd(nullptr, -10.0, 10.0, -10.0, 10.0);
 
     // Act
     gd.radGridDistSpinBox->setValue(1.5);
@@ -190,6 +200,23 @@ void FrontendTest::AddingRADGridShallYieldCorrectData()
     QVERIFY2(result.size() == 171, qPrintable(QString::fromUtf8(u8"incorrect grid found")));
 }
 
+void FrontendTest::AddingAdaptiveGridShallYieldCorrectData()
+{
+    // Arrange
+    Ui::GridDialog gd(nullptr, -10.0, 10.0, -10.0, 10.0);
+    gd.SetExpression(std::make_shared<Backend::BaseZ>());
+
+    // Act
+    gd.adaGridDistSpinBox->setValue(1.0);
+    gd.adaGridVariationSpinBox->setValue(5.0);
+    QTest::mouseClick(gd.adaGridAcceptButton, Qt::LeftButton);
+
+    auto result = gd.GetResult();
+
+    // Assert
+    QVERIFY2(result.size() == 441, qPrintable(QString::fromUtf8(u8"incorrect grid found")));
+}
+
 #endif // _USE_LONG_TEST
 
 QTEST_MAIN(FrontendTest)
@@ -25,34 +25,78 @@
 #include <QTest>
 #include <QtTest>
 
+#include <algorithm>
+
 #include "../Backend/basez.h"
 #include "../Backend/constant.h"
 #include "../Backend/product.h"
 
+#include "../Frontend/arrowfield.h"
 #include "../Frontend/mainwindow.h"
+#include "../Frontend/offscreenrenderer.h"
 #include "../Frontend/mainwindow_ui.h"
 
+/*!
+ * \brief The DrawCountingItem class counts how often the layer draws it.
+ */
+class DrawCountingItem : public QCPAbstractItem //NOLINT(cppcoreguidelines-special-member-functions)
+{
+public:
+    int drawCount = 0;
+
+    explicit DrawCountingItem(QCustomPlot * parentPlot) : QCPAbstractItem(parentPlot) {}
+
+    double selectTest(const QPointF &, bool, QVariant *) const override //NOLINT(misc-unused-parameter, hicpp-named-parameter, readability-named-parameter)
+    {
+        return -1.0;
+    }
+
+protected:
+    void draw(QCPPainter *) override //NOLINT(misc-unused-parameter, hicpp-named-parameter, readability-named-parameter)
+    {
+        ++this->drawCount;
+    }
+};
+
 class FrontendTest : public QObject
 {
     Q_OBJECT
 
 private:
     const int SingleShotInterval = 1000;
+    static const int BenchmarkItemCount = 100000;
 
 public:
     FrontendTest();
 
 private slots:
     static void ConstructionShallWorkCompletely() ;
+    static void OffscreenRenderingShallDrawWithoutWidgets();
+    static void OffscreenRenderingShallWriteFilesInParallel();
 #ifdef _USE_LONG_TEST
     void AboutButtonShallTriggerDialogAndOKShallClose();
     static void WindowShallBeStateful();
     static void ClickingPlotShallAddArrowWhenPossible();
     static void ClickingPlotShallNotAddArrowWhenImpossible();
+    static void ClickingPlotShallAddArrowToBufferedLayer();
+    static void AppendingShallOnlyDrawTheAppendedChildren();
     static void ClearButtonShallClearGraph();
     static void ParseabilityShallBeCorrectlyIndicated();
     static void ReturnKeyOnParseableInputShallActivatePlotting();
     void GridAdditionShallAddArrows();
+    static void ClearingManyArrowsShallBeFast();
+    static void RemovingManyGridArrowsShallBeFast();
+    static void DenseGridArrowsShallBeAggregatedUntilZoomedIn();
+    static void ArrowsEndingInsideShallBeVisible();
+    static void ZoomedOutSquareGridShallStayBoundedAndProgressive();
+    static void FlowButtonShallAddStreamlines();
+    static void OrbitModeShallAddArrowChains();
+    static void OrbitGridShallBeIteratedInTheBackground();
+    static void RootButtonShallMarkZerosAndPoles();
+    static void AnimateButtonShallPlayFrames();
+    static void OverlayFormulasShallBeDrawnWithDifferentStyles();
+    static void ProfileButtonShallShowReport();
+    static void TraceButtonShallRecordPipeline();
 #endif // _USE_LONG_TEST
 };
 
@@ -77,8 +121,15 @@ void FrontendTest::ConstructionShallWorkCompletely() //NOLINT(google-readability
         QVERIFY2(mw.ui->funcSetButton, qPrintable(QString::fromUtf8(u8"not created function set button")));
         QVERIFY2(mw.ui->funcClearButton, qPrintable(QString::fromUtf8(u8"not created function clear button")));
         QVERIFY2(mw.ui->gridButton, qPrintable(QString::fromUtf8(u8"not created grid button")));
+        QVERIFY2(mw.ui->flowButton, qPrintable(QString::fromUtf8(u8"not created flow button")));
+        QVERIFY2(mw.ui->orbitButton, qPrintable(QString::fromUtf8(u8"not created orbit button")));
+        QVERIFY2(mw.ui->rootButton, qPrintable(QString::fromUtf8(u8"not created root button")));
+        QVERIFY2(mw.ui->animateButton, qPrintable(QString::fromUtf8(u8"not created animate button")));
+        QVERIFY2(mw.ui->profileButton, qPrintable(QString::fromUtf8(u8"not created profile button")));
+        QVERIFY2(mw.ui->traceButton, qPrintable(QString::fromUtf8(u8"not created trace button")));
         QVERIFY2(mw.ui->aboutButton, qPrintable(QString::fromUtf8(u8"not created about button")));
         QVERIFY2(mw.ui->plot, qPrintable(QString::fromUtf8(u8"not created plot")));
+        QVERIFY2(mw.ui->profilePanel, qPrintable(QString::fromUtf8(u8"not created profile panel")));
 
     }
     catch (std::exception & ex)
@@ -91,6 +142,78 @@ void FrontendTest::ConstructionShallWorkCompletely() //NOLINT(google-readability
     }
 }
 
+void FrontendTest::OffscreenRenderingShallDrawWithoutWidgets()
+{
+    // Arrange
+    Backend::Parser parser(true);
+    auto expression = parser.Parse("z*i");
+    Backend::GridSpecification specification { Backend::GridSpecification::Type::Square, 2.0, 0.0, 0.0, 0 };
+    OffscreenRenderer plainRenderer(QSize(100, 100), -10.0, 10.0, -10.0, 10.0, false);
+    OffscreenRenderer coloringRenderer(QSize(100, 100), -10.0, 10.0, -10.0, 10.0, true);
+
+    // Act
+    auto plain = plainRenderer.Render(expression, specification);
+    auto colored = coloringRenderer.Render(expression, specification);
+    auto coloredSingle = coloringRenderer.Render(expression, specification, Backend::Precision::Single);
+
+    // Assert
+    QVERIFY2(QApplication::topLevelWidgets().isEmpty(), qPrintable(QString::fromUtf8(u8"widget created")));
+    QVERIFY2(plain.size() == QSize(100, 100), qPrintable(QString::fromUtf8(u8"incorrect image size")));
+    QVERIFY2(plain.pixel(0, 0) == QColor(Qt::white).rgb(), qPrintable(QString::fromUtf8(u8"background not white")));
+    QVERIFY2(colored.pixel(0, 0) != QColor(Qt::white).rgb(), qPrintable(QString::fromUtf8(u8"background not colored")));
+
+    bool hasArrowPixel = false;
+    for (int y = 0; y < plain.height() && !hasArrowPixel; ++y)
+    {
+        for (int x = 0; x < plain.width() && !hasArrowPixel; ++x)
+        {
+            hasArrowPixel = plain.pixel(x, y) != QColor(Qt::white).rgb();
+        }
+    }
+
+    QVERIFY2(hasArrowPixel, qPrintable(QString::fromUtf8(u8"no arrow drawn")));
+
+    // single precision may round a color channel differently, but no further
+    int maximumDifference = 0;
+    for (int y = 0; y < colored.height(); ++y)
+    {
+        for (int x = 0; x < colored.width(); ++x)
+        {
+            auto expected = colored.pixel(x, y);
+            auto actual = coloredSingle.pixel(x, y);
+            maximumDifference = std::max({ maximumDifference, std::abs(qRed(expected) - qRed(actual)), std::abs(qGreen(expected) - qGreen(actual)), std::abs(qBlue(expected) - qBlue(actual)) });
+        }
+    }
+
+    QVERIFY2(maximumDifference <= 1, qPrintable(QString::fromUtf8(u8"single precision coloring deviates")));
+}
+
+void FrontendTest::OffscreenRenderingShallWriteFilesInParallel()
+{
+    // Arrange
+    QTemporaryDir directory;
+    QVERIFY2(directory.isValid(), qPrintable(QString::fromUtf8(u8"no temporary directory")));
+
+    Backend::GridSpecification specification { Backend::GridSpecification::Type::Square, 1.0, 0.0, 0.0, 0 };
+    OffscreenRenderer renderer(QSize(64, 64), -5.0, 5.0, -5.0, 5.0, true);
+
+    const std::string formulas[] = { "z", "z*z", "sin(z)", "1/z", "exp(z)", "ln(z)", "sqrt(z)", "z^3-1", "+*" };
+
+    QList<OffscreenRenderer::Job> jobs;
+    for (const auto & formula : formulas)
+    {
+        jobs.append(OffscreenRenderer::Job{formula, specification, directory.filePath(QString::fromUtf8(u8"%1.png").arg(jobs.size()))});
+    }
+
+    // Act
+    int successCount = renderer.RenderToFiles(jobs);
+
+    // Assert
+    QVERIFY2(successCount == jobs.size() - 1, qPrintable(QString::fromUtf8(u8"unexpected number of rendered files")));
+    QVERIFY2(QFile::exists(directory.filePath(QString::fromUtf8(u8"0.png"))), qPrintable(QString::fromUtf8(u8"first file not written")));
+    QVERIFY2(!QFile::exists(directory.filePath(QString::fromUtf8(u8"8.png"))), qPrintable(QString::fromUtf8(u8"unparseable formula rendered")));
+}
+
 #ifdef _USE_LONG_TEST
 
 void FrontendTest::AboutButtonShallTriggerDialogAndOKShallClose()
@@ -196,6 +319,66 @@ void FrontendTest::ClickingPlotShallNotAddArrowWhenImpossible()
     QVERIFY2(graphHasOneItem, qPrintable(QString::fromUtf8(u8"arrow present after click")));
 }
 
+void FrontendTest::ClickingPlotShallAddArrowToBufferedLayer()
+{
+    // Arrange
+    MainWindow mw;
+
+    mw.ui->funcLineEdit->setText(QString::fromUtf8(u8"z * i"));
+    QTest::mouseClick(mw.ui->funcSetButton, Qt::LeftButton);
+
+    for (int index = 0; index < BenchmarkItemCount / 2; ++index)
+    {
+        mw.PlotArrow(Backend::complex(index, 0.0), Backend::complex(0.0, index));
+    }
+
+    mw.ui->plot->replot();
+
+    // Act
+    QBENCHMARK_ONCE
+    {
+        QTest::mouseClick(mw.ui->plot, Qt::LeftButton);
+        mw.arrowLayer->replotAppended();
+    }
+
+    // Assert
+    auto * arrow = mw.ui->plot->item();
+    QVERIFY2(arrow->layer() == mw.arrowLayer, qPrintable(QString::fromUtf8(u8"arrow not on arrow layer")));
+    QVERIFY2(mw.arrowLayer->mode() == QCPLayer::lmBuffered, qPrintable(QString::fromUtf8(u8"arrow layer not buffered")));
+    QVERIFY2(mw.arrowLayer->children().size() == BenchmarkItemCount / 2 + 1, qPrintable(QString::fromUtf8(u8"incorrect number of arrows on arrow layer")));
+}
+
+void FrontendTest::AppendingShallOnlyDrawTheAppendedChildren()
+{
+    // Arrange
+    MainWindow mw;
+
+    mw.ui->funcLineEdit->setText(QString::fromUtf8(u8"z * i"));
+    QTest::mouseClick(mw.ui->funcSetButton, Qt::LeftButton);
+
+    std::vector<DrawCountingItem *> existing;
+    for (int index = 0; index < 10; ++index)
+    {
+        existing.push_back(new DrawCountingItem(mw.ui->plot)); //NOLINT(cppcoreguidelines-owning-memory)
+    }
+
+    mw.ui->plot->replot();
+    bool allDrawnOnce = std::all_of(existing.begin(), existing.end(), [](const DrawCountingItem * item) { return item->drawCount == 1; });
+
+    // Act
+    QTest::mouseClick(mw.ui->plot, Qt::LeftButton);
+    auto * appended = new DrawCountingItem(mw.ui->plot); //NOLINT(cppcoreguidelines-owning-memory)
+    mw.arrowLayer->replotAppended();
+
+    // Assert
+    bool existingNotRedrawn = std::all_of(existing.begin(), existing.end(), [](const DrawCountingItem * item) { return item->drawCount == 1; });
+    QVERIFY2(allDrawnOnce, qPrintable(QString::fromUtf8(u8"existing children not drawn by the replot")));
+    QVERIFY2(existing.front()->layer() == mw.arrowLayer && appended->layer() == mw.arrowLayer, qPrintable(QString::fromUtf8(u8"children not on arrow layer")));
+    QVERIFY2(mw.arrowLayer->children().size() == 12, qPrintable(QString::fromUtf8(u8"clicked arrow not appended")));
+    QVERIFY2(existingNotRedrawn, qPrintable(QString::fromUtf8(u8"existing children drawn again when appending")));
+    QVERIFY2(appended->drawCount == 1, qPrintable(QString::fromUtf8(u8"appended child not drawn exactly once")));
+}
+
 void FrontendTest::ClearButtonShallClearGraph()
 {
     // Arrange
@@ -292,6 +475,424 @@ void FrontendTest::GridAdditionShallAddArrows()
     QVERIFY2(postCount > 0, qPrintable(QString::fromUtf8(u8"postCount not greater 0")));
 }
 
+void FrontendTest::ClearingManyArrowsShallBeFast()
+{
+    // Arrange
+    MainWindow mw;
+    mw.ui->funcLineEdit->setText(QString("z * i"));
+    QTest::mouseClick(mw.ui->funcSetButton, Qt::LeftButton);
+
+    for (int index = 0; index < BenchmarkItemCount; ++index)
+    {
+        mw.PlotArrow(Backend::complex(index, 0.0), Backend::complex(0.0, index));
+    }
+
+    int preCount = mw.ui->plot->itemCount();
+
+    // Act
+    QBENCHMARK_ONCE
+    {
+        mw.ClearPlot();
+    }
+
+    int postCount = mw.ui->plot->itemCount();
+
+    // Assert
+    QVERIFY2(preCount == BenchmarkItemCount, qPrintable(QString::fromUtf8(u8"preCount not equal to number of added arrows")));
+    QVERIFY2(postCount == 0, qPrintable(QString::fromUtf8(u8"postCount not equal 0")));
+}
+
+void FrontendTest::RemovingManyGridArrowsShallBeFast()
+{
+    // Arrange
+    MainWindow mw;
+    mw.ui->funcLineEdit->setText(QString("z * i"));
+    QTest::mouseClick(mw.ui->funcSetButton, Qt::LeftButton);
+
+    auto * kept = mw.PlotArrow(Backend::complex(1.0, 1.0), Backend::complex(2.0, 2.0));
+
+    std::vector<Backend::Sample> samples;
+    for (int index = 0; index < BenchmarkItemCount; ++index)
+    {
+        samples.push_back(Backend::Sample{Backend::complex(index, 0.0), Backend::complex(0.0, index)});
+    }
+
+    mw.PlotSamples(samples);
+
+    // Act
+    QBENCHMARK_ONCE
+    {
+        mw.RemoveGridArrows();
+    }
+
+    // Assert
+    QVERIFY2(mw.ui->plot->hasItem(kept), qPrintable(QString::fromUtf8(u8"clicked arrow removed")));
+    QVERIFY2(mw.gridField->GetArrowCount() == 0, qPrintable(QString::fromUtf8(u8"grid arrows still present")));
+}
+
+void FrontendTest::DenseGridArrowsShallBeAggregatedUntilZoomedIn()
+{
+    // Arrange
+    MainWindow mw;
+    mw.ui->funcLineEdit->setText(QString("z * i"));
+    QTest::mouseClick(mw.ui->funcSetButton, Qt::LeftButton);
+    mw.ui->plot->resize(800, 600);
+
+    std::vector<Backend::Sample> samples;
+    for (int x = -150; x <= 150; ++x)
+    {
+        for (int y = -150; y <= 150; ++y)
+        {
+            auto input = Backend::complex(x / 15.0, y / 15.0);
+            samples.push_back(Backend::Sample{input, input * Backend::complex(0.0, 1.0)});
+        }
+    }
+
+    mw.PlotSamples(samples);
+    mw.ui->plot->replot();
+
+    // Act
+    bool aggregatingZoomedOut = mw.gridField->IsAggregating();
+
+    QBENCHMARK_ONCE
+    {
+        mw.ui->plot->replot();
+    }
+
+    mw.ui->plot->xAxis->setRange(-0.5, 0.5);
+    mw.ui->plot->yAxis->setRange(-0.5, 0.5);
+    mw.ui->plot->replot();
+
+    bool aggregatingZoomedIn = mw.gridField->IsAggregating();
+
+    // Assert
+    QVERIFY2(aggregatingZoomedOut, qPrintable(QString::fromUtf8(u8"dense arrows not aggregated")));
+    QVERIFY2(!aggregatingZoomedIn, qPrintable(QString::fromUtf8(u8"sparse arrows aggregated")));
+}
+
+void FrontendTest::ArrowsEndingInsideShallBeVisible()
+{
+    // Arrange
+    MainWindow mw;
+    mw.ui->funcLineEdit->setText(QString("z * i"));
+    QTest::mouseClick(mw.ui->funcSetButton, Qt::LeftButton);
+    mw.ui->plot->resize(800, 600);
+
+    std::vector<Backend::Sample> samples({
+        Backend::Sample{Backend::complex(1.0, 1.0), Backend::complex(2.0, 2.0)},
+        Backend::Sample{Backend::complex(20.0, 0.0), Backend::complex(5.0, 0.0)},
+        Backend::Sample{Backend::complex(5.0, 0.0), Backend::complex(0.0, 20.0)},
+        Backend::Sample{Backend::complex(20.0, 20.0), Backend::complex(30.0, 30.0)},
+    });
+
+    // Act
+    mw.PlotSamples(samples);
+    mw.ui->plot->replot();
+    auto visibleCount = mw.gridField->GetVisibleCount();
+
+    // Assert
+    QVERIFY2(visibleCount == 3, qPrintable(QString::fromUtf8(u8"arrows not judged visible by both ends")));
+}
+
+void FrontendTest::ZoomedOutSquareGridShallStayBoundedAndProgressive()
+{
+    // Arrange
+    MainWindow mw;
+    mw.ui->funcLineEdit->setText(QString("z * i"));
+    QTest::mouseClick(mw.ui->funcSetButton, Qt::LeftButton);
+    mw.ui->plot->xAxis->setRange(-10000.0, 10000.0);
+    mw.ui->plot->yAxis->setRange(-10000.0, 10000.0);
+    mw.gridSpecification = Backend::GridSpecification { Backend::GridSpecification::Type::Square, 0.5, 0.0, 0.0, 0 };
+
+    // Act
+    mw.PlotGrid();
+    bool refining = mw.tileScheduler != nullptr;
+
+    while (mw.tileScheduler)
+    {
+        mw.RefineGrid();
+    }
+
+    auto arrowCount = mw.gridField->GetArrowCount();
+
+    mw.ui->plot->xAxis->setRange(-9000.0, 11000.0);
+    mw.PlotGrid();
+    bool refiningAfterPan = mw.tileScheduler != nullptr;
+
+    while (mw.tileScheduler)
+    {
+        mw.RefineGrid();
+    }
+
+    auto evaluationDistance = mw.viewportEvaluator->GetDistance();
+
+    // Assert
+    QVERIFY2(refining, qPrintable(QString::fromUtf8(u8"square grid not evaluated progressively")));
+    QVERIFY2(arrowCount > 0 && arrowCount <= static_cast<std::size_t>(mw.maxPointsPerViewport), qPrintable(QString::fromUtf8(u8"number of grid points not bounded")));
+    QVERIFY2(refiningAfterPan, qPrintable(QString::fromUtf8(u8"exposed strip not evaluated progressively")));
+    QVERIFY2(evaluationDistance > 0.5, qPrintable(QString::fromUtf8(u8"grid not coarsened")));
+}
+
+void FrontendTest::FlowButtonShallAddStreamlines()
+{
+    // Arrange
+    MainWindow mw;
+    mw.ui->funcLineEdit->setText(QString("z * i"));
+    bool flowIsDisabledBeforeSet = !mw.ui->flowButton->isEnabled();
+    QTest::mouseClick(mw.ui->funcSetButton, Qt::LeftButton);
+
+    auto *otherGraph = mw.ui->plot->addGraph();
+
+    // Act
+    QTest::mouseClick(mw.ui->flowButton, Qt::LeftButton);
+    bool tracedInBackground = mw.streamlineTimer.isActive();
+    bool traced = QTest::qWaitFor([&mw]() { return !mw.streamlineTimer.isActive(); }, 5000);
+    int curveCount = mw.streamlineCurves.size();
+    bool curvesOnArrowLayer = curveCount > 0 && mw.streamlineCurves.front()->layer() == mw.arrowLayer;
+
+    QTest::mouseClick(mw.ui->flowButton, Qt::LeftButton);
+    bool tracedAgain = QTest::qWaitFor([&mw]() { return !mw.streamlineTimer.isActive(); }, 5000);
+    int curveCountAgain = mw.streamlineCurves.size();
+    bool otherGraphKept = mw.ui->plot->hasPlottable(otherGraph);
+    int plottableCount = mw.ui->plot->plottableCount();
+
+    QTest::mouseClick(mw.ui->funcClearButton, Qt::LeftButton);
+    int curveCountAfterClear = mw.ui->plot->plottableCount();
+
+    // Assert
+    QVERIFY2(flowIsDisabledBeforeSet, qPrintable(QString::fromUtf8(u8"flow button enabled before set")));
+    QVERIFY2(tracedInBackground, qPrintable(QString::fromUtf8(u8"streamlines not traced in the background")));
+    QVERIFY2(traced && tracedAgain, qPrintable(QString::fromUtf8(u8"streamlines not finished")));
+    QVERIFY2(curveCount > 0, qPrintable(QString::fromUtf8(u8"no streamlines added")));
+    QVERIFY2(curvesOnArrowLayer, qPrintable(QString::fromUtf8(u8"streamlines not on arrow layer")));
+    QVERIFY2(curveCountAgain == curveCount, qPrintable(QString::fromUtf8(u8"streamlines not replaced")));
+    QVERIFY2(otherGraphKept && plottableCount == curveCount + 1, qPrintable(QString::fromUtf8(u8"other plottables removed with the streamlines")));
+    QVERIFY2(curveCountAfterClear == 0, qPrintable(QString::fromUtf8(u8"streamlines still present after clear")));
+}
+
+void FrontendTest::OrbitModeShallAddArrowChains()
+{
+    // Arrange
+    MainWindow mw;
+    mw.ui->funcLineEdit->setText(QString("z * i"));
+    QTest::mouseClick(mw.ui->funcSetButton, Qt::LeftButton);
+
+    // Act
+    QTest::mouseClick(mw.ui->orbitButton, Qt::LeftButton);
+    bool orbitIsChecked = mw.ui->orbitButton->isChecked();
+
+    mw.PlotOrbitFrom(2.0, 0.0);
+    int rotationCount = mw.ui->plot->itemCount();
+
+    QTest::mouseClick(mw.ui->funcClearButton, Qt::LeftButton);
+    mw.ui->funcLineEdit->setText(QString("z * z"));
+    QTest::mouseClick(mw.ui->funcSetButton, Qt::LeftButton);
+
+    mw.PlotOrbitFrom(2.0, 0.0);
+    int escapeCount = mw.ui->plot->itemCount();
+
+    // Assert
+    QVERIFY2(orbitIsChecked, qPrintable(QString::fromUtf8(u8"orbit button not checked")));
+    QVERIFY2(rotationCount == mw.orbitIterations, qPrintable(QString::fromUtf8(u8"bounded orbit not drawn completely")));
+    QVERIFY2(escapeCount == 4, qPrintable(QString::fromUtf8(u8"escaping orbit not ended early")));
+}
+
+void FrontendTest::OrbitGridShallBeIteratedInTheBackground()
+{
+    // Arrange
+    MainWindow mw;
+    mw.ui->funcLineEdit->setText(QString("z * i"));
+    QTest::mouseClick(mw.ui->funcSetButton, Qt::LeftButton);
+    mw.ui->plot->xAxis->setRange(-10000.0, 10000.0);
+    mw.ui->plot->yAxis->setRange(-10000.0, 10000.0);
+    mw.gridSpecification = Backend::GridSpecification { Backend::GridSpecification::Type::AngularFromApproximateDistance, 0.5, 0.0, 0.0, 0 };
+
+    // Act
+    QTest::mouseClick(mw.ui->orbitButton, Qt::LeftButton);
+    bool iteratedInBackground = mw.orbitGridTimer.isActive();
+    bool iterated = QTest::qWaitFor([&mw]() { return !mw.orbitGridTimer.isActive(); }, 5000);
+    auto arrowCount = mw.gridField != nullptr ? mw.gridField->GetArrowCount() : 0;
+
+    // Assert
+    QVERIFY2(iteratedInBackground, qPrintable(QString::fromUtf8(u8"orbit grid not iterated in the background")));
+    QVERIFY2(iterated, qPrintable(QString::fromUtf8(u8"orbit grid not finished")));
+    QVERIFY2(arrowCount > 0 && arrowCount <= static_cast<std::size_t>(mw.maxPointsPerViewport), qPrintable(QString::fromUtf8(u8"number of orbits not bounded")));
+}
+
+void FrontendTest::RootButtonShallMarkZerosAndPoles()
+{
+    // Arrange
+    MainWindow mw;
+    mw.ui->funcLineEdit->setText(QString("(z - 1) / (z + 2 * i)"));
+    QTest::mouseClick(mw.ui->funcSetButton, Qt::LeftButton);
+    mw.PlotArrow(Backend::complex(1.0, 1.0), Backend::complex(2.0, 2.0));
+
+    // Act
+    QTest::mouseClick(mw.ui->rootButton, Qt::LeftButton);
+    bool searchedInBackground = mw.rootTimer.isActive();
+    bool searched = QTest::qWaitFor([&mw]() { return !mw.rootTimer.isActive(); }, 5000);
+    int markerCount = mw.rootMarkers.size();
+    int itemCount = mw.ui->plot->itemCount();
+
+    QTest::mouseClick(mw.ui->rootButton, Qt::LeftButton);
+    bool searchedAgain = QTest::qWaitFor([&mw]() { return !mw.rootTimer.isActive(); }, 5000);
+    int itemCountAgain = mw.ui->plot->itemCount();
+
+    // Assert
+    QVERIFY2(searchedInBackground, qPrintable(QString::fromUtf8(u8"roots not searched in the background")));
+    QVERIFY2(searched && searchedAgain, qPrintable(QString::fromUtf8(u8"root search not finished")));
+    QVERIFY2(markerCount == 2, qPrintable(QString::fromUtf8(u8"zero and pole not marked")));
+    QVERIFY2(itemCount == 3, qPrintable(QString::fromUtf8(u8"unexpected number of items")));
+    QVERIFY2(itemCountAgain == 3, qPrintable(QString::fromUtf8(u8"markers not replaced")));
+}
+
+void FrontendTest::AnimateButtonShallPlayFrames()
+{
+    // Arrange
+    MainWindow mw;
+    mw.ui->funcLineEdit->setText(QString("z * exp(i * t)"));
+    bool animateIsDisabledBeforeSet = !mw.ui->animateButton->isEnabled();
+    QTest::mouseClick(mw.ui->funcSetButton, Qt::LeftButton);
+
+    // Act
+    QTest::mouseClick(mw.ui->animateButton, Qt::LeftButton);
+    bool pipelineStarted = mw.framePipeline != nullptr;
+
+    QTest::qWait(500);
+    bool arrowsShown = mw.gridField != nullptr && mw.gridField->GetArrowCount() > 0;
+    bool timeAdvanced = mw.animationTime > 0.0;
+
+    QTest::mouseClick(mw.ui->animateButton, Qt::LeftButton);
+    bool pipelineStopped = mw.framePipeline == nullptr;
+
+    QTest::mouseClick(mw.ui->animateButton, Qt::LeftButton);
+    QTest::mouseClick(mw.ui->funcClearButton, Qt::LeftButton);
+    bool pipelineStoppedByClear = mw.framePipeline == nullptr && !mw.ui->animateButton->isChecked();
+
+    // Assert
+    QVERIFY2(animateIsDisabledBeforeSet, qPrintable(QString::fromUtf8(u8"animate button enabled before set")));
+    QVERIFY2(pipelineStarted, qPrintable(QString::fromUtf8(u8"animation not started")));
+    QVERIFY2(arrowsShown, qPrintable(QString::fromUtf8(u8"no frame shown")));
+    QVERIFY2(timeAdvanced, qPrintable(QString::fromUtf8(u8"time not advanced")));
+    QVERIFY2(pipelineStopped, qPrintable(QString::fromUtf8(u8"animation not stopped")));
+    QVERIFY2(pipelineStoppedByClear, qPrintable(QString::fromUtf8(u8"animation not stopped by clear")));
+}
+
+void FrontendTest::OverlayFormulasShallBeDrawnWithDifferentStyles()
+{
+    // Arrange
+    MainWindow mw;
+    mw.ui->funcLineEdit->setText(QString("z * i; z * z; sin(z) ;"));
+    bool incompleteIsNotParseable = mw.ui->funcLineEdit->palette().base().color() != Qt::white;
+    mw.ui->funcLineEdit->setText(QString("z * i; z * z; sin(z)"));
+    bool completeIsParseable = mw.ui->funcLineEdit->palette().base().color() == Qt::white;
+    QTest::mouseClick(mw.ui->funcSetButton, Qt::LeftButton);
+
+    // Act
+    mw.PlotFrom(1.0, 1.0);
+    int clickItemCount = mw.ui->plot->itemCount();
+    auto * first = qobject_cast<QCPItemLine *>(mw.ui->plot->item(0));
+    auto * second = qobject_cast<QCPItemLine *>(mw.ui->plot->item(1));
+    bool clickStylesDiffer = first != nullptr && second != nullptr && first->pen().style() != second->pen().style();
+
+    mw.gridSpecification = Backend::GridSpecification { Backend::GridSpecification::Type::Square, 1.0, 0.0, 0.0, 0 };
+    mw.PlotGrid();
+    bool evaluatedInBackground = mw.fusedGridTimer.isActive();
+    bool evaluated = QTest::qWaitFor([&mw]() { return !mw.fusedGridTimer.isActive(); }, 5000);
+    bool overlayFieldsCreated = mw.overlayFields.size() == 2;
+    bool gridStylesDiffer = overlayFieldsCreated
+            && mw.gridField->GetPenStyle() != mw.overlayFields[0]->GetPenStyle()
+            && mw.overlayFields[0]->GetPenStyle() != mw.overlayFields[1]->GetPenStyle();
+    bool overlayFieldsFilled = overlayFieldsCreated && mw.overlayFields[0]->GetArrowCount() == mw.gridField->GetArrowCount();
+    auto arrowCount = overlayFieldsCreated ? mw.overlayFields[1]->GetArrowCount() : 0;
+
+    mw.PlotGrid();
+    bool takenFromCache = !mw.fusedGridTimer.isActive() && overlayFieldsCreated && mw.overlayFields[1]->GetArrowCount() == arrowCount;
+
+    // Assert
+    QVERIFY2(incompleteIsNotParseable, qPrintable(QString::fromUtf8(u8"empty formula indicated as parseable")));
+    QVERIFY2(completeIsParseable, qPrintable(QString::fromUtf8(u8"formulas not indicated as parseable")));
+    QVERIFY2(mw.overlayExpressions.size() == 2, qPrintable(QString::fromUtf8(u8"overlay formulas not parsed")));
+    QVERIFY2(clickItemCount == 3, qPrintable(QString::fromUtf8(u8"click did not add an arrow per formula")));
+    QVERIFY2(clickStylesDiffer, qPrintable(QString::fromUtf8(u8"arrows of formulas not told apart")));
+    QVERIFY2(evaluatedInBackground && evaluated, qPrintable(QString::fromUtf8(u8"formulas not evaluated in the background")));
+    QVERIFY2(overlayFieldsCreated, qPrintable(QString::fromUtf8(u8"overlay fields not created")));
+    QVERIFY2(gridStylesDiffer, qPrintable(QString::fromUtf8(u8"grid arrows of formulas not told apart")));
+    QVERIFY2(overlayFieldsFilled, qPrintable(QString::fromUtf8(u8"overlay fields not filled")));
+    QVERIFY2(takenFromCache, qPrintable(QString::fromUtf8(u8"revisited formulas evaluated again")));
+}
+
+void FrontendTest::ProfileButtonShallShowReport()
+{
+    // Arrange
+    MainWindow mw;
+    mw.ui->funcLineEdit->setText(QString("sin(z) / z"));
+    bool profileIsDisabledBeforeSet = !mw.ui->profileButton->isEnabled();
+    bool panelIsHiddenBeforeProfile = !mw.ui->profilePanel->isVisibleTo(&mw);
+    QTest::mouseClick(mw.ui->funcSetButton, Qt::LeftButton);
+
+    // Act
+    QTest::mouseClick(mw.ui->profileButton, Qt::LeftButton);
+    bool panelShown = mw.ui->profilePanel->isVisibleTo(&mw);
+    auto text = mw.ui->profilePanel->toPlainText();
+
+    QTest::mouseClick(mw.ui->funcClearButton, Qt::LeftButton);
+    bool panelHiddenByClear = !mw.ui->profilePanel->isVisibleTo(&mw) && !mw.ui->profileButton->isChecked();
+
+    // Assert
+    QVERIFY2(profileIsDisabledBeforeSet, qPrintable(QString::fromUtf8(u8"profile button enabled before set")));
+    QVERIFY2(panelIsHiddenBeforeProfile, qPrintable(QString::fromUtf8(u8"profile panel shown before profile")));
+    QVERIFY2(panelShown, qPrintable(QString::fromUtf8(u8"profile panel not shown")));
+    QVERIFY2(text.contains(QString::fromUtf8(u8"sin")), qPrintable(QString::fromUtf8(u8"function not in profile")));
+    QVERIFY2(text.contains(QString::fromUtf8(u8"evaluations: ")), qPrintable(QString::fromUtf8(u8"evaluations not in profile")));
+    QVERIFY2(text.contains(QString::fromUtf8(u8"hot node: ")), qPrintable(QString::fromUtf8(u8"hot node not in profile")));
+    QVERIFY2(text.contains(QString::fromUtf8(u8"Square grids")), qPrintable(QString::fromUtf8(u8"note on square grids not in profile")));
+    QVERIFY2(panelHiddenByClear, qPrintable(QString::fromUtf8(u8"profile panel not hidden by clear")));
+}
+
+void FrontendTest::TraceButtonShallRecordPipeline()
+{
+    // Arrange
+    QTemporaryDir directory;
+    QVERIFY2(directory.isValid(), qPrintable(QString::fromUtf8(u8"no temporary directory")));
+    auto fileName = directory.filePath(QString::fromUtf8(u8"trace-\u00e4\u00f6\u00fc.json"));
+    auto unwritableFileName = directory.filePath(QString::fromUtf8(u8"missing/trace.json"));
+
+    MainWindow mw;
+    mw.ui->funcLineEdit->setText(QString("z * z"));
+
+    // Act
+    QTest::mouseClick(mw.ui->traceButton, Qt::LeftButton);
+    bool tracingEnabled = Backend::Tracer::IsEnabled();
+
+    QTest::mouseClick(mw.ui->funcSetButton, Qt::LeftButton);
+    mw.PlotFrom(1.0, 1.0);
+    mw.ui->plot->replot();
+
+    // unchecking would ask for a file name, so the trace is saved directly
+    {
+        QSignalBlocker blocker(mw.ui->traceButton);
+        mw.ui->traceButton->setChecked(false);
+    }
+
+    Backend::Tracer::Disable();
+    bool saved = mw.SaveTrace(fileName);
+    bool savedUnwritable = mw.SaveTrace(unwritableFileName);
+
+    QFile file(fileName);
+    bool opened = file.open(QIODevice::ReadOnly);
+    auto text = QString::fromUtf8(file.readAll());
+
+    // Assert
+    QVERIFY2(tracingEnabled, qPrintable(QString::fromUtf8(u8"tracing not enabled")));
+    QVERIFY2(saved && opened, qPrintable(QString::fromUtf8(u8"trace not saved")));
+    QVERIFY2(!savedUnwritable, qPrintable(QString::fromUtf8(u8"failure to save not reported")));
+    QVERIFY2(text.startsWith(QString::fromUtf8(u8"{\"traceEvents\":[")), qPrintable(QString::fromUtf8(u8"trace not in trace event format")));
+    QVERIFY2(text.contains(QString::fromUtf8(u8"Parser::Parse")), qPrintable(QString::fromUtf8(u8"parsing not traced")));
+    QVERIFY2(text.contains(QString::fromUtf8(u8"MainWindow::PlotFrom")), qPrintable(QString::fromUtf8(u8"plotting not traced")));
+    QVERIFY2(text.contains(QString::fromUtf8(u8"QCustomPlot::replot")), qPrintable(QString::fromUtf8(u8"replot not traced")));
+}
+
 #endif // _USE_LONG_TEST
 
 QTEST_MAIN(FrontendTest)
@@ -17,8 +17,11 @@
  */
 
 #include "../Frontend/mainwindow.h"
+#include "../Frontend/offscreenrenderer.h"
 
 #include <QApplication>
+#include <QCommandLineParser>
+#include <QDir>
 #include <QLocale>
 #include <QTranslator>
 
@@ -26,6 +29,59 @@ int main(int argc, char *argv[])
 {
     QApplication a(argc, argv);
 
+    // headless batch rendering, e.g. with QT_QPA_PLATFORM=offscreen:
+    // QtImagiComplexation --render <directory> [--size <pixels>] [--range <range>] [--dist <dist>] [--arrows-only] [--double] <formula> [<formula> ...]
+    auto arguments = QApplication::arguments();
+    if (arguments.size() >= 2 && arguments.at(1) == QString::fromUtf8(u8"--render"))
+    {
+        QCommandLineParser commandLineParser;
+        QCommandLineOption renderOption(QString::fromUtf8(u8"render"), QString::fromUtf8(u8"Renders thumbnails of the formulas into the directory."), QString::fromUtf8(u8"directory"));
+        QCommandLineOption sizeOption(QString::fromUtf8(u8"size"), QString::fromUtf8(u8"Width and height of the thumbnails in pixels."), QString::fromUtf8(u8"pixels"), QString::fromUtf8(u8"256"));
+        QCommandLineOption rangeOption(QString::fromUtf8(u8"range"), QString::fromUtf8(u8"Maximum absolute value shown in real and imaginary direction."), QString::fromUtf8(u8"range"), QString::fromUtf8(u8"10"));
+        QCommandLineOption distOption(QString::fromUtf8(u8"dist"), QString::fromUtf8(u8"Point-to-point distance of the square grid."), QString::fromUtf8(u8"dist"), QString::fromUtf8(u8"1"));
+        QCommandLineOption arrowsOnlyOption(QString::fromUtf8(u8"arrows-only"), QString::fromUtf8(u8"Colors the arrows instead of the background."));
+        QCommandLineOption doubleOption(QString::fromUtf8(u8"double"), QString::fromUtf8(u8"Evaluates the background coloring in double instead of single precision."));
+
+        commandLineParser.addHelpOption();
+        commandLineParser.addOptions({ renderOption, sizeOption, rangeOption, distOption, arrowsOnlyOption, doubleOption });
+        commandLineParser.addPositionalArgument(QString::fromUtf8(u8"formulas"), QString::fromUtf8(u8"The formulas to render."), QString::fromUtf8(u8"<formula> [<formula> ...]"));
+        commandLineParser.process(arguments);
+
+        bool sizeIsValid = false;
+        bool rangeIsValid = false;
+        bool distIsValid = false;
+        auto thumbnailSize = commandLineParser.value(sizeOption).toInt(&sizeIsValid);
+        auto range = commandLineParser.value(rangeOption).toDouble(&rangeIsValid);
+        auto dist = commandLineParser.value(distOption).toDouble(&distIsValid);
+        auto formulas = commandLineParser.positionalArguments();
+
+        if (!sizeIsValid || !rangeIsValid || !distIsValid || thumbnailSize <= 0 || !(range > 0.0) || !(dist > 0.0) || formulas.isEmpty())
+        {
+            commandLineParser.showHelp(1);
+        }
+
+        // very dense grids are coarsened like in the window
+        const double maxPointsPerThumbnail = 40000.0;
+        Backend::GridGenerator gridGenerator(range, range);
+        auto specification = gridGenerator.Limit(Backend::GridSpecification { Backend::GridSpecification::Type::Square, dist, 0.0, 0.0, 0 }, maxPointsPerThumbnail);
+
+        // thumbnails do not need more than single precision
+        auto precision = commandLineParser.isSet(doubleOption) ? Backend::Precision::Double : Backend::Precision::Single;
+
+        QDir directory(commandLineParser.value(renderOption));
+        QList<OffscreenRenderer::Job> jobs;
+
+        for (int index = 0; index < formulas.size(); ++index)
+        {
+            auto fileName = directory.filePath(QString::fromUtf8(u8"thumbnail_%1.png").arg(index));
+            jobs.append(OffscreenRenderer::Job{formulas.at(index).toStdString(), specification, fileName, precision});
+        }
+
+        OffscreenRenderer renderer(QSize(thumbnailSize, thumbnailSize), -range, range, -range, range, !commandLineParser.isSet(arrowsOnlyOption));
+
+        return renderer.RenderToFiles(jobs) == jobs.size() ? 0 : 2;
+    }
+
     QApplication::setWindowIcon(QIcon(":/icon.ico"));
 
     QTranslator translator;